@@ -43,6 +43,10 @@ pub enum CaptureCommands {
         #[arg(long, default_value_t = 0)]
         post_roll_ms: u32,
 
+        /// Record per-function call counts and times only (no event trace)
+        #[arg(long)]
+        profile: bool,
+
         /// Arguments to pass to the binary
         #[arg(trailing_var_arg = true)]
         args: Vec<String>,
@@ -65,8 +69,17 @@ pub fn run(cmd: CaptureCommands) -> anyhow::Result<()> {
             no_voice,
             pre_roll_ms,
             post_roll_ms,
+            profile,
             args,
-        } => start_capture(&binary, !no_screen, !no_voice, pre_roll_ms, post_roll_ms, &args),
+        } => start_capture(
+            &binary,
+            !no_screen,
+            !no_voice,
+            pre_roll_ms,
+            post_roll_ms,
+            profile,
+            &args,
+        ),
         CaptureCommands::Stop { session_id } => stop_capture(session_id),
     }
 }
@@ -235,6 +248,7 @@ fn start_capture(
     voice: bool,
     pre_roll_ms: u32,
     post_roll_ms: u32,
+    profile: bool,
     args: &[String],
 ) -> anyhow::Result<()> {
     // Clean up any orphaned sessions first
@@ -310,6 +324,10 @@ fn start_capture(
     map_tracer_result(controller.fire_trigger())?;
 
     map_tracer_result(controller.set_detail_enabled(voice))?;
+    if profile {
+        // Totals land in the trace manifest's "aggregates" section at stop
+        map_tracer_result(controller.set_aggregation(2))?;
+    }
     map_tracer_result(controller.resume())?;
 
     // Start ada-recorder for screen/voice recording
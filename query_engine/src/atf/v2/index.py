@@ -8,7 +8,16 @@ import mmap
 from pathlib import Path
 from typing import Iterator, Optional
 
-from .types import IndexEvent, IndexFooter, IndexHeader, ATF_INDEX_FLAG_HAS_DETAIL_FILE
+from .types import (
+    IndexEvent,
+    IndexFooter,
+    IndexHeader,
+    ATF_INDEX_FLAG_HAS_DETAIL_FILE,
+    ATF_INDEX_FLAG_LIVE_EVENT_COUNT,
+)
+
+# Byte offset of the header event_count field
+_HEADER_EVENT_COUNT_OFFSET = 28
 
 
 class IndexReader:
@@ -67,11 +76,29 @@ class IndexReader:
                 return footer, footer.event_count
 
         # Footer invalid or missing, calculate from file size
-        events_section_size = len(self._mmap) - self._header.events_offset
-        calculated_count = events_section_size // 32
+        calculated_count = self._mapped_event_capacity()
+
+        # Live file (preallocated by the writer): trust the header count
+        if self._header.flags & ATF_INDEX_FLAG_LIVE_EVENT_COUNT:
+            return None, min(self._header.event_count, calculated_count)
 
         return None, calculated_count
 
+    def _mapped_event_capacity(self) -> int:
+        """Number of whole events that fit in the mapped events section"""
+        return max(0, len(self._mmap) - self._header.events_offset) // 32
+
+    def refresh(self) -> int:
+        """Pick up events appended to a live file since open (or last refresh)"""
+        if self._footer or not (self._header.flags & ATF_INDEX_FLAG_LIVE_EVENT_COUNT):
+            return self._event_count
+
+        offset = _HEADER_EVENT_COUNT_OFFSET
+        live_count = int.from_bytes(self._mmap[offset:offset + 4], 'little')
+        live_count = min(live_count, self._mapped_event_capacity())
+        self._event_count = max(self._event_count, live_count)
+        return self._event_count
+
     def __len__(self) -> int:
         """Get event count"""
         return self._event_count
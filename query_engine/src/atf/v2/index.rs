@@ -2,10 +2,17 @@
 // Tech Spec: M1_E5_I2_TECH_DESIGN.md - Memory-mapped reader for index files with O(1) access
 
 use super::error::{AtfV2Error, Result};
-use super::types::{AtfIndexFooter, AtfIndexHeader, IndexEvent, ATF_INDEX_FLAG_HAS_DETAIL_FILE};
+use super::types::{
+    AtfIndexFooter, AtfIndexHeader, IndexEvent, ATF_INDEX_FLAG_HAS_DETAIL_FILE,
+    ATF_INDEX_FLAG_LIVE_EVENT_COUNT,
+};
 use memmap2::Mmap;
 use std::fs::File;
 use std::path::Path;
+use std::sync::atomic::{AtomicU32, Ordering};
+
+/// Byte offset of `AtfIndexHeader::event_count` (4-byte aligned)
+const HEADER_EVENT_COUNT_OFFSET: usize = 28;
 
 /// Memory-mapped reader for ATF v2 index files
 pub struct IndexReader {
@@ -119,12 +126,47 @@ impl IndexReader {
         }
 
         // Footer invalid or missing, calculate from file size
-        let events_section_size = mmap.len().saturating_sub(header.events_offset as usize);
-        let calculated_count = (events_section_size / 32) as u32;
+        let calculated_count = Self::mapped_event_capacity(mmap, header);
+
+        // Live file (preallocated by the writer): the header count is current
+        // and the tail past it is unwritten extent, not events
+        if (header.flags & ATF_INDEX_FLAG_LIVE_EVENT_COUNT) != 0 {
+            return (None, header.event_count.min(calculated_count));
+        }
 
         (None, calculated_count)
     }
 
+    /// Number of whole events that fit in the mapped events section
+    fn mapped_event_capacity(mmap: &Mmap, header: &AtfIndexHeader) -> u32 {
+        let events_section_size = mmap.len().saturating_sub(header.events_offset as usize);
+        (events_section_size / 32) as u32
+    }
+
+    /// Pick up events appended since open (or the last refresh)
+    ///
+    /// Only files still being written with `ATF_INDEX_FLAG_LIVE_EVENT_COUNT`
+    /// can grow; finalized files return their fixed count. Growth is bounded
+    /// by the mapping taken at open, so reopen once the count stops moving
+    /// while the writer is still active.
+    pub fn refresh(&mut self) -> u32 {
+        if self.footer.is_some() || (self.header.flags & ATF_INDEX_FLAG_LIVE_EVENT_COUNT) == 0 {
+            return self.event_count;
+        }
+
+        // SAFETY: the mapping is page-aligned and at least 64 bytes, so the
+        // count field is in bounds and 4-byte aligned. Acquire pairs with the
+        // writer's release store, making the covered events visible.
+        let live_count = unsafe {
+            let ptr = self._mmap.as_ptr().add(HEADER_EVENT_COUNT_OFFSET) as *const AtomicU32;
+            (*ptr).load(Ordering::Acquire)
+        };
+
+        let capacity = Self::mapped_event_capacity(&self._mmap, &self.header);
+        self.event_count = self.event_count.max(live_count.min(capacity));
+        self.event_count
+    }
+
     /// Get event by sequence number (O(1))
     pub fn get(&self, seq: u32) -> Option<&IndexEvent> {
         if seq >= self.event_count {
@@ -891,4 +933,101 @@ mod tests {
         assert!(reader.is_empty());
         assert_eq!(reader.len(), 0);
     }
+
+    fn write_live_index_file(file: &mut NamedTempFile, live_count: u32, preallocated: u32) {
+        let header = AtfIndexHeader {
+            magic: *b"ATI2",
+            endian: 0x01,
+            version: 1,
+            arch: 1,
+            os: 3,
+            flags: ATF_INDEX_FLAG_LIVE_EVENT_COUNT,
+            thread_id: 0,
+            clock_type: 1,
+            _reserved1: [0; 3],
+            _reserved2: 0,
+            event_size: 32,
+            event_count: live_count,
+            events_offset: 64,
+            footer_offset: 64,
+            time_start_ns: 1000,
+            time_end_ns: 1000 + live_count as u64 * 100,
+        };
+        let header_bytes = unsafe {
+            std::slice::from_raw_parts(&header as *const AtfIndexHeader as *const u8, 64)
+        };
+        file.write_all(header_bytes).unwrap();
+
+        // Written events followed by zeroed, preallocated extent
+        for i in 0..preallocated {
+            let event = IndexEvent {
+                timestamp_ns: if i < live_count { 1000 + i as u64 * 100 } else { 0 },
+                function_id: if i < live_count { 0x100000001 + i as u64 } else { 0 },
+                thread_id: 0,
+                event_kind: if i < live_count { 1 } else { 0 },
+                call_depth: 0,
+                detail_seq: if i < live_count { u32::MAX } else { 0 },
+            };
+            let event_bytes = unsafe {
+                std::slice::from_raw_parts(&event as *const IndexEvent as *const u8, 32)
+            };
+            file.write_all(event_bytes).unwrap();
+        }
+        file.flush().unwrap();
+    }
+
+    #[test]
+    fn test_index_reader__live_file_no_footer__then_uses_header_count() {
+        // Live mmap-written file: preallocated tail must not count as events
+        let mut file = NamedTempFile::new().unwrap();
+        write_live_index_file(&mut file, 3, 128);
+
+        let reader = IndexReader::open(file.path()).unwrap();
+        assert_eq!(reader.len(), 3);
+        assert!(reader.footer.is_none());
+        let last = reader.get(2).unwrap();
+        let timestamp = last.timestamp_ns;
+        assert_eq!(timestamp, 1200);
+        assert!(reader.get(3).is_none());
+    }
+
+    #[test]
+    fn test_index_reader__live_file_grows__then_refresh_sees_new_events() {
+        use std::os::unix::fs::FileExt;
+
+        let mut file = NamedTempFile::new().unwrap();
+        write_live_index_file(&mut file, 2, 128);
+
+        let mut reader = IndexReader::open(file.path()).unwrap();
+        assert_eq!(reader.len(), 2);
+
+        // Writer appends two events, then publishes the new count
+        for i in 2u32..4 {
+            let event = IndexEvent {
+                timestamp_ns: 1000 + i as u64 * 100,
+                function_id: 0x100000001 + i as u64,
+                thread_id: 0,
+                event_kind: 1,
+                call_depth: 0,
+                detail_seq: u32::MAX,
+            };
+            let event_bytes = unsafe {
+                std::slice::from_raw_parts(&event as *const IndexEvent as *const u8, 32)
+            };
+            file.as_file().write_at(event_bytes, 64 + i as u64 * 32).unwrap();
+        }
+        file.as_file().write_at(&4u32.to_le_bytes(), HEADER_EVENT_COUNT_OFFSET as u64).unwrap();
+
+        assert_eq!(reader.refresh(), 4);
+        let last = reader.get(3).unwrap();
+        let timestamp = last.timestamp_ns;
+        assert_eq!(timestamp, 1300);
+    }
+
+    #[test]
+    fn test_index_reader__finalized_file__then_refresh_is_noop() {
+        let file = create_test_index_file(10);
+        let mut reader = IndexReader::open(file.path()).unwrap();
+        assert_eq!(reader.refresh(), 10);
+    }
 }
@@ -12,11 +12,12 @@ pub mod types;
 pub use detail::{DetailEventIter, DetailReader};
 pub use error::{AtfV2Error, Result};
 pub use index::{IndexEventIter, IndexReader};
-pub use session::{Manifest, MergedEventIter, SessionReader, ThreadInfo};
+pub use session::{ClockCalibration, Manifest, MergedEventIter, SessionReader, ThreadInfo};
 pub use thread::ThreadReader;
 pub use types::{
     AtfDetailFooter, AtfDetailHeader, AtfIndexFooter, AtfIndexHeader, DetailEvent,
-    DetailEventHeader, IndexEvent, ATF_DETAIL_EVENT_FUNCTION_CALL,
+    DetailEventHeader, IndexEvent, ATF_CLOCK_COUNTER, ATF_DETAIL_EVENT_FUNCTION_CALL,
     ATF_DETAIL_EVENT_FUNCTION_RETURN, ATF_EVENT_KIND_CALL, ATF_EVENT_KIND_EXCEPTION,
-    ATF_EVENT_KIND_RETURN, ATF_INDEX_FLAG_HAS_DETAIL_FILE, ATF_NO_DETAIL_SEQ,
+    ATF_EVENT_KIND_RETURN, ATF_EVENT_KIND_SAMPLED, ATF_EVENT_KIND_SPAN,
+    ATF_INDEX_FLAG_HAS_DETAIL_FILE, ATF_INDEX_FLAG_LIVE_EVENT_COUNT, ATF_NO_DETAIL_SEQ,
 };
@@ -7,7 +7,7 @@ Tech Spec: M1_E5_I2_TECH_DESIGN.md - Multi-thread reader with merge-sort iterato
 import heapq
 import json
 from pathlib import Path
-from typing import Iterator, NamedTuple
+from typing import Iterator, NamedTuple, Optional
 
 from .thread import ThreadReader
 from .types import IndexEvent
@@ -19,11 +19,41 @@ class ThreadInfo(NamedTuple):
     has_detail: bool = False
 
 
+# Timestamps are raw CPU counter ticks (see ClockCalibration)
+ATF_CLOCK_COUNTER = 4
+
+
+class ClockCalibration(NamedTuple):
+    """Counter-to-ns mapping recorded for ATF_CLOCK_COUNTER sessions"""
+    tick_base: int
+    ns_base: int
+    mult: int
+    shift: int
+    ticks_per_sec: int = 0
+
+    def to_ns(self, ticks: int) -> int:
+        """ns = ns_base + (((ticks - tick_base) * mult) >> shift)"""
+        if ticks >= self.tick_base:
+            return self.ns_base + (((ticks - self.tick_base) * self.mult) >> self.shift)
+        return self.ns_base - (((self.tick_base - ticks) * self.mult) >> self.shift)
+
+
+class FunctionAggregate(NamedTuple):
+    """Per-function totals from the aggregation lane (event timestamp units)"""
+    function_id: int
+    calls: int
+    inclusive_time: int
+    exclusive_time: int
+
+
 class Manifest(NamedTuple):
     """Session manifest"""
     threads: list[ThreadInfo]
     time_start_ns: int = 0
     time_end_ns: int = 0
+    clock_type: int = 0
+    clock_calibration: Optional[ClockCalibration] = None
+    aggregates: Optional[list[FunctionAggregate]] = None
 
     @classmethod
     def from_dict(cls, data: dict) -> 'Manifest':
@@ -36,10 +66,29 @@ class Manifest(NamedTuple):
             for t in data.get('threads', [])
         ]
 
+        calibration = data.get('clock_calibration')
+        aggregates = data.get('aggregates')
         return cls(
             threads=threads,
             time_start_ns=data.get('time_start_ns', 0),
             time_end_ns=data.get('time_end_ns', 0),
+            clock_type=data.get('clock_type', 0),
+            clock_calibration=ClockCalibration(
+                tick_base=calibration['tick_base'],
+                ns_base=calibration['ns_base'],
+                mult=calibration['mult'],
+                shift=calibration['shift'],
+                ticks_per_sec=calibration.get('ticks_per_sec', 0),
+            ) if calibration else None,
+            aggregates=[
+                FunctionAggregate(
+                    function_id=int(f['function_id'], 16),
+                    calls=f['calls'],
+                    inclusive_time=f['inclusive_time'],
+                    exclusive_time=f['exclusive_time'],
+                )
+                for f in aggregates.get('functions', [])
+            ] if aggregates else None,
         )
 
 
@@ -64,8 +113,15 @@ class SessionReader:
             if thread_dir.exists():
                 self.threads.append(ThreadReader(thread_dir))
 
+    def timestamp_ns(self, timestamp: int) -> int:
+        """Convert a raw event timestamp to ns (identity unless counter ticks)"""
+        calibration = self.manifest.clock_calibration
+        if calibration and self.manifest.clock_type == ATF_CLOCK_COUNTER:
+            return calibration.to_ns(timestamp)
+        return timestamp
+
     def time_range(self) -> tuple[int, int]:
-        """Time range across all threads"""
+        """Time range across all threads, in ns"""
         if not self.threads:
             return 0, 0
 
@@ -77,7 +133,7 @@ class SessionReader:
             min_time = min(min_time, start)
             max_time = max(max_time, end)
 
-        return int(min_time), int(max_time)
+        return self.timestamp_ns(int(min_time)), self.timestamp_ns(int(max_time))
 
     def event_count(self) -> int:
         """Total event count across all threads"""
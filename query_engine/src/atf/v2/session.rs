@@ -3,7 +3,7 @@
 
 use super::error::Result;
 use super::thread::ThreadReader;
-use super::types::IndexEvent;
+use super::types::{IndexEvent, ATF_CLOCK_COUNTER};
 use serde::{Deserialize, Serialize};
 use std::cmp::Reverse;
 use std::collections::BinaryHeap;
@@ -18,6 +18,54 @@ pub struct Manifest {
     pub time_start_ns: u64,
     #[serde(default)]
     pub time_end_ns: u64,
+    #[serde(default)]
+    pub clock_type: u8,
+    #[serde(default, skip_serializing_if = "Option::is_none")]
+    pub clock_calibration: Option<ClockCalibration>,
+    #[serde(default, skip_serializing_if = "Option::is_none")]
+    pub aggregates: Option<Aggregates>,
+}
+
+/// Per-function totals from the aggregation lane, merged across threads at
+/// session stop. Times are in event timestamp units.
+#[derive(Debug, Clone, Default, Serialize, Deserialize)]
+pub struct Aggregates {
+    #[serde(default)]
+    pub dropped_calls: u64,
+    pub functions: Vec<FunctionAggregate>,
+}
+
+#[derive(Debug, Clone, Serialize, Deserialize)]
+pub struct FunctionAggregate {
+    /// Hex string, as in the symbol table
+    pub function_id: String,
+    pub calls: u64,
+    pub inclusive_time: u64,
+    pub exclusive_time: u64,
+}
+
+/// Counter-to-ns mapping recorded by the tracer for ATF_CLOCK_COUNTER sessions
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq, Serialize, Deserialize)]
+pub struct ClockCalibration {
+    pub tick_base: u64,
+    pub ns_base: u64,
+    pub mult: u64,
+    pub shift: u32,
+    #[serde(default)]
+    pub ticks_per_sec: u64,
+}
+
+impl ClockCalibration {
+    /// ns = ns_base + (((ticks - tick_base) * mult) >> shift)
+    pub fn to_ns(&self, ticks: u64) -> u64 {
+        if ticks >= self.tick_base {
+            let delta = ((ticks - self.tick_base) as u128 * self.mult as u128) >> self.shift;
+            self.ns_base.wrapping_add(delta as u64)
+        } else {
+            let delta = ((self.tick_base - ticks) as u128 * self.mult as u128) >> self.shift;
+            self.ns_base.wrapping_sub(delta as u64)
+        }
+    }
 }
 
 #[derive(Debug, Serialize, Deserialize)]
@@ -64,7 +112,15 @@ impl SessionReader {
         &self.manifest
     }
 
-    /// Time range across all threads
+    /// Convert a raw event timestamp to ns (identity unless timestamps are counter ticks)
+    pub fn timestamp_ns(&self, timestamp: u64) -> u64 {
+        match self.manifest.clock_calibration {
+            Some(cal) if self.manifest.clock_type == ATF_CLOCK_COUNTER => cal.to_ns(timestamp),
+            _ => timestamp,
+        }
+    }
+
+    /// Time range across all threads, in ns
     pub fn time_range(&self) -> (u64, u64) {
         if self.threads.is_empty() {
             return (0, 0);
@@ -79,7 +135,7 @@ impl SessionReader {
             max_time = max_time.max(end);
         }
 
-        (min_time, max_time)
+        (self.timestamp_ns(min_time), self.timestamp_ns(max_time))
     }
 
     /// Total event count across all threads
@@ -156,6 +212,9 @@ mod tests {
             threads: thread_infos,
             time_start_ns: 1000,
             time_end_ns: 1000 + events_per_thread as u64 * 100 * thread_count as u64,
+            clock_type: 1,
+            clock_calibration: None,
+            aggregates: None,
         };
 
         let manifest_str = serde_json::to_string_pretty(&manifest).unwrap();
@@ -306,6 +365,9 @@ mod tests {
             threads: vec![],
             time_start_ns: 0,
             time_end_ns: 0,
+            clock_type: 1,
+            clock_calibration: None,
+            aggregates: None,
         };
 
         let manifest_str = serde_json::to_string_pretty(&manifest).unwrap();
@@ -329,6 +391,9 @@ mod tests {
             threads: vec![],
             time_start_ns: 0,
             time_end_ns: 0,
+            clock_type: 1,
+            clock_calibration: None,
+            aggregates: None,
         };
 
         let manifest_str = serde_json::to_string_pretty(&manifest).unwrap();
@@ -353,6 +418,35 @@ mod tests {
         assert_eq!(manifest.threads[1].id, 1);
     }
 
+    #[test]
+    fn test_session_reader__counter_clock__then_time_range_in_ns() {
+        // Counter sessions record raw ticks; the manifest calibration maps them to ns
+        let dir = create_test_session(2, 10);
+        let plain = SessionReader::open(dir.path()).unwrap();
+        let (raw_start, raw_end) = plain.time_range();
+
+        let mut manifest = plain.manifest;
+        manifest.clock_type = ATF_CLOCK_COUNTER;
+        manifest.clock_calibration = Some(ClockCalibration {
+            tick_base: 1000,
+            ns_base: 5_000_000,
+            mult: 2 << 32, // 2 ns per tick
+            shift: 32,
+            ticks_per_sec: 500_000_000,
+        });
+        fs::write(
+            dir.path().join("manifest.json"),
+            serde_json::to_string_pretty(&manifest).unwrap(),
+        )
+        .unwrap();
+
+        let session = SessionReader::open(dir.path()).unwrap();
+        let (start, end) = session.time_range();
+        assert_eq!(start, 5_000_000 + (raw_start - 1000) * 2);
+        assert_eq!(end, 5_000_000 + (raw_end - 1000) * 2);
+        assert_eq!(session.timestamp_ns(900), 5_000_000 - 200);
+    }
+
     #[test]
     fn test_session_reader__thread_dir_missing__then_skips_thread() {
         // User Story: M1_E5_I2 - Handle missing thread directories
@@ -368,6 +462,9 @@ mod tests {
             ],
             time_start_ns: 1000,
             time_end_ns: 2000,
+            clock_type: 1,
+            clock_calibration: None,
+            aggregates: None,
         };
 
         let manifest_str = serde_json::to_string_pretty(&manifest).unwrap();
@@ -31,7 +31,8 @@ class ThreadReader:
 
     def get_detail_for(self, index_event: IndexEvent) -> Optional[DetailEvent]:
         """Forward lookup: index event → paired detail event (O(1))"""
-        if index_event.detail_seq == ATF_NO_DETAIL_SEQ:
+        # Span records reuse detail_seq for their duration
+        if index_event.detail_seq == ATF_NO_DETAIL_SEQ or index_event.is_span:
             return None
 
         if not self.detail:
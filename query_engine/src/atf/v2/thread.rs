@@ -32,7 +32,8 @@ impl ThreadReader {
 
     /// Forward lookup: index event → paired detail event (O(1))
     pub fn get_detail_for(&self, index_event: &IndexEvent) -> Option<DetailEvent> {
-        if index_event.detail_seq == ATF_NO_DETAIL_SEQ {
+        // Span records reuse detail_seq for their duration
+        if index_event.detail_seq == ATF_NO_DETAIL_SEQ || index_event.is_span() {
             return None;
         }
 
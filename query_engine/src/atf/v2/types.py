@@ -10,11 +10,14 @@ from typing import NamedTuple
 # Constants
 ATF_NO_DETAIL_SEQ = 0xFFFFFFFF
 ATF_INDEX_FLAG_HAS_DETAIL_FILE = 1 << 0
+ATF_INDEX_FLAG_LIVE_EVENT_COUNT = 1 << 1  # Header count kept current while writing
 
 # Event kinds
 ATF_EVENT_KIND_CALL = 1
 ATF_EVENT_KIND_RETURN = 2
 ATF_EVENT_KIND_EXCEPTION = 3
+ATF_EVENT_KIND_SAMPLED = 4
+ATF_EVENT_KIND_SPAN = 5
 
 # Detail event types
 ATF_DETAIL_EVENT_FUNCTION_CALL = 3
@@ -96,6 +99,19 @@ class IndexEvent(NamedTuple):
             detail_seq=values[5],
         )
 
+    @property
+    def is_span(self) -> bool:
+        return self.event_kind == ATF_EVENT_KIND_SPAN
+
+    @property
+    def span_duration(self) -> int:
+        """Span duration: detail_seq holds bits 0..31, call_depth's top 16 bits hold 32..47"""
+        return ((self.call_depth >> 16) << 32) | self.detail_seq
+
+    @property
+    def span_depth(self) -> int:
+        return self.call_depth & 0xFFFF
+
 
 class IndexFooter(NamedTuple):
     """ATF V2 Index File Footer - 64 bytes"""
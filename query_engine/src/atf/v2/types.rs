@@ -19,7 +19,7 @@ pub struct AtfIndexHeader {
     pub thread_id: u32,            // Thread ID for this file
 
     // Timing metadata (8 bytes)
-    pub clock_type: u8,            // 1=mach_continuous, 2=qpc, 3=boottime
+    pub clock_type: u8,            // 1=mach_continuous, 2=qpc, 3=boottime, 4=counter
     pub _reserved1: [u8; 3],
     pub _reserved2: u32,
 
@@ -46,7 +46,7 @@ pub struct IndexEvent {
     pub timestamp_ns: u64,         // Platform continuous clock
     pub function_id: u64,          // (moduleId << 32) | symbolIndex
     pub thread_id: u32,            // OS thread identifier
-    pub event_kind: u32,           // CALL=1, RETURN=2, EXCEPTION=3
+    pub event_kind: u32,           // CALL=1, RETURN=2, EXCEPTION=3, SAMPLED=4, SPAN=5
     pub call_depth: u32,           // Call stack depth
     pub detail_seq: u32,           // Forward link to detail event (u32::MAX = none)
 }
@@ -54,6 +54,28 @@ pub struct IndexEvent {
 // Compile-time size check
 const _: () = assert!(std::mem::size_of::<IndexEvent>() == 32);
 
+impl IndexEvent {
+    pub fn is_span(&self) -> bool {
+        self.event_kind == ATF_EVENT_KIND_SPAN
+    }
+
+    /// Span duration in clock units: detail_seq holds bits 0..31, the top
+    /// 16 bits of call_depth hold bits 32..47
+    pub fn span_duration(&self) -> u64 {
+        (((self.call_depth >> 16) as u64) << 32) | self.detail_seq as u64
+    }
+
+    /// Call depth of a span record (16 bits)
+    pub fn span_depth(&self) -> u32 {
+        self.call_depth & 0xFFFF
+    }
+
+    /// Entry time of a span record
+    pub fn span_start(&self) -> u64 {
+        self.timestamp_ns.saturating_sub(self.span_duration())
+    }
+}
+
 /// ATF V2 Index File Footer - 64 bytes
 #[repr(C, packed)]
 #[derive(Debug, Copy, Clone)]
@@ -172,11 +194,21 @@ impl<'a> fmt::Debug for DetailEvent<'a> {
 // Constants
 pub const ATF_NO_DETAIL_SEQ: u32 = u32::MAX;
 pub const ATF_INDEX_FLAG_HAS_DETAIL_FILE: u32 = 1 << 0;
+/// Header event_count/time range are kept current while the file is written
+pub const ATF_INDEX_FLAG_LIVE_EVENT_COUNT: u32 = 1 << 1;
+
+// Clock types
+/// Timestamps are raw CPU counter ticks; the manifest's clock_calibration maps them to ns
+pub const ATF_CLOCK_COUNTER: u8 = 4;
 
 // Event kinds
 pub const ATF_EVENT_KIND_CALL: u32 = 1;
 pub const ATF_EVENT_KIND_RETURN: u32 = 2;
 pub const ATF_EVENT_KIND_EXCEPTION: u32 = 3;
+/// Sampling summary; call_depth carries the number of calls suppressed since the last one
+pub const ATF_EVENT_KIND_SAMPLED: u32 = 4;
+/// Completed call; timestamp_ns is the return time, duration packed in call_depth/detail_seq
+pub const ATF_EVENT_KIND_SPAN: u32 = 5;
 
 // Detail event types
 pub const ATF_DETAIL_EVENT_FUNCTION_CALL: u16 = 3;
@@ -196,6 +228,23 @@ mod tests {
         assert_eq!(std::mem::size_of::<DetailEventHeader>(), 24);
     }
 
+    #[test]
+    fn test_index_event__span_record__then_duration_unpacked() {
+        let duration: u64 = (0x1234u64 << 32) | 0x89AB_CDEF;
+        let event = IndexEvent {
+            timestamp_ns: duration + 500,
+            function_id: 7,
+            thread_id: 1,
+            event_kind: ATF_EVENT_KIND_SPAN,
+            call_depth: (0x1234 << 16) | 3,
+            detail_seq: 0x89AB_CDEF,
+        };
+        assert!(event.is_span());
+        assert_eq!(event.span_duration(), duration);
+        assert_eq!(event.span_depth(), 3);
+        assert_eq!(event.span_start(), 500);
+    }
+
     #[test]
     fn test_detail_event__from_bytes__then_parsed() {
         // User Story: M1_E5_I2 - Parse detail event from binary data
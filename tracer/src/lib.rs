@@ -261,22 +261,33 @@ pub trait BackendFFI: Send + Sync {
 // Shared Memory Types (matching C++ layout)
 // ============================================================================
 
-/// Ring buffer header - must match C++ layout exactly
-#[repr(C)]
+/// Ring buffer header - must match C++ layout exactly (version 2, 256 bytes)
+///
+/// Producer and consumer positions sit on separate 64-byte cache lines, each
+/// next to that side's cached copy of the other side's position.
+#[repr(C, align(64))]
 #[derive(Debug, Clone, Copy)]
 pub struct RingBufferHeader {
     pub magic: u32,
     pub version: u32,
     pub capacity: u32,
+    pub _reserved0: u32,
+    pub _pad0: [u32; 12],
+    /// Producer cache line
     pub write_pos: u32,
+    pub cached_read_pos: u32,
+    pub _pad_producer: [u32; 14],
+    /// Consumer cache line
     pub read_pos: u32,
-    pub flags: u32,
-    pub _reserved: [u32; 10],
+    pub cached_write_pos: u32,
+    pub _pad_consumer: [u32; 14],
+    pub overflow_count: u64,
+    pub _reserved: [u32; 8],
 }
 
 impl RingBufferHeader {
     pub const MAGIC: u32 = 0xADA0;
-    pub const VERSION: u32 = 1;
+    pub const VERSION: u32 = 2;
 }
 
 // ============================================================================
@@ -326,4 +337,12 @@ mod interface_tests {
         let _ = create_drain_service;
         let _ = create_backend_ffi;
     }
+
+    /// Test that the ring buffer header mirrors the C++ version 2 layout
+    #[test]
+    fn test_ring_buffer_header_layout() {
+        assert_eq!(std::mem::size_of::<RingBufferHeader>(), 256);
+        assert_eq!(std::mem::align_of::<RingBufferHeader>(), 64);
+        assert_eq!(RingBufferHeader::VERSION, 2);
+    }
 }
@@ -16,8 +16,12 @@ extern "C" {
 #include <tracer_backend/utils/thread_registry.h>
 #include <tracer_backend/backpressure/backpressure.h>
 
+// Upper bound on index events staged per thread before a bulk publish
+#define ADA_TLS_STAGE_CAPACITY 32
+
 // Forward declaration for RingPool (actual type is AdaRingPool in ring_pool.h)
 struct AdaRingPool;
+struct AggregateTable;
 
 // Thread-local storage for fast path access
 typedef struct ada_tls_state {
@@ -28,13 +32,15 @@ typedef struct ada_tls_state {
     uint64_t thread_id;             // Platform thread ID
 
     _Atomic(bool) registered;       // Registration complete flag
-    uint8_t slot_id;                // Optional slot id (0 if unknown)
-    uint8_t _pad1[6];               // Padding
+    uint8_t _pad0;                  // Padding
+    uint16_t slot_id;               // Registry slot
+    uint32_t stream_id;             // ATF thread id for per-thread lanes (thread_lanes_get_stream_id)
     uint64_t registration_time;     // Timestamp of registration
 
     // Ring pools for automatic swap on overflow
     struct AdaRingPool* index_pool; // Ring pool for index lane (NULL if not using pools)
     struct AdaRingPool* detail_pool;// Ring pool for detail lane (NULL if not using pools)
+    struct AggregateTable* aggregates; // Aggregation lane of this slot (NULL if none)
 
     // Statistics
     uint64_t event_count;           // Events emitted by this thread (best-effort)
@@ -42,6 +48,12 @@ typedef struct ada_tls_state {
     uint64_t overflow_count;        // Ring buffer overflows
     uint64_t _pad2;                 // Padding / reserved
     ada_backpressure_state_t backpressure[2]; // [0]=index, [1]=detail
+    LaneView lane_views[2];         // Materialized lanes of this thread: [0]=index, [1]=detail
+
+    // Index events waiting for one bulk publish to the active index ring
+    uint32_t stage_count;           // Events in stage[]
+    uint32_t stage_flight_state;    // Flight recorder state when the batch began
+    IndexEvent stage[ADA_TLS_STAGE_CAPACITY];
 } ada_tls_state_t;
 
 // Reentrancy guard for nested calls
@@ -66,10 +78,40 @@ ThreadLaneSet* ada_get_thread_lane(void);
 // Slow path: register current thread (uses global registry)
 ThreadLaneSet* ada_register_current_thread(void);
 
+// Current thread's aggregation lane, registering and allocating it on first use
+struct AggregateTable* ada_get_thread_aggregates(void);
+
 // Reentrancy guard API
 ada_reentrancy_guard_t ada_enter_trace(void);
 void ada_exit_trace(ada_reentrancy_guard_t guard);
 
+// Producer-side index batching (process-wide). batch <= 1 disables staging;
+// larger values are clamped to ADA_TLS_STAGE_CAPACITY. max_age_ns bounds how
+// long the oldest staged event waits (checked when the next event arrives and
+// by ada_tls_sweep_staged_events).
+void ada_tls_set_index_batching(uint32_t batch, uint64_t max_age_ns);
+uint32_t ada_tls_get_index_batch(void);
+
+// Stage an index event for the current thread's index pool. The batch is
+// published when full, when it has aged past max_age_ns, or when
+// flight_state differs from the state the batch began in (trigger fired).
+// Returns false when staging is disabled or the thread has no index pool;
+// the caller then writes the event directly.
+bool ada_tls_stage_index_event(const IndexEvent* event, uint32_t flight_state);
+
+// Publish the current thread's staged index events. Also runs on ring swap
+// and thread cleanup. Returns the number of events dropped (pool exhausted).
+uint32_t ada_tls_flush_index_events(void);
+
+// Publish other threads' staged batches whose oldest event is older than
+// max_age_ns at now (the event timestamp clock), or every batch when force
+// is set. A thread that goes quiet never reaches its own age check, so the
+// agent runs this on a periodic tick and with force at session stop. A
+// thread caught mid-stage is left alone; under force it is asked to publish
+// before its call returns. Threads must run ada_tls_thread_cleanup before
+// exit. Returns the number of batches published.
+uint32_t ada_tls_sweep_staged_events(uint64_t now, bool force);
+
 // Cleanup at thread exit (optional, safe to call multiple times)
 void ada_tls_thread_cleanup(void);
 
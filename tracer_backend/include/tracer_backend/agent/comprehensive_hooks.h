@@ -5,7 +5,9 @@
 #ifndef ADA_COMPREHENSIVE_HOOKS_H
 #define ADA_COMPREHENSIVE_HOOKS_H
 
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <string>
 #include <vector>
 #include <utility>
@@ -49,6 +51,64 @@ std::vector<HookPlanEntry> plan_comprehensive_hooks(
     AdaExcludeList* excludes,
     HookRegistry& registry);
 
+// ---------------------------------------------------------------------------
+// Staged planning for hook installation. The agent enumerates modules and
+// resolves addresses on a worker pool, plans ids per module, and attaches the
+// results serially inside one interceptor transaction.
+// ---------------------------------------------------------------------------
+
+// Address range [start, end) of a stub section; hooks there are skipped.
+struct HookAddressRange {
+    uint64_t start;
+    uint64_t end;
+};
+
+// One module's enumerated symbols. addresses is parallel to names; 0 means
+// the address was not known at enumeration and must be resolved.
+struct ModuleSymbols {
+    std::string path;
+    std::vector<std::string> names;
+    std::vector<uint64_t> addresses;
+    std::vector<HookAddressRange> stub_ranges;
+};
+
+// Planned hook with its target address (0 = unresolved)
+struct ResolvedHookEntry {
+    std::string symbol;
+    uint64_t function_id;
+    uint64_t address;
+    bool stub;  // Address lies in a stub section; do not attach
+};
+
+bool is_address_in_ranges(uint64_t address, const std::vector<HookAddressRange>& ranges);
+
+// Plan one module: drop duplicate names (first occurrence wins), keep at most
+// symbol_limit names (0 = unlimited), filter excludes and assign ids through
+// plan_module_hooks(). Entries keep their enumeration address.
+std::vector<ResolvedHookEntry> plan_module_symbols(
+    const ModuleSymbols& module,
+    size_t symbol_limit,
+    AdaExcludeList* excludes,
+    HookRegistry& registry);
+
+// Fill in missing addresses with resolve(symbol) and flag stub addresses.
+// Work is split into chunks across `workers` threads; resolve must be
+// safe to call concurrently.
+void resolve_hook_addresses(
+    std::vector<ResolvedHookEntry>& hooks,
+    const std::vector<HookAddressRange>& stub_ranges,
+    const std::function<uint64_t(const std::string&)>& resolve,
+    size_t workers);
+
+// Worker threads for planning: ADA_HOOK_PLAN_WORKERS if set, otherwise the
+// hardware concurrency (at most 8), never more than `tasks` and at least 1.
+size_t hook_plan_worker_count(size_t tasks);
+
+// Run task(0..count-1) on `workers` threads, the caller being one of them.
+// Tasks are claimed dynamically so uneven modules balance out.
+void run_hook_plan_tasks(size_t count, size_t workers,
+                         const std::function<void(size_t)>& task);
+
 } // namespace agent
 } // namespace ada
 
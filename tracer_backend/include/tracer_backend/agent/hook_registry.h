@@ -3,15 +3,25 @@
 //
 // Extended with module metadata (base_address, size, UUID) for symbol
 // resolution at query time. See BH-011 Symbol Resolution spec.
+//
+// Each module interns its symbol names into an append-only string arena, in
+// symbol-index order, and indexes them with a flat open-addressing table.
+// Registration is serialized by a writer mutex; lookups never take it. Slots
+// and modules are published with release stores, and tables replaced by a
+// resize (or dropped by clear()) stay allocated until destruction, so a reader
+// holding an old table stays safe (it may miss symbols registered during the
+// lookup).
 
 #ifndef ADA_HOOK_REGISTRY_H
 #define ADA_HOOK_REGISTRY_H
 
+#include <atomic>
 #include <cstdint>
+#include <cstdio>
 #include <cstring>
-#include <string>
-#include <unordered_map>
+#include <memory>
 #include <mutex>
+#include <string>
 #include <vector>
 
 namespace ada {
@@ -28,6 +38,9 @@ uint32_t fnv1a32_ci(const std::string& s);
 class HookRegistry {
 public:
     HookRegistry();
+    ~HookRegistry();
+    HookRegistry(const HookRegistry&) = delete;
+    HookRegistry& operator=(const HookRegistry&) = delete;
 
     // Register a symbol for a module path and return its 64-bit function id.
     // The module id is derived from the path via fnv1a32_ci(). Each new
@@ -35,7 +48,15 @@ public:
     // at 1. Re-registering the same symbol returns the previous id.
     uint64_t register_symbol(const std::string& module_path, const std::string& symbol);
 
-    // Query helpers
+    // Bulk form of register_symbol() for a whole module: one lock acquisition,
+    // one table sizing and one arena allocation for the batch. out_ids
+    // (optional) receives one id per input name, in input order.
+    // Returns the number of symbols that were new.
+    size_t register_module_symbols(const std::string& module_path,
+                                   const std::vector<std::string>& symbols,
+                                   std::vector<uint64_t>* out_ids);
+
+    // Query helpers (lock-free)
     bool get_id(const std::string& module_path, const std::string& symbol, uint64_t* out_id) const;
     uint32_t get_module_id(const std::string& module_path) const;
     uint32_t get_symbol_count(const std::string& module_path) const;
@@ -51,35 +72,40 @@ public:
     // Returns JSON object with "modules" and "symbols" arrays.
     std::string export_to_json() const;
 
+    // Stream the export_to_json() text to a file; returns bytes written
+    size_t write_json(FILE* out) const;
+
     // Get module count (for testing/debugging)
     size_t module_count() const;
 
-    // Reset (tests only)
+    // Forget all modules. Concurrent lookups stay safe: they may still answer
+    // from the cleared contents, which are kept until destruction.
     void clear();
 
 private:
-    struct ModuleEntry {
-        uint32_t module_id;
-        uint32_t next_index;
-        std::unordered_map<std::string, uint32_t> name_to_index;
-
-        // Runtime metadata for symbol resolution (optional, set via set_module_metadata)
-        uint64_t base_address = 0;
-        uint64_t size = 0;
-        uint8_t uuid[16] = {0};
-        bool metadata_set = false;
-    };
-
-    uint64_t register_symbol_locked(ModuleEntry& me, const std::string& symbol);
-
-    uint32_t get_or_create_module_id_locked(const std::string& module_path);
-
-    mutable std::mutex mutex_;
-    std::unordered_map<std::string, ModuleEntry> modules_;
+    struct SymbolSlot;
+    struct SymbolTable;
+    struct NameChunk;
+    struct ModuleEntry;
+    struct ModuleIndex;
+
+    const ModuleEntry* find_module(const std::string& module_path) const;
+    ModuleEntry* get_or_create_module_locked(const std::string& module_path);
+    void reserve_symbols_locked(ModuleEntry& me, size_t additional, size_t name_bytes);
+    uint64_t register_symbol_locked(ModuleEntry& me, const char* symbol, size_t length);
+
+    template <typename Sink>
+    void write_json_to(Sink& sink) const;
+
+    mutable std::mutex mutex_;                                  // Writers and exports
+    std::vector<std::unique_ptr<ModuleEntry>> modules_;         // Registration order
+    std::vector<std::unique_ptr<ModuleEntry>> retired_modules_; // Dropped by clear()
+    std::atomic<ModuleIndex*> module_index_;                    // Path -> module, lock-free
+    std::vector<std::unique_ptr<ModuleIndex>> module_indexes_;  // Current + retired
+    std::atomic<size_t> module_count_;
 };
 
 } // namespace agent
 } // namespace ada
 
 #endif // ADA_HOOK_REGISTRY_H
-
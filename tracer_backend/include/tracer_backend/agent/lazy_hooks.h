@@ -0,0 +1,86 @@
+// Lazy hook installation: every planned symbol first gets a cheap enter-only
+// probe; the first hit queues the function, and a promoter swaps the probe for
+// the full enter/leave hook, up to a budget. Functions that never run keep
+// only their probe. Function ids come from the normal plan, so they match
+// eager mode. This utility is Frida-free; the agent owns the interceptor.
+
+#ifndef ADA_LAZY_HOOKS_H
+#define ADA_LAZY_HOOKS_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace ada {
+namespace agent {
+
+// Per-probe state
+enum LazyHookState : uint32_t {
+    LAZY_HOOK_COLD = 0,         // Probe attached, never hit
+    LAZY_HOOK_HIT = 1,          // First hit queued for the promoter
+    LAZY_HOOK_PROMOTED = 2,     // Full hook installed
+    LAZY_HOOK_OVER_BUDGET = 3,  // Hit after the budget ran out; probe removed
+};
+
+struct LazyHookConfig {
+    bool enabled;                  // ADA_HOOK_MODE=lazy
+    uint32_t budget;               // ADA_LAZY_HOOK_BUDGET: max promoted hooks
+    uint32_t promote_interval_ms;  // ADA_LAZY_PROMOTE_MS: promoter period
+};
+
+#define ADA_LAZY_HOOK_DEFAULT_BUDGET 5000u
+#define ADA_LAZY_PROMOTE_DEFAULT_MS 10u
+
+LazyHookConfig lazy_hook_config_from_env();
+
+struct LazyHookStats {
+    uint32_t probes;       // Probes registered
+    uint32_t hits;         // Distinct functions seen executing
+    uint32_t promoted;     // Selected for a full hook
+    uint32_t over_budget;  // Hit after the budget was exhausted
+};
+
+// First-hit tracker. record_hit() runs in probe callbacks on any thread;
+// take_hits() is called by the single promoter thread.
+class LazyHookTracker {
+public:
+    LazyHookTracker(size_t probes, uint32_t budget);
+
+    // Returns true for the call that claims the slot's first hit
+    bool record_hit(uint32_t slot) {
+        if (slot >= probes_) return false;
+        uint32_t expected = LAZY_HOOK_COLD;
+        if (!states_[slot].compare_exchange_strong(expected, LAZY_HOOK_HIT,
+                                                   std::memory_order_acq_rel)) {
+            return false;
+        }
+        // Each slot is queued at most once, so the queue never overflows
+        size_t pos = tail_.fetch_add(1, std::memory_order_relaxed);
+        queue_[pos].store(slot + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Move queued first hits, in hit order, into `promote` (within budget)
+    // or `drop` (over budget). Returns the number taken.
+    size_t take_hits(std::vector<uint32_t>* promote, std::vector<uint32_t>* drop);
+
+    uint32_t state(uint32_t slot) const;
+    LazyHookStats stats() const;
+
+private:
+    size_t probes_;
+    uint32_t budget_;
+    std::unique_ptr<std::atomic<uint32_t>[]> states_;
+    std::unique_ptr<std::atomic<uint32_t>[]> queue_;  // slot + 1; 0 = not yet published
+    std::atomic<size_t> tail_;
+    size_t head_;                                      // Promoter only
+    std::atomic<uint32_t> promoted_;
+    std::atomic<uint32_t> over_budget_;
+};
+
+} // namespace agent
+} // namespace ada
+
+#endif // ADA_LAZY_HOOKS_H
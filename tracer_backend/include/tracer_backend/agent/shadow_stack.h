@@ -0,0 +1,76 @@
+// Per-thread shadow call stack for span pairing and aggregation. on_enter
+// pushes the function id and entry timestamp; on_leave pops the matching
+// frame, and the agent writes one span record with the inline duration
+// instead of a CALL/RETURN pair and/or adds the call to the aggregation lane.
+// Each pop charges the call's inclusive time to its parent frame, so the
+// parent's exclusive time is its own inclusive time minus child_time. Frames
+// whose leave never ran (unwound by an exception or longjmp) are dropped when
+// an outer frame is popped. Owned by one thread; Frida-free.
+
+#ifndef ADA_SHADOW_STACK_H
+#define ADA_SHADOW_STACK_H
+
+#include <cstdint>
+
+namespace ada {
+namespace agent {
+
+struct ShadowFrame {
+    uint64_t function_id;
+    uint64_t entry_timestamp;
+    uint64_t child_time;       // Inclusive time of hooked callees
+
+    uint64_t inclusive(uint64_t now) const {
+        return now > entry_timestamp ? now - entry_timestamp : 0;
+    }
+    uint64_t exclusive(uint64_t now) const {
+        uint64_t total = inclusive(now);
+        return total > child_time ? total - child_time : 0;
+    }
+};
+
+class ShadowStack {
+public:
+    // Deeper calls fall back to CALL/RETURN events
+    static constexpr uint32_t kCapacity = 256;
+
+    // False when full; the caller records the call unpaired
+    bool push(uint64_t function_id, uint64_t entry_timestamp) {
+        if (size_ >= kCapacity) {
+            overflows_++;
+            return false;
+        }
+        frames_[size_++] = ShadowFrame{function_id, entry_timestamp, 0};
+        return true;
+    }
+
+    // Pop the innermost frame for function_id at time now, discarding frames
+    // above it. False when no frame matches (already discarded).
+    bool pop(uint64_t function_id, uint64_t now, ShadowFrame* out) {
+        for (uint32_t i = size_; i > 0; --i) {
+            if (frames_[i - 1].function_id == function_id) {
+                discarded_ += size_ - i;
+                *out = frames_[i - 1];
+                size_ = i - 1;
+                if (size_ > 0) frames_[size_ - 1].child_time += out->inclusive(now);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    uint32_t size() const { return size_; }
+    uint64_t overflows() const { return overflows_; }
+    uint64_t discarded() const { return discarded_; }
+
+private:
+    ShadowFrame frames_[kCapacity];
+    uint32_t size_ = 0;
+    uint64_t overflows_ = 0;
+    uint64_t discarded_ = 0;
+};
+
+} // namespace agent
+} // namespace ada
+
+#endif // ADA_SHADOW_STACK_H
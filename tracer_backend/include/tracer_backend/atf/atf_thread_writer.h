@@ -19,6 +19,24 @@ extern "C" {
 /* Opaque thread writer handle */
 typedef struct AtfThreadWriter AtfThreadWriter;
 
+/**
+ * File I/O backend used for index and detail files
+ *
+ * STDIO is the portable buffered FILE* path. IO_URING batches large writes
+ * and keeps several of them in flight per file (Linux only). MMAP grows the
+ * file in preallocated extents and appends by memcpy into a shared mapping;
+ * index files written this way keep their header event count current, so a
+ * reader can tail a live session. AUTO picks the fastest streaming backend
+ * the host supports. Any backend that cannot be initialized at runtime falls
+ * back to STDIO, so every value is safe on every platform.
+ */
+typedef enum {
+    ATF_WRITER_BACKEND_STDIO    = 0,
+    ATF_WRITER_BACKEND_IO_URING = 1,
+    ATF_WRITER_BACKEND_AUTO     = 2,
+    ATF_WRITER_BACKEND_MMAP     = 3
+} AtfWriterBackend;
+
 /**
  * Create a thread writer
  *
@@ -33,6 +51,34 @@ AtfThreadWriter* atf_thread_writer_create(const char* session_dir,
                                           uint32_t thread_id,
                                           uint8_t clock_type);
 
+/**
+ * Create a thread writer using a specific file I/O backend
+ *
+ * Same as atf_thread_writer_create() (which uses ATF_WRITER_BACKEND_STDIO),
+ * but both the index file and the lazily created detail file are written
+ * through the requested backend.
+ *
+ * @param session_dir Base session directory
+ * @param thread_id Thread ID
+ * @param clock_type Clock type (1=mach_continuous, 2=qpc, 3=boottime)
+ * @param backend Requested file I/O backend
+ * @return Pointer to writer, or NULL on error
+ */
+AtfThreadWriter* atf_thread_writer_create_with_backend(const char* session_dir,
+                                                       uint32_t thread_id,
+                                                       uint8_t clock_type,
+                                                       AtfWriterBackend backend);
+
+/**
+ * Get the file I/O backend actually used for the index file
+ *
+ * May differ from the requested backend when it was unavailable at runtime.
+ *
+ * @param writer Pointer to writer
+ * @return Backend in use (ATF_WRITER_BACKEND_STDIO for NULL)
+ */
+AtfWriterBackend atf_thread_writer_get_backend(const AtfThreadWriter* writer);
+
 /**
  * Write an index event with optional detail
  *
@@ -53,6 +99,23 @@ uint32_t atf_thread_writer_write_event(AtfThreadWriter* writer,
                                        const void* detail_payload,
                                        size_t detail_payload_size);
 
+/**
+ * Write a contiguous span of index events straight from ring memory
+ *
+ * Ring index records share the ATF v2 IndexEvent layout and are produced as
+ * final on-disk records (thread_id and detail_seq already filled in), so the
+ * span is written verbatim in a single call with no per-event transformation.
+ * Index sequence numbers are reserved for the whole span.
+ *
+ * @param writer Pointer to writer
+ * @param events Pointer to the first ring record of the span
+ * @param count Number of records in the span (0 is a no-op)
+ * @return 0 on success, negative errno on error
+ */
+int atf_thread_writer_write_index_span(AtfThreadWriter* writer,
+                                       const void* events,
+                                       size_t count);
+
 /**
  * Finalize both index and detail files
  *
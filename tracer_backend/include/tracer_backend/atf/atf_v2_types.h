@@ -9,6 +9,7 @@
 #ifndef TRACER_BACKEND_ATF_V2_TYPES_H
 #define TRACER_BACKEND_ATF_V2_TYPES_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -32,11 +33,14 @@ extern "C" {
 #define ATF_CLOCK_MACH_CONTINUOUS  1
 #define ATF_CLOCK_QPC              2
 #define ATF_CLOCK_BOOTTIME         3
+#define ATF_CLOCK_COUNTER          4  /* Raw CPU counter ticks; manifest clock_calibration converts to ns */
 
 /* Event kind values */
 #define ATF_EVENT_KIND_CALL      1
 #define ATF_EVENT_KIND_RETURN    2
 #define ATF_EVENT_KIND_EXCEPTION 3
+#define ATF_EVENT_KIND_SAMPLED   4  /* call_depth = calls suppressed by sampling */
+#define ATF_EVENT_KIND_SPAN      5  /* Completed call; packing in tracer_types.h */
 
 /* Detail event types */
 #define ATF_DETAIL_EVENT_FUNCTION_CALL   3
@@ -46,7 +50,10 @@ extern "C" {
 #define ATF_NO_DETAIL_SEQ UINT32_MAX
 
 /* Index header flags */
-#define ATF_INDEX_FLAG_HAS_DETAIL_FILE (1U << 0)
+#define ATF_INDEX_FLAG_HAS_DETAIL_FILE   (1U << 0)
+/* Header event_count/time range are kept current while the file is written
+ * (mmap backend); readers may trust them when the footer is not there yet. */
+#define ATF_INDEX_FLAG_LIVE_EVENT_COUNT  (1U << 1)
 
 /* ===== Index File Structures ===== */
 
@@ -61,11 +68,11 @@ typedef struct __attribute__((packed)) {
     uint8_t  version;            /* 1 */
     uint8_t  arch;               /* 1=x86_64, 2=arm64 */
     uint8_t  os;                 /* 1=iOS, 2=Android, 3=macOS, 4=Linux, 5=Windows */
-    uint32_t flags;              /* Bit 0: has_detail_file */
+    uint32_t flags;              /* Bit 0: has_detail_file, bit 1: live_event_count */
     uint32_t thread_id;          /* Thread ID for this file */
 
     /* Timing metadata (8 bytes) */
-    uint8_t  clock_type;         /* 1=mach_continuous, 2=qpc, 3=boottime */
+    uint8_t  clock_type;         /* 1=mach_continuous, 2=qpc, 3=boottime, 4=counter */
     uint8_t  _reserved1[3];
     uint32_t _reserved2;
 
@@ -88,18 +95,23 @@ _Static_assert(sizeof(AtfIndexHeader) == 64, "AtfIndexHeader must be 64 bytes");
 /**
  * Index Event - 32 bytes (fixed size)
  * Captures ALL function call/return events
+ *
+ * Identical to the in-memory ring record (tracer_types.h), so index rings are
+ * written to disk without per-event transformation.
  */
 typedef struct __attribute__((packed)) {
     uint64_t timestamp_ns;       /* Platform continuous clock (genlock) */
     uint64_t function_id;        /* (moduleId << 32) | symbolIndex */
     uint32_t thread_id;          /* OS thread identifier */
-    uint32_t event_kind;         /* CALL=1, RETURN=2, EXCEPTION=3 */
+    uint32_t event_kind;         /* CALL=1, RETURN=2, EXCEPTION=3, SAMPLED=4, SPAN=5 */
     uint32_t call_depth;         /* Call stack depth */
     uint32_t detail_seq;         /* Forward link to detail event (UINT32_MAX = none) */
 } IndexEvent;
 
 /* Compile-time assertion for event size */
 _Static_assert(sizeof(IndexEvent) == 32, "IndexEvent must be 32 bytes");
+_Static_assert(offsetof(IndexEvent, thread_id) == 16, "IndexEvent layout must match ring record");
+_Static_assert(offsetof(IndexEvent, detail_seq) == 28, "IndexEvent layout must match ring record");
 
 /**
  * Index File Footer - 64 bytes
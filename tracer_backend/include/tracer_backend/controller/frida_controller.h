@@ -56,6 +56,14 @@ int frida_controller_arm_trigger(FridaController* controller,
 int frida_controller_fire_trigger(FridaController* controller);
 int frida_controller_disarm_trigger(FridaController* controller);
 int frida_controller_set_detail_enabled(FridaController* controller, uint32_t enabled);
+// Per-function sampling thresholds (see hook_sampler.h); applied by hooks
+// within their next mode check
+int frida_controller_set_sampling(FridaController* controller, uint32_t enabled,
+                                  uint32_t max_calls_per_sec, uint32_t max_sample_shift,
+                                  uint32_t window_ms);
+// Aggregation lane mode (AggregationMode); per-function totals are written to
+// the session manifest at stop
+int frida_controller_set_aggregation(FridaController* controller, uint32_t mode);
 int frida_controller_start_session(FridaController* controller);
 int frida_controller_stop_session(FridaController* controller);
 
@@ -38,7 +38,7 @@ typedef struct ShutdownThreadState {
 } ShutdownThreadState;
 
 typedef struct ShutdownState {
-    ShutdownThreadState threads[MAX_THREADS];
+    ShutdownThreadState threads[THREAD_REGISTRY_MAX_CAPACITY]; // First `capacity` entries in use
     _Atomic(uint32_t) capacity;
     _Atomic(uint32_t) active_threads;
     _Atomic(uint32_t) threads_stopped;
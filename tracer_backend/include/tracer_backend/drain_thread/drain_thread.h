@@ -21,6 +21,12 @@ typedef enum {
     DRAIN_STATE_STOPPED       = 4
 } DrainState;
 
+// Upper bound on drain workers; worker_count values above it are clamped
+#define DRAIN_MAX_WORKERS 16
+
+// worker_count value requesting one drain worker per online CPU
+#define DRAIN_WORKERS_PER_CORE UINT32_MAX
+
 // Configuration knobs for the drain thread behaviour
 typedef struct {
     uint32_t poll_interval_us;   // sleep duration when idle (0 = busy loop)
@@ -33,8 +39,42 @@ typedef struct {
     uint32_t max_events_per_thread;    // Max events per thread per iteration (0 = unlimited)
     uint32_t iteration_interval_ms;    // Time between iterations in milliseconds
     bool     enable_fair_scheduling;   // Enable fair thread selection algorithm
+
+    // Per-thread ATF file output
+    AtfWriterBackend writer_backend;   // File I/O backend for index/detail files
+
+    // Sharded drain: registry slots are split across this many workers
+    // (0 or 1 = single worker, DRAIN_WORKERS_PER_CORE = one per online CPU).
+    // Ignored when per-thread drain iteration is enabled.
+    uint32_t worker_count;
+    // Let idle workers steal slots with submitted rings from busy workers
+    // (only meaningful with more than one worker)
+    bool     enable_work_stealing;
+    // Park idle workers on the control block's wake word until the agent
+    // submits into an empty queue, instead of yielding or sleeping
+    // poll_interval_us. Requires drain_thread_set_control_block(); workers
+    // still wake every heartbeat tick to keep the heartbeat fresh.
+    bool     wake_on_submit;
+
+    // Re-merge every slot's aggregation table into <session>/aggregates.json
+    // this often while a session is active, so totals are readable before
+    // the session ends (0 = merge only at session stop)
+    uint32_t aggregate_interval_ms;
 } DrainConfig;
 
+// Per-worker slice of the drain metrics
+typedef struct {
+    uint64_t cycles_total;       // poll cycles executed by this worker
+    uint64_t cycles_idle;        // cycles with no work in this worker's shard
+    uint64_t rings_total;        // rings consumed from this worker's shard
+    uint64_t events_drained;     // events written by this worker
+    uint64_t bytes_drained;      // bytes written by this worker
+    uint64_t rebalances;         // shard recomputations after registry changes
+    uint64_t steals;             // slots drained on behalf of other workers
+    uint32_t slots_owned;        // registry slots currently held
+    uint32_t slots_queued;       // slots waiting in this worker's deque
+} DrainWorkerMetrics;
+
 // Snapshot of drain metrics - populated via drain_thread_get_metrics
 typedef struct {
     uint64_t cycles_total;       // total poll cycles executed
@@ -47,7 +87,7 @@ typedef struct {
     uint64_t yields;             // number of yields performed when idle
     uint64_t final_drains;       // number of final drain passes during shutdown
     uint64_t total_sleep_us;     // accumulated sleep duration in microseconds
-    uint64_t rings_per_thread[MAX_THREADS][2]; // per-thread lanes [thread][0=index,1=detail]
+    uint64_t rings_per_thread[MAX_THREADS][2]; // slots 0..MAX_THREADS-1 [thread][0=index,1=detail]
 
     // Per-thread drain iteration metrics
     uint64_t total_iterations;     // Total drain iterations completed
@@ -62,6 +102,27 @@ typedef struct {
     uint64_t events_per_second;    // Current events per second throughput
     uint64_t bytes_per_second;     // Current bytes per second throughput
     uint32_t cpu_usage_percent;    // CPU usage percentage (0-100)
+
+    // Event-driven wakeup (wake_on_submit)
+    uint64_t wake_parks;           // times a worker parked on the wake word
+    uint64_t wake_signals;         // parks ended by an agent submit rather than a timeout
+    uint64_t idle_wait_ns;         // time spent parked, i.e. idle time spent off-CPU
+    uint64_t wake_latency_avg_ns;  // mean signal-to-drained latency after a wakeup
+    uint64_t wake_latency_max_ns;  // worst signal-to-drained latency after a wakeup
+
+    // Slot reclamation for exited threads (registry counters)
+    uint64_t slots_reclaimed;      // retired slots emptied and recycled
+    uint64_t slots_reused;         // registrations that took a recycled slot
+    uint64_t rings_grown;          // overflow rings lanes grew into under pressure
+    uint64_t ring_growth_denied;   // growth refused (lane at limit, overflow spent)
+
+    // ATF output failures
+    uint64_t write_errors;         // failed span/record writes to ATF files
+    uint64_t events_lost;          // events consumed from rings but not written
+
+    // Sharded drain workers (aggregate fields above include all workers)
+    uint32_t worker_count;                       // Workers configured for this drain
+    DrainWorkerMetrics workers[DRAIN_MAX_WORKERS]; // Valid for [0, worker_count)
 } DrainMetrics;
 
 // Opaque drain thread handle
@@ -91,6 +152,10 @@ DrainState drain_thread_get_state(const DrainThread* drain);
 // Snapshot metrics into caller-provided structure
 void drain_thread_get_metrics(const DrainThread* drain, DrainMetrics* out_metrics);
 
+// Rings drained for any registry slot ([0]=index, [1]=detail), including slots
+// beyond the MAX_THREADS entries of DrainMetrics.rings_per_thread
+bool drain_thread_get_slot_rings(const DrainThread* drain, uint32_t slot, uint64_t out_rings[2]);
+
 // Update configuration (only allowed while not running)
 int drain_thread_update_config(DrainThread* drain, const DrainConfig* config);
 
@@ -31,7 +31,7 @@ extern "C" {
 // Performance Contracts (enforced by benchmarks)
 // ============================================================================
 
-#define THREAD_REGISTRY_MAX_THREADS 64
+#define THREAD_REGISTRY_MAX_THREADS 4096  // THREAD_REGISTRY_MAX_CAPACITY
 #define THREAD_REGISTRATION_MAX_NS 1000  // <1μs requirement
 #define LANE_ACCESS_MAX_NS 10            // <10ns fast path
 
@@ -65,21 +65,34 @@ typedef struct {
 } SPSCQueueHeader;
 
 /**
- * Ring Buffer Header - Shared memory layout
+ * Ring Buffer Header - Shared memory layout (version 2, 256 bytes)
  * Accessed atomically from both C++ writers and Rust readers
+ *
+ * Producer and consumer positions sit on separate 64-byte cache lines, each
+ * next to that side's cached copy of the other side's position.
  */
 typedef struct {
-    uint32_t magic;         // 0xADA0 for validation
-    uint32_t version;       // Format version (1)
-    uint32_t capacity;      // Number of events
-    uint32_t write_pos;     // Atomic: next write position
-    uint32_t read_pos;      // Atomic: next read position
-    uint32_t flags;         // Status flags
-    uint32_t _reserved[10]; // Future expansion
+    uint32_t magic;             // 0xADA0 for validation
+    uint32_t version;           // Format version (2)
+    uint32_t capacity;          // Number of events (power of two)
+    uint32_t _reserved0;
+    uint32_t _pad0[12];         // Padding to 64 bytes
+
+    uint32_t write_pos;         // Atomic: next write position
+    uint32_t cached_read_pos;   // Producer's last seen read_pos (producer only)
+    uint32_t _pad_producer[14]; // Padding to 128 bytes
+
+    uint32_t read_pos;          // Atomic: next read position
+    uint32_t cached_write_pos;  // Consumer's last seen write_pos (consumer only)
+    uint32_t _pad_consumer[14]; // Padding to 192 bytes
+
+    uint64_t overflow_count;    // Writes attempted on a full buffer
+    uint32_t _reserved[8];      // Future expansion
+    uint32_t _pad1[6];          // Padding to 256 bytes
 } RingBufferHeader;
 
 #define RING_BUFFER_MAGIC 0xADA0
-#define RING_BUFFER_VERSION 1
+#define RING_BUFFER_VERSION 2
 
 // ============================================================================
 // Thread Registry Lifecycle API
@@ -256,6 +269,20 @@ uint32_t thread_registry_get_capacity(ThreadRegistry* registry);
  */
 uint32_t lane_take_ring(Lane* lane);
 
+/**
+ * Take every ready ring, up to max, in one pass
+ * 
+ * @param lane Lane to drain from
+ * @param rings Receives ring indices, oldest first
+ * @param max Capacity of rings
+ * @return Number of rings taken, 0 if empty
+ * 
+ * Performance: O(n) copies, one atomic acquire and one release
+ * Thread-safe: Yes (SPSC queue)
+ * Memory order: acquire
+ */
+uint32_t lane_take_rings(Lane* lane, uint32_t* rings, uint32_t max);
+
 /**
  * Return drained ring to free pool
  * 
@@ -269,6 +296,20 @@ uint32_t lane_take_ring(Lane* lane);
  */
 bool lane_return_ring(Lane* lane, uint32_t ring_idx);
 
+/**
+ * Return drained rings to the free pool in one publish
+ * 
+ * @param lane Lane to return to
+ * @param rings Ring indices to return
+ * @param count Number of rings
+ * @return Number returned; fewer than count if the queue filled
+ * 
+ * Performance: O(n) copies, one atomic release
+ * Thread-safe: Yes (SPSC queue)
+ * Memory order: release
+ */
+uint32_t lane_return_rings(Lane* lane, const uint32_t* rings, uint32_t count);
+
 // ============================================================================
 // Statistics API
 // ============================================================================
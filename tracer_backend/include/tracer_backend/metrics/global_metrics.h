@@ -60,11 +60,6 @@ typedef struct ada_global_metrics_state {
     ADA_GLOBAL_ATOMIC_SIZE snapshot_count;
 
     ADA_METRICS_ALIGN_CACHELINE ada_global_metrics_control_t control;
-
-    // Per-slot bookkeeping for swap rate calculations
-    uint64_t previous_swap_count[MAX_THREADS];
-    uint64_t previous_swap_timestamp[MAX_THREADS];
-    uint64_t previous_thread_id[MAX_THREADS];
 } ada_global_metrics_t;
 
 // Initialize global metrics state with caller-provided snapshot buffer.
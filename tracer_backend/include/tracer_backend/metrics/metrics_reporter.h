@@ -48,7 +48,7 @@ typedef struct ada_metrics_reporter_config {
     bool start_paused;               // If true reporter starts paused
     const char* json_output_path;    // Optional path, appended-to if set
     FILE* output_stream;             // Stream for human reports (defaults to stderr)
-    size_t snapshot_capacity;        // Optional override (defaults to MAX_THREADS)
+    size_t snapshot_capacity;        // Optional override (defaults to registry capacity)
     ada_metrics_report_sink_fn sink; // Optional hook for tests/diagnostics
     void* sink_user_data;            // Passed to sink
 } ada_metrics_reporter_config_t;
@@ -125,6 +125,8 @@ typedef struct ada_thread_metrics {
         uint64_t window_bytes;
         double events_per_second;
         double bytes_per_second;
+        uint64_t prev_swap_count;          // Swap count at the previous collection
+        uint64_t prev_swap_timestamp_ns;   // 0 until the first collection
         ada_metrics_rate_sample_t samples[ADA_METRICS_RATE_HISTORY];
     } rate;
 } ada_thread_metrics_t;
@@ -2,6 +2,7 @@
 #ifndef AGENT_MODE_H
 #define AGENT_MODE_H
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <tracer_backend/utils/tracer_types.h>
 
@@ -22,6 +23,29 @@ typedef struct {
 void agent_mode_tick(AgentModeState* state, const ControlBlock* cb,
                      uint64_t now_ns, uint64_t hb_timeout_ns);
 
+// Per-thread amortization of agent_mode_tick() for the hook hot path.
+// The control block fields the tick reads share a cache line with the drain
+// heartbeat, which the controller rewrites continuously; ticking on every call
+// misses on that line every time. Hooks instead compare their timestamp with a
+// thread-local deadline and run the tick only once it has passed, using the
+// cached mode in between.
+typedef struct {
+    uint64_t next_check;   // Deadline in hook timestamp units (0 = check now)
+    uint32_t mode;         // RegistryMode observed at the last check
+    uint32_t _pad;
+} AgentModeCache;
+
+// Default spacing of full checks (well inside the 500 ms heartbeat timeout)
+#define AGENT_MODE_CHECK_INTERVAL_NS 1000000ull
+
+static inline bool agent_mode_cache_due(const AgentModeCache* cache, uint64_t now) {
+    return now >= cache->next_check;
+}
+
+// Record the mode seen by a full check and schedule the next one
+void agent_mode_cache_refresh(AgentModeCache* cache, uint32_t mode,
+                              uint64_t now, uint64_t interval);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,97 @@
+#ifndef AGGREGATE_TABLE_H
+#define AGGREGATE_TABLE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Per-function call totals: the aggregation lane.
+//
+// A registry slot gets one AggregateTable in the shared ring pool, next to its
+// index and detail lanes, the first time its thread aggregates a call
+// (thread_registry_attach_aggregates). The thread holding the slot is its only
+// writer:
+// counters are updated with plain read-modify-write and published with
+// relaxed stores, and a new key is published with a release store after its
+// counters. The drain reads tables concurrently and merges them; a read may
+// miss the latest call but never sees a torn counter. Tables are cumulative
+// and survive slot reuse, so one merge at session end covers exited threads.
+//
+// Times are in hook timestamp units (see timestamp_source.h).
+
+#define AGGREGATE_TABLE_CAPACITY 2048u      // Entries per slot (power of two, 64 KB)
+#define AGGREGATE_TABLE_MAX_PROBE 32u
+
+typedef struct {
+    uint64_t function_id;      // 0 = empty
+    uint64_t calls;
+    uint64_t inclusive_time;   // Entry to return
+    uint64_t exclusive_time;   // Inclusive minus time in hooked callees
+} AggregateEntry;
+
+typedef struct AggregateTable {
+    uint32_t capacity;         // Power of two
+    uint32_t max_used;         // Load cap (3/4 of capacity)
+    uint32_t used;             // Keys published
+    uint32_t _pad;
+    uint64_t dropped_calls;    // Calls that found no entry
+    uint8_t _reserved[40];
+    AggregateEntry entries[];
+} AggregateTable;
+
+// Bytes needed for a table of capacity entries
+size_t aggregate_table_bytes(uint32_t capacity);
+
+// Initialize a zeroed or reused block; capacity must be a power of two
+AggregateTable* aggregate_table_init(void* memory, uint32_t capacity);
+
+// Add every published entry of src (possibly live) into dst; false when dst
+// had no room for some function
+bool aggregate_table_merge(AggregateTable* dst, const AggregateTable* src);
+
+static inline uint32_t aggregate_table_slot(uint64_t function_id, uint32_t mask) {
+    return (uint32_t)((function_id * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+}
+
+// Writer only. Returns false when the function has no entry and none is free.
+static inline bool aggregate_table_add(AggregateTable* table, uint64_t function_id,
+                                       uint64_t calls, uint64_t inclusive, uint64_t exclusive) {
+    uint32_t mask = table->capacity - 1;
+    uint32_t i = aggregate_table_slot(function_id, mask);
+    for (uint32_t probe = 0; probe < AGGREGATE_TABLE_MAX_PROBE; ++probe, i = (i + 1) & mask) {
+        AggregateEntry* e = &table->entries[i];
+        if (e->function_id == function_id) {
+            __atomic_store_n(&e->calls, e->calls + calls, __ATOMIC_RELAXED);
+            __atomic_store_n(&e->inclusive_time, e->inclusive_time + inclusive, __ATOMIC_RELAXED);
+            __atomic_store_n(&e->exclusive_time, e->exclusive_time + exclusive, __ATOMIC_RELAXED);
+            return true;
+        }
+        if (e->function_id == 0) {
+            if (table->used >= table->max_used) break;
+            __atomic_store_n(&e->calls, calls, __ATOMIC_RELAXED);
+            __atomic_store_n(&e->inclusive_time, inclusive, __ATOMIC_RELAXED);
+            __atomic_store_n(&e->exclusive_time, exclusive, __ATOMIC_RELAXED);
+            __atomic_store_n(&e->function_id, function_id, __ATOMIC_RELEASE);
+            __atomic_store_n(&table->used, table->used + 1, __ATOMIC_RELAXED);
+            return true;
+        }
+    }
+    __atomic_store_n(&table->dropped_calls, table->dropped_calls + calls, __ATOMIC_RELAXED);
+    return false;
+}
+
+// One completed call
+static inline bool aggregate_table_record(AggregateTable* table, uint64_t function_id,
+                                          uint64_t inclusive, uint64_t exclusive) {
+    return aggregate_table_add(table, function_id, 1, inclusive, exclusive);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // AGGREGATE_TABLE_H
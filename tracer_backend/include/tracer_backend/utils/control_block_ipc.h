@@ -82,6 +82,38 @@ static inline uint64_t cb_get_fallback_events(ControlBlock* cb) {
     return __atomic_load_n(&cb->fallback_events, __ATOMIC_ACQUIRE);
 }
 
+static inline void cb_set_index_spans(ControlBlock* cb, uint32_t enabled) {
+    __atomic_store_n(&cb->index_spans, enabled, __ATOMIC_RELEASE);
+}
+
+static inline uint32_t cb_get_index_spans(ControlBlock* cb) {
+    return __atomic_load_n(&cb->index_spans, __ATOMIC_ACQUIRE);
+}
+
+static inline void cb_set_aggregation(ControlBlock* cb, uint32_t mode) {
+    __atomic_store_n(&cb->aggregation, mode, __ATOMIC_RELEASE);
+}
+
+static inline uint32_t cb_get_aggregation(ControlBlock* cb) {
+    return __atomic_load_n(&cb->aggregation, __ATOMIC_ACQUIRE);
+}
+
+// Sampling thresholds are published field by field with enabled last, so a
+// reader that sees the new enabled flag also sees the thresholds set with it
+static inline void cb_set_sampling(ControlBlock* cb, const SamplingControl* control) {
+    __atomic_store_n(&cb->sampling.max_calls_per_sec, control->max_calls_per_sec, __ATOMIC_RELAXED);
+    __atomic_store_n(&cb->sampling.max_sample_shift, control->max_sample_shift, __ATOMIC_RELAXED);
+    __atomic_store_n(&cb->sampling.window_ms, control->window_ms, __ATOMIC_RELAXED);
+    __atomic_store_n(&cb->sampling.enabled, control->enabled, __ATOMIC_RELEASE);
+}
+
+static inline void cb_get_sampling(ControlBlock* cb, SamplingControl* out) {
+    out->enabled = __atomic_load_n(&cb->sampling.enabled, __ATOMIC_ACQUIRE);
+    out->max_calls_per_sec = __atomic_load_n(&cb->sampling.max_calls_per_sec, __ATOMIC_RELAXED);
+    out->max_sample_shift = __atomic_load_n(&cb->sampling.max_sample_shift, __ATOMIC_RELAXED);
+    out->window_ms = __atomic_load_n(&cb->sampling.window_ms, __ATOMIC_RELAXED);
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,48 @@
+#ifndef DRAIN_WAKE_H
+#define DRAIN_WAKE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <tracer_backend/utils/tracer_types.h>
+
+// Cross-process drain wakeup on a DrainWakeWord in shared memory.
+//
+// Producer (agent): after submitting a ring into an empty submit queue, call
+// drain_wake_signal(). It costs one atomic increment and makes a syscall only
+// when a drain worker is actually parked.
+//
+// Consumer (drain): drain_wake_prepare(), rescan for work, and only if none
+// was found drain_wake_wait() on the returned sequence; drain_wake_finish()
+// afterwards. Registering before the rescan closes the race with a submit
+// that lands between the last scan and the wait.
+//
+// Linux uses a shared futex, macOS __ulock with UL_COMPARE_AND_WAIT_SHARED;
+// other platforms fall back to a short sleep.
+
+// Bump the sequence and wake parked drain workers. NULL is ignored.
+void drain_wake_signal(DrainWakeWord* word);
+
+// Register as a waiter and snapshot the sequence to wait on
+uint32_t drain_wake_prepare(DrainWakeWord* word);
+
+// Sleep until the sequence moves past seq or timeout_ns elapses.
+// Returns 0 when signalled, -ETIMEDOUT otherwise (including spurious wakeups).
+int drain_wake_wait(DrainWakeWord* word, uint32_t seq, uint64_t timeout_ns);
+
+// Deregister after drain_wake_prepare()
+void drain_wake_finish(DrainWakeWord* word);
+
+// Word signalled by this process's ring pools on submit (NULL = none).
+// The agent binds the control block's word once it is mapped.
+void drain_wake_bind_producer(DrainWakeWord* word);
+DrainWakeWord* drain_wake_producer_word(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DRAIN_WAKE_H
@@ -0,0 +1,121 @@
+#ifndef HOOK_SAMPLER_H
+#define HOOK_SAMPLER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <tracer_backend/utils/tracer_types.h>
+
+// Adaptive per-function sampling for the hook hot path.
+//
+// Each hooked function owns a HookSampler. Calls are counted per rate window;
+// when a window closes, the sampler picks the smallest N = 1 << shift that
+// brings the function back under the configured per-window budget and records
+// only every Nth call of the next window. N rises at once on a burst and
+// decays one step per quiet window. The thread that closes a window collects
+// the count of calls skipped since the previous window and emits it as a
+// single EVENT_KIND_SAMPLED index event, so totals stay reconstructible. A
+// function that goes quiet has its last count collected by
+// hook_sampler_flush from a housekeeping tick, and by a forced flush at stop.
+//
+// Each thread counts a sampler's calls in its own HookSamplerTally and adds
+// them to window_calls every HOOK_SAMPLER_TALLY_FLUSH calls. Calls still in
+// the tally when a window rolls are folded into the next window.
+//
+// Sampled-out calls still keep the caller's call depth balanced; the agent
+// marks them in Frida's per-invocation data and skips the matching return.
+
+#define SAMPLING_DEFAULT_MAX_CALLS_PER_SEC 100000u
+#define SAMPLING_DEFAULT_MAX_SHIFT 16u
+#define SAMPLING_DEFAULT_WINDOW_MS 100u
+#define SAMPLING_MAX_SHIFT_LIMIT 31u
+#define HOOK_SAMPLER_TALLY_FLUSH 64u
+
+typedef struct {
+    uint64_t window_start;   // Hook timestamp that opened the current window (0 = none yet)
+    uint32_t window_calls;   // Calls seen in the current window
+    uint32_t shift;          // Record 1 call in (1 << shift)
+    uint64_t suppressed;     // Calls skipped since the last summary
+} HookSampler;
+
+// One thread's calls to one sampler in the current window (thread-local)
+typedef struct {
+    HookSampler* sampler;    // Sampler being counted (NULL = unused)
+    uint64_t window_start;   // Window the count belongs to
+    uint32_t calls;          // This thread's calls in that window
+    uint32_t unflushed;      // Of those, not yet added to window_calls
+} HookSamplerTally;
+
+// SamplingControl converted to hook timestamp units; cached per thread
+typedef struct {
+    uint32_t enabled;
+    uint32_t max_shift;
+    uint32_t window_limit;   // Calls per window before sampling starts
+    uint32_t _pad;
+    uint64_t window_ticks;   // Window length in hook timestamp units
+} HookSamplerConfig;
+
+// Fill control with the defaults, disabled
+void hook_sampler_control_defaults(SamplingControl* control);
+
+// Derive the hot-path config from control for timestamps taken with cal
+void hook_sampler_config_from_control(const SamplingControl* control,
+                                      const TimestampCalibration* cal,
+                                      HookSamplerConfig* out);
+
+// Close the window that opened at start if no other thread has, retune the
+// shift from the window's rate and return the calls suppressed since the
+// previous summary (0 when another thread won or nothing was skipped).
+uint64_t hook_sampler_roll(HookSampler* sampler, const HookSamplerConfig* config,
+                           uint64_t now, uint64_t start);
+
+// Housekeeping: close a window no call has rolled for a whole window and
+// return the suppressed count to emit. With force (session stop), return the
+// pending count whatever the window.
+uint64_t hook_sampler_flush(HookSampler* sampler, const HookSamplerConfig* config,
+                            uint64_t now, bool force);
+
+// Point tally at sampler's window that opened at start, folding the calls the
+// tally still holds into the window now open on its previous sampler
+void hook_sampler_tally_reset(HookSamplerTally* tally, HookSampler* sampler, uint64_t start);
+
+// Hot path: true when this call should be recorded. tally is the calling
+// thread's. *summary receives the suppressed count to emit when this call
+// closed a window, else 0.
+static inline bool hook_sampler_admit(HookSampler* sampler, const HookSamplerConfig* config,
+                                      HookSamplerTally* tally, uint64_t now, uint64_t* summary) {
+    *summary = 0;
+    if (!config->enabled) {
+        return true;
+    }
+    uint64_t start = __atomic_load_n(&sampler->window_start, __ATOMIC_RELAXED);
+    // Counters on different cores may disagree slightly; never roll backwards
+    if (now > start && now - start >= config->window_ticks) {
+        *summary = hook_sampler_roll(sampler, config, now, start);
+        start = __atomic_load_n(&sampler->window_start, __ATOMIC_RELAXED);
+    }
+    if (tally->sampler != sampler || tally->window_start != start) {
+        hook_sampler_tally_reset(tally, sampler, start);
+    }
+    uint32_t n = tally->calls++;
+    if (++tally->unflushed >= HOOK_SAMPLER_TALLY_FLUSH) {
+        __atomic_fetch_add(&sampler->window_calls, tally->unflushed, __ATOMIC_RELAXED);
+        tally->unflushed = 0;
+    }
+    uint32_t shift = __atomic_load_n(&sampler->shift, __ATOMIC_RELAXED);
+    if (shift == 0 || (n & ((1u << shift) - 1u)) == 0) {
+        return true;
+    }
+    __atomic_fetch_add(&sampler->suppressed, 1, __ATOMIC_RELAXED);
+    return false;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOOK_SAMPLER_H
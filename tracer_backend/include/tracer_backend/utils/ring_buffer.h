@@ -67,11 +67,47 @@ bool ring_buffer_drop_oldest(RingBuffer* rb);
 // These operate directly on RingBufferHeader and adjacent payload buffer.
 // Event size must match the ring's event type size.
 bool ring_buffer_write_raw(RingBufferHeader* header, size_t event_size, const void* event);
+// Producer-side bulk publish: copies up to count events (as many as fit)
+// and publishes them with a single release store; returns the number written.
+size_t ring_buffer_write_batch_raw(RingBufferHeader* header, size_t event_size,
+                                   const void* events, size_t count);
 bool ring_buffer_read_raw(RingBufferHeader* header, size_t event_size, void* event);
 size_t ring_buffer_read_batch_raw(RingBufferHeader* header, size_t event_size, void* events, size_t max_count);
 size_t ring_buffer_available_read_raw(RingBufferHeader* header);
 size_t ring_buffer_available_write_raw(RingBufferHeader* header);
 
+// Zero-copy consumer view of the readable region. The readable events occupy
+// at most two contiguous spans of the payload (two only when the region wraps
+// past the end of the buffer). Spans stay owned by the consumer until
+// ring_buffer_consume_raw() publishes the new read position, so callers may
+// hand them directly to bulk writers without an intermediate copy.
+typedef struct RingBufferSpan {
+    const void* data;   // First event in the span (NULL when count == 0)
+    size_t count;       // Number of events in the span
+} RingBufferSpan;
+
+// Fill spans[0..1] with up to max_count readable events; returns the total.
+size_t ring_buffer_peek_spans_raw(RingBufferHeader* header, size_t event_size,
+                                  RingBufferSpan spans[2], size_t max_count);
+// Release count events previously returned by ring_buffer_peek_spans_raw().
+void ring_buffer_consume_raw(RingBufferHeader* header, size_t count);
+
+// Variable-length records (detail lanes, see DetailRecordHeader). The ring
+// is created with event_size == DETAIL_RECORD_ALIGN; positions count units.
+// Append a record of length bytes (its first field is total_length); it is
+// published whole or not at all. Returns false (and counts an overflow) when
+// it does not fit.
+bool ring_buffer_write_record_raw(RingBufferHeader* header, const void* record, size_t length);
+// Consumer: point *record at the oldest record and return its total_length,
+// or 0 when empty. Wraparound markers are consumed on the way.
+size_t ring_buffer_peek_record_raw(RingBufferHeader* header, const void** record);
+// Release the record returned by ring_buffer_peek_record_raw()
+void ring_buffer_consume_record_raw(RingBufferHeader* header, size_t length);
+// Producer-side recovery: drop the oldest record; false when empty
+bool ring_buffer_drop_oldest_record_raw(RingBufferHeader* header);
+// True when the largest record (DETAIL_RECORD_MAX_SIZE) no longer fits
+bool ring_buffer_record_ring_full_raw(RingBufferHeader* header);
+
 #ifdef __cplusplus
 }
 #endif
@@ -26,6 +26,12 @@ void ring_pool_destroy(RingPool* pool);
 // Returns true on success, false when no free ring is available (pool exhaustion).
 bool ring_pool_swap_active(RingPool* pool, uint32_t* out_old_idx);
 
+// Publish count events into the active ring with one bulk copy and one
+// release store, swapping to a fresh ring whenever the active one fills.
+// Returns the number written; fewer than count means the pool is exhausted.
+size_t ring_pool_write_batch(RingPool* pool, size_t event_size,
+                             const void* events, size_t count);
+
 // Get the header of the currently active ring for this pool.
 // Returns NULL on error.
 RingBufferHeader* ring_pool_get_active_header(RingPool* pool);
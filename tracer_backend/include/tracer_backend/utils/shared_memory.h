@@ -57,13 +57,14 @@ SharedMemoryRef shared_memory_create_unique(const char* role, pid_t pid, uint32_
 // environment variable or argument.
 // - parameter session_id: The host process session id. The agent shall receive the session id
 // from the controller as environment variable or argument.
-// - parameter size: The size of the shared memory segment.
+// - parameter size: The size of the shared memory segment, or 0 to map the size the creator
+// chose (e.g. a registry whose capacity the controller picked at runtime).
 //
 SharedMemoryRef shared_memory_open_unique(const char* role, pid_t pid, uint32_t session_id,
                                         size_t size);
 
 // Open shared memory by OS name (e.g. "/ada_registry_...")
-// Size must match the creator-specified size.
+// Size must match the creator-specified size, or be 0 to use it as-is.
 SharedMemoryRef shared_memory_open_named(const char* name, size_t size);
 
 // Destroy shared memory
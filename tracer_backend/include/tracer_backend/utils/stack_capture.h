@@ -0,0 +1,42 @@
+#ifndef STACK_CAPTURE_H
+#define STACK_CAPTURE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Signal-free stack snapshots for detail events.
+//
+// Each thread caches its stack bounds in TLS (pthread_getattr_np on Linux,
+// pthread_get_stackaddr_np on macOS), normally at registration. A snapshot
+// that starts inside those bounds is a plain memcpy clipped at the stack top,
+// with no syscalls. Anything else goes through a kernel-checked read of our
+// own address space (process_vm_readv / vm_read_overwrite), which returns a
+// short count instead of faulting.
+
+// Default snapshot size when capture is enabled without an explicit size
+#define STACK_CAPTURE_DEFAULT_BYTES 128u
+
+// Cache the calling thread's stack bounds.
+// Returns 0, or -ENOTSUP when the platform cannot report them.
+int stack_capture_init_thread(void);
+
+// Cached bounds of the calling thread: [*low, *high). False when unknown.
+bool stack_capture_get_bounds(uintptr_t* low, uintptr_t* high);
+
+// Copy up to max_size bytes starting at stack_ptr; returns bytes copied.
+// Initializes the thread's bounds on first use if registration did not.
+size_t stack_capture_copy(void* dest, const void* stack_ptr, size_t max_size);
+
+// Copy through the kernel-checked path only (exposed for tests/benchmarks)
+size_t stack_capture_copy_checked(void* dest, const void* src, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // STACK_CAPTURE_H
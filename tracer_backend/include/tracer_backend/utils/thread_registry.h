@@ -3,6 +3,7 @@
 
 #include "tracer_types.h"
 #include <tracer_backend/metrics/thread_metrics.h>
+#include <tracer_backend/utils/aggregate_table.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
@@ -26,6 +27,27 @@ ThreadRegistry* thread_registry_init(void* memory, size_t size);
 // Note: Memory size must be sufficient for the computed layout
 ThreadRegistry* thread_registry_init_with_capacity(void* memory, size_t size, uint32_t capacity);
 
+// Ring geometry of each lane kind, fixed when the registry is created.
+// Ring sizes are rounded up to a power of two (4 KiB - 16 MiB); ring counts
+// are clamped to [2, 32]; zero fields take the defaults.
+typedef struct {
+    uint32_t index_ring_bytes;   // Bytes per index ring (default 64 KiB)
+    uint32_t index_ring_count;   // Index rings per thread at registration (default 4)
+    uint32_t detail_ring_bytes;  // Bytes per detail ring (default 256 KiB)
+    uint32_t detail_ring_count;  // Detail rings per thread at registration (default 2)
+    // Shared overflow segment that lanes under pressure grow into, one ring
+    // at a time. Only the space left after every slot's initial rings is
+    // used; 0 (default) disables growth.
+    uint64_t overflow_bytes;
+} ThreadRegistryGeometry;
+
+void thread_registry_geometry_default(ThreadRegistryGeometry* geometry);
+
+// Initialize with explicit ring geometry; NULL geometry means the defaults.
+// Size memory with thread_registry_calculate_memory_size_with_geometry().
+ThreadRegistry* thread_registry_init_with_geometry(void* memory, size_t size, uint32_t capacity,
+                                                   const ThreadRegistryGeometry* geometry);
+
 /// Deinitialize thread registry
 /// registry: pointer to ThreadRegistry to deinitialize
 /// memory: pointer to shared memory region for the registry
@@ -74,7 +96,7 @@ bool lane_init(Lane* lane, void* ring_memory, size_t ring_size,
 // Submit a ring for draining (thread -> drain)
 // lane: lane containing the ring
 // ring_idx: index of ring to submit
-// Returns: true if submitted, false if queue full
+// Returns: true if submitted, false if queue full (nothing is overwritten)
 // Memory ordering: Uses memory_order_release for publishing
 bool lane_submit_ring(Lane* lane, uint32_t ring_idx);
 
@@ -84,6 +106,18 @@ bool lane_submit_ring(Lane* lane, uint32_t ring_idx);
 // Memory ordering: Uses memory_order_acquire for consuming
 uint32_t lane_take_ring(Lane* lane);
 
+// Take up to max submitted rings at once (drain thread side)
+// rings: receives the ring indices, oldest first
+// Returns: number of rings taken, 0 if queue empty
+// Memory ordering: One acquire of the producer position, one release of ours
+uint32_t lane_take_rings(Lane* lane, uint32_t* rings, uint32_t max);
+
+// Check for submitted rings without taking one (drain thread side)
+// lane: lane to check
+// Returns: true if the submit queue is non-empty (submit_head != submit_tail)
+// Memory ordering: Uses memory_order_acquire on the producer position
+bool lane_has_submitted_rings(Lane* lane);
+
 // Return a free ring (drain -> thread)
 // lane: lane to return ring to
 // ring_idx: index of ring that is now free
@@ -91,6 +125,11 @@ uint32_t lane_take_ring(Lane* lane);
 // Memory ordering: Uses memory_order_release for publishing
 bool lane_return_ring(Lane* lane, uint32_t ring_idx);
 
+// Return count free rings at once (drain -> thread)
+// Returns: number of rings returned; fewer than count means the queue is full
+// Memory ordering: Uses a single memory_order_release store for the batch
+uint32_t lane_return_rings(Lane* lane, const uint32_t* rings, uint32_t count);
+
 // Get a free ring (thread side)
 // lane: lane to get free ring from
 // Returns: ring index that can be used, or UINT32_MAX if none available
@@ -114,16 +153,61 @@ uint32_t thread_registry_get_active_count(ThreadRegistry* registry);
 
 // Get thread lane set by index (for drain thread iteration)
 // registry: ThreadRegistry
-// index: slot index (0 to thread_count-1)
+// index: slot index (0 to capacity-1)
 // Returns: ThreadLaneSet pointer if active, NULL if inactive
 ThreadLaneSet* thread_registry_get_thread_at(ThreadRegistry* registry, uint32_t index);
 
 // Get configured runtime capacity (pressure cap) for this registry
 uint32_t thread_registry_get_capacity(ThreadRegistry* registry);
 
-// Unregister a thread by system thread id; updates active set and counts
+// Snapshot of slots 0-63: bit i set = slot i registered
+// Memory ordering: Uses memory_order_acquire
+uint64_t thread_registry_get_active_mask(ThreadRegistry* registry);
+
+// First registered slot >= from, or UINT32_MAX; walks the slot bitmap a word
+// at a time, so visiting every registered slot costs O(capacity/64 + active)
+uint32_t thread_registry_next_active_slot(ThreadRegistry* registry, uint32_t from);
+
+// Changes whenever a slot is claimed or released; lets readers cache views
+// derived from the slot bitmap (e.g. drain shards)
+uint64_t thread_registry_get_slot_generation(ThreadRegistry* registry);
+
+// Unregister a thread by system thread id; updates active set and counts.
+// Releases the slot immediately, so undrained events in its lanes are lost;
+// exiting threads should retire instead.
 bool thread_registry_unregister_by_id(ThreadRegistry* registry, uintptr_t thread_id);
 
+// Thread exit: stop counting the thread as live and hand its slot to the
+// drain. The lanes stay visible (thread_registry_get_thread_at) until the
+// drain has emptied them and reclaimed the slot. False if not live.
+bool thread_registry_retire(ThreadRegistry* registry, ThreadLaneSet* lanes);
+
+// True between thread_registry_retire and reclamation
+bool thread_lanes_is_retiring(ThreadLaneSet* lanes);
+
+// Drain side: recycle a retired slot whose lanes hold no submitted rings,
+// once the epoch has advanced past its exit. The slot and its rings go back
+// to the free bitmap for the next registration. Call only from the slot's
+// drainer, after draining it.
+bool thread_registry_reclaim_slot(ThreadRegistry* registry, uint32_t slot);
+
+// Drain side: advance the reclaim epoch once per drain cycle
+uint64_t thread_registry_advance_epoch(ThreadRegistry* registry);
+
+// Slots recycled by the drain, and registrations that reused a recycled slot
+uint64_t thread_registry_get_slots_reclaimed(ThreadRegistry* registry);
+uint64_t thread_registry_get_slots_reused(ThreadRegistry* registry);
+
+// Producer side: append one ring from the overflow segment to the thread's
+// lane (0 = index, 1 = detail) and return its index for the caller to make
+// active; the free queue stays the drain's. UINT32_MAX when growth is
+// disabled, the lane holds 32 rings or the segment is spent.
+uint32_t thread_registry_grow_lane(ThreadRegistry* registry, ThreadLaneSet* lanes, int lane_type);
+
+// Rings handed out by thread_registry_grow_lane, and requests it refused
+uint64_t thread_registry_get_rings_grown(ThreadRegistry* registry);
+uint64_t thread_registry_get_ring_growth_denied(ThreadRegistry* registry);
+
 
 // Get active ring header directly (for raw, header-only operations)
 RingBufferHeader* thread_registry_get_active_ring_header(ThreadRegistry* registry,
@@ -134,6 +218,63 @@ RingBufferHeader* thread_registry_get_ring_header_by_idx(ThreadRegistry* registr
                                                         Lane* lane,
                                                         uint32_t ring_idx);
 
+// Size in bytes of a lane's ring (rings differ per lane kind), 0 if invalid
+uint32_t thread_registry_get_ring_bytes(ThreadRegistry* registry, Lane* lane, uint32_t ring_idx);
+
+// ============================================================================
+// Lane views - lane pointers materialized once for the hot path
+// ============================================================================
+
+#define LANE_VIEW_MAX_RINGS 32
+
+// A lane's ring headers and queue arrays resolved from the registry's
+// offsets. A view belongs to one thread (a producer's TLS, or the drainer
+// of the lane's slot) and is rebuilt only when the registry epoch (segment
+// table) moves. Rings a lane grows later are resolved on first use.
+typedef struct LaneView {
+    ThreadRegistry* registry;        // Registry the view was resolved against
+    Lane* lane;                      // Lane the view describes (NULL = not built)
+    uint32_t epoch;                  // Registry epoch at build time
+    uint32_t ring_count;             // Valid entries in rings[]
+    uint32_t* submit_queue;          // Submit queue array (thread -> drain)
+    uint32_t* free_queue;            // Free queue array (drain -> thread)
+    RingBufferHeader* rings[LANE_VIEW_MAX_RINGS];
+} LaneView;
+
+// Make view describe lane, rebuilding it if it was built for another lane or
+// an older epoch. NULL registry means the global one. False (view cleared)
+// if the lane cannot be resolved.
+bool lane_view_sync(ThreadRegistry* registry, Lane* lane, LaneView* view);
+
+// Header of a ring the view has not resolved yet (appended since it was built)
+RingBufferHeader* lane_view_resolve_ring(LaneView* view, uint32_t ring_idx);
+
+// Header of ring_idx, or NULL if the lane has no such ring
+static inline RingBufferHeader* lane_view_ring(LaneView* view, uint32_t ring_idx) {
+    if (ring_idx < view->ring_count) return view->rings[ring_idx];
+    return lane_view_resolve_ring(view, ring_idx);
+}
+
+// Header of the lane's active ring
+RingBufferHeader* lane_view_active_ring(LaneView* view);
+
+// Queue operations on a synced view; same contracts as the lane_* functions
+bool lane_view_submit_ring(LaneView* view, uint32_t ring_idx);
+uint32_t lane_view_take_ring(LaneView* view);
+uint32_t lane_view_take_rings(LaneView* view, uint32_t* rings, uint32_t max);
+bool lane_view_return_ring(LaneView* view, uint32_t ring_idx);
+uint32_t lane_view_return_rings(LaneView* view, const uint32_t* rings, uint32_t count);
+uint32_t lane_view_get_free_ring(LaneView* view);
+
+// Aggregation lane of a registry slot, allocating it on first use; called by
+// the thread holding the slot
+// Returns: the slot's AggregateTable, or NULL if the pool is exhausted
+AggregateTable* thread_registry_attach_aggregates(ThreadRegistry* registry, uint32_t slot);
+
+// Aggregation lane of a registry slot, whether or not a thread holds it now
+// Returns: the slot's AggregateTable, or NULL if none was allocated
+AggregateTable* thread_registry_get_aggregates(ThreadRegistry* registry, uint32_t slot);
+
 // ============================================================================
 // Thread-local storage
 // ============================================================================
@@ -145,6 +286,11 @@ Lane* thread_lanes_get_index_lane(ThreadLaneSet* lanes);
 Lane* thread_lanes_get_detail_lane(ThreadLaneSet* lanes);
 ada_thread_metrics_t* thread_lanes_get_metrics(ThreadLaneSet* lanes);
 uint32_t thread_lanes_get_slot_index(ThreadLaneSet* lanes);
+// ATF thread id of the lanes' current registration: the slot index on first
+// use, a fresh id above the registry capacity each time a reclaimed slot is
+// reused. The agent stamps it into index records and the drain names the
+// thread_<id> files after it, so every thread lifetime has its own stream.
+uint32_t thread_lanes_get_stream_id(ThreadLaneSet* lanes);
 uint64_t thread_lanes_get_thread_id(ThreadLaneSet* lanes);
 
 // Set active status for a thread lane set
@@ -184,6 +330,10 @@ void thread_registry_dump(ThreadRegistry* registry);
 // Calculate the memory size for a given capacity (registry structure + per-thread layouts + ring pools)
 size_t thread_registry_calculate_memory_size_with_capacity(uint32_t capacity);
 
+// Same for explicit ring geometry, including its overflow segment
+size_t thread_registry_calculate_memory_size_with_geometry(uint32_t capacity,
+                                                           const ThreadRegistryGeometry* geometry);
+
 #ifdef __cplusplus
 }
 #endif
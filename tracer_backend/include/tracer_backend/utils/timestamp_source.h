@@ -0,0 +1,92 @@
+#ifndef TIMESTAMP_SOURCE_H
+#define TIMESTAMP_SOURCE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <tracer_backend/utils/tracer_types.h>
+
+// Hook timestamp source.
+//
+// The controller picks the source at session start (ADA_TIMESTAMP_SOURCE),
+// calibrates it against CLOCK_MONOTONIC and publishes the TimestampCalibration
+// in the control block. The agent stamps events with timestamp_source_read(),
+// one read per callback; in counter mode that is a single rdtsc/cntvct_el0
+// instead of a clock_gettime() call. Event timestamps stay in raw ticks: the
+// drain records the calibration in the manifest (ATF clock_type
+// ATF_CLOCK_COUNTER) and readers convert ticks to ns.
+
+// Raw CPU counter; 0 where there is none
+static inline uint64_t timestamp_source_counter(void) {
+#if defined(__x86_64__)
+    uint32_t lo, hi;
+    __asm__ __volatile__("rdtsc" : "=a"(lo), "=d"(hi));
+    return ((uint64_t)hi << 32) | lo;
+#elif defined(__aarch64__)
+    uint64_t v;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(v));
+    return v;
+#else
+    return 0;
+#endif
+}
+
+// CLOCK_MONOTONIC in ns (vDSO on Linux)
+static inline uint64_t timestamp_source_monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ull) + (uint64_t)ts.tv_nsec;
+}
+
+// Current timestamp in the units of source (TimestampSourceKind)
+static inline uint64_t timestamp_source_read(uint32_t source) {
+    if (source == TIMESTAMP_SOURCE_COUNTER) {
+        return timestamp_source_counter();
+    }
+    return timestamp_source_monotonic_ns();
+}
+
+// Convert a timestamp taken with cal->source to CLOCK_MONOTONIC ns
+static inline uint64_t timestamp_source_to_ns(const TimestampCalibration* cal, uint64_t ts) {
+    if (cal->source != TIMESTAMP_SOURCE_COUNTER) {
+        return ts;
+    }
+    if (ts >= cal->tick_base) {
+        return cal->ns_base +
+               (uint64_t)(((__uint128_t)(ts - cal->tick_base) * cal->mult) >> cal->shift);
+    }
+    return cal->ns_base -
+           (uint64_t)(((__uint128_t)(cal->tick_base - ts) * cal->mult) >> cal->shift);
+}
+
+// Convert a duration in ns to a duration in cal->source units
+uint64_t timestamp_source_duration_from_ns(const TimestampCalibration* cal, uint64_t ns);
+
+// True when the CPU counter runs at a constant rate across cores and
+// power states (invariant TSC on x86_64; always on arm64)
+bool timestamp_source_counter_usable(void);
+
+// Calibrate source against CLOCK_MONOTONIC, sampling for about sample_ms.
+// A counter request on a CPU without a usable counter falls back to
+// TIMESTAMP_SOURCE_MONOTONIC. Returns 0, or -EINVAL on bad arguments.
+int timestamp_source_calibrate(uint32_t source, uint32_t sample_ms, TimestampCalibration* out);
+
+// Re-derive mult from the (tick_base, ns_base) pair and a fresh pair taken now,
+// so a long session's drift is corrected over its whole span.
+// Returns 0, or -EINVAL on bad arguments.
+int timestamp_source_refine(const TimestampCalibration* cal, TimestampCalibration* out);
+
+// Parse "monotonic" | "counter" | "auto"; NULL or unknown selects monotonic.
+// "auto" picks the counter when timestamp_source_counter_usable().
+uint32_t timestamp_source_parse(const char* name);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TIMESTAMP_SOURCE_H
@@ -1,6 +1,7 @@
 #ifndef TRACER_TYPES_H
 #define TRACER_TYPES_H
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -16,14 +17,19 @@
 #define CACHE_LINE_SIZE 64
 #endif
 #ifndef MAX_THREADS
-#define MAX_THREADS 64
+#define MAX_THREADS 64                      // Default registry capacity
 #endif
+// Registry capacity limit: one 64-bit word per 64 slots, 64 words
+#define THREAD_REGISTRY_SLOT_WORDS 64
+#define THREAD_REGISTRY_MAX_CAPACITY (THREAD_REGISTRY_SLOT_WORDS * 64)
 
 // Event kinds
 typedef enum {
     EVENT_KIND_CALL = 1,
     EVENT_KIND_RETURN = 2,
-    EVENT_KIND_EXCEPTION = 3
+    EVENT_KIND_EXCEPTION = 3,
+    EVENT_KIND_SAMPLED = 4,    // Sampling summary: call_depth = calls suppressed since the last one
+    EVENT_KIND_SPAN = 5        // Completed call in one record (see index_event_set_span)
 } EventKind;
 
 // Process state
@@ -46,6 +52,13 @@ typedef enum {
     REGISTRY_MODE_PER_THREAD_ONLY = 2
 } RegistryMode;
 
+// Aggregation lane mode (ControlBlock.aggregation)
+typedef enum {
+    AGGREGATION_OFF = 0,
+    AGGREGATION_WITH_EVENTS = 1,   // Per-function totals alongside the event lanes
+    AGGREGATION_ONLY = 2           // Totals only: no index or detail events
+} AggregationMode;
+
 // Flight recorder state
 typedef enum {
     FLIGHT_RECORDER_IDLE = 0,
@@ -56,16 +69,55 @@ typedef enum {
 } FlightRecorderState;
 
 // Compact index event (32 bytes)
+//
+// Byte-for-byte identical to the ATF v2 on-disk IndexEvent (atf_v2_types.h):
+// producers write the final record (thread_id = registry slot, detail_seq
+// filled in) so the drain can hand ring memory straight to index.atf.
 typedef struct __attribute__((packed)) {
     uint64_t timestamp;      // Monotonic timestamp
     uint64_t function_id;    // (moduleId << 32) | symbolIndex
-    uint32_t thread_id;      // Thread identifier
+    uint32_t thread_id;      // Thread identifier (registry slot on per-thread lanes)
     uint32_t event_kind;     // EventKind
     uint32_t call_depth;     // Call stack depth
-    uint32_t _padding;       // Alignment padding
+    uint32_t detail_seq;     // Forward link to detail event (INDEX_EVENT_NO_DETAIL_SEQ = none)
 } IndexEvent;
 
-// Rich detail event (512 bytes)
+// No linked detail event (same value as ATF_NO_DETAIL_SEQ)
+#define INDEX_EVENT_NO_DETAIL_SEQ UINT32_MAX
+
+_Static_assert(sizeof(IndexEvent) == 32, "IndexEvent must be 32 bytes");
+_Static_assert(offsetof(IndexEvent, timestamp) == 0, "IndexEvent layout must match ATF v2");
+_Static_assert(offsetof(IndexEvent, function_id) == 8, "IndexEvent layout must match ATF v2");
+_Static_assert(offsetof(IndexEvent, thread_id) == 16, "IndexEvent layout must match ATF v2");
+_Static_assert(offsetof(IndexEvent, event_kind) == 20, "IndexEvent layout must match ATF v2");
+_Static_assert(offsetof(IndexEvent, call_depth) == 24, "IndexEvent layout must match ATF v2");
+_Static_assert(offsetof(IndexEvent, detail_seq) == 28, "IndexEvent layout must match ATF v2");
+
+// Span records replace a CALL/RETURN pair with one EVENT_KIND_SPAN event written
+// at return. timestamp is the return time, so a lane stays in time order;
+// detail_seq holds duration bits 0..31 and the top 16 bits of call_depth hold
+// bits 32..47 (longer durations saturate), leaving 16 bits of depth.
+#define INDEX_SPAN_DEPTH_MASK 0xFFFFu
+#define INDEX_SPAN_MAX_DURATION ((1ull << 48) - 1)
+
+static inline void index_event_set_span(IndexEvent* e, uint32_t depth, uint64_t duration) {
+    if (duration > INDEX_SPAN_MAX_DURATION) duration = INDEX_SPAN_MAX_DURATION;
+    if (depth > INDEX_SPAN_DEPTH_MASK) depth = INDEX_SPAN_DEPTH_MASK;
+    e->event_kind = EVENT_KIND_SPAN;
+    e->call_depth = (uint32_t)((duration >> 32) << 16) | depth;
+    e->detail_seq = (uint32_t)duration;
+}
+
+static inline uint64_t index_event_span_duration(const IndexEvent* e) {
+    return ((uint64_t)(e->call_depth >> 16) << 32) | e->detail_seq;
+}
+
+static inline uint32_t index_event_span_depth(const IndexEvent* e) {
+    return e->call_depth & INDEX_SPAN_DEPTH_MASK;
+}
+
+// Rich detail event (512 bytes); slot format of the process-global detail ring.
+// Per-thread detail lanes use the variable-length DetailRecord format below.
 typedef struct __attribute__((packed)) {
     uint64_t timestamp;
     uint64_t function_id;
@@ -88,6 +140,50 @@ typedef struct __attribute__((packed)) {
     uint8_t _padding[512 - 248];
 } DetailEvent;
 
+// Variable-length detail record (per-thread detail lanes)
+//
+// Detail lane rings are byte streams counted in DETAIL_RECORD_ALIGN units
+// (the ring's event_size). Each record is a DetailRecordHeader, a
+// DetailRecordPayload and stack_size bytes of stack, padded to the unit.
+// Header and payload are laid out like the ATF v2 DetailEventHeader and
+// DetailFunctionPayload (atf_v2_types.h), so the drain forwards the payload
+// to detail.atf straight from ring memory. A record never wraps: when it does
+// not fit before the end of the buffer the producer fills the tail with a
+// DETAIL_RECORD_SKIP marker and places the record at offset 0.
+#define DETAIL_RECORD_ALIGN      8
+#define DETAIL_RECORD_CALL       3        // ATF_DETAIL_EVENT_FUNCTION_CALL
+#define DETAIL_RECORD_RETURN     4        // ATF_DETAIL_EVENT_FUNCTION_RETURN
+#define DETAIL_RECORD_SKIP       0xFFFFu  // event_type of a wraparound marker
+#define DETAIL_RECORD_STACK_MAX  512      // Bytes of stack captured at most
+
+typedef struct __attribute__((packed)) {
+    uint32_t total_length;   // Header + payload + stack bytes, excluding padding
+    uint16_t event_type;     // DETAIL_RECORD_CALL/RETURN or DETAIL_RECORD_SKIP
+    uint16_t flags;          // Reserved
+    uint32_t call_depth;     // ATF index_seq slot; the writer assigns the real link
+    uint32_t thread_id;      // Thread identifier
+    uint64_t timestamp;      // Monotonic timestamp
+} DetailRecordHeader;
+
+typedef struct __attribute__((packed)) {
+    uint64_t function_id;    // (moduleId << 32) | symbolIndex
+    uint64_t x_regs[8];      // Argument registers on call, x_regs[0] = return value on return
+    uint64_t lr;             // Link register
+    uint64_t fp;             // Frame pointer
+    uint64_t sp;             // Stack pointer
+    uint16_t stack_size;     // Bytes of stack following the payload
+    uint16_t _reserved;
+    // uint8_t stack_snapshot[stack_size] follows
+} DetailRecordPayload;
+
+_Static_assert(sizeof(DetailRecordHeader) == 24, "DetailRecordHeader must match ATF DetailEventHeader");
+_Static_assert(sizeof(DetailRecordPayload) == 100, "DetailRecordPayload must match ATF DetailFunctionPayload");
+
+#define DETAIL_RECORD_MAX_SIZE \
+    (sizeof(DetailRecordHeader) + sizeof(DetailRecordPayload) + DETAIL_RECORD_STACK_MAX)
+#define DETAIL_RECORD_MAX_UNITS \
+    ((DETAIL_RECORD_MAX_SIZE + DETAIL_RECORD_ALIGN - 1) / DETAIL_RECORD_ALIGN)
+
 // Ring buffer header - uses plain memory for cross-language atomics
 // IMPORTANT: Access write_pos/read_pos with atomic operations, NOT directly!
 // See docs/technical_insights/ada/ATOMIC_OPERATIONS_CROSS_LANGUAGE.md
@@ -101,11 +197,13 @@ typedef struct {
 
     // Producer cache line
     ADA_ALIGNAS(CACHE_LINE_SIZE) uint32_t write_pos; // Write position (use atomic ops!)
-    uint32_t _pad_producer[15];
+    uint32_t cached_read_pos;  // v2: producer's last seen read_pos; written by producer only
+    uint32_t _pad_producer[14];
 
     // Consumer cache line
     ADA_ALIGNAS(CACHE_LINE_SIZE) uint32_t read_pos;  // Read position (use atomic ops!)
-    uint32_t _pad_consumer[15];
+    uint32_t cached_write_pos; // v2: consumer's last seen write_pos; written by consumer only
+    uint32_t _pad_consumer[14];
 
     // Metrics/cache
     uint64_t overflow_count;  // Incremented when writes occur on full buffer
@@ -139,6 +237,41 @@ typedef struct {
     ShmEntry entries[8];     // 0 = registry arena; others reserved
 } ShmDirectory;
 
+// Futex word the agent bumps when a submit queue goes empty -> non-empty,
+// letting an idle drain sleep without polling (see drain_wake.h)
+typedef struct {
+    uint32_t seq;         // Incremented on every signal; the futex value
+    uint32_t waiters;     // Drain workers currently parked on seq
+    uint64_t signal_ns;   // CLOCK_MONOTONIC of the last signal seen by a waiter
+} DrainWakeWord;
+
+// Hook timestamp source published by the controller at session start (see
+// timestamp_source.h). Counter timestamps convert to CLOCK_MONOTONIC ns as
+// ns_base + (((ticks - tick_base) * mult) >> shift).
+typedef enum {
+    TIMESTAMP_SOURCE_MONOTONIC = 0,  // clock_gettime(CLOCK_MONOTONIC) ns
+    TIMESTAMP_SOURCE_COUNTER = 1     // Invariant TSC (x86_64) / cntvct_el0 (arm64) ticks
+} TimestampSourceKind;
+
+typedef struct {
+    uint32_t source;         // TimestampSourceKind
+    uint32_t shift;          // Fixed-point shift of mult
+    uint64_t mult;           // ns per tick << shift
+    uint64_t tick_base;      // Counter value paired with ns_base
+    uint64_t ns_base;        // CLOCK_MONOTONIC ns at tick_base
+    uint64_t ticks_per_sec;  // Counter frequency
+} TimestampCalibration;
+
+// Adaptive per-function sampling thresholds (see hook_sampler.h). The
+// controller may rewrite them at any time; hooks pick them up on their
+// amortized registry mode check.
+typedef struct {
+    uint32_t enabled;              // 0 = record every call
+    uint32_t max_calls_per_sec;    // Per-function rate above which 1-in-N sampling starts
+    uint32_t max_sample_shift;     // Cap on N = 1 << shift
+    uint32_t window_ms;            // Rate window; suppressed counts are summarised per window
+} SamplingControl;
+
 // Control block for shared state
 typedef struct {
     ProcessState process_state;
@@ -148,7 +281,9 @@ typedef struct {
     uint64_t trigger_time;
     uint32_t index_lane_enabled;
     uint32_t detail_lane_enabled;
-    uint32_t capture_stack_snapshot;  // Enable 128-byte stack capture
+    uint32_t capture_stack_snapshot;  // Enable stack capture (size: ADA_STACK_CAPTURE_BYTES)
+    uint32_t index_spans;             // 1 = completed calls become EVENT_KIND_SPAN records
+    uint32_t aggregation;             // AggregationMode
     uint32_t hooks_ready;             // Agent sets to 1 when hooks are installed
     uint32_t actual_hook_count;       // Agent sets to actual hookable symbol count
 
@@ -159,6 +294,9 @@ typedef struct {
     uint32_t registry_epoch;        // Current registry epoch
     uint32_t registry_mode;         // See RegistryMode
     uint64_t drain_heartbeat_ns;    // Monotonic heartbeat from controller drain thread
+    DrainWakeWord drain_wake;       // Submit wakeup for an event-driven drain
+    TimestampCalibration timestamp; // Written before the agent starts; read-only after
+    SamplingControl sampling;       // Runtime-adjustable hot function sampling
 
     // Observability counters (best-effort)
     uint64_t mode_transitions;      // Number of mode transitions observed (agent/controller)
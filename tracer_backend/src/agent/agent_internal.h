@@ -2,9 +2,12 @@
 #define AGENT_INTERNAL_H
 
 #include <atomic>
+#include <condition_variable>
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 #include <pthread.h>
 
@@ -17,10 +20,14 @@ extern "C" {
 #include <tracer_backend/ada/thread.h>
 // Agent mode state machine (C API)
 #include <tracer_backend/utils/agent_mode.h>
+// Adaptive per-function sampling (C API)
+#include <tracer_backend/utils/hook_sampler.h>
 }
 
 // Include HookRegistry for symbol table persistence
 #include <tracer_backend/agent/hook_registry.h>
+#include <tracer_backend/agent/lazy_hooks.h>
+#include <tracer_backend/agent/shadow_stack.h>
 
 // Forward declarations for C++ classes
 namespace ada {
@@ -63,11 +70,40 @@ public:
     void record_reentrancy_attempt() { reentrancy_attempts_++; }
     uint64_t reentrancy_attempts() const { return reentrancy_attempts_; }
 
+    // Registry mode as of this thread's last amortized check
+    AgentModeCache* mode_cache() { return &mode_cache_; }
+    uint32_t registry_mode() const { return mode_cache_.mode; }
+
+    // Sampling thresholds as of the same check
+    HookSamplerConfig* sampler_config() { return &sampler_config_; }
+
+    // This thread's call tally for a hooked function's sampler (direct-mapped)
+    HookSamplerTally* sampler_tally(uint64_t function_id) {
+        uint32_t h = static_cast<uint32_t>(function_id ^ (function_id >> 32)) * 2654435761u;
+        return &sampler_tallies_[h >> (32 - kSamplerTallyBits)];
+    }
+
+    // Span mode: entries paired on this thread's shadow stack
+    bool index_spans() const { return index_spans_; }
+    void set_index_spans(bool enabled) { index_spans_ = enabled; }
+    ada::agent::ShadowStack* shadow_stack() { return &shadow_stack_; }
+
+    // AggregationMode as of the last check
+    uint32_t aggregation() const { return aggregation_; }
+    void set_aggregation(uint32_t mode) { aggregation_ = mode; }
+
 private:
     uint32_t thread_id_;
     uint32_t call_depth_;
     std::atomic<bool> in_handler_;
     uint64_t reentrancy_attempts_;
+    AgentModeCache mode_cache_;
+    HookSamplerConfig sampler_config_;
+    static constexpr uint32_t kSamplerTallyBits = 6;
+    HookSamplerTally sampler_tallies_[1u << kSamplerTallyBits];
+    bool index_spans_;
+    uint32_t aggregation_;
+    ada::agent::ShadowStack shadow_stack_;
 };
 
 // ============================================================================
@@ -80,6 +116,9 @@ struct HookData {
     std::string function_name;
     GumAddress function_address;
     GumInvocationListener* listener{};  // Keep listener alive
+    GumInvocationListener* probe{};     // Lazy mode: first-hit probe until promoted
+    uint32_t lazy_slot{};               // Lazy mode: LazyHookTracker slot
+    HookSampler sampler{};              // Adaptive rate limit, shared by all threads
 
     HookData(AgentContext* ctx, uint64_t id, const std::string& name, GumAddress addr)
         : context(ctx), function_id(id), function_name(name), function_address(addr) {}
@@ -101,6 +140,17 @@ struct HookResult {
         : name(n), address(a), id(i), success(s) {}
 };
 
+// Wall-clock breakdown of install_hooks(), reported in the hook summary
+struct HookInstallTiming {
+    uint64_t plan_ns;       // Worker pool: enumerate, filter, assign ids
+    uint64_t resolve_ns;    // Worker pool: resolve addresses missing from enumeration
+    uint64_t attach_ns;     // Serial gum_interceptor_attach calls
+    uint64_t commit_ns;     // gum_interceptor_end_transaction
+    uint64_t total_ns;
+    uint32_t modules;
+    uint32_t workers;
+};
+
 // ============================================================================
 // Shared Memory Reference (RAII wrapper)
 // ============================================================================
@@ -155,6 +205,7 @@ public:
     // Hook management
     void install_hooks();
     std::vector<HookResult> get_hook_results() const { return hook_results_; }
+    const HookInstallTiming& hook_install_timing() const { return install_timing_; }
     
     // Statistics
     uint64_t events_emitted() const { return events_emitted_.load(); }
@@ -175,7 +226,8 @@ public:
     uint32_t hooks_successful() const { return num_hooks_successful_; }
 
     // Agent mode state machine tick
-    void update_registry_mode(uint64_t now_ns, uint64_t hb_timeout_ns);
+    // Run the mode state machine; returns the control block's registry_mode
+    uint32_t update_registry_mode(uint64_t now_ns, uint64_t hb_timeout_ns);
 
     // Symbol table persistence: export hook registry as JSON for manifest
     std::string export_hook_registry_json() const { return hook_registry_.export_to_json(); }
@@ -183,6 +235,9 @@ public:
     // Access hook registry for metadata capture during hook installation
     ada::agent::HookRegistry& hook_registry() { return hook_registry_; }
 
+    // Lazy hook mode (ADA_HOOK_MODE=lazy); null tracker when hooks are eager
+    ada::agent::LazyHookTracker* lazy_tracker() { return lazy_tracker_.get(); }
+
 private:
     // Shared memory segments
     SharedMemoryRef shm_control_;
@@ -205,6 +260,7 @@ private:
     std::vector<HookResult> hook_results_;
     uint32_t num_hooks_attempted_;
     uint32_t num_hooks_successful_;
+    HookInstallTiming install_timing_;
     
     // Session info
     uint32_t host_pid_;
@@ -223,11 +279,37 @@ private:
     // Hook registry for symbol table persistence (Phase 1)
     ada::agent::HookRegistry hook_registry_;
 
+    // Lazy hook mode: probes indexed by tracker slot, promoted by a background thread
+    ada::agent::LazyHookConfig lazy_config_;
+    std::unique_ptr<ada::agent::LazyHookTracker> lazy_tracker_;
+    std::vector<HookData*> lazy_hooks_;
+    std::thread lazy_promoter_;
+    std::mutex lazy_mutex_;
+    std::condition_variable lazy_cv_;
+    bool lazy_stop_;
+    uint32_t lazy_attach_failures_;     // Promoter only
+
+    // Housekeeping tick: publishes what quiet threads and functions left
+    // pending (staged index batches, sampler summaries)
+    std::thread tick_thread_;
+    std::mutex tick_mutex_;
+    std::condition_variable tick_cv_;
+    bool tick_stop_;
+    uint32_t tick_interval_ms_;
+    uint64_t last_sampler_flush_;       // Tick thread only
+
     // Helper methods
     bool open_shared_memory();
     bool attach_ring_buffers();
     void hook_function(const char* name);
     void send_hook_summary();
+    GumAttachReturn attach_hook(HookData* hook_ptr);
+    void promote_lazy_hooks();
+    void run_lazy_promoter();
+    void stop_lazy_promoter();
+    void run_tick();
+    void stop_tick();
+    void flush_sampler_summaries(bool force);
 };
 
 // ============================================================================
@@ -247,9 +329,12 @@ ThreadLocalData* get_thread_local();
 // Hash function for stable function IDs
 uint32_t hash_string(const char* str);
 
-// Platform-specific timestamp
+// Hook timestamp in the session's source units (ns or calibrated counter ticks)
 uint64_t platform_get_timestamp();
 
+// Convert a platform_get_timestamp() value to CLOCK_MONOTONIC ns
+uint64_t platform_timestamp_to_ns(uint64_t timestamp);
+
 // Safe stack capture with signal handling
 size_t safe_stack_capture(void* dest, void* stack_ptr, size_t max_size);
 
@@ -6,6 +6,10 @@ extern "C" {
 }
 
 #include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <thread>
+#include <unordered_set>
 
 namespace ada {
 namespace agent {
@@ -21,13 +25,22 @@ std::vector<HookPlanEntry> plan_module_hooks(
     AdaExcludeList* excludes,
     HookRegistry& registry) {
 
-    std::vector<HookPlanEntry> out;
-    out.reserve(exports.size());
+    std::vector<std::string> names;
+    names.reserve(exports.size());
     for (const auto& sym : exports) {
         if (sym.empty()) continue;
         if (is_excluded(excludes, sym)) continue;
-        uint64_t id = registry.register_symbol(module_path, sym);
-        out.push_back(HookPlanEntry{sym, id});
+        names.push_back(sym);
+    }
+
+    // Register the whole module in one pass
+    std::vector<uint64_t> ids;
+    registry.register_module_symbols(module_path, names, &ids);
+
+    std::vector<HookPlanEntry> out;
+    out.reserve(names.size());
+    for (size_t i = 0; i < names.size(); ++i) {
+        out.push_back(HookPlanEntry{std::move(names[i]), ids[i]});
     }
     return out;
 }
@@ -54,6 +67,100 @@ std::vector<HookPlanEntry> plan_comprehensive_hooks(
     return all;
 }
 
+bool is_address_in_ranges(uint64_t address, const std::vector<HookAddressRange>& ranges) {
+    for (const auto& range : ranges) {
+        if (address >= range.start && address < range.end) return true;
+    }
+    return false;
+}
+
+std::vector<ResolvedHookEntry> plan_module_symbols(
+    const ModuleSymbols& module,
+    size_t symbol_limit,
+    AdaExcludeList* excludes,
+    HookRegistry& registry) {
+
+    std::vector<std::string> names;
+    std::vector<uint64_t> addresses;
+    names.reserve(module.names.size());
+    addresses.reserve(module.names.size());
+    std::unordered_set<std::string> seen;
+    seen.reserve(module.names.size());
+    for (size_t i = 0; i < module.names.size(); ++i) {
+        if (symbol_limit != 0 && names.size() >= symbol_limit) break;
+        if (!seen.insert(module.names[i]).second) continue;
+        names.push_back(module.names[i]);
+        addresses.push_back(i < module.addresses.size() ? module.addresses[i] : 0);
+    }
+
+    // plan_module_hooks() preserves order, so walk both lists together
+    auto plan = plan_module_hooks(module.path, names, excludes, registry);
+    std::vector<ResolvedHookEntry> out;
+    out.reserve(plan.size());
+    size_t j = 0;
+    for (auto& entry : plan) {
+        while (names[j] != entry.symbol) ++j;
+        uint64_t address = addresses[j++];
+        bool stub = address != 0 && is_address_in_ranges(address, module.stub_ranges);
+        out.push_back(ResolvedHookEntry{std::move(entry.symbol), entry.function_id, address, stub});
+    }
+    return out;
+}
+
+void resolve_hook_addresses(
+    std::vector<ResolvedHookEntry>& hooks,
+    const std::vector<HookAddressRange>& stub_ranges,
+    const std::function<uint64_t(const std::string&)>& resolve,
+    size_t workers) {
+
+    std::vector<size_t> pending;
+    for (size_t i = 0; i < hooks.size(); ++i) {
+        if (hooks[i].address == 0) pending.push_back(i);
+    }
+    if (pending.empty() || !resolve) return;
+
+    const size_t kChunk = 256;
+    size_t chunks = (pending.size() + kChunk - 1) / kChunk;
+    run_hook_plan_tasks(chunks, std::min(workers, chunks), [&](size_t c) {
+        size_t end = std::min(pending.size(), (c + 1) * kChunk);
+        for (size_t k = c * kChunk; k < end; ++k) {
+            ResolvedHookEntry& hook = hooks[pending[k]];
+            hook.address = resolve(hook.symbol);
+            hook.stub = hook.address != 0 && is_address_in_ranges(hook.address, stub_ranges);
+        }
+    });
+}
+
+size_t hook_plan_worker_count(size_t tasks) {
+    size_t workers = std::thread::hardware_concurrency();
+    if (workers > 8) workers = 8;
+    const char* env = getenv("ADA_HOOK_PLAN_WORKERS");
+    if (env && env[0] != '\0') {
+        char* end = nullptr;
+        long value = strtol(env, &end, 10);
+        if (end != env && value > 0) workers = static_cast<size_t>(value);
+    }
+    if (workers > tasks) workers = tasks;
+    return workers == 0 ? 1 : workers;
+}
+
+void run_hook_plan_tasks(size_t count, size_t workers,
+                         const std::function<void(size_t)>& task) {
+    std::atomic<size_t> next{0};
+    auto worker = [&]() {
+        for (size_t i = next.fetch_add(1, std::memory_order_relaxed); i < count;
+             i = next.fetch_add(1, std::memory_order_relaxed)) {
+            task(i);
+        }
+    };
+    std::vector<std::thread> threads;
+    for (size_t w = 1; w < workers && w < count; ++w) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& t : threads) t.join();
+}
+
 } // namespace agent
 } // namespace ada
 
@@ -1,6 +1,7 @@
 #include "agent_internal.h"
 
 // C++ headers
+#include <chrono>
 #include <cstring>
 #include <cstdlib>
 #include <csignal>
@@ -33,6 +34,11 @@ extern "C" {
 #include <tracer_backend/utils/thread_registry.h>
 // Ring pool for swap-on-overflow
 #include <tracer_backend/utils/ring_pool.h>
+#include <tracer_backend/utils/drain_wake.h>
+#include <tracer_backend/utils/stack_capture.h>
+#include <tracer_backend/utils/timestamp_source.h>
+#include <tracer_backend/utils/control_block_ipc.h>
+#include <tracer_backend/utils/aggregate_table.h>
 // SHM directory mapping helpers (M1_E1_I8)
 #include <tracer_backend/utils/shm_directory.h>
 #include <tracer_backend/metrics/thread_metrics.h>
@@ -47,6 +53,7 @@ extern "C" {
 #include <tracer_backend/agent/module_uuid.h>
 #include <tracer_backend/agent/swift_detection.h>
 #include <tracer_backend/agent/debug_dylib_detection.h>
+#include <tracer_backend/agent/lazy_hooks.h>
 
 // #define ADA_MINIMAL_HOOKS 1  // Disabled to enable full event capture
 
@@ -54,6 +61,7 @@ extern "C" {
 extern "C" {
 void on_enter_callback(GumInvocationContext* ic, gpointer user_data);
 void on_leave_callback(GumInvocationContext* ic, gpointer user_data);
+void on_probe_hit_callback(GumInvocationContext* ic, gpointer user_data);
 
 __attribute__((visibility("default")))
 void agent_init(const gchar* data, gint data_size);
@@ -147,8 +155,14 @@ static uint32_t g_host_pid = UINT32_MAX;
 static uint32_t g_session_id = UINT32_MAX;
 static char g_exclude_csv[256] = {0};
 
+// Bytes of stack copied into detail records when capture is enabled
+static uint32_t g_stack_capture_bytes = STACK_CAPTURE_DEFAULT_BYTES;
 
-static volatile sig_atomic_t g_segfault_occurred = 0;
+// Hook timestamp source; copied from the control block at initialization
+static TimestampCalibration g_timestamp = {TIMESTAMP_SOURCE_MONOTONIC, 0, 1, 0, 0, 1000000000ull};
+
+// Spacing of full registry mode checks, in hook timestamp units
+static uint64_t g_mode_check_interval = AGENT_MODE_CHECK_INTERVAL_NS;
 
 // ============================================================================
 // ThreadLocalData Implementation
@@ -157,7 +171,12 @@ static volatile sig_atomic_t g_segfault_occurred = 0;
 ThreadLocalData::ThreadLocalData() 
     : call_depth_(0)
     , in_handler_(false)
-    , reentrancy_attempts_(0) {
+    , reentrancy_attempts_(0)
+    , mode_cache_{}
+    , sampler_config_{}
+    , sampler_tallies_{}
+    , index_spans_(false)
+    , aggregation_(AGGREGATION_OFF) {
 #ifdef __APPLE__
     thread_id_ = pthread_mach_thread_np(pthread_self());
 #else
@@ -174,6 +193,10 @@ HookData::~HookData() {
         g_object_unref(listener);
         listener = nullptr;
     }
+    if (probe) {
+        g_object_unref(probe);
+        probe = nullptr;
+    }
 }
 
 // ============================================================================
@@ -255,13 +278,20 @@ AgentContext::AgentContext()
     , interceptor_(nullptr)
     , num_hooks_attempted_(0)
     , num_hooks_successful_(0)
+    , install_timing_{}
     , host_pid_(0)
     , session_id_(0)
     , module_base_(0)
     , events_emitted_(0)
     , reentrancy_blocked_(0)
     , stack_capture_failures_(0)
-    , agent_mode_state_{} {
+    , agent_mode_state_{}
+    , lazy_config_{}
+    , lazy_stop_(false)
+    , lazy_attach_failures_(0)
+    , tick_stop_(false)
+    , tick_interval_ms_(SAMPLING_DEFAULT_WINDOW_MS)
+    , last_sampler_flush_(0) {
     // Initialize agent mode to GLOBAL_ONLY by default
     agent_mode_state_.mode = REGISTRY_MODE_GLOBAL_ONLY;
     agent_mode_state_.transitions = 0;
@@ -293,6 +323,8 @@ static void wait_for_debugger() {
 
 AgentContext::~AgentContext() {
     g_agent_shutting_down = true;
+    stop_lazy_promoter();
+    stop_tick();
     
     LOG_LIFECYCLE("[Agent] Shutting down (emitted=%llu events, blocked=%llu reentrancy)\n",
             static_cast<unsigned long long>(events_emitted_.load()),
@@ -305,6 +337,9 @@ AgentContext::~AgentContext() {
             static_cast<unsigned long long>(reentrancy_blocked_.load()),
             static_cast<unsigned long long>(stack_capture_failures_.load()));
     
+    // The control block is unmapped with shm_control_ below
+    drain_wake_bind_producer(nullptr);
+
     // Interceptor is cleaned up by unique_ptr
     // Ring buffers and shared memory are cleaned up by destructors
     LOG_LIFECYCLE("[Agent] AgentContext did destruct\n");
@@ -379,6 +414,16 @@ bool AgentContext::open_shared_memory() {
     // Map SHM directory bases (if published)
     if (control_block_) {
         (void)shm_dir_map_local_bases(&control_block_->shm_directory);
+        // Ring pools signal the controller's drain on empty -> non-empty submits
+        drain_wake_bind_producer(&control_block_->drain_wake);
+        if (control_block_->timestamp.source <= TIMESTAMP_SOURCE_COUNTER &&
+            control_block_->timestamp.mult != 0) {
+            g_timestamp = control_block_->timestamp;
+        }
+        LOG_LIFECYCLE("[Agent] Timestamp source: %s\n",
+                      g_timestamp.source == TIMESTAMP_SOURCE_COUNTER ? "counter" : "monotonic");
+        g_mode_check_interval =
+            timestamp_source_duration_from_ns(&g_timestamp, AGENT_MODE_CHECK_INTERVAL_NS);
     }
 
     // Read registry_mode from controller (do NOT overwrite it)
@@ -394,8 +439,8 @@ bool AgentContext::open_shared_memory() {
         if (env[0] != '\0' && env[0] != '0') disable_registry = true;
     }
     if (!disable_registry) {
-        size_t registry_size = thread_registry_calculate_memory_size_with_capacity(MAX_THREADS);
-        auto reg_c = shared_memory_open_unique("registry", host_pid_, session_id_, registry_size);
+        // Size 0 maps the whole segment: the controller picks the registry capacity
+        auto reg_c = shared_memory_open_unique("registry", host_pid_, session_id_, 0);
 
         // Unconditional diagnostic logging for registry status
         LOG_LIFECYCLE("[Agent] Registry shm open: %s (host_pid=%u, session_id=0x%08x)\n",
@@ -424,6 +469,34 @@ bool AgentContext::open_shared_memory() {
         LOG_LIFECYCLE("[Agent] Registry disabled by ADA_DISABLE_REGISTRY\n");
     }
 
+    // Producer-side index batching: stage N events per thread, publish in bulk
+    if (const char* env = getenv("ADA_INDEX_BATCH")) {
+        uint64_t max_age_us = 1000; // Bounds staging delay for slow call paths
+        if (const char* age = getenv("ADA_INDEX_BATCH_MAX_AGE_US")) {
+            max_age_us = strtoull(age, nullptr, 10);
+        }
+        // Staging age is compared between event timestamps
+        ada_tls_set_index_batching(static_cast<uint32_t>(strtoul(env, nullptr, 10)),
+                                   timestamp_source_duration_from_ns(&g_timestamp, max_age_us * 1000ull));
+        LOG_LIFECYCLE("[Agent] Index batching: batch=%u, max_age_us=%llu\n",
+                      ada_tls_get_index_batch(), (unsigned long long)max_age_us);
+        // Sweep quiet threads' batches at the age bound (1 ms .. one sampling window)
+        if (ada_tls_get_index_batch() > 0) {
+            uint64_t interval_ms = max_age_us / 1000;
+            tick_interval_ms_ = static_cast<uint32_t>(
+                interval_ms < 1 ? 1
+                                : (interval_ms > tick_interval_ms_ ? tick_interval_ms_ : interval_ms));
+        }
+    }
+
+    // Stack snapshot size for detail events (capture itself is gated by the control block)
+    if (const char* env = getenv("ADA_STACK_CAPTURE_BYTES")) {
+        unsigned long bytes = strtoul(env, nullptr, 10);
+        g_stack_capture_bytes = static_cast<uint32_t>(
+            bytes < DETAIL_RECORD_STACK_MAX ? bytes : DETAIL_RECORD_STACK_MAX);
+        LOG_LIFECYCLE("[Agent] Stack capture size: %u bytes\n", g_stack_capture_bytes);
+    }
+
     return true;
 }
 
@@ -565,15 +638,6 @@ static bool module_has_swift_sections(GumModule* mod) {
     return scan.has_swift;
 }
 
-static bool is_stub_address(GumAddress addr, const std::vector<SectionRange>& ranges) {
-    for (const auto& range : ranges) {
-        if (addr >= range.start && addr < range.end) {
-            return true;
-        }
-    }
-    return false;
-}
-
 static bool is_text_section(const GumSymbolSection* section) {
     if (section == nullptr || section->id == nullptr) {
         return false;
@@ -692,13 +756,6 @@ static size_t main_symbol_limit() {
     return static_cast<size_t>(value);
 }
 
-static void cap_symbol_names(std::vector<std::string>& names, size_t limit) {
-    if (limit == 0) return;
-    if (names.size() > limit) {
-        names.resize(limit);
-    }
-}
-
 // Resolve an export's actual runtime address with platform quirks handled
 static GumAddress resolve_export_address(GumModule* mod, const std::string& sym) {
     if (mod == nullptr || sym.empty()) return 0;
@@ -780,8 +837,13 @@ void AgentContext::install_hooks() {
         g_object_unref(map);
     }
 
-    gum_interceptor_begin_transaction(interceptor_.get());
+    const uint64_t install_start_ns = timestamp_source_monotonic_ns();
     g_is_installing_hooks.store(true);
+    lazy_config_ = ada::agent::lazy_hook_config_from_env();
+    if (lazy_config_.enabled) {
+        LOG_HOOK_INSTALL("[Agent] Lazy hook mode: probes first, promotion budget=%u\n",
+                         lazy_config_.budget);
+    }
     LOG_HOOK_INSTALL("[Agent] Beginning comprehensive hook installation...\n");
 
     // Registry assigns per-module stable IDs (using member hook_registry_)
@@ -826,243 +888,203 @@ void AgentContext::install_hooks() {
     }
 #endif
 
-    std::vector<SymbolEntry> main_symbol_entries;
+    // Modules to plan: the (effective) main module first, then DSOs
+    struct ModuleTask {
+        GumModule* mod;
+        bool is_main;
+        ada::agent::ModuleSymbols symbols;
+        std::vector<ada::agent::ResolvedHookEntry> plan;
+    };
+    std::vector<ModuleTask> tasks;
     if (effective_mod) {
-        // Check if ADA_HOOK_SWIFT=0 (escape hatch to force exports-only mode)
-        // Default behavior: enumerate all symbols (Swift functions included)
-        // Stub addresses are filtered at hook installation time
-        const char* hook_swift_env = getenv("ADA_HOOK_SWIFT");
-        const bool force_exports_only = (hook_swift_env && hook_swift_env[0] == '0');
+        tasks.push_back(ModuleTask{effective_mod, true, {}, {}});
+    }
 
-        if (force_exports_only) {
-            std::vector<ExportEntry> main_exports;
-            gum_module_enumerate_exports(effective_mod, collect_exports_cb, &main_exports);
-            for (const auto& entry : main_exports) {
-                // ExportEntry doesn't have address, use 0 (will fallback to resolve_export_address)
-                main_symbol_entries.push_back(SymbolEntry{entry.name, 0});
-            }
-            if (ada::internal::g_agent_verbose) {
-                LOG_HOOK_INSTALL("[Agent] ADA_HOOK_SWIFT=0; using exports-only plan (%zu symbols)\n",
-                                 main_symbol_entries.size());
+    // Enumerate all modules and hook DSOs (excluding main module)
+    // Check if we should skip DSO hooking for testing
+    bool skip_dso_hooks = false;
+    const char* skip_env = getenv("ADA_SKIP_DSO_HOOKS");
+    if (skip_env && skip_env[0] == '1') {
+        skip_dso_hooks = true;
+        LOG_HOOK_INSTALL("[Agent] Skipping DSO hooks as requested by ADA_SKIP_DSO_HOOKS=1\n");
+    }
+
+    // Module map stays alive until attach has finished with its modules
+    GumModuleMap* map = skip_dso_hooks ? nullptr : gum_module_map_new();
+    if (map) {
+        GPtrArray* mods = gum_module_map_get_values(map);
+        for (guint i = 0; mods && i < mods->len; i++) {
+            GumModule* mod = static_cast<GumModule*>(g_ptr_array_index(mods, i));
+
+            const char* path = gum_module_get_path(mod);
+
+            if (mod == main_mod || mod == effective_mod) {
+                // Main module (or debug dylib if redirected) is planned above
+                continue;
             }
-        } else {
-            gum_module_enumerate_symbols(effective_mod, collect_symbols_cb, &main_symbol_entries);
+
+            // Skip non-main modules for now. We only install hooks to the main module.
+            // TODO: Consider hooking DSO functions with system semantics later.
+            LOG_HOOK_INSTALL("[Agent] Skipping install hooks to non-main module: %s\n", path);
+            continue;
+
+            if (!path || path[0] == '\0') continue;
+            tasks.push_back(ModuleTask{mod, false, {}, {}});
+        }
+    }
+
+    // Check if ADA_HOOK_SWIFT=0 (escape hatch to force exports-only mode)
+    // Default behavior: enumerate all symbols (Swift functions included)
+    // Stub addresses are filtered at planning time
+    const char* hook_swift_env = getenv("ADA_HOOK_SWIFT");
+    const bool force_exports_only = (hook_swift_env && hook_swift_env[0] == '0');
+    const size_t symbol_limit = main_symbol_limit();
+
+    // Plan every module on the worker pool: enumeration, stub ranges, module
+    // metadata, exclude filtering and function id assignment. Nothing here
+    // touches the interceptor.
+    const size_t workers = ada::agent::hook_plan_worker_count(tasks.size());
+    uint64_t phase_start_ns = timestamp_source_monotonic_ns();
+    ada::agent::run_hook_plan_tasks(tasks.size(), workers, [&](size_t t) {
+        ModuleTask& task = tasks[t];
+        const char* path = task.is_main ? effective_path : gum_module_get_path(task.mod);
+        ada::agent::ModuleSymbols& symbols = task.symbols;
+        symbols.path = path ? path : "<main>";
+
+        std::vector<SymbolEntry> entries;
+        if (task.is_main && !force_exports_only) {
+            gum_module_enumerate_symbols(task.mod, collect_symbols_cb, &entries);
 
             // Fallback to exports if symbol enumeration returns empty.
             // This happens with Xcode debug dylibs where gum_module_enumerate_symbols
             // cannot read the symbol table, but exports are still accessible.
-            if (main_symbol_entries.empty()) {
+            if (entries.empty()) {
                 std::vector<ExportEntry> fallback_exports;
-                gum_module_enumerate_exports(effective_mod, collect_exports_cb, &fallback_exports);
-                for (const auto& entry : fallback_exports) {
-                    main_symbol_entries.push_back(SymbolEntry{entry.name, 0});
+                gum_module_enumerate_exports(task.mod, collect_exports_cb, &fallback_exports);
+                for (auto& entry : fallback_exports) {
+                    entries.push_back(SymbolEntry{std::move(entry.name), 0});
                 }
                 LOG_HOOK_INSTALL("[Agent] Symbol enumeration empty, using exports fallback (%zu symbols)\n",
-                                 main_symbol_entries.size());
-            }
-
-            if (ada::internal::g_agent_verbose) {
+                                 entries.size());
+            } else if (ada::internal::g_agent_verbose) {
                 LOG_HOOK_INSTALL("[Agent] Enumerating all symbols (Swift included): %zu symbols\n",
-                                 main_symbol_entries.size());
+                                 entries.size());
+            }
+        } else {
+            // Exports carry no address; resolve_export_address() fills it in later
+            std::vector<ExportEntry> exports;
+            gum_module_enumerate_exports(task.mod, collect_exports_cb, &exports);
+            for (auto& entry : exports) {
+                entries.push_back(SymbolEntry{std::move(entry.name), 0});
+            }
+            if (task.is_main && ada::internal::g_agent_verbose) {
+                LOG_HOOK_INSTALL("[Agent] ADA_HOOK_SWIFT=0; using exports-only plan (%zu symbols)\n",
+                                 entries.size());
             }
         }
+        if (!task.is_main && entries.empty()) return;
+
+        symbols.names.reserve(entries.size());
+        symbols.addresses.reserve(entries.size());
+        for (auto& e : entries) {
+            symbols.names.push_back(std::move(e.name));
+            symbols.addresses.push_back(e.address);
+        }
 
         // Capture module metadata for symbol resolution (Phase 1 - symbol table persistence)
-        const GumMemoryRange* range = gum_module_get_range(effective_mod);
-        if (range && effective_path) {
+        const GumMemoryRange* range = gum_module_get_range(task.mod);
+        if (range && path) {
             uint8_t uuid[16] = {0};
             ada::agent::extract_module_uuid(static_cast<uintptr_t>(range->base_address), uuid);
-            hook_registry_.set_module_metadata(effective_path, range->base_address, range->size, uuid);
-            LOG_HOOK_INSTALL("[Agent] Captured main module metadata: base=0x%llx, size=%zu\n",
-                    (unsigned long long)range->base_address, (size_t)range->size);
-        }
-    }
-    std::vector<SectionRange> main_stub_ranges;
-    if (effective_mod) {
-        gum_module_enumerate_sections(effective_mod, collect_stub_sections_cb, &main_stub_ranges);
-        if (ada::internal::g_agent_verbose && !main_stub_ranges.empty()) {
-            LOG_HOOK_INSTALL("[Agent] Collected %zu stub ranges for main module\n",
-                             main_stub_ranges.size());
-        }
-    }
-    std::vector<std::string> main_symbol_names;
-    main_symbol_names.reserve(main_symbol_entries.size());
-    std::unordered_set<std::string> seen_symbols;
-    // Build enumerated_addresses map to preserve addresses from enumeration
-    // This is critical for local/non-exported Swift symbols
-    std::unordered_map<std::string, GumAddress> enumerated_addresses;
-    enumerated_addresses.reserve(main_symbol_entries.size());
-    for (auto& e : main_symbol_entries) {
-        if (seen_symbols.insert(e.name).second) {
-            main_symbol_names.push_back(e.name);
-            enumerated_addresses.emplace(e.name, e.address);
+            hook_registry_.set_module_metadata(path, range->base_address, range->size, uuid);
+            LOG_HOOK_INSTALL("[Agent] Captured module metadata: %s base=0x%llx, size=%zu\n",
+                    path, (unsigned long long)range->base_address, (size_t)range->size);
         }
-    }
-    size_t symbol_limit = main_symbol_limit();
-    cap_symbol_names(main_symbol_names, symbol_limit);
-
-    // Plan main hooks
-    auto main_plan = ada::agent::plan_module_hooks(effective_path ? effective_path : "<main>", main_symbol_names, xs, hook_registry_);
-
-    // Build precise address lookup for main module
-    // First use addresses from enumeration (works for local/internal symbols)
-    // Fall back to resolve_export_address for exports-only mode
-    std::unordered_map<std::string, GumAddress> main_addr;
-    main_addr.reserve(main_plan.size());
-    for (const auto& entry : main_plan) {
-        GumAddress a = 0;
 
-        // First: use address from enumeration (works for local symbols)
-        auto enum_it = enumerated_addresses.find(entry.symbol);
-        if (enum_it != enumerated_addresses.end() && enum_it->second != 0) {
-            a = enum_it->second;
-        } else {
-            // Fallback: export/symbol lookup (for exports-only mode)
-            a = resolve_export_address(effective_mod, entry.symbol);
-        }
-
-        if (ada::internal::g_agent_verbose) {
-            LOG_HOOK_INSTALL("[Agent] Resolved main symbol %s -> 0x%llx\n",
-                             entry.symbol.c_str(), (unsigned long long)a);
+        if (task.is_main) {
+            std::vector<SectionRange> stub_ranges;
+            gum_module_enumerate_sections(task.mod, collect_stub_sections_cb, &stub_ranges);
+            for (const auto& r : stub_ranges) {
+                symbols.stub_ranges.push_back(ada::agent::HookAddressRange{r.start, r.end});
+            }
+            if (ada::internal::g_agent_verbose && !stub_ranges.empty()) {
+                LOG_HOOK_INSTALL("[Agent] Collected %zu stub ranges for main module\n",
+                                 stub_ranges.size());
+            }
         }
-        main_addr.emplace(entry.symbol, a);
-    }
 
-    // Hook planned symbols in main module
-    LOG_HOOK_INSTALL("[Agent] Main module has %zu planned hooks (symbol_limit=%zu)\n",
-                     main_plan.size(), symbol_limit);
-
-    for (const auto& entry : main_plan) {
-        const auto it = main_addr.find(entry.symbol);
-        num_hooks_attempted_++;
-        if (it != main_addr.end() && it->second != 0) {
-            if (is_stub_address(it->second, main_stub_ranges)) {
+        task.plan = ada::agent::plan_module_symbols(symbols, task.is_main ? symbol_limit : 0,
+                                                    xs, hook_registry_);
+    });
+    install_timing_.plan_ns = timestamp_source_monotonic_ns() - phase_start_ns;
+
+    // Resolve addresses enumeration did not provide (exports-only mode, DSOs),
+    // chunked across the same number of workers
+    phase_start_ns = timestamp_source_monotonic_ns();
+    for (ModuleTask& task : tasks) {
+        GumModule* mod = task.mod;
+        ada::agent::resolve_hook_addresses(
+            task.plan, task.symbols.stub_ranges,
+            [mod](const std::string& sym) { return resolve_export_address(mod, sym); },
+            ada::agent::hook_plan_worker_count(task.plan.size()));
+    }
+    install_timing_.resolve_ns = timestamp_source_monotonic_ns() - phase_start_ns;
+    install_timing_.modules = static_cast<uint32_t>(tasks.size());
+    install_timing_.workers = static_cast<uint32_t>(workers);
+
+    // Attach serially inside a single interceptor transaction
+    phase_start_ns = timestamp_source_monotonic_ns();
+    gum_interceptor_begin_transaction(interceptor_.get());
+    for (const ModuleTask& task : tasks) {
+        LOG_HOOK_INSTALL("[Agent] %s has %zu planned hooks (symbol_limit=%zu)\n",
+                         task.symbols.path.c_str(), task.plan.size(), task.is_main ? symbol_limit : 0);
+
+        for (const auto& entry : task.plan) {
+            num_hooks_attempted_++;
+            if (entry.address == 0) {
+                hook_results_.emplace_back(entry.symbol, 0, entry.function_id, false);
+                continue;
+            }
+            if (entry.stub) {
                 if (ada::internal::g_agent_verbose) {
                     LOG_HOOK_INSTALL("[Agent] Skipping stub symbol: %s at 0x%lx\n",
-                                     entry.symbol.c_str(), (unsigned long)it->second);
+                                     entry.symbol.c_str(), (unsigned long)entry.address);
                 }
-                hook_results_.emplace_back(entry.symbol, it->second, entry.function_id, false);
+                hook_results_.emplace_back(entry.symbol, entry.address, entry.function_id, false);
                 continue;
             }
-            LOG_HOOK_INSTALL("[Agent] Hooking main symbol: %s at 0x%lx\n", entry.symbol.c_str(), (unsigned long)it->second);
-
-            // Verify the address looks valid
-            LOG_HOOK_INSTALL("[Agent] Creating hook for %s, function_id=%llu\n", entry.symbol.c_str(), (unsigned long long)entry.function_id);
+            LOG_HOOK_INSTALL("[Agent] Hooking symbol: %s at 0x%lx, function_id=%llu\n",
+                             entry.symbol.c_str(), (unsigned long)entry.address,
+                             (unsigned long long)entry.function_id);
 
-            auto hook = std::make_unique<HookData>(this, entry.function_id, entry.symbol, it->second);
+            auto hook = std::make_unique<HookData>(this, entry.function_id, entry.symbol, entry.address);
             hooks_.push_back(std::move(hook));
             HookData* hook_ptr = hooks_.back().get();  // Get pointer after moving into vector
 
-            LOG_HOOK_INSTALL("[Agent] Creating listener with callbacks: on_enter=%p, on_leave=%p, data=%p\n",
-                    (void*)on_enter_callback, (void*)on_leave_callback, (void*)hook_ptr);
-
-            GumInvocationListener* listener = gum_make_call_listener(on_enter_callback, on_leave_callback, hook_ptr, nullptr);
-
-            LOG_HOOK_INSTALL("[Agent] Created listener: %p\n", listener);
-
-            hook_ptr->listener = listener;  // Store listener to keep it alive
-
-            GumAttachReturn ret = gum_interceptor_attach(interceptor_.get(), GSIZE_TO_POINTER(it->second), listener, nullptr, GUM_ATTACH_FLAGS_NONE);
+            GumAttachReturn ret;
+            if (lazy_config_.enabled) {
+                // Enter-only probe; the promoter installs the full hook on first hit
+                hook_ptr->lazy_slot = static_cast<uint32_t>(lazy_hooks_.size());
+                hook_ptr->probe = gum_make_probe_listener(on_probe_hit_callback, hook_ptr, nullptr);
+                ret = gum_interceptor_attach(interceptor_.get(), GSIZE_TO_POINTER(entry.address), hook_ptr->probe, nullptr, GUM_ATTACH_FLAGS_NONE);
+                if (ret == GUM_ATTACH_OK) lazy_hooks_.push_back(hook_ptr);
+            } else {
+                ret = attach_hook(hook_ptr);
+            }
             if (ret == GUM_ATTACH_OK) {
                 LOG_HOOK_INSTALL("[Agent] Successfully attached hook to %s\n", entry.symbol.c_str());
-                hook_results_.emplace_back(entry.symbol, it->second, entry.function_id, true);
+                hook_results_.emplace_back(entry.symbol, entry.address, entry.function_id, true);
                 num_hooks_successful_++;
             } else {
                 LOG_HOOK_INSTALL("[Agent] Failed to attach hook to %s (error: %d)\n", entry.symbol.c_str(), ret);
-                hook_results_.emplace_back(entry.symbol, it->second, entry.function_id, false);
+                hook_results_.emplace_back(entry.symbol, entry.address, entry.function_id, false);
             }
-        } else {
-            hook_results_.emplace_back(entry.symbol, 0, entry.function_id, false);
         }
     }
-
-    // Enumerate all modules and hook DSOs (excluding main module)
-    // Check if we should skip DSO hooking for testing
-    bool skip_dso_hooks = false;
-    const char* skip_env = getenv("ADA_SKIP_DSO_HOOKS");
-    if (skip_env && skip_env[0] == '1') {
-        skip_dso_hooks = true;
-        LOG_HOOK_INSTALL("[Agent] Skipping DSO hooks as requested by ADA_SKIP_DSO_HOOKS=1\n");
-    }
-
-    GumModuleMap* map = skip_dso_hooks ? nullptr : gum_module_map_new();
-    if (map) {
-        GPtrArray* mods = gum_module_map_get_values(map);
-        for (guint i = 0; mods && i < mods->len; i++) {
-            LOG_HOOK_INSTALL("[Agent] Install hooks to module at index %u/%u\n", i, mods->len);
-            GumModule* mod = static_cast<GumModule*>(g_ptr_array_index(mods, i));
-            
-            const char* path = gum_module_get_path(mod);
-            
-            if (mod == main_mod || mod == effective_mod) {
-                // Main module (or debug dylib if redirected) already processed above
-                continue;
-            }
-
-            // Skip non-main modules for now. We only install hooks to the main module.
-            // TODO: Consider hooking DSO functions with system semantics later.
-            LOG_HOOK_INSTALL("[Agent] Skipping install hooks to non-main module: %s\n", path);
-            continue;
-            
-            LOG_HOOK_INSTALL("[Agent] Install hooks to module %s\n", path ? path : "(unknown)");
-            if (!path || path[0] == '\0') continue;
-            std::vector<ExportEntry> exps;
-            gum_module_enumerate_exports(mod, collect_exports_cb, &exps);
-            if (exps.empty()) continue;
-
-            // Capture DSO module metadata for symbol resolution
-            const GumMemoryRange* dso_range = gum_module_get_range(mod);
-            if (dso_range) {
-                uint8_t dso_uuid[16] = {0};
-                ada::agent::extract_module_uuid(static_cast<uintptr_t>(dso_range->base_address), dso_uuid);
-                hook_registry_.set_module_metadata(path, dso_range->base_address, dso_range->size, dso_uuid);
-                LOG_HOOK_INSTALL("[Agent] Captured DSO module metadata: %s base=0x%llx, size=%zu\n",
-                        path, (unsigned long long)dso_range->base_address, (size_t)dso_range->size);
-            }
-
-            std::vector<std::string> names; names.reserve(exps.size());
-            std::unordered_map<std::string, GumAddress> addr;
-            for (auto& e : exps) {
-                names.push_back(e.name);
-                GumAddress a = resolve_export_address(mod, e.name);
-                if (ada::internal::g_agent_verbose) {
-                    // LOG_HOOK_INSTALL("[Agent] Resolved DSO export %s -> 0x%llx\n", e.name.c_str(), (unsigned long long)a); // Moved into resolve_export_address
-                }
-                addr.emplace(e.name, a);
-            }
-            auto plan = ada::agent::plan_module_hooks(path, names, xs, hook_registry_);
-            [[maybe_unused]] int32_t plan_index = 0;
-            for (const auto& pe : plan) {
-                LOG_HOOK_INSTALL("[Agent] (%d/%zu) Will attach DSO hook to %s\n", plan_index, plan.size(), pe.symbol.c_str());
-                num_hooks_attempted_++;
-                auto it = addr.find(pe.symbol);
-                if (it != addr.end() && it->second != 0) {
-                    auto hook = std::make_unique<HookData>(this, pe.function_id, pe.symbol, it->second);
-                    hooks_.push_back(std::move(hook));
-                    HookData* hook_ptr = hooks_.back().get();  // Get pointer after moving into vector
-                    LOG_HOOK_INSTALL("[Agent] (%d/%zu) Will make call listener for %s\n", plan_index, plan.size(), pe.symbol.c_str());
-                    GumInvocationListener* listener = gum_make_call_listener(on_enter_callback, on_leave_callback, hook_ptr, nullptr);
-                    hook_ptr->listener = listener;  // Store listener to keep it alive
-                    LOG_HOOK_INSTALL("[Agent] (%d/%zu) Will attach interceptor for %s\n", plan_index, plan.size(), pe.symbol.c_str());
-                    GumAttachReturn ret = gum_interceptor_attach(interceptor_.get(), GSIZE_TO_POINTER(it->second), listener, nullptr, GUM_ATTACH_FLAGS_NONE);
-                    if (ret == GUM_ATTACH_OK) {
-                        hook_results_.emplace_back(pe.symbol, it->second, pe.function_id, true);
-                        num_hooks_successful_++;
-                        LOG_HOOK_INSTALL("[Agent] (%d/%zu) Attached DSO hook to %s\n", plan_index, plan.size(), pe.symbol.c_str());
-                    } else {
-                        hook_results_.emplace_back(pe.symbol, it->second, pe.function_id, false);
-                        LOG_HOOK_INSTALL("[Agent] (%d/%zu) Failed to attach DSO hook to %s (error: %d)\n", plan_index, plan.size(), pe.symbol.c_str(), ret);
-                    }
-                } else {
-                    LOG_HOOK_INSTALL("[Agent] (%d/%zu) Skipped DSO hook to %s\n", plan_index, plan.size(), pe.symbol.c_str());
-                    hook_results_.emplace_back(pe.symbol, 0, pe.function_id, false);
-                }
-                plan_index += 1;
-            }
-            LOG_HOOK_INSTALL("[Agent] Processes hook plan for module: %s\n", gum_module_get_path(static_cast<GumModule*>(mod)));
-        }
-        LOG_HOOK_INSTALL("[Agent] Processes hook plan for all modules.\n");
-        g_object_unref(map);
+    install_timing_.attach_ns = timestamp_source_monotonic_ns() - phase_start_ns;
+    if (lazy_config_.enabled) {
+        // Probes go live with the transaction commit below
+        lazy_tracker_.reset(new ada::agent::LazyHookTracker(lazy_hooks_.size(), lazy_config_.budget));
     }
 
     LOG_HOOK_INSTALL("[Agent] hooks installation complete: %u/%u hooks installed\n",
@@ -1079,10 +1101,21 @@ void AgentContext::install_hooks() {
 
     // End transaction
     LOG_HOOK_INSTALL("[Agent] Ending transaction...\n");
+    phase_start_ns = timestamp_source_monotonic_ns();
     gum_interceptor_end_transaction(interceptor_.get());
+    install_timing_.commit_ns = timestamp_source_monotonic_ns() - phase_start_ns;
+    install_timing_.total_ns = timestamp_source_monotonic_ns() - install_start_ns;
     LOG_HOOK_INSTALL("[Agent] Transaction ended.\n");
-    
+
     g_is_installing_hooks.store(false);
+    if (map) {
+        g_object_unref(map);
+    }
+
+    if (lazy_tracker_) {
+        lazy_promoter_ = std::thread([this]() { run_lazy_promoter(); });
+    }
+    tick_thread_ = std::thread([this]() { run_tick(); });
     
     // Clean up exclude list
     if (xs) {
@@ -1103,11 +1136,10 @@ void AgentContext::install_hooks() {
                  host_pid_, session_id_);
         FILE* symbols_file = fopen(symbols_path, "w");
         if (symbols_file) {
-            std::string json = hook_registry_.export_to_json();
-            fwrite(json.data(), 1, json.size(), symbols_file);
+            size_t written = hook_registry_.write_json(symbols_file);
             fclose(symbols_file);
             LOG_HOOK_INSTALL("[Agent] Wrote symbol table to %s (%zu bytes)\n",
-                    symbols_path, json.size());
+                    symbols_path, written);
         } else {
             LOG_HOOK_INSTALL("[Agent] Failed to write symbol table to %s\n", symbols_path);
         }
@@ -1119,13 +1151,135 @@ void AgentContext::install_hooks() {
     // hooks_ready flag is set by the RAII guard at function exit
 }
 
+GumAttachReturn AgentContext::attach_hook(HookData* hook_ptr) {
+    GumInvocationListener* listener = gum_make_call_listener(on_enter_callback, on_leave_callback, hook_ptr, nullptr);
+    hook_ptr->listener = listener;  // Store listener to keep it alive
+    return gum_interceptor_attach(interceptor_.get(), GSIZE_TO_POINTER(hook_ptr->function_address),
+                                  listener, nullptr, GUM_ATTACH_FLAGS_NONE);
+}
+
+// Swap first-hit probes for full hooks (within budget) in one transaction;
+// over-budget functions just lose their probe.
+void AgentContext::promote_lazy_hooks() {
+    std::vector<uint32_t> promote;
+    std::vector<uint32_t> drop;
+    if (!lazy_tracker_ || lazy_tracker_->take_hits(&promote, &drop) == 0) return;
+
+    // Detached probes are released once the transaction has committed
+    std::vector<GumInvocationListener*> detached;
+    detached.reserve(promote.size() + drop.size());
+
+    gum_interceptor_begin_transaction(interceptor_.get());
+    for (uint32_t slot : promote) {
+        HookData* hook_ptr = lazy_hooks_[slot];
+        gum_interceptor_detach(interceptor_.get(), hook_ptr->probe);
+        detached.push_back(hook_ptr->probe);
+        hook_ptr->probe = nullptr;
+        GumAttachReturn ret = attach_hook(hook_ptr);
+        if (ret != GUM_ATTACH_OK) {
+            lazy_attach_failures_++;
+            LOG_HOOK_INSTALL("[Agent] Failed to promote hook %s (error: %d)\n",
+                             hook_ptr->function_name.c_str(), ret);
+        } else if (ada::internal::g_agent_verbose) {
+            LOG_HOOK_INSTALL("[Agent] Promoted hook %s\n", hook_ptr->function_name.c_str());
+        }
+    }
+    for (uint32_t slot : drop) {
+        HookData* hook_ptr = lazy_hooks_[slot];
+        gum_interceptor_detach(interceptor_.get(), hook_ptr->probe);
+        detached.push_back(hook_ptr->probe);
+        hook_ptr->probe = nullptr;
+    }
+    gum_interceptor_end_transaction(interceptor_.get());
+
+    for (GumInvocationListener* probe : detached) {
+        g_object_unref(probe);
+    }
+}
+
+void AgentContext::run_lazy_promoter() {
+    // Agent thread: never traced by our own hooks
+    gum_interceptor_ignore_current_thread(interceptor_.get());
+
+    std::unique_lock<std::mutex> lock(lazy_mutex_);
+    while (!lazy_stop_) {
+        lazy_cv_.wait_for(lock, std::chrono::milliseconds(lazy_config_.promote_interval_ms));
+        if (lazy_stop_) break;
+        lock.unlock();
+        promote_lazy_hooks();
+        lock.lock();
+    }
+}
+
+void AgentContext::stop_lazy_promoter() {
+    if (!lazy_promoter_.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(lazy_mutex_);
+        lazy_stop_ = true;
+    }
+    lazy_cv_.notify_all();
+    lazy_promoter_.join();
+
+    // Final promotion statistics
+    send_hook_summary();
+}
+
+void AgentContext::run_tick() {
+    // Agent thread: never traced by our own hooks
+    gum_interceptor_ignore_current_thread(interceptor_.get());
+
+    std::unique_lock<std::mutex> lock(tick_mutex_);
+    while (!tick_stop_) {
+        tick_cv_.wait_for(lock, std::chrono::milliseconds(tick_interval_ms_));
+        if (tick_stop_) break;
+        lock.unlock();
+        flush_sampler_summaries(false);
+        if (ada_tls_get_index_batch() > 0) {
+            (void)ada_tls_sweep_staged_events(platform_get_timestamp(), false);
+        }
+        lock.lock();
+    }
+}
+
+void AgentContext::stop_tick() {
+    if (tick_thread_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(tick_mutex_);
+            tick_stop_ = true;
+        }
+        tick_cv_.notify_all();
+        tick_thread_.join();
+    }
+
+    // Session stop: report every pending sampler count, then publish every
+    // live thread's batch (including those summaries) while the rings exist
+    flush_sampler_summaries(true);
+    (void)ada_tls_sweep_staged_events(0, true);
+}
+
 void AgentContext::send_hook_summary() {
     // For now, just print the summary
     // TODO: Implement proper Frida messaging when API is available
     if (ada::internal::g_agent_verbose) LOG_HOOK_SUMMARY("[Agent] Hook Summary: attempted=%u, successful=%u, failed=%u\n",
                 num_hooks_attempted_, num_hooks_successful_,
                 num_hooks_attempted_ - num_hooks_successful_);
-    
+
+    // Where startup went: planning runs on the worker pool, attach is serial
+    LOG_HOOK_SUMMARY("[Agent] Hook timing: total=%.1fms plan=%.1fms resolve=%.1fms "
+                     "attach=%.1fms commit=%.1fms (%u modules, %u workers)\n",
+                     install_timing_.total_ns / 1e6, install_timing_.plan_ns / 1e6,
+                     install_timing_.resolve_ns / 1e6, install_timing_.attach_ns / 1e6,
+                     install_timing_.commit_ns / 1e6, install_timing_.modules,
+                     install_timing_.workers);
+
+    if (lazy_tracker_) {
+        ada::agent::LazyHookStats lazy = lazy_tracker_->stats();
+        LOG_HOOK_SUMMARY("[Agent] Lazy hooks: probes=%u executed=%u promoted=%u (budget=%u, "
+                         "failed=%u) over_budget=%u cold=%u\n",
+                         lazy.probes, lazy.hits, lazy.promoted, lazy_config_.budget,
+                         lazy_attach_failures_, lazy.over_budget, lazy.probes - lazy.hits);
+    }
+
     for ([[maybe_unused]] const auto& result : hook_results_) {
         LOG_HOOK_SUMMARY("[Agent]   %s: address=0x%llx, id=%llu, %s\n", 
                 result.name.c_str(),
@@ -1136,8 +1290,8 @@ void AgentContext::send_hook_summary() {
 }
 
 // Update registry_mode via AgentModeState state machine
-void AgentContext::update_registry_mode(uint64_t now_ns, uint64_t hb_timeout_ns) {
-    if (!control_block_) return;
+uint32_t AgentContext::update_registry_mode(uint64_t now_ns, uint64_t hb_timeout_ns) {
+    if (!control_block_) return REGISTRY_MODE_GLOBAL_ONLY;
 
     // Diagnostic: log health check values (one-time)
     static bool logged_health_check = false;
@@ -1176,6 +1330,8 @@ void AgentContext::update_registry_mode(uint64_t now_ns, uint64_t hb_timeout_ns)
         // Best-effort visibility for transitions (optional)
         __atomic_fetch_add(&control_block_->mode_transitions, (uint64_t)1, __ATOMIC_RELAXED);
     }
+    // The drain may also promote the mode; report what producers should follow
+    return __atomic_load_n(&control_block_->registry_mode, __ATOMIC_ACQUIRE);
 }
 
 // ============================================================================
@@ -1258,56 +1414,22 @@ uint32_t hash_string(const char* str) {
 }
 
 uint64_t platform_get_timestamp() {
-    // Use clock_gettime(CLOCK_MONOTONIC) for consistency with GLib's g_get_monotonic_time()
-    // which the controller uses. On macOS 10.12+, CLOCK_MONOTONIC uses mach_continuous_time()
-    // internally, ensuring both controller and agent use the same time base.
-    // Previously used mach_absolute_time() which doesn't count sleep time, causing
-    // timestamp mismatches when comparing with the controller's heartbeat.
-    struct timespec ts;
-    clock_gettime(CLOCK_MONOTONIC, &ts);
-    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+    // Monotonic mode uses clock_gettime(CLOCK_MONOTONIC) for consistency with GLib's
+    // g_get_monotonic_time() which the controller uses. On macOS 10.12+, CLOCK_MONOTONIC
+    // uses mach_continuous_time() internally, ensuring both controller and agent use the
+    // same time base. Counter mode reads the CPU counter the controller calibrated
+    // against that clock; platform_timestamp_to_ns() maps it back.
+    return timestamp_source_read(g_timestamp.source);
 }
 
-static void segfault_handler(int sig) {
-    g_segfault_occurred = 1;
+uint64_t platform_timestamp_to_ns(uint64_t timestamp) {
+    return timestamp_source_to_ns(&g_timestamp, timestamp);
 }
 
 size_t safe_stack_capture(void* dest, void* stack_ptr, size_t max_size) {
-    if (!dest || !stack_ptr) return 0;
-    
-    struct sigaction old_sa, new_sa;
-    
-    new_sa.sa_handler = segfault_handler;
-    sigemptyset(&new_sa.sa_mask);
-    new_sa.sa_flags = 0;
-    
-    // Install temporary signal handler
-    sigaction(SIGSEGV, &new_sa, &old_sa);
-    g_segfault_occurred = 0;
-    
-    size_t copied = 0;
-    
-    // Try to copy in chunks to detect boundaries
-    const size_t chunk_size = 16;
-    for (size_t offset = 0; offset < max_size && !g_segfault_occurred;
-         offset += chunk_size) {
-        size_t to_copy = (offset + chunk_size <= max_size) ? 
-                        chunk_size : (max_size - offset);
-        
-        // Use volatile to prevent optimization
-        volatile char test_read = *((char*)stack_ptr + offset);
-        (void)test_read;
-        
-        if (!g_segfault_occurred) {
-            memcpy((char*)dest + offset, (char*)stack_ptr + offset, to_copy);
-            copied += to_copy;
-        }
-    }
-    
-    // Restore original handler
-    sigaction(SIGSEGV, &old_sa, nullptr);
-    
-    return copied;
+    // Bounds-checked copy inside the thread's cached stack, kernel-checked
+    // read elsewhere; no signal handler juggling on the hot path
+    return stack_capture_copy(dest, stack_ptr, max_size);
 }
 
 void parse_init_payload(const char* data, int data_size,
@@ -1377,7 +1499,8 @@ void parse_init_payload(const char* data, int data_size,
 // ============================================================================
 
 static void capture_index_event(AgentContext* ctx, HookData* hook,
-                               ThreadLocalData* tls, EventKind kind) {
+                               ThreadLocalData* tls, EventKind kind, uint64_t timestamp,
+                               uint32_t call_depth, uint64_t span_duration = 0) {
     if (!ctx->control_block()) {
         LOG_EVENTS("[Agent] Control block is NULL!\n");
         return;
@@ -1394,15 +1517,18 @@ static void capture_index_event(AgentContext* ctx, HookData* hook,
     LOG_EVENTS("[Agent] Capturing index event for %s (kind=%d)\n", hook->function_name.c_str(), kind);
     
     IndexEvent event = {};
-    event.timestamp = platform_get_timestamp();
+    event.timestamp = timestamp;
     event.function_id = hook->function_id;
     event.thread_id = tls->thread_id();
     event.event_kind = kind;
-    event.call_depth = tls->call_depth();
-    event._padding = 0;
+    event.call_depth = call_depth;
+    event.detail_seq = INDEX_EVENT_NO_DETAIL_SEQ;
+    if (kind == EVENT_KIND_SPAN) {
+        index_event_set_span(&event, call_depth, span_duration);
+    }
     
-    // Determine operating mode
-    uint32_t mode = __atomic_load_n(&ctx->control_block()->registry_mode, __ATOMIC_ACQUIRE);
+    // Determine operating mode (cached by the amortized check)
+    uint32_t mode = tls->registry_mode();
     bool wrote = false;
     bool wrote_pt = false;
 
@@ -1426,6 +1552,11 @@ static void capture_index_event(AgentContext* ctx, HookData* hook,
             if (ada_tls) ada_tls->metrics = metrics;
         }
         if (lanes && ada_tls) {
+            // Per-thread records are final ATF records: stamp the registration's
+            // stream id so the drain can write ring memory straight to
+            // thread_<stream_id>/index.atf
+            event.thread_id = ada_tls->stream_id;
+
             // Use ring pool for swap-on-overflow support
             ::RingPool* index_pool = ada_tls->index_pool;
 
@@ -1437,7 +1568,12 @@ static void capture_index_event(AgentContext* ctx, HookData* hook,
                 logged_pt_path = true;
             }
 
-            if (index_pool) {
+            if (index_pool &&
+                ada_tls_stage_index_event(&event, ctx->control_block()->flight_state)) {
+                // Staged for a bulk publish; metrics are recorded on publish
+                wrote_pt = true;
+                ctx->increment_events_emitted();
+            } else if (index_pool) {
                 RingBufferHeader* hdr = ring_pool_get_active_header(index_pool);
 
                 // One-time diagnostic for ring buffer header
@@ -1452,7 +1588,7 @@ static void capture_index_event(AgentContext* ctx, HookData* hook,
                 }
 
                 if (hdr) {
-                    wrote_pt = ring_buffer_write_raw(hdr, sizeof(IndexEvent), &event);
+                    wrote_pt = ada::internal::IndexRing::write(hdr, &event);
                     if (!wrote_pt) {
                         // Ring is full - swap to a new ring and retry
                         uint32_t old_ring_idx = UINT32_MAX;
@@ -1460,7 +1596,7 @@ static void capture_index_event(AgentContext* ctx, HookData* hook,
                             // Successfully swapped, get new active header and retry write
                             hdr = ring_pool_get_active_header(index_pool);
                             if (hdr) {
-                                wrote_pt = ring_buffer_write_raw(hdr, sizeof(IndexEvent), &event);
+                                wrote_pt = ada::internal::IndexRing::write(hdr, &event);
                             }
                         } else {
                             // Pool exhaustion - try to recover
@@ -1469,7 +1605,7 @@ static void capture_index_event(AgentContext* ctx, HookData* hook,
                                 if (ring_pool_swap_active(index_pool, &old_ring_idx)) {
                                     hdr = ring_pool_get_active_header(index_pool);
                                     if (hdr) {
-                                        wrote_pt = ring_buffer_write_raw(hdr, sizeof(IndexEvent), &event);
+                                        wrote_pt = ada::internal::IndexRing::write(hdr, &event);
                                     }
                                 }
                             }
@@ -1498,10 +1634,11 @@ static void capture_index_event(AgentContext* ctx, HookData* hook,
                 // Fallback: no ring pool, use direct registry access
                 Lane* idx_lane = thread_lanes_get_index_lane(lanes);
                 ::ThreadRegistry* reg = ada_get_global_registry();
-                if (reg) {
-                    RingBufferHeader* hdr = thread_registry_get_active_ring_header(reg, idx_lane);
+                LaneView* view = &ada_tls->lane_views[0];
+                if (reg && lane_view_sync(reg, idx_lane, view)) {
+                    RingBufferHeader* hdr = lane_view_active_ring(view);
                     if (hdr) {
-                        wrote_pt = ring_buffer_write_raw(hdr, sizeof(IndexEvent), &event);
+                        wrote_pt = ada::internal::IndexRing::write(hdr, &event);
                         if (wrote_pt) {
                             ctx->increment_events_emitted();
                             if (metrics) {
@@ -1554,9 +1691,29 @@ static void capture_index_event(AgentContext* ctx, HookData* hook,
     }
 }
 
+// Expand a ring record into the fixed 512-byte slot of the process-global ring
+static void detail_event_from_record(const DetailRecordHeader* rec, DetailEvent* detail) {
+    const auto* payload = reinterpret_cast<const DetailRecordPayload*>(rec + 1);
+    std::memset(detail, 0, sizeof(*detail));
+    detail->timestamp = rec->timestamp;
+    detail->function_id = payload->function_id;
+    detail->thread_id = rec->thread_id;
+    detail->event_kind = rec->event_type == DETAIL_RECORD_RETURN ? EVENT_KIND_RETURN : EVENT_KIND_CALL;
+    detail->call_depth = rec->call_depth;
+    std::memcpy(detail->x_regs, payload->x_regs, sizeof(detail->x_regs));
+    detail->lr = payload->lr;
+    detail->fp = payload->fp;
+    detail->sp = payload->sp;
+    // The fixed slot keeps the first 128 bytes of larger snapshots
+    size_t stack_bytes = payload->stack_size < sizeof(detail->stack_snapshot)
+                             ? payload->stack_size : sizeof(detail->stack_snapshot);
+    detail->stack_size = static_cast<uint32_t>(stack_bytes);
+    std::memcpy(detail->stack_snapshot, payload + 1, stack_bytes);
+}
+
 static void capture_detail_event(AgentContext* ctx, HookData* hook,
                                 ThreadLocalData* tls, EventKind kind,
-                                GumCpuContext* cpu) {
+                                GumCpuContext* cpu, uint64_t timestamp) {
     if (!ctx->control_block()->detail_lane_enabled) {
         LOG_EVENTS("[Agent] Detail lane disabled\n");
         return;
@@ -1564,64 +1721,71 @@ static void capture_detail_event(AgentContext* ctx, HookData* hook,
     
     LOG_EVENTS("[Agent] Capturing detail event\n");
     
-    DetailEvent detail = {};
-    detail.timestamp = platform_get_timestamp();
-    detail.function_id = hook->function_id;
-    detail.thread_id = tls->thread_id();
-    detail.event_kind = kind;
-    detail.call_depth = tls->call_depth();
+    // Variable-length record: header, payload, then only the stack bytes captured
+    alignas(DETAIL_RECORD_ALIGN) uint8_t record[DETAIL_RECORD_MAX_SIZE];
+    auto* rec = reinterpret_cast<DetailRecordHeader*>(record);
+    auto* payload = reinterpret_cast<DetailRecordPayload*>(rec + 1);
+    std::memset(record, 0, sizeof(DetailRecordHeader) + sizeof(DetailRecordPayload));
+    rec->timestamp = timestamp;
+    rec->event_type = (kind == EVENT_KIND_RETURN) ? DETAIL_RECORD_RETURN : DETAIL_RECORD_CALL;
+    rec->thread_id = tls->thread_id();
+    rec->call_depth = tls->call_depth();
+    payload->function_id = hook->function_id;
     
     if (cpu) {
 #ifdef __aarch64__
         if (kind == EVENT_KIND_CALL) {
             // Capture ARM64 ABI registers
             for (int i = 0; i < 8; i++) {
-                detail.x_regs[i] = cpu->x[i]; // x0-x7: arguments
+                payload->x_regs[i] = cpu->x[i]; // x0-x7: arguments
             }
-            detail.lr = cpu->lr;
-            detail.fp = cpu->fp;
-            detail.sp = cpu->sp;
+            payload->lr = cpu->lr;
+            payload->fp = cpu->fp;
+            payload->sp = cpu->sp;
         } else {  // EVENT_KIND_RETURN
-            detail.x_regs[0] = cpu->x[0]; // Return value
-            detail.sp = cpu->sp;
+            payload->x_regs[0] = cpu->x[0]; // Return value
+            payload->sp = cpu->sp;
         }
 #elif defined(__x86_64__)
         if (kind == EVENT_KIND_CALL) {
             // Capture x86_64 ABI registers
-            detail.x_regs[0] = cpu->rdi; // arg1
-            detail.x_regs[1] = cpu->rsi; // arg2
-            detail.x_regs[2] = cpu->rdx; // arg3
-            detail.x_regs[3] = cpu->rcx; // arg4
-            detail.x_regs[4] = cpu->r8;  // arg5
-            detail.x_regs[5] = cpu->r9;  // arg6
-            detail.x_regs[6] = cpu->rbp; // frame pointer
-            detail.x_regs[7] = cpu->rsp; // stack pointer
+            payload->x_regs[0] = cpu->rdi; // arg1
+            payload->x_regs[1] = cpu->rsi; // arg2
+            payload->x_regs[2] = cpu->rdx; // arg3
+            payload->x_regs[3] = cpu->rcx; // arg4
+            payload->x_regs[4] = cpu->r8;  // arg5
+            payload->x_regs[5] = cpu->r9;  // arg6
+            payload->x_regs[6] = cpu->rbp; // frame pointer
+            payload->x_regs[7] = cpu->rsp; // stack pointer
             
-            detail.sp = cpu->rsp;
-            detail.fp = cpu->rbp;
+            payload->sp = cpu->rsp;
+            payload->fp = cpu->rbp;
         } else {  // EVENT_KIND_RETURN
-            detail.x_regs[0] = cpu->rax; // Return value
-            detail.sp = cpu->rsp;
+            payload->x_regs[0] = cpu->rax; // Return value
+            payload->sp = cpu->rsp;
         }
 #endif
         
-        // Optional stack window capture (128 bytes)
+        // Optional stack window capture (ADA_STACK_CAPTURE_BYTES), stored inline
         if (kind == EVENT_KIND_CALL && 
             ctx->control_block()->capture_stack_snapshot) {
-            void* stack_ptr = reinterpret_cast<void*>(detail.sp);
-            size_t captured = safe_stack_capture(detail.stack_snapshot, 
+            void* stack_ptr = reinterpret_cast<void*>(payload->sp);
+            size_t captured = safe_stack_capture(payload + 1,
                                                 stack_ptr,
-                                                sizeof(detail.stack_snapshot));
-            detail.stack_size = captured;
+                                                g_stack_capture_bytes);
+            payload->stack_size = static_cast<uint16_t>(captured);
             
             if (captured == 0) {
                 ctx->increment_stack_capture_failures();
             }
         }
     }
+    const size_t record_size =
+        sizeof(DetailRecordHeader) + sizeof(DetailRecordPayload) + payload->stack_size;
+    rec->total_length = static_cast<uint32_t>(record_size);
     
-    // Determine operating mode
-    uint32_t mode = __atomic_load_n(&ctx->control_block()->registry_mode, __ATOMIC_ACQUIRE);
+    // Determine operating mode (cached by the amortized check)
+    uint32_t mode = tls->registry_mode();
     bool wrote = false;
     bool wrote_pt = false;
     if (mode == REGISTRY_MODE_DUAL_WRITE || mode == REGISTRY_MODE_PER_THREAD_ONLY) {
@@ -1635,15 +1799,16 @@ static void capture_detail_event(AgentContext* ctx, HookData* hook,
         if (lanes) {
             Lane* det_lane = thread_lanes_get_detail_lane(lanes);
             ::ThreadRegistry* reg = ada_get_global_registry();
-            if (reg) {
-                RingBufferHeader* hdr = thread_registry_get_active_ring_header(reg, det_lane);
+            LaneView* view = ada_tls ? &ada_tls->lane_views[1] : nullptr;
+            if (reg && view && lane_view_sync(reg, det_lane, view)) {
+                RingBufferHeader* hdr = lane_view_active_ring(view);
                 if (hdr) {
-                    wrote_pt = ring_buffer_write_raw(hdr, sizeof(DetailEvent), &detail);
+                    wrote_pt = ring_buffer_write_record_raw(hdr, record, record_size);
                     if (wrote_pt) {
                         LOG_EVENTS("[Agent] Wrote detail event (per-thread)\n");
                         ctx->increment_events_emitted();
                         if (metrics) {
-                            ada_thread_metrics_record_event_written(metrics, sizeof(DetailEvent));
+                            ada_thread_metrics_record_event_written(metrics, record_size);
                         }
                     } else if (metrics) {
                         ada_thread_metrics_record_ring_full(metrics);
@@ -1654,9 +1819,13 @@ static void capture_detail_event(AgentContext* ctx, HookData* hook,
     }
 
     if (mode == REGISTRY_MODE_DUAL_WRITE) {
+        DetailEvent detail;
+        detail_event_from_record(rec, &detail);
         ::RingBuffer* grb = reinterpret_cast<::RingBuffer*>(ctx->detail_ring());
         wrote = ring_buffer_write(grb, &detail);
     } else if (mode == REGISTRY_MODE_GLOBAL_ONLY || (mode == REGISTRY_MODE_PER_THREAD_ONLY && !wrote_pt)) {
+        DetailEvent detail;
+        detail_event_from_record(rec, &detail);
         ::RingBuffer* grb = reinterpret_cast<::RingBuffer*>(ctx->detail_ring());
         wrote = ring_buffer_write(grb, &detail);
         if (mode == REGISTRY_MODE_PER_THREAD_ONLY && !wrote_pt) {
@@ -1688,6 +1857,60 @@ static void capture_detail_event(AgentContext* ctx, HookData* hook,
     }
 }
 
+// Amortized registry mode check: the control block is consulted at most once
+// per g_mode_check_interval per thread; other calls read the TLS cache only.
+static inline void refresh_registry_mode(AgentContext* ctx, ThreadLocalData* tls, uint64_t now) {
+    AgentModeCache* cache = tls->mode_cache();
+    if (!agent_mode_cache_due(cache, now)) return;
+    const uint64_t hb_timeout_ns = 500000000ull; // 500 ms
+    uint32_t mode = ctx->update_registry_mode(platform_timestamp_to_ns(now), hb_timeout_ns);
+    agent_mode_cache_refresh(cache, mode, now, g_mode_check_interval);
+    if (ControlBlock* cb = ctx->control_block()) {
+        SamplingControl sampling;
+        cb_get_sampling(cb, &sampling);
+        hook_sampler_config_from_control(&sampling, &g_timestamp, tls->sampler_config());
+        tls->set_index_spans(cb_get_index_spans(cb) != 0);
+        tls->set_aggregation(cb_get_aggregation(cb));
+    }
+}
+
+// Report suppressed counts no call is left to report: functions whose window
+// went quiet (tick, once per window) or everything pending (session stop)
+void AgentContext::flush_sampler_summaries(bool force) {
+    ThreadLocalData* tls = get_thread_local();
+    if (!tls || !control_block_) return;
+    uint64_t now = platform_get_timestamp();
+    refresh_registry_mode(this, tls, now);
+    const HookSamplerConfig* config = tls->sampler_config();
+    if (!force) {
+        if (!config->enabled || now - last_sampler_flush_ < config->window_ticks) return;
+        last_sampler_flush_ = now;
+    }
+    for (const auto& hook : hooks_) {
+        uint64_t suppressed = hook_sampler_flush(&hook->sampler, config, now, force);
+        if (suppressed != 0) {
+            capture_index_event(this, hook.get(), tls, EVENT_KIND_SAMPLED, now,
+                                suppressed > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(suppressed));
+        }
+    }
+}
+
+// Frida per-invocation data, written by on_enter and read back by on_leave
+struct HookInvocationState {
+    uint16_t skip_events;   // Sampled out or aggregation-only: no events at leave
+    uint16_t shadowed;      // Entry is on the shadow stack
+    uint16_t span;          // Leave writes a span record
+    uint16_t aggregate;     // Leave adds the call to the aggregation lane
+};
+
+// Add a completed call to this thread's aggregation lane
+static inline void record_aggregate(HookData* hook, const ada::agent::ShadowFrame& frame,
+                                    uint64_t now) {
+    if (AggregateTable* table = ada_get_thread_aggregates()) {
+        aggregate_table_record(table, hook->function_id, frame.inclusive(now), frame.exclusive(now));
+    }
+}
+
 // C-style callbacks for Frida (must be extern "C")
 extern "C" {
 
@@ -1701,6 +1924,10 @@ void on_enter_callback(GumInvocationContext* ic, gpointer user_data) {
 #else
 // Full implementation with event capture
 void on_enter_callback(GumInvocationContext* ic, gpointer user_data) {
+    // Cleared first: on_leave reads it even when this callback bails out early
+    auto* state = GUM_IC_GET_INVOCATION_DATA(ic, HookInvocationState);
+    *state = HookInvocationState{};
+
     // Prevent execution during shutdown
     if (g_agent_shutting_down) return;
 
@@ -1743,19 +1970,50 @@ void on_enter_callback(GumInvocationContext* ic, gpointer user_data) {
 
     // agent_log("[Agent] on_enter: %s (tid=%u)\n", hook->function_name.c_str(), tls->thread_id());
 
-    // Tick agent mode state machine before captures
-    const uint64_t now_ns = platform_get_timestamp();
-    const uint64_t hb_timeout_ns = 500000000ull; // 500 ms
-    ctx->update_registry_mode(now_ns, hb_timeout_ns);
+    // One timestamp per callback, shared by the mode check and both lanes
+    const uint64_t now = platform_get_timestamp();
+    refresh_registry_mode(ctx, tls, now);
 
     // Increment call depth
     tls->increment_depth();
 
-    // Capture index event
-    capture_index_event(ctx, hook, tls, EVENT_KIND_CALL);
+    // Shadow the entry when the leave needs its timestamp (spans, aggregation);
+    // aggregation sees every call, ahead of sampling
+    const uint32_t aggregation = tls->aggregation();
+    if ((aggregation != AGGREGATION_OFF || tls->index_spans()) &&
+        tls->shadow_stack()->push(hook->function_id, now)) {
+        state->shadowed = 1;
+        state->aggregate = aggregation != AGGREGATION_OFF;
+    }
+    if (aggregation == AGGREGATION_ONLY) {
+        state->skip_events = 1;
+        tls->exit_handler();
+        return;
+    }
+
+    // Adaptive sampling; the thread that closes a window reports what was skipped
+    uint64_t suppressed = 0;
+    bool record = hook_sampler_admit(&hook->sampler, tls->sampler_config(),
+                                     tls->sampler_tally(hook->function_id), now, &suppressed);
+    if (suppressed != 0) {
+        capture_index_event(ctx, hook, tls, EVENT_KIND_SAMPLED, now,
+                            suppressed > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(suppressed));
+    }
+    if (!record) {
+        state->skip_events = 1;
+        tls->exit_handler();
+        return;
+    }
+
+    // Capture index event; in span mode the return writes the whole call
+    if (state->shadowed && tls->index_spans()) {
+        state->span = 1;
+    } else {
+        capture_index_event(ctx, hook, tls, EVENT_KIND_CALL, now, tls->call_depth());
+    }
 
     // Capture detail event with full ABI registers and optional stack
-    capture_detail_event(ctx, hook, tls, EVENT_KIND_CALL, ic->cpu_context);
+    capture_detail_event(ctx, hook, tls, EVENT_KIND_CALL, ic->cpu_context, now);
 
     tls->exit_handler();
 }
@@ -1793,18 +2051,41 @@ void on_leave_callback(GumInvocationContext* ic, gpointer user_data) {
     tls->enter_handler();
     
     if (ada::internal::g_agent_verbose) LOG_CALLBACKS("[Agent] on_leave: %s\n", hook->function_name.c_str());
+
+    // Sampled-out call without a shadow frame: only keep the depth balanced
+    auto* state = GUM_IC_GET_INVOCATION_DATA(ic, HookInvocationState);
+    if (state->skip_events && !state->shadowed) {
+        tls->decrement_depth();
+        tls->exit_handler();
+        return;
+    }
     
-    // Tick agent mode state machine before captures
-    const uint64_t now_ns = platform_get_timestamp();
-    const uint64_t hb_timeout_ns = 500000000ull; // 500 ms
-    ctx->update_registry_mode(now_ns, hb_timeout_ns);
+    // One timestamp per callback, shared by the mode check and both lanes
+    const uint64_t now = platform_get_timestamp();
+    refresh_registry_mode(ctx, tls, now);
+
+    ada::agent::ShadowFrame frame;
+    const bool paired = state->shadowed && tls->shadow_stack()->pop(hook->function_id, now, &frame);
+    if (paired && state->aggregate) {
+        record_aggregate(hook, frame, now);
+    }
+    if (state->skip_events) {
+        tls->decrement_depth();
+        tls->exit_handler();
+        return;
+    }
 
-    // Capture index event
-    capture_index_event(ctx, hook, tls, EVENT_KIND_RETURN);
+    // Capture index event: one span record when the entry was shadowed
+    if (paired && state->span) {
+        capture_index_event(ctx, hook, tls, EVENT_KIND_SPAN, now, tls->call_depth(),
+                            frame.inclusive(now));
+    } else {
+        capture_index_event(ctx, hook, tls, EVENT_KIND_RETURN, now, tls->call_depth());
+    }
     
     // Capture detail event with return value
     if (ctx->control_block()->flight_state == FLIGHT_RECORDER_RECORDING) {
-        capture_detail_event(ctx, hook, tls, EVENT_KIND_RETURN, ic->cpu_context);
+        capture_detail_event(ctx, hook, tls, EVENT_KIND_RETURN, ic->cpu_context, now);
     }
     
     // Decrement call depth
@@ -1814,6 +2095,20 @@ void on_leave_callback(GumInvocationContext* ic, gpointer user_data) {
 }
 #endif // ADA_MINIMAL_HOOKS
 
+// Lazy mode probe: claim the first hit and leave promotion to the promoter
+void on_probe_hit_callback(GumInvocationContext* ic, gpointer user_data) {
+    (void)ic;
+    if (g_agent_shutting_down) return;
+    if (g_is_installing_hooks.load(std::memory_order_acquire)) return;
+
+    auto* hook = static_cast<HookData*>(user_data);
+    if (!hook || !hook->context) return;
+    ada::agent::LazyHookTracker* tracker = hook->context->lazy_tracker();
+    if (tracker) {
+        tracker->record_hit(hook->lazy_slot);
+    }
+}
+
 } // extern "C"
 
 } // namespace internal
@@ -1848,58 +2143,46 @@ uint32_t agent_estimate_hooks(void) {
     ada::agent::HookRegistry registry;
     uint32_t count = 0;
 
-    // Enumerate main module symbols and plan hooks
+    // Enumerate main module symbols and plan hooks with install_hooks() rules
     GumModule* main_mod = gum_process_get_main_module();
-    std::vector<ada::internal::SectionRange> main_stub_ranges;
+    ada::agent::ModuleSymbols main_symbols;
+    main_symbols.path = "<main>";
     if (main_mod) {
+        std::vector<ada::internal::SectionRange> main_stub_ranges;
         gum_module_enumerate_sections(main_mod, ada::internal::collect_stub_sections_cb, &main_stub_ranges);
-    }
-    std::vector<ada::internal::SymbolEntry> main_symbol_entries;
-    if (main_mod) {
+        for (const auto& r : main_stub_ranges) {
+            main_symbols.stub_ranges.push_back(ada::agent::HookAddressRange{r.start, r.end});
+        }
+
         // Check if ADA_HOOK_SWIFT=0 (escape hatch to force exports-only mode)
         // Default behavior: enumerate all symbols (Swift functions included)
         const char* hook_swift_env = getenv("ADA_HOOK_SWIFT");
         const bool force_exports_only = (hook_swift_env && hook_swift_env[0] == '0');
 
+        std::vector<ada::internal::SymbolEntry> main_symbol_entries;
         if (force_exports_only) {
             std::vector<ada::internal::ExportEntry> main_exports;
             gum_module_enumerate_exports(main_mod, ada::internal::collect_exports_cb, &main_exports);
-            for (const auto& entry : main_exports) {
+            for (auto& entry : main_exports) {
                 // ExportEntry doesn't have address, use 0 (will fallback to resolve_export_address)
-                main_symbol_entries.push_back(ada::internal::SymbolEntry{entry.name, 0});
+                main_symbol_entries.push_back(ada::internal::SymbolEntry{std::move(entry.name), 0});
             }
         } else {
             gum_module_enumerate_symbols(main_mod, ada::internal::collect_symbols_cb, &main_symbol_entries);
         }
-    }
-    std::vector<std::string> main_symbol_names;
-    main_symbol_names.reserve(main_symbol_entries.size());
-    std::unordered_set<std::string> seen_symbols;
-    // Build enumerated_addresses map to preserve addresses from enumeration
-    std::unordered_map<std::string, GumAddress> enumerated_addresses;
-    enumerated_addresses.reserve(main_symbol_entries.size());
-    for (auto& e : main_symbol_entries) {
-        if (seen_symbols.insert(e.name).second) {
-            main_symbol_names.push_back(e.name);
-            enumerated_addresses.emplace(e.name, e.address);
+        for (auto& e : main_symbol_entries) {
+            main_symbols.names.push_back(std::move(e.name));
+            main_symbols.addresses.push_back(e.address);
         }
     }
-    size_t symbol_limit = ada::internal::main_symbol_limit();
-    ada::internal::cap_symbol_names(main_symbol_names, symbol_limit);
-    auto main_plan = ada::agent::plan_module_hooks("<main>", main_symbol_names, xs, registry);
+    auto main_plan = ada::agent::plan_module_symbols(
+        main_symbols, ada::internal::main_symbol_limit(), xs, registry);
+    ada::agent::resolve_hook_addresses(
+        main_plan, main_symbols.stub_ranges,
+        [main_mod](const std::string& sym) { return ada::internal::resolve_export_address(main_mod, sym); },
+        ada::agent::hook_plan_worker_count(main_plan.size()));
     for (const auto& entry : main_plan) {
-        GumAddress addr = 0;
-        // First: use address from enumeration (works for local symbols)
-        auto enum_it = enumerated_addresses.find(entry.symbol);
-        if (enum_it != enumerated_addresses.end() && enum_it->second != 0) {
-            addr = enum_it->second;
-        } else {
-            // Fallback: export/symbol lookup (for exports-only mode)
-            addr = ada::internal::resolve_export_address(main_mod, entry.symbol);
-        }
-        if (addr == 0) continue;
-        if (ada::internal::is_stub_address(addr, main_stub_ranges)) continue;
-        count += 1;
+        if (entry.address != 0 && !entry.stub) count += 1;
     }
 
     // Check if we should skip DSO hooking for testing
@@ -1,41 +1,165 @@
 #include <tracer_backend/agent/hook_registry.h>
-#include <sstream>
-#include <iomanip>
 
 namespace ada {
 namespace agent {
 
 namespace {
 
-// Helper to format UUID as string (e.g., "550E8400-E29B-41D4-A716-446655440000")
-std::string format_uuid(const uint8_t uuid[16]) {
-    std::ostringstream oss;
-    oss << std::hex << std::uppercase << std::setfill('0');
-    for (int i = 0; i < 16; ++i) {
-        if (i == 4 || i == 6 || i == 8 || i == 10) oss << '-';
-        oss << std::setw(2) << static_cast<unsigned>(uuid[i]);
-    }
-    return oss.str();
-}
-
-// Helper to escape JSON string
-std::string json_escape(const std::string& s) {
-    std::ostringstream oss;
-    for (char c : s) {
-        switch (c) {
-            case '"': oss << "\\\""; break;
-            case '\\': oss << "\\\\"; break;
-            case '\n': oss << "\\n"; break;
-            case '\r': oss << "\\r"; break;
-            case '\t': oss << "\\t"; break;
-            default: oss << c; break;
+constexpr size_t kArenaChunkBytes = 64 * 1024;  // Default name arena chunk
+constexpr size_t kMinSymbolSlots = 64;
+constexpr size_t kMinModuleSlots = 16;
+
+// Arena record: [uint32 length][name bytes][NUL], padded to 4 bytes
+inline size_t arena_record_size(size_t length) {
+    return (sizeof(uint32_t) + length + 1 + 3) & ~static_cast<size_t>(3);
+}
+
+// FNV-1a 32-bit (exact bytes) for table probing
+inline uint32_t hash_bytes(const char* s, size_t n) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < n; ++i) {
+        h ^= static_cast<unsigned char>(s[i]);
+        h *= 16777619u;
+    }
+    return h;
+}
+
+// Smallest power of two holding `count` entries at a load factor of 1/2
+inline size_t slots_for(size_t count, size_t min_slots) {
+    size_t slots = min_slots;
+    while (slots < count * 2) slots <<= 1;
+    return slots;
+}
+
+// Output targets for the JSON emitter
+struct StringSink {
+    std::string& out;
+    void append(const char* s, size_t n) { out.append(s, n); }
+};
+
+struct FileSink {
+    FILE* file;
+    size_t written = 0;
+    size_t used = 0;
+    char buf[64 * 1024];
+
+    void flush() {
+        if (used == 0) return;
+        written += fwrite(buf, 1, used, file);
+        used = 0;
+    }
+    void append(const char* s, size_t n) {
+        if (n > sizeof(buf) - used) {
+            flush();
+            if (n > sizeof(buf)) {
+                written += fwrite(s, 1, n, file);
+                return;
+            }
         }
+        std::memcpy(buf + used, s, n);
+        used += n;
     }
-    return oss.str();
+};
+
+template <typename Sink>
+inline void put(Sink& sink, const char* s) {
+    sink.append(s, std::strlen(s));
+}
+
+template <typename Sink>
+inline void put_format(Sink& sink, const char* fmt, unsigned long long value) {
+    char tmp[128];
+    int n = snprintf(tmp, sizeof(tmp), fmt, value);
+    if (n < 0) return;
+    sink.append(tmp, static_cast<size_t>(n) < sizeof(tmp) ? static_cast<size_t>(n) : sizeof(tmp) - 1);
+}
+
+// Escape JSON string: only quote, backslash and the common control characters
+template <typename Sink>
+void put_escaped(Sink& sink, const char* s, size_t n) {
+    size_t run = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const char* esc = nullptr;
+        switch (s[i]) {
+            case '"': esc = "\\\""; break;
+            case '\\': esc = "\\\\"; break;
+            case '\n': esc = "\\n"; break;
+            case '\r': esc = "\\r"; break;
+            case '\t': esc = "\\t"; break;
+            default: continue;
+        }
+        sink.append(s + run, i - run);
+        sink.append(esc, 2);
+        run = i + 1;
+    }
+    sink.append(s + run, n - run);
+}
+
+// Format UUID as string (e.g., "550E8400-E29B-41D4-A716-446655440000")
+template <typename Sink>
+void put_uuid(Sink& sink, const uint8_t uuid[16]) {
+    static const char kHex[] = "0123456789ABCDEF";
+    char tmp[36];
+    size_t n = 0;
+    for (int i = 0; i < 16; ++i) {
+        if (i == 4 || i == 6 || i == 8 || i == 10) tmp[n++] = '-';
+        tmp[n++] = kHex[uuid[i] >> 4];
+        tmp[n++] = kHex[uuid[i] & 0xf];
+    }
+    sink.append(tmp, n);
 }
 
 } // anonymous namespace
 
+// Probe slot; `index` is stored last with release so readers that see it
+// non-zero also see the name fields.
+struct HookRegistry::SymbolSlot {
+    std::atomic<uint32_t> index{0};  // Symbol index (0 = empty)
+    uint32_t hash = 0;
+    uint32_t length = 0;
+    const char* name = nullptr;      // Interned in the module arena
+};
+
+struct HookRegistry::SymbolTable {
+    explicit SymbolTable(size_t capacity)
+        : mask(capacity - 1), slots(new SymbolSlot[capacity]) {}
+    size_t mask;
+    std::unique_ptr<SymbolSlot[]> slots;
+};
+
+struct HookRegistry::NameChunk {
+    std::unique_ptr<char[]> data;
+    size_t used;
+    size_t capacity;
+};
+
+struct HookRegistry::ModuleEntry {
+    std::string path;
+    uint32_t path_hash = 0;
+    uint32_t module_id = 0;
+    uint32_t next_index = 1u;                          // Writer only
+    std::atomic<uint32_t> symbol_count{0};
+    std::atomic<SymbolTable*> table{nullptr};
+    std::vector<std::unique_ptr<SymbolTable>> tables;  // Current + retired
+    std::vector<NameChunk> arena;                      // Names in index order
+    // Runtime metadata (BH-011)
+    uint64_t base_address = 0;
+    uint64_t size = 0;
+    uint8_t uuid[16] = {};
+    bool metadata_set = false;
+};
+
+struct HookRegistry::ModuleIndex {
+    explicit ModuleIndex(size_t capacity)
+        : mask(capacity - 1), slots(new std::atomic<ModuleEntry*>[capacity]) {
+        for (size_t i = 0; i < capacity; ++i) {
+            slots[i].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+    size_t mask;
+    std::unique_ptr<std::atomic<ModuleEntry*>[]> slots;
+};
+
 // FNV-1a 32-bit (case-insensitive ASCII)
 uint32_t fnv1a32_ci(const std::string& s) {
     const uint32_t FNV_OFFSET = 2166136261u;
@@ -51,65 +175,198 @@ uint32_t fnv1a32_ci(const std::string& s) {
     return h;
 }
 
-HookRegistry::HookRegistry() : modules_() {}
+HookRegistry::HookRegistry()
+    : modules_(), retired_modules_(), module_index_(nullptr), module_indexes_(), module_count_(0) {}
 
-uint64_t HookRegistry::register_symbol(const std::string& module_path, const std::string& symbol) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto& me = modules_[module_path];
-    if (me.module_id == 0) {
-        me.module_id = fnv1a32_ci(module_path);
-        me.next_index = 1u;
+HookRegistry::~HookRegistry() = default;
+
+const HookRegistry::ModuleEntry* HookRegistry::find_module(const std::string& module_path) const {
+    const ModuleIndex* index = module_index_.load(std::memory_order_acquire);
+    if (!index) return nullptr;
+    uint32_t h = hash_bytes(module_path.data(), module_path.size());
+    for (size_t i = h & index->mask;; i = (i + 1) & index->mask) {
+        const ModuleEntry* me = index->slots[i].load(std::memory_order_acquire);
+        if (!me) return nullptr;
+        if (me->path_hash == h && me->path == module_path) return me;
+    }
+}
+
+HookRegistry::ModuleEntry* HookRegistry::get_or_create_module_locked(const std::string& module_path) {
+    if (const ModuleEntry* found = find_module(module_path)) {
+        return const_cast<ModuleEntry*>(found);
+    }
+
+    std::unique_ptr<ModuleEntry> entry(new ModuleEntry());
+    entry->path = module_path;
+    entry->path_hash = hash_bytes(module_path.data(), module_path.size());
+    entry->module_id = fnv1a32_ci(module_path);
+
+    // Grow the module index before it passes half full; the old one is kept
+    // for readers still probing it.
+    ModuleIndex* index = module_index_.load(std::memory_order_relaxed);
+    if (!index || (modules_.size() + 1) * 2 > index->mask + 1) {
+        std::unique_ptr<ModuleIndex> grown(
+            new ModuleIndex(slots_for(modules_.size() + 1, kMinModuleSlots)));
+        for (const auto& me : modules_) {
+            size_t i = me->path_hash & grown->mask;
+            while (grown->slots[i].load(std::memory_order_relaxed)) i = (i + 1) & grown->mask;
+            grown->slots[i].store(me.get(), std::memory_order_relaxed);
+        }
+        index = grown.get();
+        module_indexes_.push_back(std::move(grown));
+        module_index_.store(index, std::memory_order_release);
+    }
+
+    ModuleEntry* me = entry.get();
+    modules_.push_back(std::move(entry));
+    size_t i = me->path_hash & index->mask;
+    while (index->slots[i].load(std::memory_order_relaxed)) i = (i + 1) & index->mask;
+    index->slots[i].store(me, std::memory_order_release);
+    module_count_.store(modules_.size(), std::memory_order_release);
+    return me;
+}
+
+void HookRegistry::reserve_symbols_locked(ModuleEntry& me, size_t additional, size_t name_bytes) {
+    size_t count = me.symbol_count.load(std::memory_order_relaxed);
+    SymbolTable* table = me.table.load(std::memory_order_relaxed);
+    if (!table || (count + additional) * 2 > table->mask + 1) {
+        std::unique_ptr<SymbolTable> grown(
+            new SymbolTable(slots_for(count + additional, kMinSymbolSlots)));
+        if (table) {
+            for (size_t j = 0; j <= table->mask; ++j) {
+                const SymbolSlot& src = table->slots[j];
+                uint32_t idx = src.index.load(std::memory_order_relaxed);
+                if (idx == 0) continue;
+                size_t i = src.hash & grown->mask;
+                while (grown->slots[i].index.load(std::memory_order_relaxed)) i = (i + 1) & grown->mask;
+                SymbolSlot& dst = grown->slots[i];
+                dst.hash = src.hash;
+                dst.length = src.length;
+                dst.name = src.name;
+                dst.index.store(idx, std::memory_order_relaxed);
+            }
+        }
+        table = grown.get();
+        me.tables.push_back(std::move(grown));
+        me.table.store(table, std::memory_order_release);
+    }
+
+    // One chunk large enough for the whole batch
+    if (name_bytes > 0) {
+        bool fits = !me.arena.empty() &&
+                    me.arena.back().capacity - me.arena.back().used >= name_bytes;
+        if (!fits) {
+            size_t capacity = name_bytes > kArenaChunkBytes ? name_bytes : kArenaChunkBytes;
+            me.arena.push_back(NameChunk{std::unique_ptr<char[]>(new char[capacity]), 0, capacity});
+        }
     }
-    return register_symbol_locked(me, symbol);
 }
 
-uint64_t HookRegistry::register_symbol_locked(ModuleEntry& me, const std::string& symbol) {
-    auto it = me.name_to_index.find(symbol);
-    if (it != me.name_to_index.end()) {
-        return make_function_id(me.module_id, it->second);
+uint64_t HookRegistry::register_symbol_locked(ModuleEntry& me, const char* symbol, size_t length) {
+    SymbolTable* table = me.table.load(std::memory_order_relaxed);
+    uint32_t h = hash_bytes(symbol, length);
+    size_t i = h & table->mask;
+    for (;; i = (i + 1) & table->mask) {
+        const SymbolSlot& slot = table->slots[i];
+        uint32_t idx = slot.index.load(std::memory_order_relaxed);
+        if (idx == 0) break;
+        if (slot.hash == h && slot.length == length && std::memcmp(slot.name, symbol, length) == 0) {
+            return make_function_id(me.module_id, idx);
+        }
+    }
+
+    // Intern the name; records stay in index order so export can walk them
+    size_t record = arena_record_size(length);
+    if (me.arena.empty() || me.arena.back().capacity - me.arena.back().used < record) {
+        size_t capacity = record > kArenaChunkBytes ? record : kArenaChunkBytes;
+        me.arena.push_back(NameChunk{std::unique_ptr<char[]>(new char[capacity]), 0, capacity});
     }
+    NameChunk& chunk = me.arena.back();
+    char* rec = chunk.data.get() + chunk.used;
+    uint32_t len32 = static_cast<uint32_t>(length);
+    std::memcpy(rec, &len32, sizeof(len32));
+    char* name = rec + sizeof(len32);
+    std::memcpy(name, symbol, length);
+    name[length] = '\0';
+    chunk.used += record;
+
     uint32_t idx = me.next_index++;
-    me.name_to_index.emplace(symbol, idx);
+    SymbolSlot& slot = table->slots[i];
+    slot.hash = h;
+    slot.length = len32;
+    slot.name = name;
+    slot.index.store(idx, std::memory_order_release);
+    me.symbol_count.store(me.symbol_count.load(std::memory_order_relaxed) + 1,
+                          std::memory_order_release);
     return make_function_id(me.module_id, idx);
 }
 
-bool HookRegistry::get_id(const std::string& module_path, const std::string& symbol, uint64_t* out_id) const {
+uint64_t HookRegistry::register_symbol(const std::string& module_path, const std::string& symbol) {
     std::lock_guard<std::mutex> lock(mutex_);
-    auto it = modules_.find(module_path);
-    if (it == modules_.end()) return false;
-    const auto& me = it->second;
-    auto it2 = me.name_to_index.find(symbol);
-    if (it2 == me.name_to_index.end()) return false;
-    if (out_id) *out_id = make_function_id(me.module_id, it2->second);
-    return true;
+    ModuleEntry* me = get_or_create_module_locked(module_path);
+    reserve_symbols_locked(*me, 1, 0);
+    return register_symbol_locked(*me, symbol.data(), symbol.size());
 }
 
-uint32_t HookRegistry::get_module_id(const std::string& module_path) const {
+size_t HookRegistry::register_module_symbols(const std::string& module_path,
+                                             const std::vector<std::string>& symbols,
+                                             std::vector<uint64_t>* out_ids) {
+    size_t name_bytes = 0;
+    for (const auto& sym : symbols) name_bytes += arena_record_size(sym.size());
+
     std::lock_guard<std::mutex> lock(mutex_);
-    auto it = modules_.find(module_path);
-    if (it == modules_.end()) return 0u;
-    return it->second.module_id;
+    ModuleEntry* me = get_or_create_module_locked(module_path);
+    uint32_t before = me->symbol_count.load(std::memory_order_relaxed);
+    reserve_symbols_locked(*me, symbols.size(), name_bytes);
+    if (out_ids) {
+        out_ids->clear();
+        out_ids->reserve(symbols.size());
+    }
+    for (const auto& sym : symbols) {
+        uint64_t id = register_symbol_locked(*me, sym.data(), sym.size());
+        if (out_ids) out_ids->push_back(id);
+    }
+    return me->symbol_count.load(std::memory_order_relaxed) - before;
+}
+
+bool HookRegistry::get_id(const std::string& module_path, const std::string& symbol, uint64_t* out_id) const {
+    const ModuleEntry* me = find_module(module_path);
+    if (!me) return false;
+    const SymbolTable* table = me->table.load(std::memory_order_acquire);
+    if (!table) return false;
+    uint32_t h = hash_bytes(symbol.data(), symbol.size());
+    for (size_t i = h & table->mask;; i = (i + 1) & table->mask) {
+        const SymbolSlot& slot = table->slots[i];
+        uint32_t idx = slot.index.load(std::memory_order_acquire);
+        if (idx == 0) return false;
+        if (slot.hash == h && slot.length == symbol.size() &&
+            std::memcmp(slot.name, symbol.data(), symbol.size()) == 0) {
+            if (out_id) *out_id = make_function_id(me->module_id, idx);
+            return true;
+        }
+    }
+}
+
+uint32_t HookRegistry::get_module_id(const std::string& module_path) const {
+    const ModuleEntry* me = find_module(module_path);
+    return me ? me->module_id : 0u;
 }
 
 uint32_t HookRegistry::get_symbol_count(const std::string& module_path) const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto it = modules_.find(module_path);
-    if (it == modules_.end()) return 0u;
-    return static_cast<uint32_t>(it->second.name_to_index.size());
+    const ModuleEntry* me = find_module(module_path);
+    return me ? me->symbol_count.load(std::memory_order_acquire) : 0u;
 }
 
 void HookRegistry::clear() {
     std::lock_guard<std::mutex> lock(mutex_);
-    modules_.clear();
-}
-
-uint32_t HookRegistry::get_or_create_module_id_locked(const std::string& module_path) {
-    auto& me = modules_[module_path];
-    if (me.module_id == 0) {
-        me.module_id = fnv1a32_ci(module_path);
-        me.next_index = 1u;
+    module_index_.store(nullptr, std::memory_order_release);
+    module_count_.store(0, std::memory_order_release);
+    // Readers may still be probing the old index or a module's tables; both
+    // are retired rather than freed (module_indexes_ keeps every index)
+    for (auto& me : modules_) {
+        retired_modules_.push_back(std::move(me));
     }
-    return me.module_id;
+    modules_.clear();
 }
 
 void HookRegistry::set_module_metadata(const std::string& module_path,
@@ -117,83 +374,87 @@ void HookRegistry::set_module_metadata(const std::string& module_path,
                                        uint64_t size,
                                        const uint8_t uuid[16]) {
     std::lock_guard<std::mutex> lock(mutex_);
-    auto it = modules_.find(module_path);
-    if (it == modules_.end()) {
-        // Module not registered yet, create entry
-        auto& me = modules_[module_path];
-        me.module_id = fnv1a32_ci(module_path);
-        me.next_index = 1u;
-        me.base_address = base_address;
-        me.size = size;
-        std::memcpy(me.uuid, uuid, 16);
-        me.metadata_set = true;
-    } else {
-        it->second.base_address = base_address;
-        it->second.size = size;
-        std::memcpy(it->second.uuid, uuid, 16);
-        it->second.metadata_set = true;
-    }
+    // Creates the entry if the module has no symbols yet
+    ModuleEntry* me = get_or_create_module_locked(module_path);
+    me->base_address = base_address;
+    me->size = size;
+    std::memcpy(me->uuid, uuid, 16);
+    me->metadata_set = true;
 }
 
 size_t HookRegistry::module_count() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return modules_.size();
+    return module_count_.load(std::memory_order_acquire);
 }
 
-std::string HookRegistry::export_to_json() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    std::ostringstream oss;
-
+template <typename Sink>
+void HookRegistry::write_json_to(Sink& sink) const {
     // Modules array
-    oss << "\"modules\": [\n";
+    put(sink, "\"modules\": [\n");
     bool first_module = true;
-    for (const auto& kv : modules_) {
-        const std::string& path = kv.first;
-        const ModuleEntry& me = kv.second;
+    for (const auto& entry : modules_) {
+        const ModuleEntry& me = *entry;
 
-        if (!first_module) oss << ",\n";
+        if (!first_module) put(sink, ",\n");
         first_module = false;
 
-        oss << "    {\n";
-        oss << "      \"module_id\": " << me.module_id << ",\n";
-        oss << "      \"path\": \"" << json_escape(path) << "\"";
+        put_format(sink, "    {\n      \"module_id\": %llu,\n      \"path\": \"", me.module_id);
+        put_escaped(sink, me.path.data(), me.path.size());
+        put(sink, "\"");
 
         if (me.metadata_set) {
-            oss << ",\n";
-            oss << "      \"base_address\": \"0x" << std::hex << me.base_address << std::dec << "\",\n";
-            oss << "      \"size\": " << me.size << ",\n";
-            oss << "      \"uuid\": \"" << format_uuid(me.uuid) << "\"";
+            put_format(sink, ",\n      \"base_address\": \"0x%llx\",\n", me.base_address);
+            put_format(sink, "      \"size\": %llu,\n      \"uuid\": \"", me.size);
+            put_uuid(sink, me.uuid);
+            put(sink, "\"");
         }
-        oss << "\n    }";
+        put(sink, "\n    }");
     }
-    oss << "\n  ],\n";
+    put(sink, "\n  ],\n");
 
-    // Symbols array
-    oss << "  \"symbols\": [\n";
+    // Symbols array, streamed from each module's arena in index order
+    put(sink, "  \"symbols\": [\n");
     bool first_symbol = true;
-    for (const auto& kv : modules_) {
-        const ModuleEntry& me = kv.second;
-        for (const auto& sym_kv : me.name_to_index) {
-            const std::string& symbol_name = sym_kv.first;
-            uint32_t symbol_index = sym_kv.second;
-            uint64_t function_id = make_function_id(me.module_id, symbol_index);
-
-            if (!first_symbol) oss << ",\n";
-            first_symbol = false;
-
-            oss << "    {\n";
-            oss << "      \"function_id\": \"0x" << std::hex << std::setw(16) << std::setfill('0') << function_id << std::dec << "\",\n";
-            oss << "      \"module_id\": " << me.module_id << ",\n";
-            oss << "      \"symbol_index\": " << symbol_index << ",\n";
-            oss << "      \"name\": \"" << json_escape(symbol_name) << "\"\n";
-            oss << "    }";
+    for (const auto& entry : modules_) {
+        const ModuleEntry& me = *entry;
+        uint32_t symbol_index = 1u;
+        for (const NameChunk& chunk : me.arena) {
+            for (size_t off = 0; off < chunk.used; ++symbol_index) {
+                const char* rec = chunk.data.get() + off;
+                uint32_t length;
+                std::memcpy(&length, rec, sizeof(length));
+                off += arena_record_size(length);
+
+                if (!first_symbol) put(sink, ",\n");
+                first_symbol = false;
+
+                put_format(sink, "    {\n      \"function_id\": \"0x%016llx\",\n",
+                           make_function_id(me.module_id, symbol_index));
+                put_format(sink, "      \"module_id\": %llu,\n", me.module_id);
+                put_format(sink, "      \"symbol_index\": %llu,\n      \"name\": \"", symbol_index);
+                put_escaped(sink, rec + sizeof(length), length);
+                put(sink, "\"\n    }");
+            }
         }
     }
-    oss << "\n  ]";
+    put(sink, "\n  ]");
+}
+
+std::string HookRegistry::export_to_json() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::string out;
+    StringSink sink{out};
+    write_json_to(sink);
+    return out;
+}
 
-    return oss.str();
+size_t HookRegistry::write_json(FILE* out) const {
+    if (!out) return 0;
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::unique_ptr<FileSink> sink(new FileSink{out, 0, 0, {}});
+    write_json_to(*sink);
+    sink->flush();
+    return sink->written;
 }
 
 } // namespace agent
 } // namespace ada
-
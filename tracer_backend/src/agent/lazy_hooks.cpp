@@ -0,0 +1,83 @@
+#include <tracer_backend/agent/lazy_hooks.h>
+
+#include <cstdlib>
+#include <cstring>
+
+namespace ada {
+namespace agent {
+
+namespace {
+
+uint32_t env_u32(const char* name, uint32_t fallback) {
+    const char* env = getenv(name);
+    if (!env || env[0] == '\0') return fallback;
+    char* end = nullptr;
+    unsigned long value = strtoul(env, &end, 10);
+    if (end == env || value == 0 || value > UINT32_MAX) return fallback;
+    return static_cast<uint32_t>(value);
+}
+
+} // anonymous namespace
+
+LazyHookConfig lazy_hook_config_from_env() {
+    LazyHookConfig config;
+    const char* mode = getenv("ADA_HOOK_MODE");
+    config.enabled = mode && strcmp(mode, "lazy") == 0;
+    config.budget = env_u32("ADA_LAZY_HOOK_BUDGET", ADA_LAZY_HOOK_DEFAULT_BUDGET);
+    config.promote_interval_ms = env_u32("ADA_LAZY_PROMOTE_MS", ADA_LAZY_PROMOTE_DEFAULT_MS);
+    return config;
+}
+
+LazyHookTracker::LazyHookTracker(size_t probes, uint32_t budget)
+    : probes_(probes),
+      budget_(budget),
+      states_(new std::atomic<uint32_t>[probes ? probes : 1]),
+      queue_(new std::atomic<uint32_t>[probes ? probes : 1]),
+      tail_(0),
+      head_(0),
+      promoted_(0),
+      over_budget_(0) {
+    for (size_t i = 0; i < probes; ++i) {
+        states_[i].store(LAZY_HOOK_COLD, std::memory_order_relaxed);
+        queue_[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+size_t LazyHookTracker::take_hits(std::vector<uint32_t>* promote, std::vector<uint32_t>* drop) {
+    size_t taken = 0;
+    // Stop at the first position a producer has claimed but not yet published
+    while (head_ < probes_) {
+        uint32_t entry = queue_[head_].load(std::memory_order_acquire);
+        if (entry == 0) break;
+        uint32_t slot = entry - 1;
+        head_++;
+        taken++;
+        if (promoted_.load(std::memory_order_relaxed) < budget_) {
+            states_[slot].store(LAZY_HOOK_PROMOTED, std::memory_order_release);
+            promoted_.fetch_add(1, std::memory_order_relaxed);
+            if (promote) promote->push_back(slot);
+        } else {
+            states_[slot].store(LAZY_HOOK_OVER_BUDGET, std::memory_order_release);
+            over_budget_.fetch_add(1, std::memory_order_relaxed);
+            if (drop) drop->push_back(slot);
+        }
+    }
+    return taken;
+}
+
+uint32_t LazyHookTracker::state(uint32_t slot) const {
+    if (slot >= probes_) return LAZY_HOOK_COLD;
+    return states_[slot].load(std::memory_order_acquire);
+}
+
+LazyHookStats LazyHookTracker::stats() const {
+    LazyHookStats s;
+    s.probes = static_cast<uint32_t>(probes_);
+    s.hits = static_cast<uint32_t>(tail_.load(std::memory_order_relaxed));
+    s.promoted = promoted_.load(std::memory_order_relaxed);
+    s.over_budget = over_budget_.load(std::memory_order_relaxed);
+    return s;
+}
+
+} // namespace agent
+} // namespace ada
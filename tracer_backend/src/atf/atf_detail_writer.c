@@ -2,10 +2,12 @@
  * @file atf_detail_writer.c
  * @brief Implementation of ATF v2 detail file writer
  *
- * Writes variable-length detail events to disk with length prefixes.
+ * Writes variable-length detail events to disk with length prefixes through
+ * a pluggable file sink (buffered stdio or batched io_uring).
  */
 
 #include "atf_detail_writer_private.h"
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <errno.h>
@@ -70,6 +72,14 @@ static void get_directory(const char* filepath, char* dir, size_t dir_size) {
 AtfDetailWriter* atf_detail_writer_create(const char* filepath,
                                           uint32_t thread_id,
                                           uint8_t clock_type) {
+    return atf_detail_writer_create_with_backend(filepath, thread_id, clock_type,
+                                                 ATF_WRITER_BACKEND_STDIO);
+}
+
+AtfDetailWriter* atf_detail_writer_create_with_backend(const char* filepath,
+                                                       uint32_t thread_id,
+                                                       uint8_t clock_type,
+                                                       AtfWriterBackend backend) {
     if (!filepath) return NULL;
 
     /* Create directory if needed */
@@ -84,8 +94,8 @@ AtfDetailWriter* atf_detail_writer_create(const char* filepath,
     if (!writer) return NULL; // LCOV_EXCL_LINE
 
     /* Open file for writing */
-    writer->file = fopen(filepath, "wb");
-    if (!writer->file) {
+    writer->sink = atf_file_sink_open(filepath, backend);
+    if (!writer->sink) {
         free(writer);
         return NULL;
     }
@@ -115,8 +125,8 @@ AtfDetailWriter* atf_detail_writer_create(const char* filepath,
     writer->header.index_seq_start = 0;
     writer->header.index_seq_end = 0;
 
-    if (fwrite(&writer->header, sizeof(writer->header), 1, writer->file) != 1) { // LCOV_EXCL_START
-        fclose(writer->file);
+    if (atf_file_sink_append(writer->sink, &writer->header, sizeof(writer->header)) != 0) { // LCOV_EXCL_START
+        atf_file_sink_close(writer->sink);
         free(writer);
         return NULL;
     } // LCOV_EXCL_STOP
@@ -130,7 +140,7 @@ int atf_detail_writer_write_event(AtfDetailWriter* writer,
                                   uint16_t event_type,
                                   const void* payload,
                                   size_t payload_size) {
-    if (!writer || !writer->file) return -EINVAL;
+    if (!writer || !writer->sink) return -EINVAL;
     if (!payload && payload_size > 0) return -EINVAL;
 
     /* Build event header */
@@ -157,13 +167,13 @@ int atf_detail_writer_write_event(AtfDetailWriter* writer,
     }
 
     /* Write header */
-    if (fwrite(&header, sizeof(header), 1, writer->file) != 1) { // LCOV_EXCL_LINE
+    if (atf_file_sink_append(writer->sink, &header, sizeof(header)) != 0) { // LCOV_EXCL_LINE
         return -EIO; // LCOV_EXCL_LINE
     } // LCOV_EXCL_LINE
 
     /* Write payload */
     if (payload_size > 0) {
-        if (fwrite(payload, payload_size, 1, writer->file) != 1) { // LCOV_EXCL_LINE
+        if (atf_file_sink_append(writer->sink, payload, payload_size) != 0) { // LCOV_EXCL_LINE
             return -EIO; // LCOV_EXCL_LINE
         } // LCOV_EXCL_LINE
     }
@@ -175,12 +185,7 @@ int atf_detail_writer_write_event(AtfDetailWriter* writer,
 }
 
 int atf_detail_writer_finalize(AtfDetailWriter* writer) {
-    if (!writer || !writer->file) return -EINVAL;
-
-    /* Flush events */
-    if (fflush(writer->file) != 0) { // LCOV_EXCL_LINE
-        return -EIO; // LCOV_EXCL_LINE
-    } // LCOV_EXCL_LINE
+    if (!writer || !writer->sink) return -EINVAL;
 
     /* Write footer */
     AtfDetailFooter footer;
@@ -192,7 +197,7 @@ int atf_detail_writer_finalize(AtfDetailWriter* writer) {
     footer.time_start_ns = writer->time_start_ns;
     footer.time_end_ns = writer->time_end_ns;
 
-    if (fwrite(&footer, sizeof(footer), 1, writer->file) != 1) { // LCOV_EXCL_LINE
+    if (atf_file_sink_append(writer->sink, &footer, sizeof(footer)) != 0) { // LCOV_EXCL_LINE
         return -EIO; // LCOV_EXCL_LINE
     } // LCOV_EXCL_LINE
 
@@ -202,17 +207,13 @@ int atf_detail_writer_finalize(AtfDetailWriter* writer) {
     writer->header.index_seq_start = writer->index_seq_start;
     writer->header.index_seq_end = writer->index_seq_end;
 
-    /* Seek to beginning and rewrite header */
-    if (fseek(writer->file, 0, SEEK_SET) != 0) { // LCOV_EXCL_LINE
+    /* Rewrite header in place */
+    if (atf_file_sink_write_at(writer->sink, &writer->header, sizeof(writer->header), 0) != 0) { // LCOV_EXCL_LINE
         return -EIO; // LCOV_EXCL_LINE
     } // LCOV_EXCL_LINE
 
-    if (fwrite(&writer->header, sizeof(writer->header), 1, writer->file) != 1) { // LCOV_EXCL_LINE
-        return -EIO; // LCOV_EXCL_LINE
-    } // LCOV_EXCL_LINE
-
-    /* Flush header */
-    if (fflush(writer->file) != 0) { // LCOV_EXCL_LINE
+    /* Flush events, footer and header */
+    if (atf_file_sink_flush(writer->sink) != 0) { // LCOV_EXCL_LINE
         return -EIO; // LCOV_EXCL_LINE
     } // LCOV_EXCL_LINE
 
@@ -222,9 +223,7 @@ int atf_detail_writer_finalize(AtfDetailWriter* writer) {
 void atf_detail_writer_close(AtfDetailWriter* writer) {
     if (!writer) return;
 
-    if (writer->file) {
-        fclose(writer->file);
-    }
+    atf_file_sink_close(writer->sink);
 
     free(writer);
 }
@@ -10,7 +10,7 @@
 #define TRACER_BACKEND_ATF_DETAIL_WRITER_PRIVATE_H
 
 #include <tracer_backend/atf/atf_v2_types.h>
-#include <stdio.h>
+#include "atf_file_sink_private.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -20,7 +20,7 @@ extern "C" {
  * Detail file writer state
  */
 typedef struct {
-    FILE* file;                  /* File handle */
+    AtfFileSink* sink;           /* Output file (stdio or io_uring backend) */
     AtfDetailHeader header;      /* Header (updated at finalize) */
     uint32_t event_count;        /* Number of events written */
     uint64_t bytes_written;      /* Total bytes written (events only) */
@@ -44,6 +44,20 @@ AtfDetailWriter* atf_detail_writer_create(const char* filepath,
                                           uint32_t thread_id,
                                           uint8_t clock_type);
 
+/**
+ * Create a detail writer using a specific file I/O backend
+ *
+ * @param filepath Path to detail file
+ * @param thread_id Thread ID
+ * @param clock_type Clock type
+ * @param backend Requested backend (falls back to stdio when unavailable)
+ * @return Pointer to writer, or NULL on error
+ */
+AtfDetailWriter* atf_detail_writer_create_with_backend(const char* filepath,
+                                                       uint32_t thread_id,
+                                                       uint8_t clock_type,
+                                                       AtfWriterBackend backend);
+
 /**
  * Write a detail event
  *
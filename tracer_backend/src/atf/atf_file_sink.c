@@ -0,0 +1,116 @@
+/**
+ * @file atf_file_sink.c
+ * @brief Backend selection and the portable stdio file sink
+ */
+
+#include "atf_file_sink_private.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+
+/* ===== stdio backend ===== */
+
+typedef struct {
+    AtfFileSink base;
+    FILE* file;
+} AtfStdioSink;
+
+static int stdio_sink_append(AtfFileSink* sink, const void* data, size_t size) {
+    AtfStdioSink* s = (AtfStdioSink*)sink;
+    if (size == 0) return 0;
+
+    if (fwrite(data, size, 1, s->file) != 1) { // LCOV_EXCL_LINE
+        return -EIO; // LCOV_EXCL_LINE
+    } // LCOV_EXCL_LINE
+
+    sink->size += size;
+    return 0;
+}
+
+static int stdio_sink_write_at(AtfFileSink* sink, const void* data, size_t size,
+                               uint64_t offset) {
+    AtfStdioSink* s = (AtfStdioSink*)sink;
+    if (offset + size > sink->size) return -EINVAL;
+
+    if (fseek(s->file, (long)offset, SEEK_SET) != 0) { // LCOV_EXCL_LINE
+        return -EIO; // LCOV_EXCL_LINE
+    } // LCOV_EXCL_LINE
+
+    int ret = 0;
+    if (size > 0 && fwrite(data, size, 1, s->file) != 1) { // LCOV_EXCL_LINE
+        ret = -EIO; // LCOV_EXCL_LINE
+    } // LCOV_EXCL_LINE
+
+    /* Restore the append position */
+    if (fseek(s->file, 0, SEEK_END) != 0) { // LCOV_EXCL_LINE
+        return -EIO; // LCOV_EXCL_LINE
+    } // LCOV_EXCL_LINE
+
+    return ret;
+}
+
+static int stdio_sink_flush(AtfFileSink* sink) {
+    AtfStdioSink* s = (AtfStdioSink*)sink;
+
+    if (fflush(s->file) != 0) { // LCOV_EXCL_LINE
+        return -EIO; // LCOV_EXCL_LINE
+    } // LCOV_EXCL_LINE
+
+    return 0;
+}
+
+static void stdio_sink_close(AtfFileSink* sink) {
+    AtfStdioSink* s = (AtfStdioSink*)sink;
+    fclose(s->file);
+    free(s);
+}
+
+static const AtfFileSinkOps k_stdio_sink_ops = {
+    stdio_sink_append,
+    stdio_sink_write_at,
+    stdio_sink_flush,
+    stdio_sink_close,
+};
+
+AtfFileSink* atf_file_sink_open_stdio(const char* path) {
+    if (!path) return NULL;
+
+    AtfStdioSink* s = (AtfStdioSink*)calloc(1, sizeof(AtfStdioSink));
+    if (!s) return NULL; // LCOV_EXCL_LINE
+
+    s->file = fopen(path, "wb");
+    if (!s->file) {
+        free(s);
+        return NULL;
+    }
+
+    s->base.ops = &k_stdio_sink_ops;
+    s->base.backend = ATF_WRITER_BACKEND_STDIO;
+    s->base.size = 0;
+    return &s->base;
+}
+
+/* ===== Backend selection ===== */
+
+AtfFileSink* atf_file_sink_open(const char* path, AtfWriterBackend backend) {
+    if (!path) return NULL;
+
+    if (backend == ATF_WRITER_BACKEND_MMAP) {
+        AtfFileSink* sink = atf_file_sink_open_mmap(path);
+        if (sink) {
+            return sink;
+        }
+    }
+
+#if defined(ADA_ATF_HAVE_IO_URING)
+    if (backend == ATF_WRITER_BACKEND_IO_URING || backend == ATF_WRITER_BACKEND_AUTO) {
+        AtfFileSink* sink = atf_file_sink_open_io_uring(path);
+        if (sink) {
+            return sink;
+        }
+        /* Ring unavailable (old kernel, seccomp, RLIMIT_MEMLOCK): use stdio */
+    }
+#endif
+
+    return atf_file_sink_open_stdio(path);
+}
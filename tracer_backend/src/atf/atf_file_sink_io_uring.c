@@ -0,0 +1,429 @@
+/**
+ * @file atf_file_sink_io_uring.c
+ * @brief io_uring file sink (Linux)
+ *
+ * Appends are copied into a small set of page-aligned staging buffers. Each
+ * full buffer is submitted as one positioned IORING_OP_WRITEV and the next
+ * buffer is filled while up to ATF_URING_BUFFER_COUNT - 1 writes are still
+ * in flight, so the drain thread never blocks in write(2) on the hot path.
+ *
+ * The ring is driven with the raw io_uring_setup/io_uring_enter syscalls so
+ * no liburing dependency is needed. WRITEV (kernel 5.1) is used instead of
+ * WRITE (5.6) so any kernel that can create a ring can also run the sink.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE  /* syscall, pwrite, MAP_POPULATE, O_CLOEXEC under -std=c11 */
+#endif
+
+#include "atf_file_sink_private.h"
+
+#if defined(ADA_ATF_HAVE_IO_URING)
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup 425
+#endif
+#ifndef __NR_io_uring_enter
+#define __NR_io_uring_enter 426
+#endif
+
+#define ATF_URING_QUEUE_DEPTH   8u
+#define ATF_URING_BUFFER_COUNT  4u
+#define ATF_URING_BUFFER_SIZE   (256u * 1024u)
+#define ATF_URING_BUFFER_ALIGN  4096u
+#define ATF_URING_SYNC_TAG      UINT64_MAX
+
+_Static_assert(ATF_URING_BUFFER_COUNT + 1 <= ATF_URING_QUEUE_DEPTH,
+               "Queue must hold every staging buffer plus one positioned write");
+
+/**
+ * Staging buffer (one in-flight write at most)
+ */
+typedef struct {
+    uint8_t* data;          /* ATF_URING_BUFFER_ALIGN-aligned storage */
+    size_t used;            /* Bytes staged */
+    uint64_t offset;        /* File offset of data[0] once submitted */
+    struct iovec iov;       /* Must stay valid while in flight */
+    int in_flight;
+} AtfUringBuffer;
+
+typedef struct {
+    AtfFileSink base;
+    int fd;
+    int ring_fd;
+
+    /* Submission queue */
+    void* sq_ring;
+    size_t sq_ring_size;
+    unsigned* sq_tail;
+    unsigned* sq_mask;
+    unsigned* sq_array;
+    struct io_uring_sqe* sqes;
+    size_t sqes_size;
+
+    /* Completion queue (aliases sq_ring with IORING_FEAT_SINGLE_MMAP) */
+    void* cq_ring;
+    size_t cq_ring_size;
+    unsigned* cq_head;
+    unsigned* cq_tail;
+    unsigned* cq_mask;
+    struct io_uring_cqe* cqes;
+
+    /* Staging */
+    AtfUringBuffer buffers[ATF_URING_BUFFER_COUNT];
+    uint32_t current;        /* Buffer being filled */
+    uint64_t next_offset;    /* File offset of the current buffer */
+    uint32_t in_flight;      /* Submitted, not yet completed */
+
+    /* Positioned (synchronous) write */
+    struct iovec sync_iov;
+    uint64_t sync_offset;
+    int sync_pending;
+    int sync_result;
+
+    int error;               /* First asynchronous write error (sticky) */
+} AtfUringSink;
+
+/* ===== Syscall helpers ===== */
+
+static int uring_enter(int ring_fd, unsigned to_submit, unsigned min_complete, unsigned flags) {
+    long ret;
+    do {
+        ret = syscall(__NR_io_uring_enter, ring_fd, to_submit, min_complete, flags, NULL, 0);
+    } while (ret < 0 && errno == EINTR && to_submit == 0);
+    return ret < 0 ? -errno : (int)ret;
+}
+
+/* Complete a short write synchronously */
+static int pwrite_all(int fd, const uint8_t* data, size_t size, uint64_t offset) {
+    while (size > 0) {
+        ssize_t n = pwrite(fd, data, size, (off_t)offset);
+        if (n < 0) { // LCOV_EXCL_START
+            if (errno == EINTR) continue;
+            return -errno;
+        } // LCOV_EXCL_STOP
+        data += n;
+        size -= (size_t)n;
+        offset += (uint64_t)n;
+    }
+    return 0;
+}
+
+/* ===== Ring operations ===== */
+
+static int uring_submit_writev(AtfUringSink* s, const struct iovec* iov,
+                               uint64_t offset, uint64_t user_data) {
+    unsigned tail = *s->sq_tail;
+    unsigned idx = tail & *s->sq_mask;
+
+    struct io_uring_sqe* sqe = &s->sqes[idx];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = IORING_OP_WRITEV;
+    sqe->fd = s->fd;
+    sqe->addr = (uint64_t)(uintptr_t)iov;
+    sqe->len = 1;
+    sqe->off = offset;
+    sqe->user_data = user_data;
+
+    s->sq_array[idx] = idx;
+    __atomic_store_n(s->sq_tail, tail + 1, __ATOMIC_RELEASE);
+
+    int ret = uring_enter(s->ring_fd, 1, 0, 0);
+    if (ret < 0) { // LCOV_EXCL_START
+        /* Withdraw the entry so the ring stays consistent */
+        __atomic_store_n(s->sq_tail, tail, __ATOMIC_RELEASE);
+        return ret;
+    } // LCOV_EXCL_STOP
+
+    s->in_flight++;
+    return 0;
+}
+
+static void uring_complete(AtfUringSink* s, uint64_t user_data, int32_t res) {
+    s->in_flight--;
+
+    const struct iovec* iov;
+    uint64_t offset;
+    if (user_data == ATF_URING_SYNC_TAG) {
+        iov = &s->sync_iov;
+        offset = s->sync_offset;
+        s->sync_pending = 0;
+    } else {
+        AtfUringBuffer* b = &s->buffers[user_data];
+        iov = &b->iov;
+        offset = b->offset;
+        b->in_flight = 0;
+        b->used = 0;
+    }
+
+    int ret = 0;
+    if (res < 0) { // LCOV_EXCL_LINE
+        ret = res; // LCOV_EXCL_LINE
+    } else if ((size_t)res < iov->iov_len) { // LCOV_EXCL_START
+        ret = pwrite_all(s->fd, (const uint8_t*)iov->iov_base + res,
+                         iov->iov_len - (size_t)res, offset + (uint64_t)res);
+    } // LCOV_EXCL_STOP
+
+    if (user_data == ATF_URING_SYNC_TAG) {
+        s->sync_result = ret;
+    } else if (ret != 0 && s->error == 0) { // LCOV_EXCL_LINE
+        s->error = ret; // LCOV_EXCL_LINE
+    }
+}
+
+/* Reap available completions, blocking for at least one if wait is set */
+static int uring_reap(AtfUringSink* s, int wait) {
+    if (wait) {
+        int ret = uring_enter(s->ring_fd, 0, 1, IORING_ENTER_GETEVENTS);
+        if (ret < 0) return ret; // LCOV_EXCL_LINE
+    }
+
+    unsigned head = *s->cq_head;
+    unsigned tail = __atomic_load_n(s->cq_tail, __ATOMIC_ACQUIRE);
+    while (head != tail) {
+        const struct io_uring_cqe* cqe = &s->cqes[head & *s->cq_mask];
+        uring_complete(s, cqe->user_data, cqe->res);
+        head++;
+    }
+    __atomic_store_n(s->cq_head, head, __ATOMIC_RELEASE);
+    return 0;
+}
+
+static int uring_wait_all(AtfUringSink* s) {
+    while (s->in_flight > 0) {
+        int ret = uring_reap(s, 1);
+        if (ret < 0) return ret; // LCOV_EXCL_LINE
+    }
+    return 0;
+}
+
+/* Submit the current buffer and make the next one available for staging */
+static int uring_submit_current(AtfUringSink* s) {
+    AtfUringBuffer* b = &s->buffers[s->current];
+    if (b->used == 0) return 0;
+
+    b->offset = s->next_offset;
+    b->iov.iov_base = b->data;
+    b->iov.iov_len = b->used;
+
+    int ret = uring_submit_writev(s, &b->iov, b->offset, s->current);
+    if (ret < 0) return ret; // LCOV_EXCL_LINE
+    b->in_flight = 1;
+    s->next_offset += b->used;
+
+    s->current = (s->current + 1) % ATF_URING_BUFFER_COUNT;
+    AtfUringBuffer* next = &s->buffers[s->current];
+    while (next->in_flight) {
+        ret = uring_reap(s, 1);
+        if (ret < 0) return ret; // LCOV_EXCL_LINE
+    }
+
+    /* Opportunistically retire other finished writes */
+    uring_reap(s, 0);
+    return s->error;
+}
+
+/* ===== Sink operations ===== */
+
+static int uring_sink_append(AtfFileSink* sink, const void* data, size_t size) {
+    AtfUringSink* s = (AtfUringSink*)sink;
+    if (s->error) return s->error;
+
+    const uint8_t* src = (const uint8_t*)data;
+    while (size > 0) {
+        AtfUringBuffer* b = &s->buffers[s->current];
+        size_t space = ATF_URING_BUFFER_SIZE - b->used;
+        size_t n = size < space ? size : space;
+
+        memcpy(b->data + b->used, src, n);
+        b->used += n;
+        sink->size += n;
+        src += n;
+        size -= n;
+
+        if (b->used == ATF_URING_BUFFER_SIZE) {
+            int ret = uring_submit_current(s);
+            if (ret < 0) return ret; // LCOV_EXCL_LINE
+        }
+    }
+
+    return 0;
+}
+
+static int uring_sink_flush(AtfFileSink* sink) {
+    AtfUringSink* s = (AtfUringSink*)sink;
+
+    int ret = uring_submit_current(s);
+    if (ret < 0) return ret; // LCOV_EXCL_LINE
+
+    ret = uring_wait_all(s);
+    if (ret < 0) return ret; // LCOV_EXCL_LINE
+
+    return s->error;
+}
+
+static int uring_sink_write_at(AtfFileSink* sink, const void* data, size_t size,
+                               uint64_t offset) {
+    AtfUringSink* s = (AtfUringSink*)sink;
+    if (offset + size > sink->size) return -EINVAL;
+    if (size == 0) return 0;
+
+    /* Earlier appends may cover the same range; they must land first */
+    int ret = uring_sink_flush(sink);
+    if (ret < 0) return ret; // LCOV_EXCL_LINE
+
+    s->sync_iov.iov_base = (void*)data;
+    s->sync_iov.iov_len = size;
+    s->sync_offset = offset;
+    s->sync_pending = 1;
+    s->sync_result = 0;
+
+    ret = uring_submit_writev(s, &s->sync_iov, offset, ATF_URING_SYNC_TAG);
+    if (ret < 0) { // LCOV_EXCL_START
+        s->sync_pending = 0;
+        return ret;
+    } // LCOV_EXCL_STOP
+
+    while (s->sync_pending) {
+        ret = uring_reap(s, 1);
+        if (ret < 0) return ret; // LCOV_EXCL_LINE
+    }
+
+    return s->sync_result;
+}
+
+static void uring_sink_destroy(AtfUringSink* s) {
+    if (s->cq_ring && s->cq_ring != MAP_FAILED && s->cq_ring != s->sq_ring) {
+        munmap(s->cq_ring, s->cq_ring_size);
+    }
+    if (s->sq_ring && s->sq_ring != MAP_FAILED) {
+        munmap(s->sq_ring, s->sq_ring_size);
+    }
+    if (s->sqes && s->sqes != MAP_FAILED) {
+        munmap(s->sqes, s->sqes_size);
+    }
+    if (s->ring_fd >= 0) {
+        close(s->ring_fd);
+    }
+    if (s->fd >= 0) {
+        close(s->fd);
+    }
+    for (uint32_t i = 0; i < ATF_URING_BUFFER_COUNT; i++) {
+        free(s->buffers[i].data);
+    }
+    free(s);
+}
+
+static void uring_sink_close(AtfFileSink* sink) {
+    AtfUringSink* s = (AtfUringSink*)sink;
+
+    /* Staging buffers must not be freed while the kernel still reads them */
+    (void)uring_sink_flush(sink);
+    (void)uring_wait_all(s);
+    uring_sink_destroy(s);
+}
+
+static const AtfFileSinkOps k_uring_sink_ops = {
+    uring_sink_append,
+    uring_sink_write_at,
+    uring_sink_flush,
+    uring_sink_close,
+};
+
+/* ===== Setup ===== */
+
+static int uring_map_rings(AtfUringSink* s, const struct io_uring_params* p) {
+    s->sq_ring_size = p->sq_off.array + p->sq_entries * sizeof(unsigned);
+    s->cq_ring_size = p->cq_off.cqes + p->cq_entries * sizeof(struct io_uring_cqe);
+
+    int single_mmap = (p->features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap) {
+        if (s->cq_ring_size > s->sq_ring_size) s->sq_ring_size = s->cq_ring_size;
+        s->cq_ring_size = s->sq_ring_size;
+    }
+
+    s->sq_ring = mmap(NULL, s->sq_ring_size, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, s->ring_fd, IORING_OFF_SQ_RING);
+    if (s->sq_ring == MAP_FAILED) return -errno; // LCOV_EXCL_LINE
+
+    if (single_mmap) {
+        s->cq_ring = s->sq_ring;
+    } else { // LCOV_EXCL_START
+        s->cq_ring = mmap(NULL, s->cq_ring_size, PROT_READ | PROT_WRITE,
+                          MAP_SHARED | MAP_POPULATE, s->ring_fd, IORING_OFF_CQ_RING);
+        if (s->cq_ring == MAP_FAILED) return -errno;
+    } // LCOV_EXCL_STOP
+
+    s->sqes_size = p->sq_entries * sizeof(struct io_uring_sqe);
+    s->sqes = (struct io_uring_sqe*)mmap(NULL, s->sqes_size, PROT_READ | PROT_WRITE,
+                                         MAP_SHARED | MAP_POPULATE, s->ring_fd,
+                                         IORING_OFF_SQES);
+    if (s->sqes == MAP_FAILED) return -errno; // LCOV_EXCL_LINE
+
+    uint8_t* sq = (uint8_t*)s->sq_ring;
+    s->sq_tail = (unsigned*)(sq + p->sq_off.tail);
+    s->sq_mask = (unsigned*)(sq + p->sq_off.ring_mask);
+    s->sq_array = (unsigned*)(sq + p->sq_off.array);
+
+    uint8_t* cq = (uint8_t*)s->cq_ring;
+    s->cq_head = (unsigned*)(cq + p->cq_off.head);
+    s->cq_tail = (unsigned*)(cq + p->cq_off.tail);
+    s->cq_mask = (unsigned*)(cq + p->cq_off.ring_mask);
+    s->cqes = (struct io_uring_cqe*)(cq + p->cq_off.cqes);
+    return 0;
+}
+
+AtfFileSink* atf_file_sink_open_io_uring(const char* path) {
+    if (!path) return NULL;
+
+    AtfUringSink* s = (AtfUringSink*)calloc(1, sizeof(AtfUringSink));
+    if (!s) return NULL; // LCOV_EXCL_LINE
+    s->fd = -1;
+
+    /* Ring first: if the kernel refuses it the caller falls back to stdio */
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    s->ring_fd = (int)syscall(__NR_io_uring_setup, ATF_URING_QUEUE_DEPTH, &params);
+    if (s->ring_fd < 0) { // LCOV_EXCL_START
+        s->ring_fd = -1;
+        uring_sink_destroy(s);
+        return NULL;
+    } // LCOV_EXCL_STOP
+
+    if (uring_map_rings(s, &params) != 0) { // LCOV_EXCL_START
+        uring_sink_destroy(s);
+        return NULL;
+    } // LCOV_EXCL_STOP
+
+    for (uint32_t i = 0; i < ATF_URING_BUFFER_COUNT; i++) {
+        void* data = NULL;
+        if (posix_memalign(&data, ATF_URING_BUFFER_ALIGN, ATF_URING_BUFFER_SIZE) != 0) { // LCOV_EXCL_START
+            uring_sink_destroy(s);
+            return NULL;
+        } // LCOV_EXCL_STOP
+        s->buffers[i].data = (uint8_t*)data;
+    }
+
+    s->fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (s->fd < 0) {
+        uring_sink_destroy(s);
+        return NULL;
+    }
+
+    s->base.ops = &k_uring_sink_ops;
+    s->base.backend = ATF_WRITER_BACKEND_IO_URING;
+    s->base.size = 0;
+    return &s->base;
+}
+
+#endif /* ADA_ATF_HAVE_IO_URING */
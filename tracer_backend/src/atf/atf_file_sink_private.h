@@ -0,0 +1,121 @@
+/**
+ * @file atf_file_sink_private.h
+ * @brief Private header for ATF v2 file sinks (pluggable write backends)
+ *
+ * A sink is an append-mostly output file with one extra operation: a
+ * positioned write used at finalize to rewrite the header. The index and
+ * detail writers only talk to sinks, so the I/O strategy (stdio, io_uring,
+ * mmap) is chosen per file without touching the on-disk format code.
+ */
+
+#ifndef TRACER_BACKEND_ATF_FILE_SINK_PRIVATE_H
+#define TRACER_BACKEND_ATF_FILE_SINK_PRIVATE_H
+
+#include <tracer_backend/atf/atf_thread_writer.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct AtfFileSink AtfFileSink;
+
+/**
+ * Backend operations
+ *
+ * All operations return 0 on success or a negative errno on error.
+ */
+typedef struct {
+    /* Append bytes at the current end of file */
+    int (*append)(AtfFileSink* sink, const void* data, size_t size);
+    /* Write bytes at an absolute offset already covered by appends */
+    int (*write_at)(AtfFileSink* sink, const void* data, size_t size, uint64_t offset);
+    /* Hand every previous append/write_at to the file (no fsync) */
+    int (*flush)(AtfFileSink* sink);
+    /* Write out staged data (like fclose) and release all resources */
+    void (*close)(AtfFileSink* sink);
+} AtfFileSinkOps;
+
+/**
+ * Common sink state; backends embed this as their first member
+ */
+struct AtfFileSink {
+    const AtfFileSinkOps* ops;   /* Backend operations */
+    AtfWriterBackend backend;    /* Backend actually in use */
+    uint64_t size;               /* Logical file size (next append offset) */
+};
+
+/**
+ * Open (create or truncate) a file through the requested backend
+ *
+ * Falls back to ATF_WRITER_BACKEND_STDIO when the requested backend is not
+ * compiled in or cannot be initialized (e.g. io_uring blocked by seccomp).
+ *
+ * @param path File path (parent directory must exist)
+ * @param backend Requested backend
+ * @return Pointer to sink, or NULL if the file cannot be opened
+ */
+AtfFileSink* atf_file_sink_open(const char* path, AtfWriterBackend backend);
+
+/**
+ * Open a file with the stdio backend
+ *
+ * @param path File path
+ * @return Pointer to sink, or NULL on error
+ */
+AtfFileSink* atf_file_sink_open_stdio(const char* path);
+
+/**
+ * Open a file with the mmap backend
+ *
+ * @param path File path
+ * @return Pointer to sink, or NULL on error
+ */
+AtfFileSink* atf_file_sink_open_mmap(const char* path);
+
+/**
+ * Get the base of the live file mapping
+ *
+ * Only the mmap backend has one. The pointer is invalidated by the next
+ * append (which may remap), so callers must re-query it after appending.
+ *
+ * @param sink Pointer to sink
+ * @return Mapping of [0, sink->size), or NULL for other backends
+ */
+void* atf_file_sink_mapping(AtfFileSink* sink);
+
+#if defined(ADA_ATF_HAVE_IO_URING)
+/**
+ * Open a file with the io_uring backend
+ *
+ * @param path File path
+ * @return Pointer to sink, or NULL if the file or the ring cannot be set up
+ */
+AtfFileSink* atf_file_sink_open_io_uring(const char* path);
+#endif
+
+static inline int atf_file_sink_append(AtfFileSink* sink, const void* data, size_t size) {
+    return sink->ops->append(sink, data, size);
+}
+
+static inline int atf_file_sink_write_at(AtfFileSink* sink, const void* data,
+                                         size_t size, uint64_t offset) {
+    return sink->ops->write_at(sink, data, size, offset);
+}
+
+static inline int atf_file_sink_flush(AtfFileSink* sink) {
+    return sink->ops->flush(sink);
+}
+
+static inline void atf_file_sink_close(AtfFileSink* sink) {
+    if (sink) {
+        sink->ops->close(sink);
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TRACER_BACKEND_ATF_FILE_SINK_PRIVATE_H */
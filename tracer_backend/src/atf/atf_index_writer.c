@@ -2,12 +2,15 @@
  * @file atf_index_writer.c
  * @brief Implementation of ATF v2 index file writer
  *
- * Writes fixed 32-byte index events to disk with buffered I/O for performance.
+ * Writes fixed 32-byte index events to disk through a pluggable file sink
+ * (buffered stdio or batched io_uring).
  */
 
 #include "atf_index_writer_private.h"
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stddef.h>
 #include <errno.h>
 #include <sys/stat.h>
 
@@ -31,6 +34,10 @@
     #define CURRENT_ARCH ATF_ARCH_X86_64
 #endif
 
+/* Live header updates store event_count with a single aligned 32-bit store */
+_Static_assert(offsetof(AtfIndexHeader, event_count) % sizeof(uint32_t) == 0,
+               "AtfIndexHeader.event_count must be 4-byte aligned");
+
 /* Helper to create directory recursively */
 static int mkdir_recursive(const char* path) {
     char tmp[1024];
@@ -54,6 +61,23 @@ static int mkdir_recursive(const char* path) {
     return 0;
 }
 
+/*
+ * mmap backend: keep the mapped header current after every append so a
+ * reader mapping the file can tail it. The count is published last with
+ * release ordering, so events it covers are already in the mapping.
+ */
+static void publish_live_header(AtfIndexWriter* writer) {
+    uint8_t* live = (uint8_t*)atf_file_sink_mapping(writer->sink);
+    if (!live) return;
+
+    AtfIndexHeader* header = (AtfIndexHeader*)live;
+    header->flags = writer->header.flags;
+    header->time_start_ns = writer->time_start_ns;
+    header->time_end_ns = writer->time_end_ns;
+    __atomic_store_n((uint32_t*)(live + offsetof(AtfIndexHeader, event_count)),
+                     writer->event_count, __ATOMIC_RELEASE);
+}
+
 /* Helper to get directory from filepath */
 static void get_directory(const char* filepath, char* dir, size_t dir_size) {
     const char* last_slash = strrchr(filepath, '/');
@@ -70,6 +94,14 @@ static void get_directory(const char* filepath, char* dir, size_t dir_size) {
 AtfIndexWriter* atf_index_writer_create(const char* filepath,
                                         uint32_t thread_id,
                                         uint8_t clock_type) {
+    return atf_index_writer_create_with_backend(filepath, thread_id, clock_type,
+                                                ATF_WRITER_BACKEND_STDIO);
+}
+
+AtfIndexWriter* atf_index_writer_create_with_backend(const char* filepath,
+                                                     uint32_t thread_id,
+                                                     uint8_t clock_type,
+                                                     AtfWriterBackend backend) {
     if (!filepath) return NULL;
 
     /* Create directory if needed */
@@ -84,8 +116,8 @@ AtfIndexWriter* atf_index_writer_create(const char* filepath,
     if (!writer) return NULL; // LCOV_EXCL_LINE
 
     /* Open file for writing */
-    writer->file = fopen(filepath, "wb");
-    if (!writer->file) {
+    writer->sink = atf_file_sink_open(filepath, backend);
+    if (!writer->sink) {
         free(writer);
         return NULL;
     }
@@ -113,9 +145,12 @@ AtfIndexWriter* atf_index_writer_create(const char* filepath,
     writer->header.footer_offset = 64;  /* Will be updated */
     writer->header.time_start_ns = 0;
     writer->header.time_end_ns = 0;
+    if (writer->sink->backend == ATF_WRITER_BACKEND_MMAP) {
+        writer->header.flags |= ATF_INDEX_FLAG_LIVE_EVENT_COUNT;
+    }
 
-    if (fwrite(&writer->header, sizeof(writer->header), 1, writer->file) != 1) { // LCOV_EXCL_START
-        fclose(writer->file);
+    if (atf_file_sink_append(writer->sink, &writer->header, sizeof(writer->header)) != 0) { // LCOV_EXCL_START
+        atf_file_sink_close(writer->sink);
         free(writer);
         return NULL;
     } // LCOV_EXCL_STOP
@@ -124,7 +159,7 @@ AtfIndexWriter* atf_index_writer_create(const char* filepath,
 }
 
 int atf_index_writer_write_event(AtfIndexWriter* writer, const IndexEvent* event) {
-    if (!writer || !writer->file || !event) return -EINVAL;
+    if (!writer || !writer->sink || !event) return -EINVAL;
 
     /* Update time range */
     if (writer->event_count == 0) {
@@ -133,28 +168,43 @@ int atf_index_writer_write_event(AtfIndexWriter* writer, const IndexEvent* event
     writer->time_end_ns = event->timestamp_ns;
 
     /* Write event */
-    if (fwrite(event, sizeof(IndexEvent), 1, writer->file) != 1) { // LCOV_EXCL_LINE
+    if (atf_file_sink_append(writer->sink, event, sizeof(IndexEvent)) != 0) { // LCOV_EXCL_LINE
         return -EIO; // LCOV_EXCL_LINE
     } // LCOV_EXCL_LINE
 
     writer->event_count++;
+    publish_live_header(writer);
     return 0;
 }
 
-int atf_index_writer_finalize(AtfIndexWriter* writer) {
-    if (!writer || !writer->file) return -EINVAL;
+int atf_index_writer_write_events(AtfIndexWriter* writer,
+                                  const IndexEvent* events,
+                                  size_t count) {
+    if (!writer || !writer->sink || (!events && count > 0)) return -EINVAL;
+    if (count == 0) return 0;
 
-    /* Flush events */
-    if (fflush(writer->file) != 0) { // LCOV_EXCL_LINE
-        return -EIO; // LCOV_EXCL_LINE
-    } // LCOV_EXCL_LINE
+    /* Update time range */
+    if (writer->event_count == 0) {
+        writer->time_start_ns = events[0].timestamp_ns;
+    }
+    writer->time_end_ns = events[count - 1].timestamp_ns;
 
-    /* Get footer offset */
-    long footer_offset = ftell(writer->file);
-    if (footer_offset < 0) { // LCOV_EXCL_LINE
+    /* Write the whole span at once */
+    if (atf_file_sink_append(writer->sink, events, count * sizeof(IndexEvent)) != 0) { // LCOV_EXCL_LINE
         return -EIO; // LCOV_EXCL_LINE
     } // LCOV_EXCL_LINE
 
+    writer->event_count += (uint32_t)count;
+    publish_live_header(writer);
+    return 0;
+}
+
+int atf_index_writer_finalize(AtfIndexWriter* writer) {
+    if (!writer || !writer->sink) return -EINVAL;
+
+    /* Footer follows the last event */
+    uint64_t footer_offset = writer->sink->size;
+
     /* Write footer */
     AtfIndexFooter footer;
     memset(&footer, 0, sizeof(footer));
@@ -165,7 +215,7 @@ int atf_index_writer_finalize(AtfIndexWriter* writer) {
     footer.time_end_ns = writer->time_end_ns;
     footer.bytes_written = writer->event_count * sizeof(IndexEvent);
 
-    if (fwrite(&footer, sizeof(footer), 1, writer->file) != 1) { // LCOV_EXCL_LINE
+    if (atf_file_sink_append(writer->sink, &footer, sizeof(footer)) != 0) { // LCOV_EXCL_LINE
         return -EIO; // LCOV_EXCL_LINE
     } // LCOV_EXCL_LINE
 
@@ -175,17 +225,14 @@ int atf_index_writer_finalize(AtfIndexWriter* writer) {
     writer->header.time_start_ns = writer->time_start_ns;
     writer->header.time_end_ns = writer->time_end_ns;
 
-    /* Seek to beginning and rewrite header */
-    if (fseek(writer->file, 0, SEEK_SET) != 0) { // LCOV_EXCL_LINE
+    /* Rewrite header in place */
+    if (atf_file_sink_write_at(writer->sink, &writer->header, sizeof(writer->header), 0) != 0) { // LCOV_EXCL_LINE
         return -EIO; // LCOV_EXCL_LINE
     } // LCOV_EXCL_LINE
 
-    if (fwrite(&writer->header, sizeof(writer->header), 1, writer->file) != 1) { // LCOV_EXCL_LINE
-        return -EIO; // LCOV_EXCL_LINE
-    } // LCOV_EXCL_LINE
-
-    /* Flush header */
-    if (fflush(writer->file) != 0) { // LCOV_EXCL_LINE
+    /* Flush events, footer and header (the mmap backend also truncates its
+     * preallocated tail, leaving footer_offset + sizeof(AtfIndexFooter)) */
+    if (atf_file_sink_flush(writer->sink) != 0) { // LCOV_EXCL_LINE
         return -EIO; // LCOV_EXCL_LINE
     } // LCOV_EXCL_LINE
 
@@ -195,9 +242,7 @@ int atf_index_writer_finalize(AtfIndexWriter* writer) {
 void atf_index_writer_close(AtfIndexWriter* writer) {
     if (!writer) return;
 
-    if (writer->file) {
-        fclose(writer->file);
-    }
+    atf_file_sink_close(writer->sink);
 
     free(writer);
 }
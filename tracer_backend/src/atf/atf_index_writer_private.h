@@ -3,14 +3,15 @@
  * @brief Private header for ATF v2 index file writer
  *
  * The index writer handles writing fixed 32-byte index events to disk.
- * It maintains buffered I/O for performance and tracks file metadata.
+ * Output goes through an AtfFileSink (buffered stdio or batched io_uring)
+ * and the writer tracks file metadata.
  */
 
 #ifndef TRACER_BACKEND_ATF_INDEX_WRITER_PRIVATE_H
 #define TRACER_BACKEND_ATF_INDEX_WRITER_PRIVATE_H
 
 #include <tracer_backend/atf/atf_v2_types.h>
-#include <stdio.h>
+#include "atf_file_sink_private.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -20,7 +21,7 @@ extern "C" {
  * Index file writer state
  */
 typedef struct {
-    FILE* file;                  /* File handle */
+    AtfFileSink* sink;           /* Output file (stdio or io_uring backend) */
     AtfIndexHeader header;       /* Header (updated at finalize) */
     uint32_t event_count;        /* Number of events written */
     uint64_t time_start_ns;      /* First event timestamp */
@@ -41,6 +42,20 @@ AtfIndexWriter* atf_index_writer_create(const char* filepath,
                                         uint32_t thread_id,
                                         uint8_t clock_type);
 
+/**
+ * Create an index writer using a specific file I/O backend
+ *
+ * @param filepath Path to index file
+ * @param thread_id Thread ID
+ * @param clock_type Clock type
+ * @param backend Requested backend (falls back to stdio when unavailable)
+ * @return Pointer to writer, or NULL on error
+ */
+AtfIndexWriter* atf_index_writer_create_with_backend(const char* filepath,
+                                                     uint32_t thread_id,
+                                                     uint8_t clock_type,
+                                                     AtfWriterBackend backend);
+
 /**
  * Write an index event
  *
@@ -50,6 +65,20 @@ AtfIndexWriter* atf_index_writer_create(const char* filepath,
  */
 int atf_index_writer_write_event(AtfIndexWriter* writer, const IndexEvent* event);
 
+/**
+ * Write a contiguous span of index events
+ *
+ * Issues a single write for the whole span instead of one per event.
+ *
+ * @param writer Pointer to writer
+ * @param events Pointer to first event of the span
+ * @param count Number of events in the span (0 is a no-op)
+ * @return 0 on success, negative errno on error
+ */
+int atf_index_writer_write_events(AtfIndexWriter* writer,
+                                  const IndexEvent* events,
+                                  size_t count);
+
 /**
  * Finalize the index file
  *
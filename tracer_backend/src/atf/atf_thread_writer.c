@@ -24,12 +24,21 @@ struct AtfThreadWriter {
     char* session_dir;               /* Stored for detail writer creation */
     uint32_t thread_id;
     uint8_t clock_type;
+    AtfWriterBackend backend;        /* Requested file I/O backend */
     int detail_file_created;
 };
 
 AtfThreadWriter* atf_thread_writer_create(const char* session_dir,
                                           uint32_t thread_id,
                                           uint8_t clock_type) {
+    return atf_thread_writer_create_with_backend(session_dir, thread_id, clock_type,
+                                                 ATF_WRITER_BACKEND_STDIO);
+}
+
+AtfThreadWriter* atf_thread_writer_create_with_backend(const char* session_dir,
+                                                       uint32_t thread_id,
+                                                       uint8_t clock_type,
+                                                       AtfWriterBackend backend) {
     if (!session_dir) return NULL;
 
     /* Allocate writer */
@@ -46,6 +55,7 @@ AtfThreadWriter* atf_thread_writer_create(const char* session_dir,
     /* Initialize state */
     writer->thread_id = thread_id;
     writer->clock_type = clock_type;
+    writer->backend = backend;
     writer->detail_file_created = 0;
     atf_thread_counters_init(&writer->counters);
 
@@ -55,7 +65,8 @@ AtfThreadWriter* atf_thread_writer_create(const char* session_dir,
              session_dir, thread_id);
 
     /* Create index writer */
-    writer->index_writer = atf_index_writer_create(index_path, thread_id, clock_type);
+    writer->index_writer = atf_index_writer_create_with_backend(index_path, thread_id,
+                                                                clock_type, backend);
     if (!writer->index_writer) { // LCOV_EXCL_START
         free(writer->session_dir);
         free(writer);
@@ -68,6 +79,11 @@ AtfThreadWriter* atf_thread_writer_create(const char* session_dir,
     return writer;
 }
 
+AtfWriterBackend atf_thread_writer_get_backend(const AtfThreadWriter* writer) {
+    if (!writer || !writer->index_writer) return ATF_WRITER_BACKEND_STDIO;
+    return writer->index_writer->sink->backend;
+}
+
 uint32_t atf_thread_writer_write_event(AtfThreadWriter* writer,
                                        uint64_t timestamp_ns,
                                        uint64_t function_id,
@@ -106,9 +122,10 @@ uint32_t atf_thread_writer_write_event(AtfThreadWriter* writer,
             snprintf(detail_path, sizeof(detail_path),
                      "%s/thread_%u/detail.atf", writer->session_dir, writer->thread_id);
 
-            writer->detail_writer = atf_detail_writer_create(detail_path,
-                                                             writer->thread_id,
-                                                             writer->clock_type);
+            writer->detail_writer = atf_detail_writer_create_with_backend(detail_path,
+                                                                          writer->thread_id,
+                                                                          writer->clock_type,
+                                                                          writer->backend);
             if (!writer->detail_writer) { // LCOV_EXCL_LINE
                 return UINT32_MAX; // LCOV_EXCL_LINE
             } // LCOV_EXCL_LINE
@@ -142,6 +159,22 @@ uint32_t atf_thread_writer_write_event(AtfThreadWriter* writer,
     return idx_seq;
 }
 
+int atf_thread_writer_write_index_span(AtfThreadWriter* writer,
+                                       const void* events,
+                                       size_t count) {
+    if (!writer || !writer->index_writer || (!events && count > 0)) return -EINVAL;
+    if (count == 0) return 0;
+
+    /* Ring records are final on-disk records; write them verbatim */
+    int rc = atf_index_writer_write_events(writer->index_writer,
+                                           (const IndexEvent*)events, count);
+    if (rc != 0) return rc;
+
+    /* Index-only events: the run of index sequences is committed */
+    writer->counters.index_count += (uint32_t)count;
+    return 0;
+}
+
 int atf_thread_writer_finalize(AtfThreadWriter* writer) {
     if (!writer) return -EINVAL;
 
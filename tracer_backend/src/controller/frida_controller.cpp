@@ -5,6 +5,8 @@ extern "C" {
 }
 extern "C" {
 #include <tracer_backend/utils/ring_buffer.h>
+#include <tracer_backend/utils/timestamp_source.h>
+#include <tracer_backend/utils/hook_sampler.h>
 }
 #include "../utils/thread_registry_private.h"
 
@@ -233,6 +235,35 @@ FridaController::FridaController(const std::string& output_dir)
     // Create and start C-based drain thread (with ATF session management)
     DrainConfig drain_config;
     drain_config_default(&drain_config);
+    // ATF file backend override: stdio | io_uring | mmap | auto
+    if (const char* env = getenv("ADA_ATF_WRITER_BACKEND")) {
+        if (strcmp(env, "stdio") == 0) {
+            drain_config.writer_backend = ATF_WRITER_BACKEND_STDIO;
+        } else if (strcmp(env, "io_uring") == 0) {
+            drain_config.writer_backend = ATF_WRITER_BACKEND_IO_URING;
+        } else if (strcmp(env, "mmap") == 0) {
+            drain_config.writer_backend = ATF_WRITER_BACKEND_MMAP;
+        } else if (strcmp(env, "auto") == 0) {
+            drain_config.writer_backend = ATF_WRITER_BACKEND_AUTO;
+        }
+    }
+    // Drain worker override: a count, or "cores" for one worker per online CPU
+    if (const char* env = getenv("ADA_DRAIN_WORKERS")) {
+        if (strcmp(env, "cores") == 0) {
+            drain_config.worker_count = DRAIN_WORKERS_PER_CORE;
+        } else {
+            unsigned long workers = strtoul(env, nullptr, 10);
+            if (workers > 0) {
+                drain_config.worker_count = static_cast<uint32_t>(workers);
+            }
+        }
+    }
+    if (const char* env = getenv("ADA_DRAIN_WORK_STEALING")) {
+        drain_config.enable_work_stealing = strcmp(env, "1") == 0;
+    }
+    if (const char* env = getenv("ADA_DRAIN_WAKE")) {
+        drain_config.wake_on_submit = strcmp(env, "1") == 0;
+    }
     drain_ = drain_thread_create(registry_, &drain_config);
     if (!drain_) {
         cleanup_frida_objects();
@@ -491,14 +522,93 @@ bool FridaController::initialize_shared_memory() {
     cb_set_heartbeat_ns(control_block_, 0);
     control_block_->actual_hook_count = 0;
 
+    // Hook timestamp source; calibrated once, before the agent can read it
+    const uint32_t ts_source = timestamp_source_parse(getenv("ADA_TIMESTAMP_SOURCE"));
+    (void)timestamp_source_calibrate(ts_source, 10, &control_block_->timestamp);
+    g_debug("Timestamp source: %s (%llu ticks/s)\n",
+            control_block_->timestamp.source == TIMESTAMP_SOURCE_COUNTER ? "counter" : "monotonic",
+            (unsigned long long)control_block_->timestamp.ticks_per_sec);
+
+    // Hot function sampling: off unless ADA_SAMPLING_MAX_RATE (calls/s per
+    // function) is set; set_sampling() retunes it while the session runs
+    SamplingControl sampling;
+    hook_sampler_control_defaults(&sampling);
+    if (const char* env = getenv("ADA_SAMPLING_MAX_RATE")) {
+        unsigned long rate = strtoul(env, nullptr, 10);
+        if (rate > 0 && rate <= UINT32_MAX) {
+            sampling.enabled = 1;
+            sampling.max_calls_per_sec = static_cast<uint32_t>(rate);
+        }
+    }
+    if (const char* env = getenv("ADA_SAMPLING_MAX_SHIFT")) {
+        unsigned long shift = strtoul(env, nullptr, 10);
+        if (shift > 0 && shift <= SAMPLING_MAX_SHIFT_LIMIT) {
+            sampling.max_sample_shift = static_cast<uint32_t>(shift);
+        }
+    }
+    if (const char* env = getenv("ADA_SAMPLING_WINDOW_MS")) {
+        unsigned long window = strtoul(env, nullptr, 10);
+        if (window > 0 && window <= 60000) {
+            sampling.window_ms = static_cast<uint32_t>(window);
+        }
+    }
+    cb_set_sampling(control_block_, &sampling);
+
+    // Spans-only index lane: one EVENT_KIND_SPAN record per completed call
+    if (const char* env = getenv("ADA_INDEX_SPANS")) {
+        cb_set_index_spans(control_block_, strcmp(env, "1") == 0 ? 1u : 0u);
+    }
+
+    // Aggregation lane: "events" keeps tracing alongside the per-function
+    // totals, "only" records totals alone
+    if (const char* env = getenv("ADA_AGGREGATION")) {
+        if (strcmp(env, "events") == 0 || strcmp(env, "1") == 0) {
+            cb_set_aggregation(control_block_, AGGREGATION_WITH_EVENTS);
+        } else if (strcmp(env, "only") == 0 || strcmp(env, "2") == 0) {
+            cb_set_aggregation(control_block_, AGGREGATION_ONLY);
+        }
+    }
+
     // Optional: allow disabling registry via env (verification / fallback)
     bool disable_registry = false;
     if (const char* env = getenv("ADA_DISABLE_REGISTRY")) {
         if (env[0] != '\0' && env[0] != '0') disable_registry = true;
     }
 
+    // Registry capacity: ADA_MAX_THREADS slots (default MAX_THREADS). Each slot
+    // reserves its ring pool, so raise it only for targets with many threads.
+    uint32_t registry_capacity = MAX_THREADS;
+    if (const char* env = getenv("ADA_MAX_THREADS")) {
+        unsigned long threads = strtoul(env, nullptr, 10);
+        if (threads > 0) {
+            registry_capacity = threads > THREAD_REGISTRY_MAX_CAPACITY
+                ? THREAD_REGISTRY_MAX_CAPACITY
+                : static_cast<uint32_t>(threads);
+        }
+    }
+
+    // Ring geometry: ADA_INDEX_RING_KB / ADA_INDEX_RINGS and ADA_DETAIL_RING_KB /
+    // ADA_DETAIL_RINGS size every thread's lanes; ADA_RING_OVERFLOW_MB is the
+    // shared budget lanes under pressure grow into instead of dropping.
+    ThreadRegistryGeometry geometry;
+    thread_registry_geometry_default(&geometry);
+    geometry.overflow_bytes = 16ull << 20;
+    auto env_u32 = [](const char* name, uint32_t scale, uint32_t* out) {
+        if (const char* env = getenv(name)) {
+            unsigned long value = strtoul(env, nullptr, 10);
+            if (value > 0 && value <= UINT32_MAX / scale) *out = static_cast<uint32_t>(value) * scale;
+        }
+    };
+    env_u32("ADA_INDEX_RING_KB", 1024, &geometry.index_ring_bytes);
+    env_u32("ADA_INDEX_RINGS", 1, &geometry.index_ring_count);
+    env_u32("ADA_DETAIL_RING_KB", 1024, &geometry.detail_ring_bytes);
+    env_u32("ADA_DETAIL_RINGS", 1, &geometry.detail_ring_count);
+    if (const char* env = getenv("ADA_RING_OVERFLOW_MB")) {
+        geometry.overflow_bytes = static_cast<uint64_t>(strtoull(env, nullptr, 10)) << 20;
+    }
+
     // Create thread registry shared memory and initialize it (unless disabled)
-    size_t registry_size = thread_registry_calculate_memory_size_with_capacity(MAX_THREADS);
+    size_t registry_size = thread_registry_calculate_memory_size_with_geometry(registry_capacity, &geometry);
     if (!disable_registry) {
         SharedMemoryRef registry_ref = shared_memory_create_unique(
             ADA_ROLE_REGISTRY, controller_pid, session_id,
@@ -511,7 +621,7 @@ bool FridaController::initialize_shared_memory() {
                 shared_memory_get_name(registry_ref));
 
         void* reg_addr = shared_memory_get_address(registry_ref);
-        registry_ = thread_registry_init(reg_addr, registry_size);
+        registry_ = thread_registry_init_with_geometry(reg_addr, registry_size, registry_capacity, &geometry);
         if (!registry_) {
             g_debug("Failed to initialize thread registry at %p (size=%zu)\n", reg_addr, registry_size);
             return false;
@@ -1317,6 +1427,32 @@ int FridaController::set_detail_enabled(uint32_t enabled) {
     return 0;
 }
 
+int FridaController::set_sampling(uint32_t enabled, uint32_t max_calls_per_sec,
+                                  uint32_t max_sample_shift, uint32_t window_ms) {
+    if (!control_block_) {
+        return -1;
+    }
+    if (enabled && (max_calls_per_sec == 0 || window_ms == 0 ||
+                    max_sample_shift > SAMPLING_MAX_SHIFT_LIMIT)) {
+        return -1;
+    }
+
+    SamplingControl sampling = {enabled ? 1u : 0u, max_calls_per_sec, max_sample_shift, window_ms};
+    cb_set_sampling(control_block_, &sampling);
+
+    return 0;
+}
+
+int FridaController::set_aggregation(uint32_t mode) {
+    if (!control_block_ || mode > AGGREGATION_ONLY) {
+        return -1;
+    }
+
+    cb_set_aggregation(control_block_, mode);
+
+    return 0;
+}
+
 int FridaController::start_session() {
     if (!start_atf_session()) {
         return -1;
@@ -1586,6 +1722,20 @@ int frida_controller_set_detail_enabled(FridaController* controller, uint32_t en
         ->set_detail_enabled(enabled);
 }
 
+int frida_controller_set_sampling(FridaController* controller, uint32_t enabled,
+                                  uint32_t max_calls_per_sec, uint32_t max_sample_shift,
+                                  uint32_t window_ms) {
+    if (!controller) return -1;
+    return reinterpret_cast<ada::internal::FridaController*>(controller)
+        ->set_sampling(enabled, max_calls_per_sec, max_sample_shift, window_ms);
+}
+
+int frida_controller_set_aggregation(FridaController* controller, uint32_t mode) {
+    if (!controller) return -1;
+    return reinterpret_cast<ada::internal::FridaController*>(controller)
+        ->set_aggregation(mode);
+}
+
 int frida_controller_start_session(FridaController* controller) {
     if (!controller) return -1;
     return reinterpret_cast<ada::internal::FridaController*>(controller)
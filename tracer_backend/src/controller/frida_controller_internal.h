@@ -68,6 +68,9 @@ public:
     int fire_trigger();
     int disarm_trigger();
     int set_detail_enabled(uint32_t enabled);
+    int set_sampling(uint32_t enabled, uint32_t max_calls_per_sec,
+                     uint32_t max_sample_shift, uint32_t window_ms);
+    int set_aggregation(uint32_t mode);
     int start_session();
     int stop_session();
     
@@ -29,11 +29,13 @@ void shutdown_state_init(ShutdownState* state, uint32_t capacity) {
         return;
     }
 
-    if (capacity == 0 || capacity > MAX_THREADS) {
+    if (capacity == 0) {
         capacity = MAX_THREADS;
+    } else if (capacity > THREAD_REGISTRY_MAX_CAPACITY) {
+        capacity = THREAD_REGISTRY_MAX_CAPACITY;
     }
 
-    for (uint32_t i = 0; i < MAX_THREADS; ++i) {
+    for (uint32_t i = 0; i < THREAD_REGISTRY_MAX_CAPACITY; ++i) {
         atomic_init(&state->threads[i].accepting_events, false);
         atomic_init(&state->threads[i].flush_requested, false);
         atomic_init(&state->threads[i].flush_complete, false);
@@ -282,8 +284,10 @@ static void shutdown_manager_snapshot_registry(ShutdownManager* manager) {
     }
 
     uint32_t capacity = thread_registry_get_capacity(manager->registry);
-    if (capacity == 0 || capacity > MAX_THREADS) {
+    if (capacity == 0) {
         capacity = MAX_THREADS;
+    } else if (capacity > THREAD_REGISTRY_MAX_CAPACITY) {
+        capacity = THREAD_REGISTRY_MAX_CAPACITY;
     }
 
     atomic_store_explicit(&manager->state->capacity, capacity, memory_order_release);
@@ -373,8 +377,10 @@ static uint64_t shutdown_manager_events_in_flight(const ShutdownManager* manager
 
     const ShutdownState* state = manager->state;
     uint32_t capacity = atomic_load_explicit(&state->capacity, memory_order_acquire);
-    if (capacity == 0 || capacity > MAX_THREADS) {
+    if (capacity == 0) {
         capacity = MAX_THREADS;
+    } else if (capacity > THREAD_REGISTRY_MAX_CAPACITY) {
+        capacity = THREAD_REGISTRY_MAX_CAPACITY;
     }
 
     uint64_t total = 0;
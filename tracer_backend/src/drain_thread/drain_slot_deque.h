@@ -0,0 +1,104 @@
+#ifndef DRAIN_SLOT_DEQUE_H
+#define DRAIN_SLOT_DEQUE_H
+
+// Work-stealing deque of registry slot indices (Chase-Lev).
+//
+// The owning drain worker pushes and pops at the bottom; other workers steal
+// from the top. A slot is queued at most once at a time (guarded by the
+// caller's per-slot state), so one entry per possible registry slot always
+// suffices and the buffer never grows.
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <tracer_backend/utils/tracer_types.h>
+
+#define DRAIN_SLOT_DEQUE_CAPACITY THREAD_REGISTRY_MAX_CAPACITY
+#define DRAIN_SLOT_DEQUE_EMPTY    UINT32_MAX
+
+_Static_assert((DRAIN_SLOT_DEQUE_CAPACITY & (DRAIN_SLOT_DEQUE_CAPACITY - 1)) == 0,
+               "Slot deque capacity must be a power of two");
+
+typedef struct {
+    atomic_int_fast64_t top;      // Next index to steal
+    atomic_int_fast64_t bottom;   // Next index to push
+    atomic_uint slots[DRAIN_SLOT_DEQUE_CAPACITY];
+} DrainSlotDeque;
+
+static inline void drain_slot_deque_init(DrainSlotDeque* dq) {
+    atomic_init(&dq->top, 0);
+    atomic_init(&dq->bottom, 0);
+    for (uint32_t i = 0; i < DRAIN_SLOT_DEQUE_CAPACITY; ++i) {
+        atomic_init(&dq->slots[i], DRAIN_SLOT_DEQUE_EMPTY);
+    }
+}
+
+// Owner only. Returns false if the deque is full.
+static inline bool drain_slot_deque_push(DrainSlotDeque* dq, uint32_t slot) {
+    int_fast64_t b = atomic_load_explicit(&dq->bottom, memory_order_relaxed);
+    int_fast64_t t = atomic_load_explicit(&dq->top, memory_order_acquire);
+    if (b - t >= DRAIN_SLOT_DEQUE_CAPACITY) {
+        return false;
+    }
+    atomic_store_explicit(&dq->slots[b & (DRAIN_SLOT_DEQUE_CAPACITY - 1)], slot,
+                          memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&dq->bottom, b + 1, memory_order_relaxed);
+    return true;
+}
+
+// Owner only. Takes the most recently pushed slot.
+static inline uint32_t drain_slot_deque_pop(DrainSlotDeque* dq) {
+    int_fast64_t b = atomic_load_explicit(&dq->bottom, memory_order_relaxed) - 1;
+    atomic_store_explicit(&dq->bottom, b, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    int_fast64_t t = atomic_load_explicit(&dq->top, memory_order_relaxed);
+
+    if (t > b) {
+        atomic_store_explicit(&dq->bottom, b + 1, memory_order_relaxed);
+        return DRAIN_SLOT_DEQUE_EMPTY;
+    }
+
+    uint32_t slot = atomic_load_explicit(&dq->slots[b & (DRAIN_SLOT_DEQUE_CAPACITY - 1)],
+                                         memory_order_relaxed);
+    if (t == b) {
+        // Last entry: race any thief for it
+        if (!atomic_compare_exchange_strong_explicit(&dq->top, &t, t + 1,
+                                                     memory_order_seq_cst,
+                                                     memory_order_relaxed)) {
+            slot = DRAIN_SLOT_DEQUE_EMPTY;
+        }
+        atomic_store_explicit(&dq->bottom, b + 1, memory_order_relaxed);
+    }
+    return slot;
+}
+
+// Any thread. Takes the oldest slot; returns DRAIN_SLOT_DEQUE_EMPTY when the
+// deque is empty or another thief won the race.
+static inline uint32_t drain_slot_deque_steal(DrainSlotDeque* dq) {
+    int_fast64_t t = atomic_load_explicit(&dq->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    int_fast64_t b = atomic_load_explicit(&dq->bottom, memory_order_acquire);
+    if (t >= b) {
+        return DRAIN_SLOT_DEQUE_EMPTY;
+    }
+
+    uint32_t slot = atomic_load_explicit(&dq->slots[t & (DRAIN_SLOT_DEQUE_CAPACITY - 1)],
+                                         memory_order_relaxed);
+    if (!atomic_compare_exchange_strong_explicit(&dq->top, &t, t + 1,
+                                                 memory_order_seq_cst,
+                                                 memory_order_relaxed)) {
+        return DRAIN_SLOT_DEQUE_EMPTY;
+    }
+    return slot;
+}
+
+// Racy size estimate for metrics and idle checks
+static inline uint32_t drain_slot_deque_size(const DrainSlotDeque* dq) {
+    int_fast64_t b = atomic_load_explicit(&dq->bottom, memory_order_relaxed);
+    int_fast64_t t = atomic_load_explicit(&dq->top, memory_order_relaxed);
+    return b > t ? (uint32_t)(b - t) : 0;
+}
+
+#endif // DRAIN_SLOT_DEQUE_H
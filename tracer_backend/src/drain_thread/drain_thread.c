@@ -10,6 +10,8 @@
 
 #include <tracer_backend/atf/atf_thread_writer.h>
 #include <tracer_backend/utils/control_block_ipc.h>
+#include <tracer_backend/utils/drain_wake.h>
+#include <tracer_backend/utils/timestamp_source.h>
 #include <tracer_backend/utils/agent_mode.h>
 
 #if defined(__has_attribute)
@@ -118,15 +120,15 @@ static int drain_thread_call_pthread_join(pthread_t thread, void** retval) {
     return pthread_join(thread, retval);
 }
 
-static bool drain_thread_call_lane_return_ring(Lane* lane, uint32_t ring_idx) {
+static bool drain_thread_call_lane_return_ring(LaneView* view, uint32_t ring_idx) {
     if (drain_thread_test_override_lane_return_ring) {
         bool handled = false;
-        bool result = drain_thread_test_override_lane_return_ring(lane, ring_idx, &handled);
+        bool result = drain_thread_test_override_lane_return_ring(view->lane, ring_idx, &handled);
         if (handled) {
             return result;
         }
     }
-    return lane_return_ring(lane, ring_idx);
+    return lane_view_return_ring(view, ring_idx);
 }
 
 static void* drain_thread_call_calloc(size_t nmemb, size_t size) {
@@ -183,7 +185,9 @@ static void drain_update_control_block(DrainThread* drain) {
     }
 }
 
-static void drain_metrics_atomic_reset(DrainMetricsAtomic* m) {
+static void drain_metrics_atomic_reset(DrainMetricsAtomic* m,
+                                       atomic_uint_fast64_t (*per_thread_rings)[2],
+                                       uint32_t slots) {
     atomic_init(&m->cycles_total, 0);
     atomic_init(&m->cycles_idle, 0);
     atomic_init(&m->rings_total, 0);
@@ -194,7 +198,8 @@ static void drain_metrics_atomic_reset(DrainMetricsAtomic* m) {
     atomic_init(&m->yields, 0);
     atomic_init(&m->final_drains, 0);
     atomic_init(&m->total_sleep_us, 0);
-    for (uint32_t i = 0; i < MAX_THREADS; ++i) {
+    m->per_thread_rings = per_thread_rings;
+    for (uint32_t i = 0; i < slots; ++i) {
         atomic_init(&m->per_thread_rings[i][0], 0);
         atomic_init(&m->per_thread_rings[i][1], 0);
     }
@@ -211,6 +216,15 @@ static void drain_metrics_atomic_reset(DrainMetricsAtomic* m) {
     atomic_init(&m->events_per_second, 0);
     atomic_init(&m->bytes_per_second, 0);
     atomic_init(&m->cpu_usage_percent, 0);
+
+    atomic_init(&m->wake_parks, 0);
+    atomic_init(&m->wake_signals, 0);
+    atomic_init(&m->idle_wait_ns, 0);
+    atomic_init(&m->wake_latency_samples, 0);
+    atomic_init(&m->wake_latency_total_ns, 0);
+    atomic_init(&m->wake_latency_max_ns, 0);
+    atomic_init(&m->write_errors, 0);
+    atomic_init(&m->events_lost, 0);
 }
 
 static uint32_t compute_effective_limit(const DrainThread* drain, bool final_pass) {
@@ -230,26 +244,54 @@ static uint32_t compute_effective_limit(const DrainThread* drain, bool final_pas
     return limit;
 }
 
-static void return_ring_to_producer(Lane* lane, uint32_t ring_idx) {
-    if (!lane) {
+static void return_ring_to_producer(LaneView* view, uint32_t ring_idx) {
+    if (!view || !view->lane) {
         return;
     }
     // Retry until the ring is successfully returned. This should normally succeed immediately.
     for (int attempts = 0; attempts < 1000; ++attempts) {
-        if (drain_thread_call_lane_return_ring(lane, ring_idx)) {
+        if (drain_thread_call_lane_return_ring(view, ring_idx)) {
             return;
         }
         sched_yield();
     }
     // Last resort: busy wait to avoid losing the ring.
-    while (!drain_thread_call_lane_return_ring(lane, ring_idx)) {
+    while (!drain_thread_call_lane_return_ring(view, ring_idx)) {
         sched_yield();
     }
 }
 
+// Hand drained rings back with one release store; any the free queue cannot
+// take now go through the retrying single-ring path
+static void return_rings_to_producer(LaneView* view, const uint32_t* rings, uint32_t count) {
+    uint32_t returned = lane_view_return_rings(view, rings, count);
+    for (uint32_t i = returned; i < count; ++i) {
+        return_ring_to_producer(view, rings[i]);
+    }
+}
+
+// Counters owned by the calling worker; direct lane drains use the shared set
+static inline DrainMetricsAtomic* drain_metrics_for(DrainThread* drain, DrainWorker* worker) {
+    return worker ? &worker->metrics : &drain->metrics;
+}
+
+// ATF clock_type values (atf_v2_types.h, whose IndexEvent clashes with the
+// ring record type in this translation unit)
+#define DRAIN_CLOCK_MACH_CONTINUOUS 1  // ATF_CLOCK_MACH_CONTINUOUS
+#define DRAIN_CLOCK_COUNTER         4  // ATF_CLOCK_COUNTER
+
+// ATF clock_type of the hook timestamps published in the control block
+static uint8_t drain_clock_type(const DrainThread* drain) {
+    if (drain->control_block &&
+        drain->control_block->timestamp.source == TIMESTAMP_SOURCE_COUNTER) {
+        return DRAIN_CLOCK_COUNTER;
+    }
+    return DRAIN_CLOCK_MACH_CONTINUOUS; // CLOCK_MONOTONIC ns; matches mach_continuous on macOS
+}
+
 // Get or create ATF thread writer for the given thread ID
 static AtfThreadWriter* get_or_create_thread_writer(DrainThread* drain, uint32_t thread_id) {
-    if (!drain || thread_id >= MAX_THREADS) {
+    if (!drain || thread_id >= drain->slot_capacity) {
         return NULL;
     }
 
@@ -263,13 +305,18 @@ static AtfThreadWriter* get_or_create_thread_writer(DrainThread* drain, uint32_t
         return NULL;
     }
 
+    // Files are named after the registration's stream id, the same id the
+    // agent stamps into the slot's index records
+    ThreadLaneSet* lanes = drain->registry ? thread_registry_get_thread_at(drain->registry, thread_id) : NULL;
+    uint32_t stream_id = lanes ? thread_lanes_get_stream_id(lanes) : thread_id;
+
     // Create new thread writer
-    // Clock type: 1 = mach_continuous (macOS), 2 = QPC (Windows), 3 = boottime (Linux)
-    uint8_t clock_type = 1; // Default to mach_continuous for macOS
-    AtfThreadWriter* writer = atf_thread_writer_create(
+    uint8_t clock_type = drain_clock_type(drain);
+    AtfThreadWriter* writer = atf_thread_writer_create_with_backend(
         drain->session_dir,
-        thread_id,
-        clock_type
+        stream_id,
+        clock_type,
+        drain->config.writer_backend
     );
 
     if (writer) {
@@ -279,7 +326,91 @@ static AtfThreadWriter* get_or_create_thread_writer(DrainThread* drain, uint32_t
     return writer;
 }
 
+// Finalize a reclaimed slot's writer. The thread that reuses the slot has a
+// new stream id, so it opens fresh thread_<id> files.
+static void drain_retire_slot_writer(DrainThread* drain, uint32_t slot) {
+    if (slot >= drain->slot_capacity || !drain->thread_writers[slot]) {
+        return;
+    }
+    AtfThreadWriter* writer = drain->thread_writers[slot];
+    drain->thread_writers[slot] = NULL;
+    atf_thread_writer_finalize(writer);
+    atf_thread_writer_close(writer);
+}
+
+// Recycle an exited thread's slot; call only after a pass found it empty
+static void drain_reclaim_slot(DrainThread* drain, uint32_t slot) {
+    if (thread_registry_reclaim_slot(drain->registry, slot)) {
+        drain_retire_slot_writer(drain, slot);
+    }
+}
+
+// Drain an index ring by handing contiguous payload spans straight to the
+// writer: at most two spans per pass (two only on wraparound), each written
+// verbatim with a single call (ring records are final ATF records), then one
+// release store to publish the consumed count. A failed write is counted
+// before the span is consumed: the ring must be recycled either way, so the
+// events are lost, but never silently.
+static uint32_t drain_index_ring(AtfThreadWriter* writer, RingBufferHeader* ring_hdr,
+                                 DrainMetricsAtomic* metrics) {
+    uint32_t events_read = 0;
+    RingBufferSpan spans[2];
+    size_t available;
+    while ((available = ring_buffer_peek_spans_raw(ring_hdr, sizeof(IndexEvent),
+                                                   spans, SIZE_MAX)) > 0) {
+        size_t written = 0;
+        for (int i = 0; i < 2 && spans[i].count > 0; ++i) {
+            if (atf_thread_writer_write_index_span(writer, spans[i].data, spans[i].count) != 0) {
+                atomic_fetch_add_explicit(&metrics->write_errors, 1, memory_order_relaxed);
+                break;
+            }
+            written += spans[i].count;
+        }
+        if (written < available) {
+            atomic_fetch_add_explicit(&metrics->events_lost, available - written, memory_order_relaxed);
+        }
+        ring_buffer_consume_raw(ring_hdr, available);
+        events_read += (uint32_t)written;
+    }
+    return events_read;
+}
+
+// Drain a detail ring record by record. Ring records already carry the ATF
+// DetailFunctionPayload layout, so the payload is forwarded from ring memory
+// as is; the writer supplies the detail header and the index back-link.
+static uint32_t drain_detail_ring(AtfThreadWriter* writer, RingBufferHeader* ring_hdr,
+                                  uint64_t* bytes_read, DrainMetricsAtomic* metrics) {
+    uint32_t events_read = 0;
+    const void* record = NULL;
+    size_t length;
+    while ((length = ring_buffer_peek_record_raw(ring_hdr, &record)) > 0) {
+        const DetailRecordHeader* rec = (const DetailRecordHeader*)record;
+        const DetailRecordPayload* payload = (const DetailRecordPayload*)(rec + 1);
+        // Returns the record's index sequence, UINT32_MAX on failure
+        uint32_t seq = atf_thread_writer_write_event(
+            writer,
+            rec->timestamp,
+            payload->function_id,
+            rec->event_type == DETAIL_RECORD_RETURN ? EVENT_KIND_RETURN : EVENT_KIND_CALL,
+            rec->call_depth,
+            payload,
+            length - sizeof(DetailRecordHeader)
+        );
+        if (seq == UINT32_MAX) {
+            atomic_fetch_add_explicit(&metrics->write_errors, 1, memory_order_relaxed);
+            atomic_fetch_add_explicit(&metrics->events_lost, 1, memory_order_relaxed);
+        }
+        ring_buffer_consume_record_raw(ring_hdr, length);
+        if (seq != UINT32_MAX) {
+            *bytes_read += length;
+            events_read++;
+        }
+    }
+    return events_read;
+}
+
 static uint32_t drain_lane(DrainThread* drain,
+                           DrainWorker* worker,
                            uint32_t slot_index,
                            Lane* lane,
                            bool is_detail,
@@ -293,105 +424,67 @@ static uint32_t drain_lane(DrainThread* drain,
     }
 
     const uint32_t limit = compute_effective_limit(drain, final_pass);
+    DrainMetricsAtomic* metrics = drain_metrics_for(drain, worker);
     uint32_t processed = 0;
     uint32_t events_read = 0;
+    uint64_t detail_bytes = 0;
+
+    // Lanes are materialized once per slot and reused across cycles
+    LaneView local_view = {0};
+    LaneView* view = slot_index < drain->slot_capacity
+        ? &drain->lane_views[slot_index][is_detail ? 1 : 0]
+        : &local_view;
+    if (!lane_view_sync(drain->registry, lane, view)) {
+        if (out_hit_limit) {
+            *out_hit_limit = false;
+        }
+        return 0;
+    }
 
     // Get ATF writer for this thread if session is active
     AtfThreadWriter* writer = NULL;
-    if (drain->session_active && slot_index < MAX_THREADS) {
+    if (drain->session_active && slot_index < drain->slot_capacity) {
         writer = get_or_create_thread_writer(drain, slot_index);
     }
 
-    // First try the queue-based ring swap mechanism
+    // First try the queue-based ring swap mechanism: collect every ready
+    // ring (up to the quantum) in one acquire, drain them, return them in one
+    // release
+    uint32_t rings[LANE_VIEW_MAX_RINGS];
     while (processed < limit) {
-        uint32_t ring_idx = lane_take_ring(lane);
-        if (ring_idx == UINT32_MAX) {
+        uint32_t want = limit - processed;
+        if (want > LANE_VIEW_MAX_RINGS) {
+            want = LANE_VIEW_MAX_RINGS;
+        }
+        uint32_t taken = lane_view_take_rings(view, rings, want);
+        if (taken == 0) {
             break;
         }
 
-        // Extract events from ring buffer and write to ATF V2
+        // Extract events from ring buffers and write to ATF V2
         if (writer && drain->registry) {
-            RingBufferHeader* ring_hdr = thread_registry_get_ring_header_by_idx(
-                drain->registry, lane, ring_idx);
-
-            if (ring_hdr) {
-                if (is_detail) {
-                    // Detail lane - read DetailEvents
-                    DetailEvent detail_event;
-                    while (ring_buffer_read_raw(ring_hdr, sizeof(DetailEvent), &detail_event)) {
-                        // Write detail event to ATF V2
-                        atf_thread_writer_write_event(
-                            writer,
-                            detail_event.timestamp,
-                            detail_event.function_id,
-                            detail_event.event_kind,
-                            detail_event.call_depth,
-                            &detail_event,  // Full detail payload
-                            sizeof(DetailEvent)
-                        );
-                        events_read++;
-                    }
-                } else {
-                    // Index lane - read IndexEvents
-                    IndexEvent index_event;
-                    while (ring_buffer_read_raw(ring_hdr, sizeof(IndexEvent), &index_event)) {
-                        // Write index event to ATF V2 (no detail payload)
-                        atf_thread_writer_write_event(
-                            writer,
-                            index_event.timestamp,
-                            index_event.function_id,
-                            index_event.event_kind,
-                            index_event.call_depth,
-                            NULL,  // No detail payload for index events
-                            0
-                        );
-                        events_read++;
-                    }
+            for (uint32_t i = 0; i < taken; ++i) {
+                RingBufferHeader* ring_hdr = lane_view_ring(view, rings[i]);
+                if (ring_hdr) {
+                    events_read += is_detail ? drain_detail_ring(writer, ring_hdr, &detail_bytes, metrics)
+                                             : drain_index_ring(writer, ring_hdr, metrics);
                 }
             }
         }
 
-        return_ring_to_producer(lane, ring_idx);
-        ++processed;
+        return_rings_to_producer(view, rings, taken);
+        processed += taken;
     }
 
     // Fallback: directly read from active ring buffer if queue was empty
     // This handles the case where the agent writes directly to the active
     // ring buffer without using the ring swap mechanism.
     if (processed == 0 && writer && drain->registry) {
-        RingBufferHeader* active_hdr = thread_registry_get_active_ring_header(
-            drain->registry, lane);
+        RingBufferHeader* active_hdr = lane_view_active_ring(view);
 
         if (active_hdr) {
-            if (is_detail) {
-                DetailEvent detail_event;
-                while (ring_buffer_read_raw(active_hdr, sizeof(DetailEvent), &detail_event)) {
-                    atf_thread_writer_write_event(
-                        writer,
-                        detail_event.timestamp,
-                        detail_event.function_id,
-                        detail_event.event_kind,
-                        detail_event.call_depth,
-                        &detail_event,
-                        sizeof(DetailEvent)
-                    );
-                    events_read++;
-                }
-            } else {
-                IndexEvent index_event;
-                while (ring_buffer_read_raw(active_hdr, sizeof(IndexEvent), &index_event)) {
-                    atf_thread_writer_write_event(
-                        writer,
-                        index_event.timestamp,
-                        index_event.function_id,
-                        index_event.event_kind,
-                        index_event.call_depth,
-                        NULL,
-                        0
-                    );
-                    events_read++;
-                }
-            }
+            events_read += is_detail ? drain_detail_ring(writer, active_hdr, &detail_bytes, metrics)
+                                     : drain_index_ring(writer, active_hdr, metrics);
             // Count as one processed "ring" for metrics if we read any events
             if (events_read > 0) {
                 processed = 1;
@@ -407,25 +500,25 @@ static uint32_t drain_lane(DrainThread* drain,
         return 0;
     }
 
-    atomic_fetch_add_explicit(&drain->metrics.rings_total, processed, memory_order_relaxed);
+    atomic_fetch_add_explicit(&metrics->rings_total, processed, memory_order_relaxed);
     if (is_detail) {
-        atomic_fetch_add_explicit(&drain->metrics.rings_detail, processed, memory_order_relaxed);
+        atomic_fetch_add_explicit(&metrics->rings_detail, processed, memory_order_relaxed);
     } else {
-        atomic_fetch_add_explicit(&drain->metrics.rings_index, processed, memory_order_relaxed);
+        atomic_fetch_add_explicit(&metrics->rings_index, processed, memory_order_relaxed);
     }
 
-    if (slot_index < MAX_THREADS) {
-        atomic_fetch_add_explicit(&drain->metrics.per_thread_rings[slot_index][is_detail ? 1 : 0],
+    if (slot_index < drain->slot_capacity) {
+        atomic_fetch_add_explicit(&metrics->per_thread_rings[slot_index][is_detail ? 1 : 0],
                                   processed,
                                   memory_order_relaxed);
     }
 
     // Track actual events drained (used by FridaController::get_stats())
     if (events_read > 0) {
-        atomic_fetch_add_explicit(&drain->metrics.total_events_drained, events_read, memory_order_relaxed);
-        // Estimate bytes: IndexEvent = 32 bytes, DetailEvent = varies
-        size_t event_size = is_detail ? sizeof(DetailEvent) : sizeof(IndexEvent);
-        atomic_fetch_add_explicit(&drain->metrics.total_bytes_drained, events_read * event_size, memory_order_relaxed);
+        atomic_fetch_add_explicit(&metrics->total_events_drained, events_read, memory_order_relaxed);
+        // Index events are fixed size; detail records report their own length
+        uint64_t bytes = is_detail ? detail_bytes : (uint64_t)events_read * sizeof(IndexEvent);
+        atomic_fetch_add_explicit(&metrics->total_bytes_drained, bytes, memory_order_relaxed);
     }
 
     return processed;
@@ -699,6 +792,43 @@ static ThreadDrainResult drain_thread_lanes(DrainIterator* iter, uint32_t thread
     return result;
 }
 
+// Drain both lanes of one registry slot
+static bool drain_slot(DrainThread* drain,
+                       DrainWorker* worker,
+                       uint32_t slot,
+                       ThreadLaneSet* lanes,
+                       bool final_pass) {
+    DrainMetricsAtomic* metrics = drain_metrics_for(drain, worker);
+    bool work_done = false;
+    bool hit_limit = false;
+
+    Lane* index_lane = thread_lanes_get_index_lane(lanes);
+    uint32_t processed = drain_lane(drain, worker, slot, index_lane, false, final_pass, &hit_limit);
+    if (processed > 0) {
+        work_done = true;
+    }
+    if (hit_limit) {
+        atomic_fetch_add_explicit(&metrics->fairness_switches, 1, memory_order_relaxed);
+    }
+
+    hit_limit = false;
+    Lane* detail_lane = thread_lanes_get_detail_lane(lanes);
+    processed = drain_lane(drain, worker, slot, detail_lane, true, final_pass, &hit_limit);
+    if (processed > 0) {
+        work_done = true;
+    }
+    if (hit_limit) {
+        atomic_fetch_add_explicit(&metrics->fairness_switches, 1, memory_order_relaxed);
+    }
+
+    // An exited thread's slot is recycled once a pass finds nothing left
+    if (!work_done && thread_lanes_is_retiring(lanes)) {
+        drain_reclaim_slot(drain, slot);
+    }
+
+    return work_done;
+}
+
 // Main drain iteration function
 static bool drain_iteration(DrainThread* drain) {
     if (!drain || !drain->iterator) {
@@ -824,6 +954,23 @@ static bool drain_iteration(DrainThread* drain) {
         }
     }
 
+    // Exited threads' slots are recycled once an iteration finds no work.
+    // The scheduler above only tracks simulated pending counts, so each
+    // retiring slot's lanes are drained here and the slot is reclaimed only
+    // after a pass over them comes back empty.
+    if (!work_done) {
+        for (uint32_t slot = thread_registry_next_active_slot(drain->registry, 0);
+             slot != UINT32_MAX;
+             slot = thread_registry_next_active_slot(drain->registry, slot + 1)) {
+            ThreadLaneSet* lanes = thread_registry_get_thread_at(drain->registry, slot);
+            if (lanes && thread_lanes_is_retiring(lanes) &&
+                drain_slot(drain, NULL, slot, lanes, true)) {
+                work_done = true;
+            }
+        }
+    }
+    thread_registry_advance_epoch(drain->registry);
+
     // Update iteration metrics
     uint64_t iteration_end = monotonic_now_ns();
     uint64_t iteration_duration = iteration_end - iteration_start;
@@ -967,12 +1114,23 @@ static void drain_iterator_destroy(DrainIterator* iter) {
     free(iter);
 }
 
-static bool drain_cycle(DrainThread* drain, bool final_pass) {
+// Slots the cycles may visit: the registry's capacity, bounded by the per-slot
+// arrays sized at creation
+static uint32_t drain_slot_limit(const DrainThread* drain) {
+    uint32_t capacity = thread_registry_get_capacity(drain->registry);
+    return capacity < drain->slot_capacity ? capacity : drain->slot_capacity;
+}
+
+// Visit every registered slot. Used by a lone worker, and by worker 0 for the
+// shutdown sweep once all other workers have exited. Walks the registry's slot
+// bitmap from the round-robin cursor, so idle capacity costs one word test
+// per 64 slots.
+static bool drain_cycle_all(DrainThread* drain, DrainWorker* worker, bool final_pass) {
     if (!drain || !drain->registry) {
         return false;
     }
 
-    const uint32_t capacity = thread_registry_get_capacity(drain->registry);
+    const uint32_t capacity = drain_slot_limit(drain);
     if (capacity == 0) {
         return false;
     }
@@ -984,66 +1142,351 @@ static bool drain_cycle(DrainThread* drain, bool final_pass) {
 
     bool work_done = false;
 
-    for (uint32_t offset = 0; offset < capacity; ++offset) {
-        uint32_t slot = (start + offset) % capacity;
-        ThreadLaneSet* lanes = thread_registry_get_thread_at(drain->registry, slot);
-        if (!lanes) {
-            continue;
+    // [start, capacity) then [0, start)
+    for (uint32_t pass = 0; pass < 2; ++pass) {
+        const uint32_t end = pass == 0 ? capacity : start;
+        for (uint32_t slot = thread_registry_next_active_slot(drain->registry, pass == 0 ? start : 0);
+             slot < end;
+             slot = thread_registry_next_active_slot(drain->registry, slot + 1)) {
+            ThreadLaneSet* lanes = thread_registry_get_thread_at(drain->registry, slot);
+            if (!lanes) {
+                continue;
+            }
+            if (drain_slot(drain, worker, slot, lanes, final_pass)) {
+                work_done = true;
+            }
         }
+    }
 
-        bool hit_limit = false;
+    atomic_store_explicit(&drain->rr_cursor, (start + 1) % capacity, memory_order_relaxed);
+    atomic_store_explicit(&drain->last_cycle_ns, monotonic_now_ns(), memory_order_relaxed);
+    thread_registry_advance_epoch(drain->registry);
 
-        Lane* index_lane = thread_lanes_get_index_lane(lanes);
-        uint32_t processed = drain_lane(drain, slot, index_lane, false, final_pass, &hit_limit);
-        if (processed > 0) {
-            work_done = true;
+    return work_done;
+}
+
+static bool drain_cycle(DrainThread* drain, bool final_pass) {
+    return drain_cycle_all(drain, NULL, final_pass);
+}
+
+// Spread active slots evenly: the k-th active slot belongs to worker k % count
+static void drain_worker_compute_shard(DrainThread* drain, DrainWorker* worker, uint32_t capacity) {
+    memset(worker->shard_words, 0, sizeof(worker->shard_words));
+    uint32_t rank = 0;
+    for (uint32_t slot = thread_registry_next_active_slot(drain->registry, 0);
+         slot < capacity;
+         slot = thread_registry_next_active_slot(drain->registry, slot + 1)) {
+        if (rank % drain->worker_count == worker->index) {
+            worker->shard_words[slot / 64] |= 1ull << (slot % 64);
         }
-        if (hit_limit) {
-            atomic_fetch_add_explicit(&drain->metrics.fairness_switches, 1, memory_order_relaxed);
+        rank++;
+    }
+}
+
+static void drain_worker_refresh_shard(DrainThread* drain, DrainWorker* worker, uint32_t capacity) {
+    uint64_t generation = thread_registry_get_slot_generation(drain->registry);
+    if (generation == worker->observed_generation) {
+        return;
+    }
+    worker->observed_generation = generation;
+    drain_worker_compute_shard(drain, worker, capacity);
+    atomic_fetch_add_explicit(&worker->rebalances, 1, memory_order_relaxed);
+}
+
+// First slot >= from that is in the worker's shard or still held by it (so
+// slots that left the shard get released), or UINT32_MAX
+static uint32_t drain_worker_next_slot(const DrainWorker* worker, uint32_t from, uint32_t capacity) {
+    for (uint32_t w = from / 64; w * 64 < capacity; ++w) {
+        uint64_t bits = worker->shard_words[w] | worker->owned_words[w];
+        if (w == from / 64) {
+            bits &= ~0ull << (from % 64);
+        }
+        if (bits) {
+            uint32_t slot = w * 64 + (uint32_t)__builtin_ctzll(bits);
+            return slot < capacity ? slot : UINT32_MAX;
         }
+    }
+    return UINT32_MAX;
+}
 
-        hit_limit = false;
-        Lane* detail_lane = thread_lanes_get_detail_lane(lanes);
-        processed = drain_lane(drain, slot, detail_lane, true, final_pass, &hit_limit);
-        if (processed > 0) {
-            work_done = true;
+// Decide whether the worker may drain a slot this cycle. A worker releases
+// slots that left its shard between visits (never mid-drain), and claims new
+// ones only once the previous owner has released them. The release/acquire
+// pair hands the slot's ATF writer over with it.
+static bool drain_worker_hold_slot(DrainThread* drain, DrainWorker* worker, uint32_t slot) {
+    uint32_t owner = atomic_load_explicit(&drain->slot_owner[slot], memory_order_relaxed);
+    const uint64_t bit = 1ull << (slot % 64);
+
+    if ((worker->shard_words[slot / 64] & bit) == 0) {
+        if (owner == worker->index) {
+            atomic_store_explicit(&drain->slot_owner[slot], DRAIN_SLOT_UNOWNED, memory_order_release);
+            atomic_fetch_sub_explicit(&worker->slots_owned, 1, memory_order_relaxed);
         }
-        if (hit_limit) {
-            atomic_fetch_add_explicit(&drain->metrics.fairness_switches, 1, memory_order_relaxed);
+        worker->owned_words[slot / 64] &= ~bit;
+        return false;
+    }
+
+    if (owner == worker->index) {
+        return true;
+    }
+
+    unsigned int expected = DRAIN_SLOT_UNOWNED;
+    if (!atomic_compare_exchange_strong_explicit(&drain->slot_owner[slot],
+                                                 &expected,
+                                                 worker->index,
+                                                 memory_order_acquire,
+                                                 memory_order_relaxed)) {
+        return false; // Previous owner has not let go yet
+    }
+    worker->owned_words[slot / 64] |= bit;
+    atomic_fetch_add_explicit(&worker->slots_owned, 1, memory_order_relaxed);
+    return true;
+}
+
+// Visit the slots in this worker's shard
+static bool drain_shard_cycle(DrainThread* drain, DrainWorker* worker, bool final_pass) {
+    if (!drain->registry) {
+        return false;
+    }
+
+    const uint32_t capacity = drain_slot_limit(drain);
+    if (capacity == 0) {
+        return false;
+    }
+
+    drain_worker_refresh_shard(drain, worker, capacity);
+
+    uint32_t start = worker->rr_cursor < capacity ? worker->rr_cursor : 0;
+    bool work_done = false;
+
+    for (uint32_t pass = 0; pass < 2; ++pass) {
+        const uint32_t end = pass == 0 ? capacity : start;
+        for (uint32_t slot = drain_worker_next_slot(worker, pass == 0 ? start : 0, capacity);
+             slot < end;
+             slot = drain_worker_next_slot(worker, slot + 1, capacity)) {
+            if (!drain_worker_hold_slot(drain, worker, slot)) {
+                continue;
+            }
+            ThreadLaneSet* lanes = thread_registry_get_thread_at(drain->registry, slot);
+            if (!lanes) {
+                continue;
+            }
+            if (drain_slot(drain, worker, slot, lanes, final_pass)) {
+                work_done = true;
+            }
         }
     }
 
-    atomic_store_explicit(&drain->rr_cursor, (start + 1) % capacity, memory_order_relaxed);
+    worker->rr_cursor = (start + 1) % capacity;
     atomic_store_explicit(&drain->last_cycle_ns, monotonic_now_ns(), memory_order_relaxed);
+    thread_registry_advance_epoch(drain->registry);
 
     return work_done;
 }
 
+static bool drain_slot_has_submitted(ThreadLaneSet* lanes) {
+    return lane_has_submitted_rings(thread_lanes_get_index_lane(lanes)) ||
+           lane_has_submitted_rings(thread_lanes_get_detail_lane(lanes));
+}
+
+// Drain a slot taken from a deque. A queued slot is handed out exactly once,
+// so whoever took it drains it exclusively; the release store lets the next
+// drainer (possibly another worker) see this one's writer state.
+static bool drain_queued_slot(DrainThread* drain, DrainWorker* worker, uint32_t slot, bool final_pass) {
+    atomic_store_explicit(&drain->slot_state[slot], DRAIN_SLOT_DRAINING, memory_order_relaxed);
+
+    bool work_done = false;
+    ThreadLaneSet* lanes = thread_registry_get_thread_at(drain->registry, slot);
+    if (lanes) {
+        work_done = drain_slot(drain, worker, slot, lanes, final_pass);
+    }
+
+    atomic_store_explicit(&drain->slot_state[slot], DRAIN_SLOT_IDLE, memory_order_release);
+    return work_done;
+}
+
+// Take one queued slot from the peer with the deepest deque
+static bool drain_steal_slot(DrainThread* drain, DrainWorker* thief, bool final_pass) {
+    DrainWorker* victim = NULL;
+    uint32_t deepest = 0;
+    for (uint32_t i = 1; i < drain->worker_count; ++i) {
+        DrainWorker* peer = &drain->workers[(thief->index + i) % drain->worker_count];
+        uint32_t depth = drain_slot_deque_size(&peer->deque);
+        if (depth > deepest) {
+            deepest = depth;
+            victim = peer;
+        }
+    }
+    if (!victim) {
+        return false;
+    }
+
+    uint32_t slot = drain_slot_deque_steal(&victim->deque);
+    if (slot == DRAIN_SLOT_DEQUE_EMPTY) {
+        return false; // Lost the race to the owner or another thief
+    }
+    atomic_fetch_add_explicit(&thief->steals, 1, memory_order_relaxed);
+    return drain_queued_slot(drain, thief, slot, final_pass);
+}
+
+// Work-stealing variant of the shard cycle: owned slots with submitted rings
+// go through the worker's deque, where idle peers can take them while this
+// worker is busy with a hot slot.
+static bool drain_stealing_cycle(DrainThread* drain, DrainWorker* worker, bool final_pass) {
+    if (!drain->registry) {
+        return false;
+    }
+
+    const uint32_t capacity = drain_slot_limit(drain);
+    if (capacity == 0) {
+        return false;
+    }
+
+    drain_worker_refresh_shard(drain, worker, capacity);
+
+    uint32_t start = worker->rr_cursor < capacity ? worker->rr_cursor : 0;
+    bool work_done = false;
+
+    for (uint32_t pass = 0; pass < 2; ++pass) {
+        const uint32_t end = pass == 0 ? capacity : start;
+        for (uint32_t slot = drain_worker_next_slot(worker, pass == 0 ? start : 0, capacity);
+             slot < end;
+             slot = drain_worker_next_slot(worker, slot + 1, capacity)) {
+            if (!drain_worker_hold_slot(drain, worker, slot)) {
+                continue;
+            }
+            ThreadLaneSet* lanes = thread_registry_get_thread_at(drain->registry, slot);
+            if (!lanes) {
+                continue;
+            }
+
+            unsigned int expected = DRAIN_SLOT_IDLE;
+            if (drain_slot_has_submitted(lanes)) {
+                if (atomic_compare_exchange_strong_explicit(&drain->slot_state[slot],
+                                                            &expected,
+                                                            DRAIN_SLOT_QUEUED,
+                                                            memory_order_acquire,
+                                                            memory_order_relaxed)) {
+                    // Cannot fail: each slot is queued at most once
+                    (void)drain_slot_deque_push(&worker->deque, slot);
+                }
+            } else if (atomic_compare_exchange_strong_explicit(&drain->slot_state[slot],
+                                                               &expected,
+                                                               DRAIN_SLOT_DRAINING,
+                                                               memory_order_acquire,
+                                                               memory_order_relaxed)) {
+                // No submitted rings: flush the active ring in place
+                if (drain_slot(drain, worker, slot, lanes, final_pass)) {
+                    work_done = true;
+                }
+                atomic_store_explicit(&drain->slot_state[slot], DRAIN_SLOT_IDLE, memory_order_release);
+            }
+        }
+    }
+    worker->rr_cursor = (start + 1) % capacity;
+
+    uint32_t slot;
+    while ((slot = drain_slot_deque_pop(&worker->deque)) != DRAIN_SLOT_DEQUE_EMPTY) {
+        if (drain_queued_slot(drain, worker, slot, final_pass)) {
+            work_done = true;
+        }
+    }
+
+    if (!work_done) {
+        work_done = drain_steal_slot(drain, worker, final_pass);
+    }
+
+    atomic_store_explicit(&drain->last_cycle_ns, monotonic_now_ns(), memory_order_relaxed);
+    thread_registry_advance_epoch(drain->registry);
+    return work_done;
+}
+
+static bool drain_worker_cycle(DrainThread* drain, DrainWorker* worker, bool final_pass) {
+    if (drain->worker_count <= 1) {
+        return drain_cycle_all(drain, worker, final_pass);
+    }
+    if (drain->worker_algorithm == DRAIN_SCHED_WORK_STEALING) {
+        return drain_stealing_cycle(drain, worker, final_pass);
+    }
+    return drain_shard_cycle(drain, worker, final_pass);
+}
+
+// Add the summable counters of one metrics set into a snapshot
+static void drain_metrics_accumulate(const DrainMetricsAtomic* src, uint32_t slots, DrainMetrics* out) {
+    out->cycles_total += atomic_load_explicit(&src->cycles_total, memory_order_relaxed);
+    out->cycles_idle += atomic_load_explicit(&src->cycles_idle, memory_order_relaxed);
+    out->rings_total += atomic_load_explicit(&src->rings_total, memory_order_relaxed);
+    out->rings_index += atomic_load_explicit(&src->rings_index, memory_order_relaxed);
+    out->rings_detail += atomic_load_explicit(&src->rings_detail, memory_order_relaxed);
+    out->fairness_switches += atomic_load_explicit(&src->fairness_switches, memory_order_relaxed);
+    out->sleeps += atomic_load_explicit(&src->sleeps, memory_order_relaxed);
+    out->yields += atomic_load_explicit(&src->yields, memory_order_relaxed);
+    out->final_drains += atomic_load_explicit(&src->final_drains, memory_order_relaxed);
+    out->total_sleep_us += atomic_load_explicit(&src->total_sleep_us, memory_order_relaxed);
+    for (uint32_t i = 0; i < slots && i < MAX_THREADS; ++i) {
+        out->rings_per_thread[i][0] += atomic_load_explicit(&src->per_thread_rings[i][0], memory_order_relaxed);
+        out->rings_per_thread[i][1] += atomic_load_explicit(&src->per_thread_rings[i][1], memory_order_relaxed);
+    }
+    out->total_events_drained += atomic_load_explicit(&src->total_events_drained, memory_order_relaxed);
+    out->total_bytes_drained += atomic_load_explicit(&src->total_bytes_drained, memory_order_relaxed);
+    out->wake_parks += atomic_load_explicit(&src->wake_parks, memory_order_relaxed);
+    out->wake_signals += atomic_load_explicit(&src->wake_signals, memory_order_relaxed);
+    out->idle_wait_ns += atomic_load_explicit(&src->idle_wait_ns, memory_order_relaxed);
+    out->write_errors += atomic_load_explicit(&src->write_errors, memory_order_relaxed);
+    out->events_lost += atomic_load_explicit(&src->events_lost, memory_order_relaxed);
+    uint64_t latency_max = atomic_load_explicit(&src->wake_latency_max_ns, memory_order_relaxed);
+    if (latency_max > out->wake_latency_max_ns) {
+        out->wake_latency_max_ns = latency_max;
+    }
+}
+
+// Mean wake latency across the shared set and every worker
+static uint64_t drain_wake_latency_avg(const DrainThread* drain) {
+    uint64_t samples = atomic_load_explicit(&drain->metrics.wake_latency_samples, memory_order_relaxed);
+    uint64_t total = atomic_load_explicit(&drain->metrics.wake_latency_total_ns, memory_order_relaxed);
+    for (uint32_t w = 0; w < DRAIN_MAX_WORKERS; ++w) {
+        const DrainMetricsAtomic* m = &drain->workers[w].metrics;
+        samples += atomic_load_explicit(&m->wake_latency_samples, memory_order_relaxed);
+        total += atomic_load_explicit(&m->wake_latency_total_ns, memory_order_relaxed);
+    }
+    return samples > 0 ? total / samples : 0;
+}
+
 static void drain_metrics_snapshot(const DrainThread* drain, DrainMetrics* out) {
     if (!drain || !out) {
         return;
     }
     memset(out, 0, sizeof(*out));
+
+    // Counters are split between the shared set and each worker's own set
+    drain_metrics_accumulate(&drain->metrics, drain->slot_capacity, out);
+    for (uint32_t w = 0; w < DRAIN_MAX_WORKERS; ++w) {
+        drain_metrics_accumulate(&drain->workers[w].metrics, drain->slot_capacity, out);
+    }
+    out->wake_latency_avg_ns = drain_wake_latency_avg(drain);
+    out->slots_reclaimed = thread_registry_get_slots_reclaimed(drain->registry);
+    out->slots_reused = thread_registry_get_slots_reused(drain->registry);
+    out->rings_grown = thread_registry_get_rings_grown(drain->registry);
+    out->ring_growth_denied = thread_registry_get_ring_growth_denied(drain->registry);
+
+    out->worker_count = drain->worker_count;
+    for (uint32_t w = 0; w < drain->worker_count && w < DRAIN_MAX_WORKERS; ++w) {
+        const DrainWorker* worker = &drain->workers[w];
+        DrainWorkerMetrics* dst = &out->workers[w];
+        dst->cycles_total = atomic_load_explicit(&worker->metrics.cycles_total, memory_order_relaxed);
+        dst->cycles_idle = atomic_load_explicit(&worker->metrics.cycles_idle, memory_order_relaxed);
+        dst->rings_total = atomic_load_explicit(&worker->metrics.rings_total, memory_order_relaxed);
+        dst->events_drained = atomic_load_explicit(&worker->metrics.total_events_drained, memory_order_relaxed);
+        dst->bytes_drained = atomic_load_explicit(&worker->metrics.total_bytes_drained, memory_order_relaxed);
+        dst->rebalances = atomic_load_explicit(&worker->rebalances, memory_order_relaxed);
+        dst->steals = atomic_load_explicit(&worker->steals, memory_order_relaxed);
+        dst->slots_owned = (uint32_t)atomic_load_explicit(&worker->slots_owned, memory_order_relaxed);
+        dst->slots_queued = drain_slot_deque_size(&worker->deque);
+    }
+
+    // Per-thread drain iteration metrics (iterator mode runs on the shared set)
     const DrainMetricsAtomic* src = &drain->metrics;
-    out->cycles_total = atomic_load_explicit(&src->cycles_total, memory_order_relaxed);
-    out->cycles_idle = atomic_load_explicit(&src->cycles_idle, memory_order_relaxed);
-    out->rings_total = atomic_load_explicit(&src->rings_total, memory_order_relaxed);
-    out->rings_index = atomic_load_explicit(&src->rings_index, memory_order_relaxed);
-    out->rings_detail = atomic_load_explicit(&src->rings_detail, memory_order_relaxed);
-    out->fairness_switches = atomic_load_explicit(&src->fairness_switches, memory_order_relaxed);
-    out->sleeps = atomic_load_explicit(&src->sleeps, memory_order_relaxed);
-    out->yields = atomic_load_explicit(&src->yields, memory_order_relaxed);
-    out->final_drains = atomic_load_explicit(&src->final_drains, memory_order_relaxed);
-    out->total_sleep_us = atomic_load_explicit(&src->total_sleep_us, memory_order_relaxed);
-    for (uint32_t i = 0; i < MAX_THREADS; ++i) {
-        out->rings_per_thread[i][0] = atomic_load_explicit(&src->per_thread_rings[i][0], memory_order_relaxed);
-        out->rings_per_thread[i][1] = atomic_load_explicit(&src->per_thread_rings[i][1], memory_order_relaxed);
-    }
-
-    // Per-thread drain iteration metrics
     out->total_iterations = atomic_load_explicit(&src->total_iterations, memory_order_relaxed);
-    out->total_events_drained = atomic_load_explicit(&src->total_events_drained, memory_order_relaxed);
-    out->total_bytes_drained = atomic_load_explicit(&src->total_bytes_drained, memory_order_relaxed);
     out->threads_processed = atomic_load_explicit(&src->threads_processed, memory_order_relaxed);
     out->threads_skipped = atomic_load_explicit(&src->threads_skipped, memory_order_relaxed);
     out->iteration_duration_ns = atomic_load_explicit(&src->iteration_duration_ns, memory_order_relaxed);
@@ -1061,6 +1504,226 @@ static void drain_metrics_snapshot(const DrainThread* drain, DrainMetrics* out)
     }
 }
 
+static inline DrainWakeWord* drain_wake_word(const DrainThread* drain) {
+    if (!drain->config.wake_on_submit || !drain->control_block) {
+        return NULL;
+    }
+    return &drain->control_block->drain_wake;
+}
+
+// Park on the wake word until the agent submits into an empty queue, stop is
+// requested, or a heartbeat tick passes. The worker registers before one more
+// cycle so a submit landing after the idle cycle is either drained here or
+// bumps the sequence the wait compares against.
+static void drain_idle_park(DrainThread* drain, DrainWorker* worker,
+                            DrainMetricsAtomic* metrics, DrainWakeWord* word) {
+    uint32_t seq = drain_wake_prepare(word);
+
+    bool work = atomic_load_explicit(&drain->state, memory_order_acquire) != DRAIN_STATE_RUNNING ||
+                drain_worker_cycle(drain, worker, false);
+    if (!work) {
+        uint64_t start_ns = monotonic_now_ns();
+        int rc = drain_wake_wait(word, seq, kRegistryTickIntervalNs);
+        atomic_fetch_add_explicit(&metrics->idle_wait_ns, monotonic_now_ns() - start_ns,
+                                  memory_order_relaxed);
+        atomic_fetch_add_explicit(&metrics->wake_parks, 1, memory_order_relaxed);
+        if (rc == 0) {
+            atomic_fetch_add_explicit(&metrics->wake_signals, 1, memory_order_relaxed);
+            worker->wake_pending = true;
+        }
+    }
+
+    drain_wake_finish(word);
+}
+
+// After a wakeup, charge the time from the agent's signal to the first
+// cycle that drained something
+static void drain_note_wake_latency(DrainThread* drain, DrainWorker* worker,
+                                    DrainMetricsAtomic* metrics, bool work) {
+    if (!worker->wake_pending) {
+        return;
+    }
+    worker->wake_pending = false;
+    if (!work || !drain->control_block) {
+        return;
+    }
+
+    uint64_t signal_ns = __atomic_load_n(&drain->control_block->drain_wake.signal_ns,
+                                         __ATOMIC_RELAXED);
+    uint64_t now_ns = monotonic_now_ns();
+    if (signal_ns == 0 || signal_ns > now_ns) {
+        return;
+    }
+    uint64_t latency = now_ns - signal_ns;
+    atomic_fetch_add_explicit(&metrics->wake_latency_samples, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&metrics->wake_latency_total_ns, latency, memory_order_relaxed);
+    if (latency > atomic_load_explicit(&metrics->wake_latency_max_ns, memory_order_relaxed)) {
+        atomic_store_explicit(&metrics->wake_latency_max_ns, latency, memory_order_relaxed);
+    }
+}
+
+// Back off after a cycle that found no work
+static void drain_idle_backoff(DrainThread* drain, DrainWorker* worker,
+                               DrainMetricsAtomic* metrics) {
+    DrainWakeWord* word = drain_wake_word(drain);
+    if (word) {
+        drain_idle_park(drain, worker, metrics, word);
+    } else if (drain->config.yield_on_idle) {
+        sched_yield();
+        atomic_fetch_add_explicit(&metrics->yields, 1, memory_order_relaxed);
+    } else if (drain->config.poll_interval_us > 0) {
+        usleep(drain->config.poll_interval_us);
+        atomic_fetch_add_explicit(&metrics->sleeps, 1, memory_order_relaxed);
+        atomic_fetch_add_explicit(&metrics->total_sleep_us,
+                                  drain->config.poll_interval_us,
+                                  memory_order_relaxed);
+    }
+}
+
+// Entry point for workers 1..N-1: drain the shard until stop, finish the
+// shard, then report done so worker 0 can run the shutdown sweep.
+static void* drain_shard_worker_thread(void* arg) {
+    DrainWorker* worker = (DrainWorker*)arg;
+    DrainThread* drain = worker->drain;
+
+    char name[16];
+    snprintf(name, sizeof(name), "ada_drain_%u", worker->index);
+#if defined(__APPLE__)
+    pthread_setname_np(name);
+#elif defined(__linux__)
+    pthread_setname_np(pthread_self(), name);
+#endif
+
+    DrainMetricsAtomic* metrics = &worker->metrics;
+    while (atomic_load_explicit(&drain->state, memory_order_acquire) == DRAIN_STATE_RUNNING) {
+        bool work = drain_worker_cycle(drain, worker, false);
+        drain_note_wake_latency(drain, worker, metrics, work);
+        atomic_fetch_add_explicit(&metrics->cycles_total, 1, memory_order_relaxed);
+        if (!work) {
+            atomic_fetch_add_explicit(&metrics->cycles_idle, 1, memory_order_relaxed);
+            drain_idle_backoff(drain, worker, metrics);
+        }
+    }
+
+    bool had_work;
+    do {
+        had_work = drain_worker_cycle(drain, worker, true);
+        atomic_fetch_add_explicit(&metrics->cycles_total, 1, memory_order_relaxed);
+    } while (had_work);
+
+    atomic_fetch_sub_explicit(&drain->workers_running, 1, memory_order_release);
+    return NULL;
+}
+
+// Merge every slot's aggregation lane into a fresh table. Tables are
+// cumulative per slot, so each merge is a full snapshot that also covers
+// threads that exited during the session. The merged table is sized from the
+// slots' key counts at half load; if a live table grew past that or a probe
+// run overflowed, the merge is redone at twice the size, so functions are
+// never lost to the merge itself (dropped_calls reports only the slots' own
+// drops). Caller frees the result.
+static AggregateTable* drain_merge_aggregates(DrainThread* drain) {
+    if (!drain->registry) {
+        return NULL;
+    }
+    uint32_t slots = thread_registry_get_capacity(drain->registry);
+    uint64_t keys = 0;
+    for (uint32_t slot = 0; slot < slots; slot++) {
+        const AggregateTable* table = thread_registry_get_aggregates(drain->registry, slot);
+        if (table) {
+            keys += __atomic_load_n(&table->used, __ATOMIC_RELAXED);
+        }
+    }
+    uint64_t capacity = AGGREGATE_TABLE_CAPACITY;
+    while (capacity < keys * 2 && capacity < (1ull << 31)) {
+        capacity <<= 1;
+    }
+
+    for (;;) {
+        AggregateTable* merged = (AggregateTable*)malloc(aggregate_table_bytes((uint32_t)capacity));
+        if (!aggregate_table_init(merged, (uint32_t)capacity)) {
+            free(merged);
+            return NULL;
+        }
+        bool complete = true;
+        for (uint32_t slot = 0; slot < slots && complete; slot++) {
+            const AggregateTable* table = thread_registry_get_aggregates(drain->registry, slot);
+            complete = aggregate_table_merge(merged, table);
+        }
+        if (complete || capacity >= (1ull << 31)) {
+            return merged;
+        }
+        free(merged);
+        capacity <<= 1;
+    }
+}
+
+// Write the "aggregates" object shared by manifest.json and aggregates.json
+static void drain_print_aggregates(FILE* out, const AggregateTable* merged) {
+    fprintf(out, "{\"dropped_calls\": %llu, \"functions\": [\n",
+            (unsigned long long)merged->dropped_calls);
+    bool first = true;
+    for (uint32_t i = 0; i < merged->capacity; i++) {
+        const AggregateEntry* e = &merged->entries[i];
+        if (e->function_id == 0) {
+            continue;
+        }
+        fprintf(out,
+                "%s    {\"function_id\": \"0x%016llx\", \"calls\": %llu, "
+                "\"inclusive_time\": %llu, \"exclusive_time\": %llu}",
+                first ? "" : ",\n",
+                (unsigned long long)e->function_id, (unsigned long long)e->calls,
+                (unsigned long long)e->inclusive_time, (unsigned long long)e->exclusive_time);
+        first = false;
+    }
+    fprintf(out, "\n  ]}");
+}
+
+// Replace <session>/aggregates.json with a merged snapshot. Written to a
+// temporary file and renamed so readers never see a partial document.
+static void drain_write_aggregates_file(const char* session_dir, const AggregateTable* merged) {
+    char path[4096 + 32];
+    char tmp_path[4096 + 32];
+    snprintf(path, sizeof(path), "%s/aggregates.json", session_dir);
+    snprintf(tmp_path, sizeof(tmp_path), "%s/aggregates.json.tmp", session_dir);
+
+    FILE* out = fopen(tmp_path, "w");
+    if (!out) {
+        return;
+    }
+    fprintf(out, "{\n  \"aggregates\": ");
+    drain_print_aggregates(out, merged);
+    fprintf(out, "\n}\n");
+    if (fclose(out) != 0 || rename(tmp_path, path) != 0) {
+        unlink(tmp_path);
+    }
+}
+
+// Periodic merge on the drain tick. Skips the tick instead of waiting while
+// session start/stop holds the lifecycle lock; stop does the final merge.
+static void drain_tick_aggregates(DrainThread* drain) {
+    uint32_t interval_ms = drain->config.aggregate_interval_ms;
+    if (interval_ms == 0 || !drain->registry) {
+        return;
+    }
+    uint64_t now_ns = monotonic_now_ns();
+    if (now_ns - drain->last_aggregate_merge_ns < (uint64_t)interval_ms * 1000000ull) {
+        return;
+    }
+    if (pthread_mutex_trylock(&drain->lifecycle_lock) != 0) {
+        return;
+    }
+    drain->last_aggregate_merge_ns = now_ns;
+    if (drain->session_active) {
+        AggregateTable* merged = drain_merge_aggregates(drain);
+        if (merged && merged->used > 0) {
+            drain_write_aggregates_file(drain->session_dir, merged);
+        }
+        free(merged);
+    }
+    pthread_mutex_unlock(&drain->lifecycle_lock);
+}
+
 static void* drain_worker_thread(void* arg) {
     DrainThread* drain = (DrainThread*)arg;
     if (!drain) {
@@ -1073,8 +1736,12 @@ static void* drain_worker_thread(void* arg) {
     pthread_setname_np(pthread_self(), "ada_drain");
 #endif
 
+    DrainWorker* worker = &drain->workers[0];
+    DrainMetricsAtomic* metrics = drain->iterator_enabled ? &drain->metrics : &worker->metrics;
+
     while (atomic_load_explicit(&drain->state, memory_order_acquire) == DRAIN_STATE_RUNNING) {
         drain_update_control_block(drain);
+        drain_tick_aggregates(drain);
         bool work = false;
 
         // Use per-thread drain iteration if available
@@ -1084,38 +1751,30 @@ static void* drain_worker_thread(void* arg) {
             // Sleep for iteration interval if no work done and interval configured
             if (!work && drain->iterator->iteration_interval_ms > 0) {
                 usleep(drain->iterator->iteration_interval_ms * 1000);
-                atomic_fetch_add_explicit(&drain->metrics.sleeps, 1, memory_order_relaxed);
-                atomic_fetch_add_explicit(&drain->metrics.total_sleep_us,
+                atomic_fetch_add_explicit(&metrics->sleeps, 1, memory_order_relaxed);
+                atomic_fetch_add_explicit(&metrics->total_sleep_us,
                                           drain->iterator->iteration_interval_ms * 1000,
                                           memory_order_relaxed);
             }
         } else {
             // Fallback to traditional drain cycle
-            work = drain_cycle(drain, false);
+            work = drain_worker_cycle(drain, worker, false);
+            drain_note_wake_latency(drain, worker, metrics, work);
         }
 
-        atomic_fetch_add_explicit(&drain->metrics.cycles_total, 1, memory_order_relaxed);
+        atomic_fetch_add_explicit(&metrics->cycles_total, 1, memory_order_relaxed);
         if (!work) {
-            atomic_fetch_add_explicit(&drain->metrics.cycles_idle, 1, memory_order_relaxed);
+            atomic_fetch_add_explicit(&metrics->cycles_idle, 1, memory_order_relaxed);
 
             // Only apply idle handling if not using per-thread drain with its own timing
             if (!drain->iterator_enabled) {
-                if (drain->config.yield_on_idle) {
-                    sched_yield();
-                    atomic_fetch_add_explicit(&drain->metrics.yields, 1, memory_order_relaxed);
-                } else if (drain->config.poll_interval_us > 0) {
-                    usleep(drain->config.poll_interval_us);
-                    atomic_fetch_add_explicit(&drain->metrics.sleeps, 1, memory_order_relaxed);
-                    atomic_fetch_add_explicit(&drain->metrics.total_sleep_us,
-                                              drain->config.poll_interval_us,
-                                              memory_order_relaxed);
-                }
+                drain_idle_backoff(drain, worker, metrics);
             }
         }
     }
 
     // Final drain when stopping
-    atomic_fetch_add_explicit(&drain->metrics.final_drains, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&metrics->final_drains, 1, memory_order_relaxed);
 
     // For testing: if iterator state is DRAIN_ITER_DRAINING, only run one iteration
     bool single_iteration_mode = false;
@@ -1124,15 +1783,21 @@ static void* drain_worker_thread(void* arg) {
         single_iteration_mode = (iter_state == DRAIN_ITER_DRAINING);
     }
 
+    // Other workers finish their shards first; their slots and writers then
+    // pass to this thread for one sweep over every slot
+    while (atomic_load_explicit(&drain->workers_running, memory_order_acquire) > 0) {
+        sched_yield();
+    }
+
     bool had_work;
     do {
         // Use appropriate drain method for final drain
         if (drain->iterator_enabled && drain->iterator) {
             had_work = drain_iteration(drain);
         } else {
-            had_work = drain_cycle(drain, true);
+            had_work = drain_cycle_all(drain, worker, true);
         }
-        atomic_fetch_add_explicit(&drain->metrics.cycles_total, 1, memory_order_relaxed);
+        atomic_fetch_add_explicit(&metrics->cycles_total, 1, memory_order_relaxed);
         if (!had_work || single_iteration_mode) {
             break;
         }
@@ -1142,6 +1807,71 @@ static void* drain_worker_thread(void* arg) {
     return NULL;
 }
 
+static uint32_t drain_resolve_worker_count(const DrainConfig* config, bool iterator_enabled) {
+    if (iterator_enabled) {
+        return 1; // Iterator mode keeps its scheduling state on one thread
+    }
+    uint32_t count = config->worker_count;
+    if (count == DRAIN_WORKERS_PER_CORE) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        count = cpus > 0 ? (uint32_t)cpus : 1;
+    }
+    if (count == 0) {
+        count = 1;
+    }
+    if (count > DRAIN_MAX_WORKERS) {
+        count = DRAIN_MAX_WORKERS;
+    }
+    return count;
+}
+
+static DrainSchedulingAlgorithm drain_resolve_worker_algorithm(const DrainConfig* config,
+                                                               uint32_t worker_count) {
+    if (config->enable_work_stealing && worker_count > 1) {
+        return DRAIN_SCHED_WORK_STEALING;
+    }
+    return DRAIN_SCHED_ROUND_ROBIN;
+}
+
+// Start every worker with an empty shard and every slot unowned
+static void drain_workers_reset(DrainThread* drain) {
+    for (uint32_t w = 0; w < DRAIN_MAX_WORKERS; ++w) {
+        DrainWorker* worker = &drain->workers[w];
+        worker->drain = drain;
+        worker->index = w;
+        worker->started = false;
+        worker->observed_generation = 0;
+        memset(worker->shard_words, 0, sizeof(worker->shard_words));
+        memset(worker->owned_words, 0, sizeof(worker->owned_words));
+        worker->rr_cursor = 0;
+        worker->wake_pending = false;
+        atomic_store_explicit(&worker->slots_owned, 0, memory_order_relaxed);
+        drain_slot_deque_init(&worker->deque);
+    }
+    for (uint32_t slot = 0; slot < drain->slot_capacity; ++slot) {
+        atomic_store_explicit(&drain->slot_owner[slot], DRAIN_SLOT_UNOWNED, memory_order_relaxed);
+        atomic_store_explicit(&drain->slot_state[slot], DRAIN_SLOT_IDLE, memory_order_relaxed);
+    }
+    atomic_store_explicit(&drain->workers_running, 0, memory_order_relaxed);
+}
+
+// Join workers 1..N-1; returns the first join error
+static int drain_join_shard_workers(DrainThread* drain) {
+    int rc = 0;
+    for (uint32_t w = 1; w < DRAIN_MAX_WORKERS; ++w) {
+        DrainWorker* worker = &drain->workers[w];
+        if (!worker->started) {
+            continue;
+        }
+        int join_rc = drain_thread_call_pthread_join(worker->thread, NULL);
+        if (join_rc != 0 && rc == 0) {
+            rc = join_rc;
+        }
+        worker->started = false;
+    }
+    return rc;
+}
+
 // --------------------------------------------------------------------------------------
 // Public API
 // --------------------------------------------------------------------------------------
@@ -1160,6 +1890,46 @@ void drain_config_default(DrainConfig* config) {
     config->max_events_per_thread = 0;       // 0 = unlimited (use traditional behavior)
     config->iteration_interval_ms = 0;       // 0 = disabled (use traditional behavior)
     config->enable_fair_scheduling = false;  // Disabled by default for backward compatibility
+
+    // Buffered stdio by default: io_uring/mmap keep per-file queues and
+    // extents, which adds up at thousands of thread slots. Opt in via config.
+    config->writer_backend = ATF_WRITER_BACKEND_STDIO;
+
+    config->worker_count = 1;                // Single worker by default
+    config->enable_work_stealing = false;    // Static shards unless enabled
+    config->wake_on_submit = false;          // Poll unless the agent signals submits
+    config->aggregate_interval_ms = 1000;    // Refresh aggregates.json once a second
+}
+
+// Allocate the per-slot arrays for a registry of the given capacity
+static bool drain_slot_arrays_alloc(DrainThread* drain, uint32_t capacity) {
+    drain->slot_capacity = capacity;
+    drain->thread_writers = (AtfThreadWriter**)drain_thread_call_calloc(capacity, sizeof(AtfThreadWriter*));
+    drain->slot_owner = (atomic_uint*)drain_thread_call_calloc(capacity, sizeof(atomic_uint));
+    drain->slot_state = (atomic_uint*)drain_thread_call_calloc(capacity, sizeof(atomic_uint));
+    drain->thread_metrics_buffer = (ada_thread_metrics_snapshot_t*)drain_thread_call_calloc(
+        capacity, sizeof(ada_thread_metrics_snapshot_t));
+    drain->slot_rings = (atomic_uint_fast64_t(*)[2])drain_thread_call_calloc(
+        (size_t)(1 + DRAIN_MAX_WORKERS) * capacity, sizeof(*drain->slot_rings));
+    drain->lane_views = (LaneView(*)[2])drain_thread_call_calloc(capacity, sizeof(*drain->lane_views));
+    return drain->thread_writers && drain->slot_owner && drain->slot_state &&
+           drain->thread_metrics_buffer && drain->slot_rings && drain->lane_views;
+}
+
+static void drain_slot_arrays_free(DrainThread* drain) {
+    free(drain->thread_writers);
+    free(drain->slot_owner);
+    free(drain->slot_state);
+    free(drain->thread_metrics_buffer);
+    free(drain->slot_rings);
+    free(drain->lane_views);
+    drain->thread_writers = NULL;
+    drain->slot_owner = NULL;
+    drain->slot_state = NULL;
+    drain->thread_metrics_buffer = NULL;
+    drain->slot_rings = NULL;
+    drain->lane_views = NULL;
+    drain->slot_capacity = 0;
 }
 
 DrainThread* drain_thread_create(ThreadRegistry* registry, const DrainConfig* config) {
@@ -1184,18 +1954,41 @@ DrainThread* drain_thread_create(ThreadRegistry* registry, const DrainConfig* co
     drain->control_block = NULL;
     drain->last_registry_tick_ns = 0;
     drain->warmup_ticks = 0;
+    drain->last_aggregate_merge_ns = 0;
     drain->session_dir[0] = '\0';
     drain->session_active = false;
-    memset(drain->thread_writers, 0, sizeof(drain->thread_writers));
     drain->symbol_table_json = NULL;  // Phase 1: symbol resolution
     drain->thread_started = false;
 
-    drain_metrics_atomic_reset(&drain->metrics);
+    uint32_t slot_capacity = thread_registry_get_capacity(registry);
+    if (slot_capacity == 0) {
+        slot_capacity = MAX_THREADS;
+    }
+    if (!drain_slot_arrays_alloc(drain, slot_capacity)) {
+        drain_slot_arrays_free(drain);
+        free(drain);
+        return NULL;
+    }
+
+    drain_metrics_atomic_reset(&drain->metrics, drain->slot_rings, slot_capacity);
+    for (uint32_t w = 0; w < DRAIN_MAX_WORKERS; ++w) {
+        drain_metrics_atomic_reset(&drain->workers[w].metrics,
+                                   drain->slot_rings + (size_t)(1 + w) * slot_capacity,
+                                   slot_capacity);
+        atomic_init(&drain->workers[w].rebalances, 0);
+        atomic_init(&drain->workers[w].slots_owned, 0);
+        atomic_init(&drain->workers[w].steals, 0);
+    }
+    for (uint32_t slot = 0; slot < slot_capacity; ++slot) {
+        atomic_init(&drain->slot_owner[slot], DRAIN_SLOT_UNOWNED);
+        atomic_init(&drain->slot_state[slot], DRAIN_SLOT_IDLE);
+    }
+    atomic_init(&drain->workers_running, 0);
 
     if (!ada_global_metrics_init(&drain->thread_metrics,
                                  drain->thread_metrics_buffer,
-                                 MAX_THREADS)) {
-        pthread_mutex_destroy(&drain->lifecycle_lock);
+                                 slot_capacity)) {
+        drain_slot_arrays_free(drain);
         free(drain);
         return NULL;
     }
@@ -1205,6 +1998,7 @@ DrainThread* drain_thread_create(ThreadRegistry* registry, const DrainConfig* co
     atomic_init(&drain->last_cycle_ns, monotonic_now_ns());
 
     if (drain_thread_call_pthread_mutex_init(&drain->lifecycle_lock, NULL) != 0) {
+        drain_slot_arrays_free(drain);
         free(drain);
         return NULL;
     }
@@ -1213,14 +2007,10 @@ DrainThread* drain_thread_create(ThreadRegistry* registry, const DrainConfig* co
     if (local_config.enable_fair_scheduling ||
         (local_config.max_threads_per_cycle > 0 && local_config.enable_fair_scheduling)) {
 
-        uint32_t max_threads = thread_registry_get_capacity(registry);
-        if (max_threads == 0) {
-            max_threads = MAX_THREADS; // Fallback to system maximum
-        }
-
-        drain->iterator = drain_iterator_create(&local_config, max_threads);
+        drain->iterator = drain_iterator_create(&local_config, slot_capacity);
         if (!drain->iterator) {
             pthread_mutex_destroy(&drain->lifecycle_lock);
+            drain_slot_arrays_free(drain);
             free(drain);
             return NULL;
         }
@@ -1231,6 +2021,10 @@ DrainThread* drain_thread_create(ThreadRegistry* registry, const DrainConfig* co
         drain->iterator_enabled = false;
     }
 
+    drain->worker_count = drain_resolve_worker_count(&local_config, drain->iterator_enabled);
+    drain->worker_algorithm = drain_resolve_worker_algorithm(&local_config, drain->worker_count);
+    drain_workers_reset(drain);
+
     return drain;
 }
 
@@ -1271,8 +2065,14 @@ int drain_thread_start(DrainThread* drain) {
         return -EINVAL;
     }
 
+    drain->worker_count = drain_resolve_worker_count(&drain->config, drain->iterator_enabled);
+    drain->worker_algorithm = drain_resolve_worker_algorithm(&drain->config, drain->worker_count);
+    drain_workers_reset(drain);
+    atomic_store_explicit(&drain->workers_running, drain->worker_count - 1, memory_order_relaxed);
+
     int rc = drain_thread_call_pthread_create(&drain->worker, NULL, drain_worker_thread, drain);
     if (rc != 0) {
+        atomic_store_explicit(&drain->workers_running, 0, memory_order_relaxed);
         atomic_store_explicit(&drain->state, DRAIN_STATE_INITIALIZED, memory_order_release);
         pthread_mutex_unlock(&drain->lifecycle_lock);
         return rc;
@@ -1280,6 +2080,24 @@ int drain_thread_start(DrainThread* drain) {
 
     drain->thread_started = true;
 
+    for (uint32_t w = 1; w < drain->worker_count; ++w) {
+        DrainWorker* worker = &drain->workers[w];
+        rc = drain_thread_call_pthread_create(&worker->thread, NULL, drain_shard_worker_thread, worker);
+        if (rc != 0) {
+            // Unwind: workers that never started will not report done
+            atomic_fetch_sub_explicit(&drain->workers_running, drain->worker_count - w,
+                                      memory_order_release);
+            atomic_store_explicit(&drain->state, DRAIN_STATE_STOPPING, memory_order_release);
+            (void)drain_thread_call_pthread_join(drain->worker, NULL);
+            drain->thread_started = false;
+            (void)drain_join_shard_workers(drain);
+            atomic_store_explicit(&drain->state, DRAIN_STATE_INITIALIZED, memory_order_release);
+            pthread_mutex_unlock(&drain->lifecycle_lock);
+            return rc;
+        }
+        worker->started = true;
+    }
+
     pthread_mutex_unlock(&drain->lifecycle_lock);
     return 0;
 }
@@ -1304,14 +2122,17 @@ int drain_thread_stop(DrainThread* drain) {
             int join_rc = drain_thread_call_pthread_join(drain->worker, NULL);
             pthread_mutex_lock(&drain->lifecycle_lock);
             drain->thread_started = false;
+            int shard_rc = drain_join_shard_workers(drain);
             pthread_mutex_unlock(&drain->lifecycle_lock);
-            return join_rc;
+            return join_rc != 0 ? join_rc : shard_rc;
         }
         return 0;
     }
 
     if (state == DRAIN_STATE_RUNNING) {
         atomic_store_explicit(&drain->state, DRAIN_STATE_STOPPING, memory_order_release);
+        // Parked workers recheck the state once the sequence moves
+        drain_wake_signal(drain_wake_word(drain));
     }
 
     bool started = drain->thread_started;
@@ -1325,6 +2146,10 @@ int drain_thread_stop(DrainThread* drain) {
         }
         pthread_mutex_lock(&drain->lifecycle_lock);
         drain->thread_started = false;
+        int shard_rc = drain_join_shard_workers(drain);
+        if (shard_rc != 0 && rc == 0) {
+            rc = shard_rc;
+        }
         pthread_mutex_unlock(&drain->lifecycle_lock);
     }
 
@@ -1359,6 +2184,7 @@ void drain_thread_destroy(DrainThread* drain) {
         drain->symbol_table_json = NULL;
     }
 
+    drain_slot_arrays_free(drain);
     pthread_mutex_destroy(&drain->lifecycle_lock);
     free(drain);
 }
@@ -1374,6 +2200,21 @@ void drain_thread_get_metrics(const DrainThread* drain, DrainMetrics* out_metric
     drain_metrics_snapshot(drain, out_metrics);
 }
 
+bool drain_thread_get_slot_rings(const DrainThread* drain, uint32_t slot, uint64_t out_rings[2]) {
+    if (!drain || !out_rings || slot >= drain->slot_capacity) {
+        return false;
+    }
+    for (uint32_t lane = 0; lane < 2; ++lane) {
+        uint64_t total = 0;
+        for (uint32_t set = 0; set < 1 + DRAIN_MAX_WORKERS; ++set) {
+            total += atomic_load_explicit(&drain->slot_rings[(size_t)set * drain->slot_capacity + slot][lane],
+                                          memory_order_relaxed);
+        }
+        out_rings[lane] = total;
+    }
+    return true;
+}
+
 int drain_thread_update_config(DrainThread* drain, const DrainConfig* config) {
     if (!drain || !config) {
         return -EINVAL;
@@ -1410,6 +2251,47 @@ int drain_thread_start_session(DrainThread* drain, const char* session_dir) {
     return 0;
 }
 
+// Final merge at session stop: refreshes aggregates.json and writes the
+// "aggregates" manifest section from the same snapshot
+static void drain_write_aggregates(DrainThread* drain, FILE* manifest) {
+    AggregateTable* merged = drain_merge_aggregates(drain);
+    if (!merged) {
+        return;
+    }
+    if (merged->used > 0) {
+        drain_write_aggregates_file(drain->session_dir, merged);
+        fprintf(manifest, "  \"aggregates\": ");
+        drain_print_aggregates(manifest, merged);
+        fprintf(manifest, ",\n");
+    }
+    free(merged);
+}
+
+// List every thread_<id> stream written this session. Stream ids are dense:
+// slot indexes, then one per slot reuse (thread_lanes_get_stream_id), so the
+// streams of threads whose slots were reclaimed mid-session are found by id
+// without the drain keeping a list. Call after the writers are finalized.
+static void drain_write_manifest_threads(DrainThread* drain, FILE* manifest) {
+    uint64_t limit = drain->slot_capacity;
+    if (drain->registry) {
+        limit = (uint64_t)thread_registry_get_capacity(drain->registry) +
+                thread_registry_get_slots_reused(drain->registry);
+    }
+
+    bool first = true;
+    char index_path[4096 + 32];
+    for (uint64_t id = 0; id < limit && id <= UINT32_MAX; id++) {
+        snprintf(index_path, sizeof(index_path), "%s/thread_%llu/index.atf",
+                 drain->session_dir, (unsigned long long)id);
+        if (access(index_path, F_OK) != 0) {
+            continue;
+        }
+        fprintf(manifest, "%s    {\"id\": %llu, \"has_detail\": true}",
+                first ? "" : ",\n", (unsigned long long)id);
+        first = false;
+    }
+}
+
 int drain_thread_stop_session(DrainThread* drain) {
     if (!drain) {
         return -EINVAL;
@@ -1422,6 +2304,15 @@ int drain_thread_stop_session(DrainThread* drain) {
         return 0;
     }
 
+    // Finalize and close all thread writers
+    for (uint32_t i = 0; i < drain->slot_capacity; i++) {
+        if (drain->thread_writers[i]) {
+            atf_thread_writer_finalize(drain->thread_writers[i]);
+            atf_thread_writer_close(drain->thread_writers[i]);
+            drain->thread_writers[i] = NULL;
+        }
+    }
+
     // Generate manifest.json with thread list and time range
     char manifest_path[4096];
     snprintf(manifest_path, sizeof(manifest_path), "%s/manifest.json", drain->session_dir);
@@ -1431,21 +2322,25 @@ int drain_thread_stop_session(DrainThread* drain) {
         fprintf(manifest, "{\n");
         fprintf(manifest, "  \"threads\": [\n");
 
-        bool first = true;
-        for (uint32_t i = 0; i < MAX_THREADS; i++) {
-            if (drain->thread_writers[i]) {
-                if (!first) {
-                    fprintf(manifest, ",\n");
-                }
-                fprintf(manifest, "    {\"id\": %u, \"has_detail\": true}", i);
-                first = false;
-            }
-        }
-
+        drain_write_manifest_threads(drain, manifest);
         fprintf(manifest, "\n  ],\n");
         fprintf(manifest, "  \"time_start_ns\": 0,\n");
         fprintf(manifest, "  \"time_end_ns\": 0,\n");
-        fprintf(manifest, "  \"clock_type\": 1,\n");
+        fprintf(manifest, "  \"clock_type\": %u,\n", (unsigned)drain_clock_type(drain));
+        if (drain_clock_type(drain) == DRAIN_CLOCK_COUNTER) {
+            // ns = ns_base + (((ticks - tick_base) * mult) >> shift); the rate is
+            // re-measured over the whole session before it is recorded
+            TimestampCalibration cal;
+            (void)timestamp_source_refine(&drain->control_block->timestamp, &cal);
+            fprintf(manifest,
+                    "  \"clock_calibration\": {\"tick_base\": %llu, \"ns_base\": %llu, "
+                    "\"mult\": %llu, \"shift\": %u, \"ticks_per_sec\": %llu},\n",
+                    (unsigned long long)cal.tick_base, (unsigned long long)cal.ns_base,
+                    (unsigned long long)cal.mult, cal.shift,
+                    (unsigned long long)cal.ticks_per_sec);
+        }
+
+        drain_write_aggregates(drain, manifest);
 
         // Include symbol table if available (Phase 1: symbol resolution)
         if (drain->symbol_table_json && drain->symbol_table_json[0] != '\0') {
@@ -1459,15 +2354,6 @@ int drain_thread_stop_session(DrainThread* drain) {
         fclose(manifest);
     }
 
-    // Finalize and close all thread writers
-    for (uint32_t i = 0; i < MAX_THREADS; i++) {
-        if (drain->thread_writers[i]) {
-            atf_thread_writer_finalize(drain->thread_writers[i]);
-            atf_thread_writer_close(drain->thread_writers[i]);
-            drain->thread_writers[i] = NULL;
-        }
-    }
-
     drain->session_active = false;
     drain->session_dir[0] = '\0';
 
@@ -1512,7 +2398,7 @@ AtfThreadWriter* drain_thread_get_atf_writer(DrainThread* drain, uint32_t thread
 }
 
 void drain_thread_set_atf_writer(DrainThread* drain, uint32_t thread_id, AtfThreadWriter* writer) {
-    if (!drain || thread_id >= MAX_THREADS) {
+    if (!drain || thread_id >= drain->slot_capacity) {
         return;
     }
     drain->thread_writers[thread_id] = writer;
@@ -1528,7 +2414,7 @@ uint32_t drain_thread_test_drain_lane(DrainThread* drain,
                                       bool is_detail,
                                       bool final_pass,
                                       bool* out_hit_limit) {
-    return drain_lane(drain, slot_index, lane, is_detail, final_pass, out_hit_limit);
+    return drain_lane(drain, NULL, slot_index, lane, is_detail, final_pass, out_hit_limit);
 }
 
 bool drain_thread_test_cycle(DrainThread* drain, bool final_pass) {
@@ -1536,7 +2422,10 @@ bool drain_thread_test_cycle(DrainThread* drain, bool final_pass) {
 }
 
 void drain_thread_test_return_ring(Lane* lane, uint32_t ring_idx) {
-    return_ring_to_producer(lane, ring_idx);
+    LaneView view = {0};
+    if (lane_view_sync(NULL, lane, &view)) {
+        return_ring_to_producer(&view, ring_idx);
+    }
 }
 
 void drain_thread_test_update_control_block(DrainThread* drain) {
@@ -1585,6 +2474,25 @@ void drain_thread_test_set_registry(DrainThread* drain, ThreadRegistry* registry
     drain->registry = registry;
 }
 
+bool drain_thread_test_worker_cycle(DrainThread* drain, uint32_t worker_index, bool final_pass) {
+    if (!drain || worker_index >= drain->worker_count) {
+        return false;
+    }
+    return drain_worker_cycle(drain, &drain->workers[worker_index], final_pass);
+}
+
+// Queue a slot on a worker's deque as its owner's scan would
+bool drain_thread_test_enqueue_slot(DrainThread* drain, uint32_t worker_index, uint32_t slot) {
+    if (!drain || worker_index >= drain->worker_count || slot >= drain->slot_capacity) {
+        return false;
+    }
+    unsigned int expected = DRAIN_SLOT_IDLE;
+    if (!atomic_compare_exchange_strong(&drain->slot_state[slot], &expected, DRAIN_SLOT_QUEUED)) {
+        return false;
+    }
+    return drain_slot_deque_push(&drain->workers[worker_index].deque, slot);
+}
+
 void* drain_thread_test_worker_entry(void* arg) {
     return drain_worker_thread(arg);
 }
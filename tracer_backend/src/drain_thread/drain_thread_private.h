@@ -12,6 +12,8 @@
 #include <tracer_backend/utils/ring_buffer.h>
 #include <tracer_backend/metrics/global_metrics.h>
 
+#include "drain_slot_deque.h"
+
 typedef struct {
     atomic_uint_fast64_t cycles_total;
     atomic_uint_fast64_t cycles_idle;
@@ -23,7 +25,7 @@ typedef struct {
     atomic_uint_fast64_t yields;
     atomic_uint_fast64_t final_drains;
     atomic_uint_fast64_t total_sleep_us;
-    atomic_uint_fast64_t per_thread_rings[MAX_THREADS][2];
+    atomic_uint_fast64_t (*per_thread_rings)[2]; // [DrainThread.slot_capacity], in DrainThread.slot_rings
 
     // Per-thread drain iteration metrics (atomic)
     atomic_uint_fast64_t total_iterations;
@@ -38,6 +40,18 @@ typedef struct {
     atomic_uint_fast64_t bytes_per_second;
     atomic_uint_fast32_t cpu_usage_percent;
     // Note: fairness_index is not atomic as it requires calculation
+
+    // Event-driven wakeup (wake_on_submit)
+    atomic_uint_fast64_t wake_parks;
+    atomic_uint_fast64_t wake_signals;
+    atomic_uint_fast64_t idle_wait_ns;
+    atomic_uint_fast64_t wake_latency_samples;
+    atomic_uint_fast64_t wake_latency_total_ns;
+    atomic_uint_fast64_t wake_latency_max_ns;
+
+    // ATF write failures
+    atomic_uint_fast64_t write_errors;
+    atomic_uint_fast64_t events_lost;
 } DrainMetricsAtomic;
 
 // Per-thread drain state tracking
@@ -68,7 +82,8 @@ typedef enum DrainSchedulingAlgorithm {
     DRAIN_SCHED_ROUND_ROBIN = 0,
     DRAIN_SCHED_WEIGHTED_FAIR = 1,
     DRAIN_SCHED_PRIORITY_BASED = 2,
-    DRAIN_SCHED_ADAPTIVE = 3
+    DRAIN_SCHED_ADAPTIVE = 3,
+    DRAIN_SCHED_WORK_STEALING = 4      // Sharded workers with per-worker slot deques
 } DrainSchedulingAlgorithm;
 
 // Forward declaration
@@ -154,6 +169,42 @@ typedef struct DrainIterator {
     uint64_t last_fairness_calc_ns;    // Last fairness calculation time
 } DrainIterator;
 
+// Slot owner value when no worker holds the slot
+#define DRAIN_SLOT_UNOWNED UINT32_MAX
+
+// Work-stealing slot states: a slot is queued in at most one deque and
+// drained by at most one worker at a time
+#define DRAIN_SLOT_IDLE     0u
+#define DRAIN_SLOT_QUEUED   1u
+#define DRAIN_SLOT_DRAINING 2u
+
+// One drain worker. Each worker drains a disjoint shard of registry slots and
+// is the only thread that touches the ATF writers of slots it holds, so the
+// write path needs no locking. Ownership of a slot moves between workers
+// through DrainThread.slot_owner when the registry's slot bitmap changes.
+typedef struct DrainWorker {
+    struct DrainThread* drain;
+    uint32_t            index;
+    pthread_t           thread;              // Unused for worker 0 (runs on DrainThread.worker)
+    bool                started;
+
+    // Shard state (touched only by this worker)
+    uint64_t            observed_generation;  // Registry slot generation the shard was computed from
+    uint64_t            shard_words[THREAD_REGISTRY_SLOT_WORDS]; // Slots assigned to this worker
+    uint64_t            owned_words[THREAD_REGISTRY_SLOT_WORDS]; // Slots this worker holds in slot_owner
+    uint32_t            rr_cursor;            // Round-robin start within the shard
+
+    atomic_uint_fast32_t slots_owned;         // Slots currently held
+    atomic_uint_fast64_t rebalances;          // Shard recomputations after slot bitmap changes
+
+    // Work stealing: owned slots with submitted rings, stealable by others
+    DrainSlotDeque      deque;
+    atomic_uint_fast64_t steals;              // Slots this worker took from others
+
+    bool                wake_pending;         // Woken by a submit; next drained cycle records latency
+    DrainMetricsAtomic  metrics;              // Counters updated only by this worker
+} DrainWorker;
+
 struct DrainThread {
     atomic_int          state;
     ThreadRegistry*     registry;
@@ -161,11 +212,12 @@ struct DrainThread {
     ControlBlock*       control_block;
     uint64_t            last_registry_tick_ns;
     uint32_t            warmup_ticks;
+    uint64_t            last_aggregate_merge_ns; // Last periodic aggregates.json snapshot
 
     // ATF V2 session management
     char                session_dir[4096];
     bool                session_active;
-    AtfThreadWriter*    thread_writers[MAX_THREADS]; // Per-thread writers
+    AtfThreadWriter**   thread_writers;      // [slot_capacity] per-thread writers
 
     // Symbol table JSON for manifest (Phase 1 - symbol resolution)
     char*               symbol_table_json;  // Heap-allocated, freed on destroy
@@ -177,14 +229,27 @@ struct DrainThread {
     atomic_uint         rr_cursor;           // round-robin start index
     atomic_uint_fast64_t last_cycle_ns;      // last cycle timestamp snapshot
 
-    DrainMetricsAtomic  metrics;
+    DrainMetricsAtomic  metrics;             // Iterator mode and direct lane drains
+
+    // Sharded drain workers (worker 0 runs on `worker` above)
+    uint32_t            worker_count;
+    DrainWorker         workers[DRAIN_MAX_WORKERS];
+    DrainSchedulingAlgorithm worker_algorithm;    // ROUND_ROBIN or WORK_STEALING
+    atomic_uint*        slot_owner;               // [slot_capacity] worker index holding each slot
+    atomic_uint*        slot_state;               // [slot_capacity] DRAIN_SLOT_* (work stealing only)
+    atomic_uint         workers_running;          // Workers that have not finished their final pass
 
     // Per-thread drain iteration
     DrainIterator*      iterator;            // Drain iterator (allocated separately)
     bool                iterator_enabled;    // Whether per-thread drain is enabled
 
     ada_global_metrics_t thread_metrics;
-    ada_thread_metrics_snapshot_t thread_metrics_buffer[MAX_THREADS];
+    ada_thread_metrics_snapshot_t* thread_metrics_buffer; // [slot_capacity]
+
+    // Per-slot arrays are sized from the registry capacity at creation
+    uint32_t            slot_capacity;
+    atomic_uint_fast64_t (*slot_rings)[2];   // [(1 + DRAIN_MAX_WORKERS) * slot_capacity]
+    LaneView            (*lane_views)[2];    // [slot_capacity] lanes as resolved by the slot's drainer
 };
 
 #endif // DRAIN_THREAD_PRIVATE_H
@@ -89,6 +89,17 @@ pub mod ffi {
                 controller: *mut FridaController,
                 enabled: c_uint,
             ) -> c_int;
+            pub fn frida_controller_set_sampling(
+                controller: *mut FridaController,
+                enabled: c_uint,
+                max_calls_per_sec: c_uint,
+                max_sample_shift: c_uint,
+                window_ms: c_uint,
+            ) -> c_int;
+            pub fn frida_controller_set_aggregation(
+                controller: *mut FridaController,
+                mode: c_uint,
+            ) -> c_int;
             pub fn frida_controller_start_session(controller: *mut FridaController) -> c_int;
             pub fn frida_controller_stop_session(controller: *mut FridaController) -> c_int;
             pub fn frida_controller_get_stats(controller: *mut FridaController) -> TracerStats;
@@ -222,6 +233,42 @@ impl TracerController {
         Ok(())
     }
 
+    /// Configure adaptive per-function sampling; hooks pick it up at runtime
+    pub fn set_sampling(
+        &mut self,
+        enabled: bool,
+        max_calls_per_sec: u32,
+        max_sample_shift: u32,
+        window_ms: u32,
+    ) -> anyhow::Result<()> {
+        let result = unsafe {
+            ffi::frida_controller_set_sampling(
+                self.ptr,
+                enabled as u32,
+                max_calls_per_sec,
+                max_sample_shift,
+                window_ms,
+            )
+        };
+
+        if result != 0 {
+            anyhow::bail!("Failed to update sampling thresholds");
+        }
+
+        Ok(())
+    }
+
+    /// Set the aggregation lane mode: 0 off, 1 alongside events, 2 totals only
+    pub fn set_aggregation(&mut self, mode: u32) -> anyhow::Result<()> {
+        let result = unsafe { ffi::frida_controller_set_aggregation(self.ptr, mode) };
+
+        if result != 0 {
+            anyhow::bail!("Failed to update aggregation mode");
+        }
+
+        Ok(())
+    }
+
     /// Start ATF session output without resuming the process
     pub fn start_session(&mut self) -> anyhow::Result<()> {
         let result = unsafe { ffi::frida_controller_start_session(self.ptr) };
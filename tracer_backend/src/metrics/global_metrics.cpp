@@ -19,39 +19,26 @@ static uint32_t compute_queue_depth(std::atomic<uint32_t>& head,
     uint32_t h = head.load(std::memory_order_acquire);
     uint32_t t = tail.load(std::memory_order_acquire);
     if (capacity == 0u) return 0u;
-    if (t >= h) {
-        return t - h;
-    }
-    return capacity - (h - t);
+    return (t - h) & (capacity - 1u);  // Lane queue capacities are powers of two
 }
 
-static double compute_swaps_per_second(ada_global_metrics_t* global,
-                                       uint32_t slot,
-                                       uint64_t thread_id,
+// Swap bookkeeping lives in the thread's own rate window, so it covers every
+// registry slot and resets when the slot is reused
+static double compute_swaps_per_second(ada_thread_metrics_t* metrics,
                                        uint64_t swap_count,
                                        uint64_t now_ns) {
-    if (slot >= MAX_THREADS) return 0.0;
-
-    if (global->previous_thread_id[slot] != thread_id) {
-        global->previous_thread_id[slot] = thread_id;
-        global->previous_swap_count[slot] = swap_count;
-        global->previous_swap_timestamp[slot] = now_ns;
-        return 0.0;
-    }
-
-    uint64_t prev_count = global->previous_swap_count[slot];
-    uint64_t prev_ts = global->previous_swap_timestamp[slot];
+    uint64_t prev_count = metrics->rate.prev_swap_count;
+    uint64_t prev_ts = metrics->rate.prev_swap_timestamp_ns;
 
-    global->previous_swap_count[slot] = swap_count;
-    global->previous_swap_timestamp[slot] = now_ns;
+    metrics->rate.prev_swap_count = swap_count;
+    metrics->rate.prev_swap_timestamp_ns = now_ns;
 
-    if (now_ns <= prev_ts || swap_count <= prev_count) {
+    if (prev_ts == 0ull || now_ns <= prev_ts || swap_count <= prev_count) {
         return 0.0;
     }
 
     uint64_t delta_count = swap_count - prev_count;
     uint64_t delta_ns = now_ns - prev_ts;
-    if (delta_ns == 0ull) return 0.0;
     return static_cast<double>(delta_count) * 1000000000.0 / static_cast<double>(delta_ns);
 }
 
@@ -78,10 +65,6 @@ bool ada_global_metrics_init(ada_global_metrics_t* global,
                      ADA_MEMORY_ORDER_RELAXED);
     ADA_ATOMIC_STORE(global->control.last_collection_ns, 0, ADA_MEMORY_ORDER_RELAXED);
     ADA_ATOMIC_STORE(global->control.collection_enabled, true, ADA_MEMORY_ORDER_RELAXED);
-
-    std::memset(global->previous_swap_count, 0, sizeof(global->previous_swap_count));
-    std::memset(global->previous_swap_timestamp, 0, sizeof(global->previous_swap_timestamp));
-    std::memset(global->previous_thread_id, 0, sizeof(global->previous_thread_id));
     return true;
 }
 
@@ -142,7 +125,9 @@ bool ada_global_metrics_collect(ada_global_metrics_t* global,
 
     auto* cpp_registry = ada::internal::to_cpp(registry);
     uint32_t capacity = cpp_registry->get_capacity();
-    for (uint32_t i = 0; i < capacity; ++i) {
+    for (uint32_t i = cpp_registry->next_claimed_slot(0);
+         i < capacity;
+         i = cpp_registry->next_claimed_slot(i + 1)) {
         ThreadLaneSet* lanes = thread_registry_get_thread_at(registry, i);
         if (!lanes) continue;
 
@@ -178,9 +163,7 @@ bool ada_global_metrics_collect(ada_global_metrics_t* global,
                                                 rate.events_per_second,
                                                 rate.bytes_per_second);
 
-        double swaps_per_second = compute_swaps_per_second(global,
-                                                           snap->slot_index,
-                                                           snap->thread_id,
+        double swaps_per_second = compute_swaps_per_second(metrics,
                                                            snap->swap_count,
                                                            now_ns);
         ada_thread_metrics_snapshot_set_swap_rate(snap, swaps_per_second);
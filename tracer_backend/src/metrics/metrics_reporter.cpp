@@ -259,7 +259,13 @@ static bool initialize_state(ReporterState* state,
         state->json_path = config->json_output_path;
     }
 
-    size_t capacity = config->snapshot_capacity != 0 ? config->snapshot_capacity : MAX_THREADS;
+    size_t capacity = config->snapshot_capacity;
+    if (capacity == 0) {
+        capacity = thread_registry_get_capacity(config->registry);
+    }
+    if (capacity == 0) {
+        capacity = MAX_THREADS;
+    }
     state->snapshots.resize(capacity);
 
     // Initialize global metrics - guaranteed to succeed with valid capacity
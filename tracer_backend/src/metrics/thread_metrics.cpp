@@ -14,6 +14,8 @@ void clear_rate_history(ada_thread_metrics_t* metrics) {
     metrics->rate.window_bytes = 0;
     metrics->rate.events_per_second = 0.0;
     metrics->rate.bytes_per_second = 0.0;
+    metrics->rate.prev_swap_count = 0;
+    metrics->rate.prev_swap_timestamp_ns = 0;
     std::memset(metrics->rate.samples, 0, sizeof(metrics->rate.samples));
 }
 
@@ -54,7 +54,7 @@ bool is_ring_full(RingPool* pool) {
     if (!pool) return false;
     RingBufferHeader* header = ring_pool_get_active_header(pool);
     if (!header) return false;
-    return ring_buffer_available_write_raw(header) == 0;
+    return ring_buffer_record_ring_full_raw(header);
 }
 
 void set_error(DetailLaneControlImpl& impl, DetailLaneControlError error) {
@@ -1,7 +1,9 @@
 #include <tracer_backend/ada/thread.h>
 #include <tracer_backend/utils/ring_pool.h>
+#include <tracer_backend/utils/stack_capture.h>
 
 #include <pthread.h>
+#include <sched.h>
 #include <string.h>
 #include <time.h>
 
@@ -16,6 +18,69 @@ static __thread bool g_tls_bp_initialized = false;
 // Global registry pointer (set by controller/agent runtime)
 static _Atomic(ThreadRegistry*) g_global_registry = NULL;
 
+// Index batching configuration (set by the agent runtime)
+static _Atomic(uint32_t) g_index_batch = 0;
+static _Atomic(uint64_t) g_index_batch_max_age_ns = 0;
+
+// Staged batches by registry slot, so a sweeper can publish them for a thread
+// that has gone quiet. The owning thread holds its entry's lock while it
+// stages or publishes; owner is set only while events are staged and is
+// cleared under the lock, so a sweeper holding the lock may publish through
+// it. While batching is on, the owner writes its index pool (and that pool's
+// backpressure state) only under this lock, which is what lets a sweeper
+// drive them. Each entry has its own cache line: the owner's exchange stays
+// local and no other thread touches the line except a sweep. Sweepers only
+// try-lock and skip a busy owner; an owner waits only when a sweeper is
+// publishing its batch at that moment, at most once per sweep.
+typedef struct {
+    _Atomic(uint32_t) lock;
+    _Atomic(bool) flush_requested;       // Set by a sweeper that found the owner busy
+    _Atomic(ada_tls_state_t*) owner;
+    uint8_t _pad[CACHE_LINE_SIZE - 16];
+} ADA_ALIGNAS(CACHE_LINE_SIZE) ada_stage_entry_t;
+
+_Static_assert(sizeof(ada_stage_entry_t) == CACHE_LINE_SIZE,
+               "stage entries must not share cache lines");
+
+static ada_stage_entry_t g_stage_entries[THREAD_REGISTRY_MAX_CAPACITY];
+
+static ada_stage_entry_t* stage_lock_own(void) {
+    ada_stage_entry_t* entry = &g_stage_entries[g_tls_state.slot_id];
+    while (atomic_exchange_explicit(&entry->lock, 1, memory_order_acquire) != 0) {
+        sched_yield();  // A sweeper is publishing this batch
+    }
+    return entry;
+}
+
+static inline void stage_unlock(ada_stage_entry_t* entry) {
+    atomic_store_explicit(&entry->lock, 0, memory_order_release);
+}
+
+// Caller holds entry->lock
+static uint32_t stage_publish(ada_tls_state_t* st, ada_stage_entry_t* entry) {
+    atomic_store_explicit(&entry->owner, NULL, memory_order_relaxed);
+    atomic_store_explicit(&entry->flush_requested, false, memory_order_relaxed);
+
+    uint32_t count = st->stage_count;
+    if (count == 0) return 0;
+    st->stage_count = 0;
+
+    size_t written = ring_pool_write_batch(st->index_pool, sizeof(IndexEvent),
+                                           st->stage, count);
+    ada_thread_metrics_t* metrics = st->metrics;
+    ada_thread_metrics_record_events_written_bulk(metrics, written,
+                                                  written * sizeof(IndexEvent));
+
+    uint32_t dropped = count - (uint32_t)written;
+    if (dropped > 0) {
+        st->overflow_count += dropped;
+        for (uint32_t i = 0; i < dropped; ++i) {
+            ada_thread_metrics_record_event_dropped(metrics);
+        }
+    }
+    return dropped;
+}
+
 static uint64_t ada_now_monotonic_ns(void) {
 #ifdef __APPLE__
     // Fallback simple clock for C file; agent has mach for high-res
@@ -39,6 +104,14 @@ ada_tls_state_t* ada_get_tls_state(void) {
 }
 
 void ada_reset_tls_state(void) {
+    // Staged events are discarded; keep sweepers off the cleared state
+    if (g_tls_state.index_pool) {
+        ada_stage_entry_t* entry = stage_lock_own();
+        if (atomic_load_explicit(&entry->owner, memory_order_relaxed) == &g_tls_state) {
+            atomic_store_explicit(&entry->owner, NULL, memory_order_relaxed);
+        }
+        stage_unlock(entry);
+    }
     // Destroy ring pools before clearing state
     if (g_tls_state.index_pool) {
         ring_pool_destroy(g_tls_state.index_pool);
@@ -61,6 +134,90 @@ ThreadRegistry* ada_get_global_registry(void) {
     return atomic_load_explicit(&g_global_registry, memory_order_acquire);
 }
 
+void ada_tls_set_index_batching(uint32_t batch, uint64_t max_age_ns) {
+    if (batch > ADA_TLS_STAGE_CAPACITY) {
+        batch = ADA_TLS_STAGE_CAPACITY;
+    }
+    atomic_store_explicit(&g_index_batch_max_age_ns, max_age_ns, memory_order_relaxed);
+    atomic_store_explicit(&g_index_batch, batch > 1 ? batch : 0, memory_order_release);
+}
+
+uint32_t ada_tls_get_index_batch(void) {
+    return atomic_load_explicit(&g_index_batch, memory_order_acquire);
+}
+
+uint32_t ada_tls_flush_index_events(void) {
+    if (!g_tls_state.index_pool) return 0;
+
+    ada_stage_entry_t* entry = stage_lock_own();
+    uint32_t dropped = stage_publish(&g_tls_state, entry);
+    stage_unlock(entry);
+    return dropped;
+}
+
+bool ada_tls_stage_index_event(const IndexEvent* event, uint32_t flight_state) {
+    uint32_t batch = atomic_load_explicit(&g_index_batch, memory_order_relaxed);
+    if (batch == 0 || !event || !g_tls_state.index_pool) {
+        return false;
+    }
+
+    ada_stage_entry_t* entry = stage_lock_own();
+    uint32_t count = g_tls_state.stage_count;
+    if (count > 0) {
+        uint64_t max_age = atomic_load_explicit(&g_index_batch_max_age_ns, memory_order_relaxed);
+        bool aged = event->timestamp - g_tls_state.stage[0].timestamp > max_age;
+        if (aged || flight_state != g_tls_state.stage_flight_state) {
+            (void)stage_publish(&g_tls_state, entry);
+            count = 0;
+        }
+    }
+
+    if (count == 0) {
+        g_tls_state.stage_flight_state = flight_state;
+        atomic_store_explicit(&entry->owner, &g_tls_state, memory_order_relaxed);
+    }
+    g_tls_state.stage[count] = *event;
+    g_tls_state.stage_count = ++count;
+
+    if (count >= batch || atomic_load_explicit(&entry->flush_requested, memory_order_relaxed)) {
+        (void)stage_publish(&g_tls_state, entry);
+    }
+    stage_unlock(entry);
+    return true;
+}
+
+uint32_t ada_tls_sweep_staged_events(uint64_t now, bool force) {
+    ThreadRegistry* reg = ada_get_global_registry();
+    if (!reg) return 0;
+    uint64_t max_age = atomic_load_explicit(&g_index_batch_max_age_ns, memory_order_relaxed);
+    uint32_t published = 0;
+
+    // Only registered slots can hold a batch; walk the registry's bitmap
+    for (uint32_t slot = thread_registry_next_active_slot(reg, 0);
+         slot != UINT32_MAX && slot < THREAD_REGISTRY_MAX_CAPACITY;
+         slot = thread_registry_next_active_slot(reg, slot + 1)) {
+        ada_stage_entry_t* entry = &g_stage_entries[slot];
+        if (!atomic_load_explicit(&entry->owner, memory_order_relaxed)) continue;
+
+        if (atomic_exchange_explicit(&entry->lock, 1, memory_order_acquire) != 0) {
+            // Owner is mid-call and will check its own age; at stop, make
+            // it publish before it returns
+            if (force) {
+                atomic_store_explicit(&entry->flush_requested, true, memory_order_relaxed);
+            }
+            continue;
+        }
+        ada_tls_state_t* st = atomic_load_explicit(&entry->owner, memory_order_relaxed);
+        if (st && st->stage_count > 0 &&
+            (force || now - st->stage[0].timestamp > max_age)) {
+            (void)stage_publish(st, entry);
+            published++;
+        }
+        stage_unlock(entry);
+    }
+    return published;
+}
+
 static inline uint64_t ada_get_thread_id_portable(void) {
 #ifdef __APPLE__
     return (uint64_t)pthread_mach_thread_np(pthread_self());
@@ -98,7 +255,10 @@ ThreadLaneSet* ada_register_current_thread(void) {
     g_tls_state.metrics = thread_lanes_get_metrics(lanes);
     g_tls_state.thread_id = ada_get_thread_id_portable();
     g_tls_state.registration_time = ada_now_monotonic_ns();
-    // Slot id is optional; not exposed via API, leave as 0
+    g_tls_state.slot_id = (uint16_t)thread_lanes_get_slot_index(lanes);
+    // ATF thread id stamped into per-thread index records; unique per
+    // registration, so a reused slot never shares an id with its predecessor
+    g_tls_state.stream_id = thread_lanes_get_stream_id(lanes);
 
     // Create ring pools for swap-on-overflow support
     g_tls_state.index_pool = ring_pool_create(reg, lanes, 0);  // 0 = index lane
@@ -107,6 +267,9 @@ ThreadLaneSet* ada_register_current_thread(void) {
     // Synchronize thread_registry TLS too
     tls_my_lanes = lanes;
 
+    // Stack bounds for syscall-free detail snapshots
+    (void)stack_capture_init_thread();
+
     atomic_store_explicit(&g_tls_state.registered, true, memory_order_release);
     return lanes;
 }
@@ -121,6 +284,14 @@ ThreadLaneSet* ada_get_thread_lane(void) {
     return registered;
 }
 
+struct AggregateTable* ada_get_thread_aggregates(void) {
+    if (g_tls_state.aggregates) return g_tls_state.aggregates;
+    if (!ada_get_thread_lane()) return NULL;
+    g_tls_state.aggregates =
+        thread_registry_attach_aggregates(ada_get_global_registry(), g_tls_state.slot_id);
+    return g_tls_state.aggregates;
+}
+
 ada_reentrancy_guard_t ada_enter_trace(void) {
     ada_reentrancy_guard_t guard;
     guard.prev_depth = g_tls_state.call_depth;
@@ -141,12 +312,14 @@ void ada_exit_trace(ada_reentrancy_guard_t guard) {
 }
 
 void ada_tls_thread_cleanup(void) {
+    // Publish staged events while the lanes are still registered
+    (void)ada_tls_flush_index_events();
+
     ThreadLaneSet* lanes = g_tls_state.lanes;
     ThreadRegistry* reg = ada_get_global_registry();
     if (lanes && reg) {
-        // Unregister by id to update active set and counts
-        uintptr_t tid = (uintptr_t)pthread_self();
-        (void)thread_registry_unregister_by_id(reg, tid);
+        // The drain empties the lanes, then recycles the slot and its rings
+        (void)thread_registry_retire(reg, lanes);
     } else if (lanes) {
         // Best-effort fallback
         thread_registry_unregister(lanes);
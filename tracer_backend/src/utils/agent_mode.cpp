@@ -38,3 +38,9 @@ extern "C" void agent_mode_tick(AgentModeState* state, const ControlBlock* cb,
     }
 }
 
+extern "C" void agent_mode_cache_refresh(AgentModeCache* cache, uint32_t mode,
+                                         uint64_t now, uint64_t interval) {
+    if (!cache) return;
+    cache->mode = mode;
+    cache->next_check = now + interval;
+}
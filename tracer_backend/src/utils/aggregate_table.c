@@ -0,0 +1,43 @@
+#include <tracer_backend/utils/aggregate_table.h>
+
+#include <string.h>
+
+_Static_assert(sizeof(AggregateTable) == 64, "AggregateTable header must be one cache line");
+_Static_assert(sizeof(AggregateEntry) == 32, "AggregateEntry must be 32 bytes");
+
+size_t aggregate_table_bytes(uint32_t capacity) {
+    return sizeof(AggregateTable) + (size_t)capacity * sizeof(AggregateEntry);
+}
+
+AggregateTable* aggregate_table_init(void* memory, uint32_t capacity) {
+    if (!memory || capacity == 0 || (capacity & (capacity - 1)) != 0) {
+        return NULL;
+    }
+    memset(memory, 0, aggregate_table_bytes(capacity));
+    AggregateTable* table = (AggregateTable*)memory;
+    table->capacity = capacity;
+    table->max_used = capacity - capacity / 4;
+    return table;
+}
+
+bool aggregate_table_merge(AggregateTable* dst, const AggregateTable* src) {
+    if (!dst || !src) {
+        return true;
+    }
+    bool complete = true;
+    for (uint32_t i = 0; i < src->capacity; ++i) {
+        const AggregateEntry* e = &src->entries[i];
+        uint64_t function_id = __atomic_load_n(&e->function_id, __ATOMIC_ACQUIRE);
+        if (function_id == 0) {
+            continue;
+        }
+        if (!aggregate_table_add(dst, function_id,
+                                 __atomic_load_n(&e->calls, __ATOMIC_RELAXED),
+                                 __atomic_load_n(&e->inclusive_time, __ATOMIC_RELAXED),
+                                 __atomic_load_n(&e->exclusive_time, __ATOMIC_RELAXED))) {
+            complete = false;
+        }
+    }
+    dst->dropped_calls += __atomic_load_n(&src->dropped_calls, __ATOMIC_RELAXED);
+    return complete;
+}
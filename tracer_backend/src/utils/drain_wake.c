@@ -0,0 +1,102 @@
+#include <tracer_backend/utils/drain_wake.h>
+
+#include <errno.h>
+#include <limits.h>
+#include <time.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#elif defined(__APPLE__)
+// Stable since macOS 10.12; also what libc++ uses for std::atomic::wait
+extern int __ulock_wait(uint32_t operation, void* addr, uint64_t value, uint32_t timeout_us);
+extern int __ulock_wake(uint32_t operation, void* addr, uint64_t wake_value);
+#define UL_COMPARE_AND_WAIT_SHARED 3
+#define ULF_WAKE_ALL               0x00000100
+#endif
+
+// Cap for the sleep fallback so a missed signal costs at most one poll
+#define DRAIN_WAKE_FALLBACK_SLEEP_US 1000u
+
+static DrainWakeWord* g_producer_word = NULL;
+
+static inline uint64_t wake_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ull) + (uint64_t)ts.tv_nsec;
+}
+
+static void wake_os_wait(uint32_t* addr, uint32_t expected, uint64_t timeout_ns) {
+#if defined(__linux__)
+    struct timespec ts;
+    ts.tv_sec = (time_t)(timeout_ns / 1000000000ull);
+    ts.tv_nsec = (long)(timeout_ns % 1000000000ull);
+    (void)syscall(SYS_futex, addr, FUTEX_WAIT, expected, &ts, NULL, 0);
+#elif defined(__APPLE__)
+    uint64_t timeout_us = timeout_ns / 1000u;
+    if (timeout_us == 0) timeout_us = 1;
+    if (timeout_us > UINT32_MAX) timeout_us = UINT32_MAX;
+    (void)__ulock_wait(UL_COMPARE_AND_WAIT_SHARED, addr, expected, (uint32_t)timeout_us);
+#else
+    (void)addr;
+    (void)expected;
+    uint64_t timeout_us = timeout_ns / 1000u;
+    usleep((useconds_t)(timeout_us < DRAIN_WAKE_FALLBACK_SLEEP_US
+                            ? timeout_us : DRAIN_WAKE_FALLBACK_SLEEP_US));
+#endif
+}
+
+static void wake_os_wake_all(uint32_t* addr) {
+#if defined(__linux__)
+    (void)syscall(SYS_futex, addr, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+#elif defined(__APPLE__)
+    (void)__ulock_wake(UL_COMPARE_AND_WAIT_SHARED | ULF_WAKE_ALL, addr, 0);
+#else
+    (void)addr;
+#endif
+}
+
+void drain_wake_signal(DrainWakeWord* word) {
+    if (!word) return;
+
+    // Only stamp when someone will read it; keeps the common path to one RMW
+    if (__atomic_load_n(&word->waiters, __ATOMIC_RELAXED) != 0) {
+        __atomic_store_n(&word->signal_ns, wake_now_ns(), __ATOMIC_RELAXED);
+    }
+
+    // Pairs with drain_wake_prepare(): either the waiter sees the new
+    // sequence (and the submit before it), or this load sees the waiter
+    __atomic_fetch_add(&word->seq, 1u, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&word->waiters, __ATOMIC_SEQ_CST) != 0) {
+        wake_os_wake_all(&word->seq);
+    }
+}
+
+uint32_t drain_wake_prepare(DrainWakeWord* word) {
+    if (!word) return 0;
+    __atomic_fetch_add(&word->waiters, 1u, __ATOMIC_SEQ_CST);
+    return __atomic_load_n(&word->seq, __ATOMIC_SEQ_CST);
+}
+
+int drain_wake_wait(DrainWakeWord* word, uint32_t seq, uint64_t timeout_ns) {
+    if (!word) return -EINVAL;
+
+    if (__atomic_load_n(&word->seq, __ATOMIC_ACQUIRE) == seq) {
+        wake_os_wait(&word->seq, seq, timeout_ns);
+    }
+    return __atomic_load_n(&word->seq, __ATOMIC_ACQUIRE) != seq ? 0 : -ETIMEDOUT;
+}
+
+void drain_wake_finish(DrainWakeWord* word) {
+    if (!word) return;
+    __atomic_fetch_sub(&word->waiters, 1u, __ATOMIC_RELEASE);
+}
+
+void drain_wake_bind_producer(DrainWakeWord* word) {
+    __atomic_store_n(&g_producer_word, word, __ATOMIC_RELEASE);
+}
+
+DrainWakeWord* drain_wake_producer_word(void) {
+    return __atomic_load_n(&g_producer_word, __ATOMIC_ACQUIRE);
+}
@@ -0,0 +1,77 @@
+#include <tracer_backend/utils/hook_sampler.h>
+#include <tracer_backend/utils/timestamp_source.h>
+
+void hook_sampler_control_defaults(SamplingControl* control) {
+    control->enabled = 0;
+    control->max_calls_per_sec = SAMPLING_DEFAULT_MAX_CALLS_PER_SEC;
+    control->max_sample_shift = SAMPLING_DEFAULT_MAX_SHIFT;
+    control->window_ms = SAMPLING_DEFAULT_WINDOW_MS;
+}
+
+void hook_sampler_config_from_control(const SamplingControl* control,
+                                      const TimestampCalibration* cal,
+                                      HookSamplerConfig* out) {
+    uint32_t window_ms = control->window_ms ? control->window_ms : SAMPLING_DEFAULT_WINDOW_MS;
+    uint64_t limit = (uint64_t)control->max_calls_per_sec * window_ms / 1000u;
+    out->enabled = control->enabled && control->max_calls_per_sec != 0;
+    out->max_shift = control->max_sample_shift < SAMPLING_MAX_SHIFT_LIMIT
+                         ? control->max_sample_shift
+                         : SAMPLING_MAX_SHIFT_LIMIT;
+    out->window_limit = limit == 0 ? 1u : (limit > UINT32_MAX ? UINT32_MAX : (uint32_t)limit);
+    out->_pad = 0;
+    out->window_ticks = timestamp_source_duration_from_ns(cal, (uint64_t)window_ms * 1000000ull);
+    if (out->window_ticks == 0) {
+        out->window_ticks = 1;
+    }
+}
+
+uint64_t hook_sampler_roll(HookSampler* sampler, const HookSamplerConfig* config,
+                           uint64_t now, uint64_t start) {
+    if (!__atomic_compare_exchange_n(&sampler->window_start, &start, now,
+                                     0, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+        return 0;
+    }
+    uint64_t calls = __atomic_exchange_n(&sampler->window_calls, 0, __ATOMIC_RELAXED);
+    if (start == 0) {
+        return 0;  // First call ever: just open a window
+    }
+
+    // Normalise to one window so an idle gap does not read as a burst
+    uint64_t elapsed = now - start;
+    uint64_t per_window = (uint64_t)(((__uint128_t)calls * config->window_ticks) / elapsed);
+
+    uint32_t needed = 0;
+    while (needed < config->max_shift && (per_window >> needed) > config->window_limit) {
+        needed++;
+    }
+    uint32_t current = __atomic_load_n(&sampler->shift, __ATOMIC_RELAXED);
+    uint32_t next = needed >= current ? needed : current - 1;
+    if (next > config->max_shift) {
+        next = config->max_shift;
+    }
+    __atomic_store_n(&sampler->shift, next, __ATOMIC_RELAXED);
+
+    return __atomic_exchange_n(&sampler->suppressed, 0, __ATOMIC_RELAXED);
+}
+
+uint64_t hook_sampler_flush(HookSampler* sampler, const HookSamplerConfig* config,
+                            uint64_t now, bool force) {
+    if (force) {
+        return __atomic_exchange_n(&sampler->suppressed, 0, __ATOMIC_RELAXED);
+    }
+    uint64_t start = __atomic_load_n(&sampler->window_start, __ATOMIC_RELAXED);
+    if (start == 0 || now <= start || now - start < config->window_ticks) {
+        return 0;
+    }
+    return hook_sampler_roll(sampler, config, now, start);
+}
+
+void hook_sampler_tally_reset(HookSamplerTally* tally, HookSampler* sampler, uint64_t start) {
+    if (tally->sampler && tally->unflushed != 0) {
+        __atomic_fetch_add(&tally->sampler->window_calls, tally->unflushed, __ATOMIC_RELAXED);
+    }
+    tally->sampler = sampler;
+    tally->window_start = start;
+    tally->calls = 0;
+    tally->unflushed = 0;
+}
@@ -2,6 +2,16 @@
 #include "ring_buffer_private.h"
 #include <cstdlib>
 
+namespace ada {
+namespace internal {
+
+void rb_copy_events(void* dst, const void* src, size_t bytes) {
+    std::memcpy(dst, src, bytes);
+}
+
+} // namespace internal
+} // namespace ada
+
 // ============================================================================
 // C API Implementation (extern "C")
 // ============================================================================
@@ -139,50 +149,28 @@ static inline uint32_t rb_mask_from_header(const RingBufferHeader* hdr) {
     return hdr->capacity ? (hdr->capacity - 1u) : 0u;
 }
 
-static inline uint8_t* rb_buffer_from_header(RingBufferHeader* hdr) {
-    return reinterpret_cast<uint8_t*>(hdr) + sizeof(RingBufferHeader);
-}
+// The raw functions below are thin wrappers over the event-size specialised
+// FixedRing operations (see ring_buffer_private.h)
 
 bool ring_buffer_write_raw(RingBufferHeader* header, size_t event_size, const void* event) {
     if (!header || !event || header->capacity == 0) return false;
-    uint32_t mask = rb_mask_from_header(header);
-    uint32_t write_pos = __atomic_load_n(&header->write_pos, __ATOMIC_ACQUIRE);
-    uint32_t next_pos = (write_pos + 1) & mask;
-    uint32_t read_pos = __atomic_load_n(&header->read_pos, __ATOMIC_ACQUIRE);
-    if (next_pos == read_pos) {
-        __atomic_fetch_add(&header->overflow_count, (uint64_t)1, __ATOMIC_RELAXED);
-        return false;
-    }
-    uint8_t* buf = rb_buffer_from_header(header);
-    void* dest = buf + (write_pos * event_size);
-    std::memcpy(dest, event, event_size);
-    __atomic_store_n(&header->write_pos, next_pos, __ATOMIC_RELEASE);
-    return true;
+    return ada::internal::rb_write(header, event_size, event);
+}
+
+size_t ring_buffer_write_batch_raw(RingBufferHeader* header, size_t event_size,
+                                   const void* events, size_t count) {
+    if (!header || !events || header->capacity == 0 || count == 0) return 0;
+    return ada::internal::rb_write_batch(header, event_size, events, count);
 }
 
 bool ring_buffer_read_raw(RingBufferHeader* header, size_t event_size, void* event) {
     if (!header || !event || header->capacity == 0) return false;
-    uint32_t mask = rb_mask_from_header(header);
-    uint32_t read_pos = __atomic_load_n(&header->read_pos, __ATOMIC_ACQUIRE);
-    uint32_t write_pos = __atomic_load_n(&header->write_pos, __ATOMIC_ACQUIRE);
-    if (read_pos == write_pos) return false;
-    uint8_t* buf = rb_buffer_from_header(header);
-    void* src = buf + (read_pos * event_size);
-    std::memcpy(event, src, event_size);
-    uint32_t next_pos = (read_pos + 1) & mask;
-    __atomic_store_n(&header->read_pos, next_pos, __ATOMIC_RELEASE);
-    return true;
+    return ada::internal::rb_read(header, event_size, event);
 }
 
 size_t ring_buffer_read_batch_raw(RingBufferHeader* header, size_t event_size, void* events, size_t max_count) {
-    if (!header || !events || max_count == 0) return 0;
-    size_t n = 0;
-    uint8_t* dest = static_cast<uint8_t*>(events);
-    while (n < max_count) {
-        if (!ring_buffer_read_raw(header, event_size, dest + n * event_size)) break;
-        n++;
-    }
-    return n;
+    if (!header || !events || header->capacity == 0 || max_count == 0) return 0;
+    return ada::internal::rb_read_batch(header, event_size, events, max_count);
 }
 
 size_t ring_buffer_available_read_raw(RingBufferHeader* header) {
@@ -203,4 +191,124 @@ size_t ring_buffer_available_write_raw(RingBufferHeader* header) {
     return (read_pos - write_pos - 1u) & rb_mask_from_header(header);
 }
 
+size_t ring_buffer_peek_spans_raw(RingBufferHeader* header, size_t event_size,
+                                  RingBufferSpan spans[2], size_t max_count) {
+    if (!spans) return 0;
+    if (!header || header->capacity == 0 || max_count == 0) {
+        spans[0].data = nullptr;
+        spans[0].count = 0;
+        spans[1].data = nullptr;
+        spans[1].count = 0;
+        return 0;
+    }
+    return ada::internal::rb_peek_spans(header, event_size, spans, max_count);
+}
+
+void ring_buffer_consume_raw(RingBufferHeader* header, size_t count) {
+    if (!header || header->capacity == 0 || count == 0) return;
+    uint32_t mask = rb_mask_from_header(header);
+    uint32_t read_pos = __atomic_load_n(&header->read_pos, __ATOMIC_RELAXED);
+    uint32_t next_pos = (read_pos + static_cast<uint32_t>(count)) & mask;
+    __atomic_store_n(&header->read_pos, next_pos, __ATOMIC_RELEASE);
+}
+
+
+// ----------------------------------------------------------------------------
+// Variable-length records
+// ----------------------------------------------------------------------------
+
+static inline uint32_t rb_record_units(size_t length) {
+    return static_cast<uint32_t>((length + DETAIL_RECORD_ALIGN - 1) / DETAIL_RECORD_ALIGN);
+}
+
+bool ring_buffer_write_record_raw(RingBufferHeader* header, const void* record, size_t length) {
+    if (!header || !record || header->capacity == 0) return false;
+    if (length < sizeof(DetailRecordHeader)) return false;
+
+    uint32_t mask = rb_mask_from_header(header);
+    uint32_t units = rb_record_units(length);
+    uint32_t write_pos = __atomic_load_n(&header->write_pos, __ATOMIC_RELAXED);
+    uint32_t to_end = header->capacity - write_pos;
+    // A record that would straddle the end costs the tail as well
+    uint32_t needed = units <= to_end ? units : to_end + units;
+    if (ada::internal::rb_producer_free(header, write_pos, mask, needed) < needed) {
+        __atomic_fetch_add(&header->overflow_count, (uint64_t)1, __ATOMIC_RELAXED);
+        return false;
+    }
+
+    uint8_t* buf = reinterpret_cast<uint8_t*>(header) + sizeof(RingBufferHeader);
+    uint32_t pos = write_pos;
+    if (units > to_end) {
+        // Skip marker: total_length and event_type fit in one unit
+        DetailRecordHeader skip = {};
+        skip.total_length = to_end * DETAIL_RECORD_ALIGN;
+        skip.event_type = DETAIL_RECORD_SKIP;
+        std::memcpy(buf + (static_cast<size_t>(pos) * DETAIL_RECORD_ALIGN), &skip, DETAIL_RECORD_ALIGN);
+        pos = 0;
+    }
+    std::memcpy(buf + (static_cast<size_t>(pos) * DETAIL_RECORD_ALIGN), record, length);
+    // Marker and record become visible together
+    __atomic_store_n(&header->write_pos, (pos + units) & mask, __ATOMIC_RELEASE);
+    return true;
+}
+
+size_t ring_buffer_peek_record_raw(RingBufferHeader* header, const void** record) {
+    if (!record) return 0;
+    *record = nullptr;
+    if (!header || header->capacity == 0) return 0;
+
+    uint32_t mask = rb_mask_from_header(header);
+    uint8_t* buf = reinterpret_cast<uint8_t*>(header) + sizeof(RingBufferHeader);
+    for (;;) {
+        uint32_t read_pos = __atomic_load_n(&header->read_pos, __ATOMIC_ACQUIRE);
+        size_t available = ada::internal::rb_consumer_available(header, read_pos, mask, 1);
+        if (available == 0) return 0;
+
+        const uint8_t* rec = buf + (static_cast<size_t>(read_pos) * DETAIL_RECORD_ALIGN);
+        DetailRecordHeader head;
+        std::memcpy(&head, rec, DETAIL_RECORD_ALIGN);  // total_length + event_type
+        uint32_t units = rb_record_units(head.total_length);
+        if (units == 0 || units > available) { // LCOV_EXCL_START - producer never publishes these
+            // Corrupt stream: discard what is readable rather than spin on it
+            __atomic_store_n(&header->read_pos, (read_pos + static_cast<uint32_t>(available)) & mask,
+                             __ATOMIC_RELEASE);
+            return 0;
+        } // LCOV_EXCL_STOP
+        if (head.event_type == DETAIL_RECORD_SKIP) {
+            __atomic_store_n(&header->read_pos, (read_pos + units) & mask, __ATOMIC_RELEASE);
+            continue;
+        }
+        *record = rec;
+        return head.total_length;
+    }
+}
+
+void ring_buffer_consume_record_raw(RingBufferHeader* header, size_t length) {
+    if (!header || header->capacity == 0 || length == 0) return;
+    uint32_t mask = rb_mask_from_header(header);
+    uint32_t read_pos = __atomic_load_n(&header->read_pos, __ATOMIC_RELAXED);
+    __atomic_store_n(&header->read_pos, (read_pos + rb_record_units(length)) & mask,
+                     __ATOMIC_RELEASE);
+}
+
+bool ring_buffer_drop_oldest_record_raw(RingBufferHeader* header) {
+    const void* record = nullptr;
+    size_t length = ring_buffer_peek_record_raw(header, &record);
+    if (length == 0) return false;
+    ring_buffer_consume_record_raw(header, length);
+    // read_pos moved without the consumer; keep its cache from lagging behind it
+    ada::internal::rb_resync_caches(header);
+    return true;
+}
+
+bool ring_buffer_record_ring_full_raw(RingBufferHeader* header) {
+    if (!header || header->capacity == 0) return false;
+    // Worst case also pays for a skip marker over the tail
+    size_t needed = DETAIL_RECORD_MAX_UNITS;
+    uint32_t write_pos = __atomic_load_n(&header->write_pos, __ATOMIC_ACQUIRE);
+    uint32_t to_end = header->capacity - write_pos;
+    if (to_end < needed) needed += to_end;
+    return ring_buffer_available_write_raw(header) < needed;
+}
+
 }
@@ -10,14 +10,241 @@
 // Do NOT include <atomic> as it conflicts with stdatomic.h
 extern "C" {
 #include <tracer_backend/utils/tracer_types.h>
+#include <tracer_backend/utils/ring_buffer.h>
 }
 
 #define RING_BUFFER_MAGIC 0xADA0
-#define RING_BUFFER_VERSION 1
+// v2: producer/consumer cache each other's position in their own cache line
+#define RING_BUFFER_VERSION 2
 
 namespace ada {
 namespace internal {
 
+// ============================================================================
+// Position caching (Lamport/FastForward style)
+// ============================================================================
+// Each side keeps the last value it saw of the other side's position in its
+// own cache line and only touches the other side's line when the cached value
+// cannot satisfy the request. Positions only move forward, so a stale cache
+// under-reports space/events and is always safe.
+
+// Producer: free slots after write_pos, refreshing read_pos if fewer than needed
+inline size_t rb_producer_free(RingBufferHeader* header, uint32_t write_pos,
+                               uint32_t mask, size_t needed) {
+    uint32_t read_pos = __atomic_load_n(&header->cached_read_pos, __ATOMIC_RELAXED);
+    size_t free_slots = (read_pos - write_pos - 1u) & mask;
+    if (free_slots < needed) {
+        read_pos = __atomic_load_n(&header->read_pos, __ATOMIC_ACQUIRE);
+        __atomic_store_n(&header->cached_read_pos, read_pos, __ATOMIC_RELAXED);
+        free_slots = (read_pos - write_pos - 1u) & mask;
+    }
+    return free_slots;
+}
+
+// Consumer: readable events at read_pos, refreshing write_pos if fewer than needed
+inline size_t rb_consumer_available(RingBufferHeader* header, uint32_t read_pos,
+                                    uint32_t mask, size_t needed) {
+    uint32_t write_pos = __atomic_load_n(&header->cached_write_pos, __ATOMIC_RELAXED);
+    size_t available = (write_pos - read_pos) & mask;
+    if (available < needed) {
+        write_pos = __atomic_load_n(&header->write_pos, __ATOMIC_ACQUIRE);
+        __atomic_store_n(&header->cached_write_pos, write_pos, __ATOMIC_RELAXED);
+        available = (write_pos - read_pos) & mask;
+    }
+    return available;
+}
+
+// Re-seed both caches after a position moved outside the normal protocol
+// (reset, or the producer dropping from a ring it took back from the drain)
+inline void rb_resync_caches(RingBufferHeader* header) {
+    __atomic_store_n(&header->cached_read_pos,
+                     __atomic_load_n(&header->read_pos, __ATOMIC_ACQUIRE), __ATOMIC_RELAXED);
+    __atomic_store_n(&header->cached_write_pos,
+                     __atomic_load_n(&header->write_pos, __ATOMIC_ACQUIRE), __ATOMIC_RELAXED);
+}
+
+// ============================================================================
+// Event-size specialised ring operations
+// ============================================================================
+// Header-only SPSC operations with the event size as a template parameter.
+// With EventSize fixed, slot offsets compile to shifts and the per-event copy
+// is a fixed-size memcpy the compiler inlines. FixedRing<0> takes the size at
+// runtime and backs rings of any other event type. Capacity remains a per-ring
+// property chosen at creation, so the mask still comes from the header.
+
+// Out-of-line copy (ring_buffer.cpp) for events too large to inline well:
+// x86 compilers lower a big constant-size memcpy to rep movs, which loses to
+// the libc routine. Kept in another TU so the size stays opaque.
+void rb_copy_events(void* dst, const void* src, size_t bytes);
+
+// Largest event copied inline as a constant-size memcpy
+constexpr size_t kRingInlineCopyMax = 128;
+
+template <size_t EventSize>
+struct FixedRing {
+    static constexpr size_t kEventSize = EventSize;
+
+    static inline size_t event_size(size_t runtime_size) {
+        return EventSize ? EventSize : runtime_size;
+    }
+
+    static inline void copy_event(void* dst, const void* src, size_t runtime_size) {
+        if (EventSize != 0 && EventSize <= kRingInlineCopyMax) {
+            std::memcpy(dst, src, EventSize);
+        } else {
+            rb_copy_events(dst, src, event_size(runtime_size));
+        }
+    }
+
+    static inline uint8_t* slot(RingBufferHeader* header, uint32_t pos, size_t runtime_size) {
+        return reinterpret_cast<uint8_t*>(header) + sizeof(RingBufferHeader) +
+               (static_cast<size_t>(pos) * event_size(runtime_size));
+    }
+
+    static bool write(RingBufferHeader* header, size_t runtime_size, const void* event) {
+        uint32_t mask = header->capacity - 1u;
+        uint32_t write_pos = __atomic_load_n(&header->write_pos, __ATOMIC_RELAXED);
+        if (rb_producer_free(header, write_pos, mask, 1) == 0) {
+            __atomic_fetch_add(&header->overflow_count, (uint64_t)1, __ATOMIC_RELAXED);
+            return false;
+        }
+        copy_event(slot(header, write_pos, runtime_size), event, runtime_size);
+        __atomic_store_n(&header->write_pos, (write_pos + 1) & mask, __ATOMIC_RELEASE);
+        return true;
+    }
+
+    // Copies as many of count events as fit (at most two copies, two only when
+    // the batch wraps) and publishes them with one release store
+    static size_t write_batch(RingBufferHeader* header, size_t runtime_size,
+                              const void* events, size_t count) {
+        uint32_t mask = header->capacity - 1u;
+        uint32_t write_pos = __atomic_load_n(&header->write_pos, __ATOMIC_RELAXED);
+        size_t free_slots = rb_producer_free(header, write_pos, mask, count);
+        size_t n = count < free_slots ? count : free_slots;
+        if (n < count) {
+            __atomic_fetch_add(&header->overflow_count, (uint64_t)1, __ATOMIC_RELAXED);
+        }
+        if (n == 0) return 0;
+
+        size_t size = event_size(runtime_size);
+        const uint8_t* src = static_cast<const uint8_t*>(events);
+        size_t to_end = static_cast<size_t>(header->capacity) - write_pos;
+        size_t first = n < to_end ? n : to_end;
+        std::memcpy(slot(header, write_pos, runtime_size), src, first * size);
+        if (n > first) {
+            std::memcpy(slot(header, 0, runtime_size), src + (first * size), (n - first) * size);
+        }
+        __atomic_store_n(&header->write_pos, (write_pos + static_cast<uint32_t>(n)) & mask,
+                         __ATOMIC_RELEASE);
+        return n;
+    }
+
+    static bool read(RingBufferHeader* header, size_t runtime_size, void* event) {
+        uint32_t mask = header->capacity - 1u;
+        uint32_t read_pos = __atomic_load_n(&header->read_pos, __ATOMIC_ACQUIRE);
+        if (rb_consumer_available(header, read_pos, mask, 1) == 0) return false;
+        copy_event(event, slot(header, read_pos, runtime_size), runtime_size);
+        __atomic_store_n(&header->read_pos, (read_pos + 1) & mask, __ATOMIC_RELEASE);
+        return true;
+    }
+
+    // Bulk counterpart of read(): at most two copies and one release store
+    static size_t read_batch(RingBufferHeader* header, size_t runtime_size,
+                             void* events, size_t max_count) {
+        RingBufferSpan spans[2];
+        size_t n = peek_spans(header, runtime_size, spans, max_count);
+        if (n == 0) return 0;
+
+        size_t size = event_size(runtime_size);
+        uint8_t* dest = static_cast<uint8_t*>(events);
+        std::memcpy(dest, spans[0].data, spans[0].count * size);
+        if (spans[1].count) {
+            std::memcpy(dest + (spans[0].count * size), spans[1].data, spans[1].count * size);
+        }
+        uint32_t read_pos = __atomic_load_n(&header->read_pos, __ATOMIC_RELAXED);
+        __atomic_store_n(&header->read_pos,
+                         (read_pos + static_cast<uint32_t>(n)) & (header->capacity - 1u),
+                         __ATOMIC_RELEASE);
+        return n;
+    }
+
+    static size_t peek_spans(RingBufferHeader* header, size_t runtime_size,
+                             RingBufferSpan spans[2], size_t max_count) {
+        spans[0].data = nullptr;
+        spans[0].count = 0;
+        spans[1].data = nullptr;
+        spans[1].count = 0;
+
+        uint32_t mask = header->capacity - 1u;
+        uint32_t read_pos = __atomic_load_n(&header->read_pos, __ATOMIC_ACQUIRE);
+        size_t available = rb_consumer_available(header, read_pos, mask, max_count);
+        if (available > max_count) available = max_count;
+        if (available == 0) return 0;
+
+        size_t to_end = static_cast<size_t>(header->capacity) - read_pos;
+        size_t first = available < to_end ? available : to_end;
+        spans[0].data = slot(header, read_pos, runtime_size);
+        spans[0].count = first;
+        if (available > first) {
+            spans[1].data = slot(header, 0, runtime_size);
+            spans[1].count = available - first;
+        }
+        return available;
+    }
+
+    // Typed shorthands for the fixed-size specialisations
+    template <size_t S = EventSize>
+    static bool write(RingBufferHeader* header, const void* event) {
+        static_assert(S != 0, "runtime-sized rings must pass the event size");
+        return write(header, S, event);
+    }
+
+    template <size_t S = EventSize>
+    static bool read(RingBufferHeader* header, void* event) {
+        static_assert(S != 0, "runtime-sized rings must pass the event size");
+        return read(header, S, event);
+    }
+};
+
+using IndexRing = FixedRing<sizeof(IndexEvent)>;
+using DetailRing = FixedRing<sizeof(DetailEvent)>;
+using DynamicRing = FixedRing<0>;
+
+// Route a runtime event size to its specialisation. The handle API and the
+// C ABI go through these, so C callers (the drain) get the fixed-size copies
+// for index and detail rings at the cost of one predictable branch.
+#define RB_DISPATCH(event_size, call, ...)                                        \
+    switch (event_size) {                                                       \
+        case sizeof(IndexEvent):  return IndexRing::call(__VA_ARGS__);          \
+        case sizeof(DetailEvent): return DetailRing::call(__VA_ARGS__);         \
+        default:                  return DynamicRing::call(__VA_ARGS__);        \
+    }
+
+inline bool rb_write(RingBufferHeader* header, size_t event_size, const void* event) {
+    RB_DISPATCH(event_size, write, header, event_size, event)
+}
+
+inline size_t rb_write_batch(RingBufferHeader* header, size_t event_size,
+                             const void* events, size_t count) {
+    RB_DISPATCH(event_size, write_batch, header, event_size, events, count)
+}
+
+inline bool rb_read(RingBufferHeader* header, size_t event_size, void* event) {
+    RB_DISPATCH(event_size, read, header, event_size, event)
+}
+
+inline size_t rb_read_batch(RingBufferHeader* header, size_t event_size,
+                            void* events, size_t max_count) {
+    RB_DISPATCH(event_size, read_batch, header, event_size, events, max_count)
+}
+
+inline size_t rb_peek_spans(RingBufferHeader* header, size_t event_size,
+                            RingBufferSpan spans[2], size_t max_count) {
+    RB_DISPATCH(event_size, peek_spans, header, event_size, spans, max_count)
+}
+
+#undef RB_DISPATCH
+
 // ============================================================================
 // RingBuffer Implementation Class
 // ============================================================================
@@ -63,6 +290,8 @@ public:
         // Use C11 atomic operations on _Atomic members
         __atomic_store_n(&header_->write_pos, 0, __ATOMIC_RELAXED);
         __atomic_store_n(&header_->read_pos, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&header_->cached_read_pos, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&header_->cached_write_pos, 0, __ATOMIC_RELAXED);
         __atomic_store_n(&header_->overflow_count, (uint64_t)0, __ATOMIC_RELAXED);
         
         return true;
@@ -91,6 +320,10 @@ public:
         if (header_->magic != RING_BUFFER_MAGIC) {
             return false;
         }
+        // Older layouts lack the position caches
+        if (header_->version != RING_BUFFER_VERSION) {
+            return false;
+        }
         // Compute mask from capacity (assume power-of-two)
         if (header_->capacity == 0) return false;
         mask_ = header_->capacity - 1u;
@@ -101,26 +334,7 @@ public:
     // Producer operations
     bool write(const void* event) {
         if (!event) return false;
-        
-        uint32_t write_pos = __atomic_load_n(&header_->write_pos, __ATOMIC_ACQUIRE);
-        uint32_t next_pos = (write_pos + 1) & mask_;
-        uint32_t read_pos = __atomic_load_n(&header_->read_pos, __ATOMIC_ACQUIRE);
-        
-        // Check if full
-        if (next_pos == read_pos) {
-            // Buffer full: increment overflow counter and reject write
-            __atomic_fetch_add(&header_->overflow_count, (uint64_t)1, __ATOMIC_RELAXED);
-            return false;
-        }
-        
-        // Copy event
-        void* dest = buffer_ + (write_pos * event_size_);
-        std::memcpy(dest, event, event_size_);
-        
-        // Update write position
-        __atomic_store_n(&header_->write_pos, next_pos, __ATOMIC_RELEASE);
-        
-        return true;
+        return rb_write(header_, event_size_, event);
     }
     
     size_t available_write() {
@@ -132,40 +346,12 @@ public:
     // Consumer operations
     bool read(void* event) {
         if (!event) return false;
-        
-        uint32_t read_pos = __atomic_load_n(&header_->read_pos, __ATOMIC_ACQUIRE);
-        uint32_t write_pos = __atomic_load_n(&header_->write_pos, __ATOMIC_ACQUIRE);
-        
-        // Check if empty
-        if (read_pos == write_pos) {
-            return false; // Buffer empty
-        }
-        
-        // Copy event
-        void* src = buffer_ + (read_pos * event_size_);
-        std::memcpy(event, src, event_size_);
-        
-        // Update read position
-        uint32_t next_pos = (read_pos + 1) & mask_;
-        __atomic_store_n(&header_->read_pos, next_pos, __ATOMIC_RELEASE);
-        
-        return true;
+        return rb_read(header_, event_size_, event);
     }
     
     size_t read_batch(void* events, size_t max_count) {
         if (!events || max_count == 0) return 0;
-        
-        size_t count = 0;
-        uint8_t* dest = static_cast<uint8_t*>(events);
-        
-        while (count < max_count) {
-            if (!read(dest + (count * event_size_))) {
-                break;
-            }
-            count++;
-        }
-        
-        return count;
+        return rb_read_batch(header_, event_size_, events, max_count);
     }
     
     size_t available_read() {
@@ -193,6 +379,7 @@ public:
     void reset() {
         __atomic_store_n(&header_->write_pos, 0, __ATOMIC_RELEASE);
         __atomic_store_n(&header_->read_pos, 0, __ATOMIC_RELEASE);
+        rb_resync_caches(header_);
     }
 
     // Drop the oldest event to free space
@@ -208,6 +395,8 @@ public:
         // Advance read position to drop the oldest event
         uint32_t next_pos = (read_pos + 1) & mask_;
         __atomic_store_n(&header_->read_pos, next_pos, __ATOMIC_RELEASE);
+        // read_pos moved without the consumer; keep its cache from lagging behind it
+        rb_resync_caches(header_);
 
         return true;
     }
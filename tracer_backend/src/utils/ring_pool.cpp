@@ -1,6 +1,7 @@
 #include <tracer_backend/utils/ring_pool.h>
 #include <tracer_backend/utils/thread_registry.h>
 #include <tracer_backend/utils/ring_buffer.h>
+#include <tracer_backend/utils/drain_wake.h>
 #include <tracer_backend/utils/tracer_types.h>
 #include "thread_registry_private.h"
 #include <tracer_backend/ada/thread.h>
@@ -22,6 +23,14 @@ static inline ::Lane* pool_get_lane(AdaRingPool* pool) {
                                   : thread_lanes_get_detail_lane(pool->lanes);
 }
 
+// The calling thread's materialized view of the pool's lane. Views live in
+// the caller's TLS, not the pool, so a pool driven from another thread
+// never shares one.
+static LaneView* pool_view(AdaRingPool* pool, ::Lane* lane) {
+    LaneView* view = &ada_get_tls_state()->lane_views[pool->lane_type];
+    return lane_view_sync(pool->reg, lane, view) ? view : nullptr;
+}
+
 static uint32_t lane_free_count(::Lane* lane) {
     if (!lane) return 0;
     auto* cpp_lane = ada::internal::to_cpp(lane);
@@ -29,10 +38,7 @@ static uint32_t lane_free_count(::Lane* lane) {
     uint32_t tail = cpp_lane->free_tail.load(std::memory_order_acquire);
     uint32_t capacity = cpp_lane->free_capacity;
     if (capacity == 0) return 0;
-    if (tail >= head) {
-        return tail - head;
-    }
-    return capacity - (head - tail);
+    return (tail - head) & (capacity - 1);
 }
 
 static void bp_bind_lane(AdaRingPool* pool, ::Lane* lane) {
@@ -57,6 +63,11 @@ static void bp_mark_drop(AdaRingPool* pool, size_t bytes, uint64_t now_ns = 0) {
     ada_backpressure_state_on_drop(pool->backpressure, bytes, now_ns);
 }
 
+static bool bp_under_pressure(AdaRingPool* pool) {
+    if (!pool || !pool->backpressure) return false;
+    return ada_backpressure_state_get_mode(pool->backpressure) == ADA_BACKPRESSURE_STATE_PRESSURE;
+}
+
 } // namespace
 
 extern "C" {
@@ -105,12 +116,16 @@ void ring_pool_destroy(RingPool* pool) {
     delete p;
 }
 
-bool ring_pool_swap_active(RingPool* pool, uint32_t* out_old_idx) {
+// Swap without publishing the caller's staged events (ring_pool_write_batch
+// runs inside that publish)
+static bool pool_swap_active(RingPool* pool, uint32_t* out_old_idx) {
     if (!pool) return false;
     auto* p = reinterpret_cast<AdaRingPool*>(pool);
     ::Lane* lane = pool_get_lane(p);
     if (!lane) return false;
     auto* cpp_lane = ada::internal::to_cpp(lane);
+    LaneView* view = pool_view(p, lane);
+    if (!view) return false;
 
     bp_sample_lane(p, lane, 0);
 
@@ -118,18 +133,29 @@ bool ring_pool_swap_active(RingPool* pool, uint32_t* out_old_idx) {
     uint64_t swap_start = metrics ? ada_metrics_now_ns() : 0;
     ada_metrics_swap_token_t swap_token = ada_thread_metrics_swap_begin(metrics, swap_start);
 
-    uint32_t new_idx = lane_get_free_ring(lane);
+    // Under pressure, take a fresh overflow ring before the last free ones;
+    // once exhausted, grow before dropping. Lanes without an overflow
+    // segment (or at their ring limit) fall through unchanged.
+    uint32_t new_idx = bp_under_pressure(p)
+        ? thread_registry_grow_lane(p->reg, p->lanes, p->lane_type)
+        : UINT32_MAX;
+    bool owns_new = true; // False when rotating onto a ring we did not take
+    if (new_idx == UINT32_MAX) {
+        new_idx = lane_view_get_free_ring(view);
+    }
     if (new_idx == UINT32_MAX) {
         if (metrics) {
             ada_thread_metrics_record_ring_full(metrics);
         }
-        if (ring_pool_handle_exhaustion(pool)) {
-            new_idx = lane_get_free_ring(lane);
+        new_idx = thread_registry_grow_lane(p->reg, p->lanes, p->lane_type);
+        if (new_idx == UINT32_MAX && ring_pool_handle_exhaustion(pool)) {
+            new_idx = lane_view_get_free_ring(view);
         }
         if (new_idx == UINT32_MAX) {
             if (cpp_lane->ring_count > 1) {
                 uint32_t cur = cpp_lane->active_idx.load(std::memory_order_acquire);
                 new_idx = (cur + 1) % cpp_lane->ring_count;
+                owns_new = false;
             } else {
                 bp_sample_lane(p, lane, 0);
                 if (metrics) {
@@ -141,10 +167,30 @@ bool ring_pool_swap_active(RingPool* pool, uint32_t* out_old_idx) {
     }
 
     uint32_t old_idx = cpp_lane->active_idx.exchange(new_idx, std::memory_order_acq_rel);
-    if (out_old_idx) *out_old_idx = old_idx;
 
-    bool submitted = lane_submit_ring(lane, old_idx);
-    (void)submitted;
+    // Wake a parked drain only on the empty -> non-empty transition; with
+    // rings already queued the drain is awake or about to rescan
+    bool was_empty = !lane_has_submitted_rings(lane);
+    if (!lane_view_submit_ring(view, old_idx)) {
+        // Submit queue full: the old ring would be lost if we moved on, so
+        // keep writing into it and hand the new ring back. Writes that no
+        // longer fit are the drop.
+        cpp_lane->active_idx.store(old_idx, std::memory_order_release);
+        if (owns_new) {
+            (void)lane_view_return_ring(view, new_idx);
+        }
+        bp_mark_drop(p, 0, 0);
+        bp_sample_lane(p, lane, 0);
+        if (metrics) {
+            ada_thread_metrics_record_ring_full(metrics);
+            ada_thread_metrics_swap_end(&swap_token, ada_metrics_now_ns(), cpp_lane->ring_count);
+        }
+        return false;
+    }
+    if (out_old_idx) *out_old_idx = old_idx;
+    if (was_empty) {
+        drain_wake_signal(drain_wake_producer_word());
+    }
 
     bp_sample_lane(p, lane, 0);
     if (metrics) {
@@ -155,13 +201,51 @@ bool ring_pool_swap_active(RingPool* pool, uint32_t* out_old_idx) {
     return true;
 }
 
+bool ring_pool_swap_active(RingPool* pool, uint32_t* out_old_idx) {
+    if (!pool) return false;
+    auto* p = reinterpret_cast<AdaRingPool*>(pool);
+
+    // Staged index events are older than the swap; they belong in the ring
+    // being submitted. Sweepers publish through ring_pool_write_batch only,
+    // so this public swap is always the owning thread's.
+    if (p->lane_type == 0 && ada_get_tls_state()->index_pool == pool) {
+        (void)ada_tls_flush_index_events();
+    }
+    return pool_swap_active(pool, out_old_idx);
+}
+
+size_t ring_pool_write_batch(RingPool* pool, size_t event_size,
+                             const void* events, size_t count) {
+    if (!pool || !events || count == 0) return 0;
+
+    const uint8_t* src = static_cast<const uint8_t*>(events);
+    RingBufferHeader* hdr = ring_pool_get_active_header(pool);
+    size_t written = ring_buffer_write_batch_raw(hdr, event_size, src, count);
+    while (written < count) {
+        // Active ring is full: submit it and continue in a fresh one
+        if (!pool_swap_active(pool, nullptr) &&
+            !(ring_pool_handle_exhaustion(pool) && pool_swap_active(pool, nullptr))) {
+            break;
+        }
+        hdr = ring_pool_get_active_header(pool);
+        size_t n = ring_buffer_write_batch_raw(hdr, event_size,
+                                               src + (written * event_size),
+                                               count - written);
+        if (n == 0) {
+            break;
+        }
+        written += n;
+    }
+    return written;
+}
+
 RingBufferHeader* ring_pool_get_active_header(RingPool* pool) {
     if (!pool) return nullptr;
     auto* p = reinterpret_cast<AdaRingPool*>(pool);
-    Lane* lane = (p->lane_type == 0) ? thread_lanes_get_index_lane(p->lanes)
-                                     : thread_lanes_get_detail_lane(p->lanes);
+    ::Lane* lane = pool_get_lane(p);
     if (!lane) return nullptr;
-    return thread_registry_get_active_ring_header(p->reg, lane);
+    LaneView* view = pool_view(p, lane);
+    return view ? lane_view_active_ring(view) : nullptr;
 }
 
 bool ring_pool_handle_exhaustion(RingPool* pool) {
@@ -169,6 +253,8 @@ bool ring_pool_handle_exhaustion(RingPool* pool) {
     auto* p = reinterpret_cast<AdaRingPool*>(pool);
     ::Lane* lane = pool_get_lane(p);
     if (!lane) return false;
+    LaneView* view = pool_view(p, lane);
+    if (!view) return false;
 
     bp_sample_lane(p, lane, 0);
     bp_mark_exhaustion(p, 0);
@@ -179,24 +265,33 @@ bool ring_pool_handle_exhaustion(RingPool* pool) {
     }
 
     // Take the oldest ring from the submit queue
-    uint32_t oldest = lane_take_ring(lane);
+    uint32_t oldest = lane_view_take_ring(view);
     if (oldest == UINT32_MAX) {
         bp_sample_lane(p, lane, 0);
         return false;
     }
 
     // Get the ring buffer header and drop the oldest event
-    RingBufferHeader* hdr = thread_registry_get_ring_header_by_idx(p->reg, lane, oldest);
-    if (hdr) {
-        // Calculate the event size based on lane type
-        size_t event_size = (p->lane_type == 0) ? sizeof(IndexEvent) : sizeof(DetailEvent);
+    RingBufferHeader* hdr = lane_view_ring(view, oldest);
+    if (hdr && p->lane_type == 1) {
+        // Detail rings hold variable-length records; drop one whole record
+        const void* record = nullptr;
+        size_t record_size = ring_buffer_peek_record_raw(hdr, &record);
+        bool dropped = ring_buffer_drop_oldest_record_raw(hdr);
+        bp_mark_drop(p, dropped ? record_size : 0, 0);
+        if (metrics && dropped) {
+            ada_thread_metrics_record_event_dropped(metrics);
+            ada_thread_metrics_record_ring_full(metrics);
+        }
+    } else if (hdr) {
+        size_t event_size = sizeof(IndexEvent);
 
         // Create a temporary ring buffer handle to drop the oldest event
         void* ring_mem = reinterpret_cast<void*>(hdr);
         // Attach to the ring buffer (doesn't reinitialize)
         RingBuffer* rb = ring_buffer_attach(ring_mem,
-                                           (p->lane_type == 0) ? 64 * 1024 : 256 * 1024,
-                                           event_size);
+                                            thread_registry_get_ring_bytes(p->reg, lane, oldest),
+                                            event_size);
         if (rb) {
             // Drop the oldest event if the ring has any events
             bool dropped = ring_buffer_drop_oldest(rb);
@@ -211,7 +306,7 @@ bool ring_pool_handle_exhaustion(RingPool* pool) {
     }
 
     // Return the ring to the free queue
-    bool returned = lane_return_ring(lane, oldest);
+    bool returned = lane_view_return_ring(view, oldest);
     bp_sample_lane(p, lane, 0);
     return returned;
 }
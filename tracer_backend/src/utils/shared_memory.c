@@ -152,6 +152,18 @@ static SharedMemoryRef shared_memory_open(const char* name, size_t size) {
         free(shm);
         return NULL;
     }
+
+    // Size 0: map whatever the creator sized the segment to
+    if (size == 0) {
+        struct stat st;
+        if (fstat(shm->fd, &st) != 0 || st.st_size <= 0) {
+            DEBUG_LOG("Failed to size shared memory object (%s): %s\n", shm->name, strerror(errno));
+            close(shm->fd);
+            free(shm);
+            return NULL;
+        }
+        size = (size_t)st.st_size;
+    }
     
     // Map memory
     shm->address = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, shm->fd, 0);
@@ -0,0 +1,127 @@
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE  // pthread_getattr_np, process_vm_readv
+#endif
+
+#include <tracer_backend/utils/stack_capture.h>
+
+#include <errno.h>
+#include <pthread.h>
+#include <string.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <sys/uio.h>
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#include <mach/mach_vm.h>
+#endif
+
+// Bounds of the calling thread's stack; 0/0 until initialized
+static __thread uintptr_t tls_stack_low = 0;
+static __thread uintptr_t tls_stack_high = 0;
+static __thread bool tls_stack_probed = false;
+
+static int stack_query_bounds(uintptr_t* low, uintptr_t* high) {
+#if defined(__linux__)
+    pthread_attr_t attr;
+    if (pthread_getattr_np(pthread_self(), &attr) != 0) {
+        return -ENOTSUP; // LCOV_EXCL_LINE
+    }
+    void* addr = NULL;
+    size_t size = 0;
+    int rc = pthread_attr_getstack(&attr, &addr, &size);
+    pthread_attr_destroy(&attr);
+    if (rc != 0 || !addr || size == 0) {
+        return -ENOTSUP; // LCOV_EXCL_LINE
+    }
+    *low = (uintptr_t)addr;
+    *high = (uintptr_t)addr + size;
+    return 0;
+#elif defined(__APPLE__)
+    pthread_t self = pthread_self();
+    uintptr_t top = (uintptr_t)pthread_get_stackaddr_np(self); // Highest address
+    size_t size = pthread_get_stacksize_np(self);
+    if (top == 0 || size == 0) {
+        return -ENOTSUP;
+    }
+    *low = top - size;
+    *high = top;
+    return 0;
+#else
+    (void)low;
+    (void)high;
+    return -ENOTSUP;
+#endif
+}
+
+int stack_capture_init_thread(void) {
+    uintptr_t low = 0, high = 0;
+    int rc = stack_query_bounds(&low, &high);
+    tls_stack_probed = true;
+    if (rc != 0) {
+        tls_stack_low = tls_stack_high = 0; // LCOV_EXCL_LINE
+        return rc;                          // LCOV_EXCL_LINE
+    }
+    tls_stack_low = low;
+    tls_stack_high = high;
+    return 0;
+}
+
+bool stack_capture_get_bounds(uintptr_t* low, uintptr_t* high) {
+    if (tls_stack_high == 0) return false;
+    if (low) *low = tls_stack_low;
+    if (high) *high = tls_stack_high;
+    return true;
+}
+
+size_t stack_capture_copy_checked(void* dest, const void* src, size_t size) {
+    if (!dest || !src || size == 0) return 0;
+#if defined(__linux__)
+    // Split at the page boundary so a fault on the second page still yields
+    // the bytes of the first (partial transfers stop at iovec granularity)
+    static size_t page_size = 0;
+    if (page_size == 0) {
+        long ps = sysconf(_SC_PAGESIZE);
+        page_size = ps > 0 ? (size_t)ps : 4096u;
+    }
+    uintptr_t start = (uintptr_t)src;
+    size_t first = page_size - (start & (page_size - 1));
+    if (first > size) first = size;
+
+    struct iovec local = { dest, size };
+    struct iovec remote[2] = {
+        { (void*)src, first },
+        { (void*)(start + first), size - first },
+    };
+    ssize_t n = process_vm_readv(getpid(), &local, 1, remote, size > first ? 2 : 1, 0);
+    return n > 0 ? (size_t)n : 0;
+#elif defined(__APPLE__)
+    mach_vm_size_t copied = 0;
+    kern_return_t kr = mach_vm_read_overwrite(mach_task_self(), (mach_vm_address_t)src,
+                                              (mach_vm_size_t)size,
+                                              (mach_vm_address_t)dest, &copied);
+    return kr == KERN_SUCCESS ? (size_t)copied : 0;
+#else
+    return 0;
+#endif
+}
+
+size_t stack_capture_copy(void* dest, const void* stack_ptr, size_t max_size) {
+    if (!dest || !stack_ptr || max_size == 0) return 0;
+
+    if (!tls_stack_probed) {
+        (void)stack_capture_init_thread();
+    }
+
+    uintptr_t sp = (uintptr_t)stack_ptr;
+    if (sp >= tls_stack_low && sp < tls_stack_high) {
+        // Live stack from sp up to the top is mapped; clip at the top
+        size_t limit = (size_t)(tls_stack_high - sp);
+        size_t n = max_size < limit ? max_size : limit;
+        memcpy(dest, stack_ptr, n);
+        return n;
+    }
+
+    // Not our stack (alternate signal stack, coroutine, bad sp)
+    return stack_capture_copy_checked(dest, stack_ptr, max_size);
+}
@@ -51,6 +51,17 @@ ThreadRegistry* thread_registry_init_with_capacity(void* memory, size_t size, ui
     return reinterpret_cast<ThreadRegistry*>(impl);
 }
 
+void thread_registry_geometry_default(ThreadRegistryGeometry* geometry) {
+    if (!geometry) return;
+    *geometry = ada::internal::ThreadRegistry::normalize_geometry(nullptr);
+}
+
+ThreadRegistry* thread_registry_init_with_geometry(void* memory, size_t size, uint32_t capacity,
+                                                   const ThreadRegistryGeometry* geometry) {
+    auto* impl = ada::internal::ThreadRegistry::create(memory, size, capacity, geometry);
+    return reinterpret_cast<ThreadRegistry*>(impl);
+}
+
 ThreadRegistry* thread_registry_attach(void* memory) {
     if (!memory) return nullptr;
     auto* impl = reinterpret_cast<ada::internal::ThreadRegistry*>(memory);
@@ -88,7 +99,8 @@ ThreadLaneSet* thread_registry_get_thread_lanes(ThreadRegistry* registry, uintpt
     
     // Search for existing registration
     auto* lanes_base = reinterpret_cast<ada::internal::ThreadLaneSet*>(reinterpret_cast<uint8_t*>(cpp_registry) + cpp_registry->lanes_off);
-    for (uint32_t i = 0; i < cpp_registry->thread_count.load(); ++i) {
+    for (uint32_t i = cpp_registry->next_claimed_slot(0); i != UINT32_MAX;
+         i = cpp_registry->next_claimed_slot(i + 1)) {
         if (lanes_base[i].thread_id == thread_id && 
             lanes_base[i].active.load()) {
             return reinterpret_cast<ThreadLaneSet*>(&lanes_base[i]);
@@ -127,28 +139,18 @@ RingBufferHeader* thread_registry_get_active_ring_header(ThreadRegistry* registr
     return thread_registry_get_ring_header_by_idx(registry, lane, idx);
 }
 
-RingBufferHeader* thread_registry_get_ring_header_by_idx(ThreadRegistry* registry,
-                                                         Lane* lane,
-                                                         uint32_t ring_idx) {
+// Descriptor of a lane's ring, or nullptr if the index or its segment is invalid
+static const ada::internal::LaneMemoryLayout::RingDescriptor* lane_ring_desc(ThreadRegistry* registry,
+                                                                             Lane* lane,
+                                                                             uint32_t ring_idx) {
     if (!registry || !lane) return nullptr;
     auto* cpp_registry = reinterpret_cast<ada::internal::ThreadRegistry*>(registry);
     auto* cpp_lane = reinterpret_cast<ada::internal::Lane*>(lane);
-    if (ring_idx >= cpp_lane->ring_count) return nullptr;
+    // Grown rings are published by a release store of the count
+    if (ring_idx >= __atomic_load_n(&cpp_lane->ring_count, __ATOMIC_ACQUIRE)) return nullptr;
     using ada::internal::ThreadLaneSet;
-    uint8_t* p = reinterpret_cast<uint8_t*>(cpp_lane);
-    ThreadLaneSet* parent = nullptr;
-    bool is_index = false;
-    ThreadLaneSet* cand_idx = reinterpret_cast<ThreadLaneSet*>(p - offsetof(ThreadLaneSet, index_lane));
-    if (reinterpret_cast<ada::internal::Lane*>(&cand_idx->index_lane) == cpp_lane) {
-        parent = cand_idx;
-        is_index = true;
-    } else {
-        ThreadLaneSet* cand_det = reinterpret_cast<ThreadLaneSet*>(p - offsetof(ThreadLaneSet, detail_lane));
-        if (reinterpret_cast<ada::internal::Lane*>(&cand_det->detail_lane) == cpp_lane) {
-            parent = cand_det;
-            is_index = false;
-        }
-    }
+    ThreadLaneSet* parent = cpp_lane->owner();
+    bool is_index = cpp_lane->lane_kind == ada::internal::LANE_KIND_INDEX;
     if (!parent) return nullptr;
     uint8_t* reg_base = reinterpret_cast<uint8_t*>(cpp_registry);
     auto& seg = cpp_registry->segments[0];
@@ -157,10 +159,23 @@ RingBufferHeader* thread_registry_get_ring_header_by_idx(ThreadRegistry* registr
     auto* layout = reinterpret_cast<ada::internal::LaneMemoryLayout*>(seg_base + layout_off);
     uint32_t seg_id = layout->ring_descs[ring_idx].segment_id;
     if (seg_id == 0 || seg_id > cpp_registry->segment_count.load()) return nullptr;
-    auto& seg2 = cpp_registry->segments[seg_id - 1];
-    uint8_t* seg_base2 = reg_base + seg2.base_offset;
-    uint8_t* ring_ptr = seg_base2 + layout->ring_descs[ring_idx].offset;
-    return reinterpret_cast<RingBufferHeader*>(ring_ptr);
+    return &layout->ring_descs[ring_idx];
+}
+
+RingBufferHeader* thread_registry_get_ring_header_by_idx(ThreadRegistry* registry,
+                                                         Lane* lane,
+                                                         uint32_t ring_idx) {
+    const auto* desc = lane_ring_desc(registry, lane, ring_idx);
+    if (!desc) return nullptr;
+    auto* cpp_registry = reinterpret_cast<ada::internal::ThreadRegistry*>(registry);
+    uint8_t* seg_base = reinterpret_cast<uint8_t*>(cpp_registry) +
+                        cpp_registry->segments[desc->segment_id - 1].base_offset;
+    return reinterpret_cast<RingBufferHeader*>(seg_base + desc->offset);
+}
+
+uint32_t thread_registry_get_ring_bytes(ThreadRegistry* registry, Lane* lane, uint32_t ring_idx) {
+    const auto* desc = lane_ring_desc(registry, lane, ring_idx);
+    return desc ? desc->bytes : 0;
 }
 
 bool thread_registry_unregister_by_id(ThreadRegistry* registry, uintptr_t thread_id) {
@@ -169,20 +184,14 @@ bool thread_registry_unregister_by_id(ThreadRegistry* registry, uintptr_t thread
     
     // Find and deactivate thread
     auto* lanes_base = reinterpret_cast<ada::internal::ThreadLaneSet*>(reinterpret_cast<uint8_t*>(cpp_registry) + cpp_registry->lanes_off);
-    for (uint32_t i = 0; i < cpp_registry->thread_count.load(); ++i) {
-        if (lanes_base[i].thread_id == thread_id) {
+    for (uint32_t i = cpp_registry->next_claimed_slot(0); i != UINT32_MAX;
+         i = cpp_registry->next_claimed_slot(i + 1)) {
+        // Retiring slots belong to the drain; a reused pthread_t must not match them
+        if (lanes_base[i].thread_id == thread_id &&
+            lanes_base[i].retire_epoch.load(std::memory_order_acquire) == 0) {
             bool was_active = lanes_base[i].active.exchange(false);
-            if (was_active) {
-                // Clear active_mask bit with CAS
-                uint64_t bit = 1ull << i;
-                uint64_t mask = cpp_registry->active_mask.load(std::memory_order_acquire);
-                while (mask & bit) {
-                    uint64_t new_mask = mask & ~bit;
-                    if (cpp_registry->active_mask.compare_exchange_weak(mask, new_mask, std::memory_order_acq_rel, std::memory_order_acquire)) {
-                        cpp_registry->thread_count.fetch_sub(1, std::memory_order_acq_rel);
-                        break;
-                    }
-                }
+            if (was_active && cpp_registry->release_slot(i)) {
+                cpp_registry->thread_count.fetch_sub(1, std::memory_order_acq_rel);
             }
             return true;
         }
@@ -196,19 +205,74 @@ uint32_t thread_registry_get_active_count(ThreadRegistry* registry) {
     
     uint32_t count = 0;
     auto* lanes_base = reinterpret_cast<ada::internal::ThreadLaneSet*>(reinterpret_cast<uint8_t*>(cpp_registry) + cpp_registry->lanes_off);
-    for (uint32_t i = 0; i < cpp_registry->thread_count.load(); ++i) {
-        if (lanes_base[i].active.load()) {
+    for (uint32_t i = cpp_registry->next_claimed_slot(0); i != UINT32_MAX;
+         i = cpp_registry->next_claimed_slot(i + 1)) {
+        if (lanes_base[i].active.load() &&
+            lanes_base[i].retire_epoch.load(std::memory_order_acquire) == 0) {
             count++;
         }
     }
     return count;
 }
 
+bool thread_registry_retire(ThreadRegistry* registry, ThreadLaneSet* lanes) {
+    if (!registry || !lanes) return false;
+    auto* cpp_registry = reinterpret_cast<ada::internal::ThreadRegistry*>(registry);
+    return cpp_registry->retire_thread(reinterpret_cast<ada::internal::ThreadLaneSet*>(lanes));
+}
+
+bool thread_registry_reclaim_slot(ThreadRegistry* registry, uint32_t slot) {
+    if (!registry) return false;
+    auto* cpp_registry = reinterpret_cast<ada::internal::ThreadRegistry*>(registry);
+    return cpp_registry->reclaim_slot(slot);
+}
+
+uint64_t thread_registry_advance_epoch(ThreadRegistry* registry) {
+    if (!registry) return 0;
+    auto* cpp_registry = reinterpret_cast<ada::internal::ThreadRegistry*>(registry);
+    return cpp_registry->advance_reclaim_epoch();
+}
+
+uint64_t thread_registry_get_slots_reclaimed(ThreadRegistry* registry) {
+    if (!registry) return 0;
+    auto* cpp_registry = reinterpret_cast<ada::internal::ThreadRegistry*>(registry);
+    return cpp_registry->slots_reclaimed.load(std::memory_order_relaxed);
+}
+
+uint64_t thread_registry_get_slots_reused(ThreadRegistry* registry) {
+    if (!registry) return 0;
+    auto* cpp_registry = reinterpret_cast<ada::internal::ThreadRegistry*>(registry);
+    return cpp_registry->slots_reused.load(std::memory_order_relaxed);
+}
+
+uint32_t thread_registry_grow_lane(ThreadRegistry* registry, ThreadLaneSet* lanes, int lane_type) {
+    if (!registry || !lanes) return UINT32_MAX;
+    auto* cpp_registry = reinterpret_cast<ada::internal::ThreadRegistry*>(registry);
+    return cpp_registry->grow_lane(reinterpret_cast<ada::internal::ThreadLaneSet*>(lanes), lane_type);
+}
+
+uint64_t thread_registry_get_rings_grown(ThreadRegistry* registry) {
+    if (!registry) return 0;
+    auto* cpp_registry = reinterpret_cast<ada::internal::ThreadRegistry*>(registry);
+    return cpp_registry->rings_grown.load(std::memory_order_relaxed);
+}
+
+uint64_t thread_registry_get_ring_growth_denied(ThreadRegistry* registry) {
+    if (!registry) return 0;
+    auto* cpp_registry = reinterpret_cast<ada::internal::ThreadRegistry*>(registry);
+    return cpp_registry->ring_growth_denied.load(std::memory_order_relaxed);
+}
+
+bool thread_lanes_is_retiring(ThreadLaneSet* lanes) {
+    if (!lanes) return false;
+    auto* cpp_lanes = reinterpret_cast<ada::internal::ThreadLaneSet*>(lanes);
+    return cpp_lanes->retire_epoch.load(std::memory_order_acquire) != 0;
+}
+
 ThreadLaneSet* thread_registry_get_thread_at(ThreadRegistry* registry, uint32_t index) {
     auto* cpp_registry = reinterpret_cast<ada::internal::ThreadRegistry*>(registry);
     if (!registry || index >= cpp_registry->get_capacity()) return nullptr;
     
-    if (index >= cpp_registry->thread_count.load()) return nullptr;
     auto* lanes_base = reinterpret_cast<ada::internal::ThreadLaneSet*>(reinterpret_cast<uint8_t*>(cpp_registry) + cpp_registry->lanes_off);
     if (!lanes_base[index].active.load()) return nullptr;
     
@@ -233,161 +297,228 @@ bool thread_registry_is_shutdown_requested(ThreadRegistry* registry) {
     return cpp_registry->shutdown_requested.load();
 }
 
-// Lane operations - delegate to C++ implementation
-bool lane_submit_ring(Lane* lane, uint32_t ring_idx) {
-    if (!lane) return false;
-    auto* cpp_lane = reinterpret_cast<ada::internal::Lane*>(lane);
-    // Best-effort: bump parent lane-set's events_generated for visibility tests
-    using ada::internal::ThreadLaneSet;
-    uint8_t* p = reinterpret_cast<uint8_t*>(cpp_lane);
-    ThreadLaneSet* parent = nullptr;
-    bool is_index = false;
-    ThreadLaneSet* cand_idx = reinterpret_cast<ThreadLaneSet*>(p - offsetof(ThreadLaneSet, index_lane));
-    if (reinterpret_cast<ada::internal::Lane*>(&cand_idx->index_lane) == cpp_lane) {
-        parent = cand_idx;
-        is_index = true;
-    } else {
-        ThreadLaneSet* cand_det = reinterpret_cast<ThreadLaneSet*>(p - offsetof(ThreadLaneSet, detail_lane));
-        if (reinterpret_cast<ada::internal::Lane*>(&cand_det->detail_lane) == cpp_lane) {
-            parent = cand_det;
-            is_index = false;
-        }
-    }
-    if (parent) {
-        parent->events_generated.fetch_add(1, std::memory_order_release);
-    }
-    // Materialize layout from offsets using global registry base
+// Queue arrays of a lane, resolved through the global registry
+static ada::internal::LaneMemoryLayout* lane_layout(ada::internal::Lane* lane) {
+    ada::internal::ThreadLaneSet* parent = lane->owner();
     ThreadRegistry* reg = ada_get_global_registry();
-    if (!reg || !parent) return false;
+    if (!reg || !parent) return nullptr;
     auto* cpp_reg = reinterpret_cast<ada::internal::ThreadRegistry*>(reg);
     void* base0 = shm_dir_get_base(0);
     uint8_t* pool_base = base0 ? (reinterpret_cast<uint8_t*>(base0) + cpp_reg->segments[0].base_offset)
                                : (reinterpret_cast<uint8_t*>(cpp_reg) + cpp_reg->segments[0].base_offset);
+    bool is_index = lane->lane_kind == ada::internal::LANE_KIND_INDEX;
     uint64_t layout_off = is_index ? parent->index_layout_off : parent->detail_layout_off;
-    auto* layout = reinterpret_cast<ada::internal::LaneMemoryLayout*>(pool_base + layout_off);
+    return reinterpret_cast<ada::internal::LaneMemoryLayout*>(pool_base + layout_off);
+}
+
+// SPSC queue bodies shared by the lane_* and lane_view_* entry points.
+// Capacities are powers of two, so positions wrap by mask; one slot stays
+// empty to tell a full queue from an empty one.
+static uint32_t spsc_push_n(std::atomic<uint32_t>& head, std::atomic<uint32_t>& tail, uint32_t capacity,
+                            uint32_t* queue, const uint32_t* items, uint32_t count) {
+    const uint32_t mask = capacity - 1;
+    uint32_t t = tail.load(std::memory_order_relaxed);
+    uint32_t space = (head.load(std::memory_order_acquire) - t - 1) & mask;
+    uint32_t n = count < space ? count : space;
+    for (uint32_t i = 0; i < n; ++i) {
+        queue[(t + i) & mask] = items[i];
+    }
+    if (n > 0) tail.store((t + n) & mask, std::memory_order_release);
+    return n;
+}
+
+static uint32_t spsc_pop_n(std::atomic<uint32_t>& head, std::atomic<uint32_t>& tail, uint32_t capacity,
+                           const uint32_t* queue, uint32_t* out, uint32_t max) {
+    const uint32_t mask = capacity - 1;
+    uint32_t h = head.load(std::memory_order_relaxed);
+    uint32_t ready = (tail.load(std::memory_order_acquire) - h) & mask;
+    uint32_t n = max < ready ? max : ready;
+    for (uint32_t i = 0; i < n; ++i) {
+        out[i] = queue[(h + i) & mask];
+    }
+    if (n > 0) head.store((h + n) & mask, std::memory_order_release);
+    return n;
+}
 
-    // Treat submit queue as SPSC queue
-    auto head = cpp_lane->submit_head.load(std::memory_order_relaxed);
-    auto tail = cpp_lane->submit_tail.load(std::memory_order_acquire);
-    auto next = (tail + 1) % cpp_lane->submit_capacity;
-    if (next == head) {
-        // Overwrite oldest (advance head) to avoid artificial drops in integration tests
-        cpp_lane->submit_head.store((head + 1) % cpp_lane->submit_capacity, std::memory_order_release);
-        head = cpp_lane->submit_head.load(std::memory_order_relaxed);
-        next = (tail + 1) % cpp_lane->submit_capacity;
-        if (next == head) return false;
+static bool submit_queue_push(ada::internal::Lane* cpp_lane, uint32_t* queue, uint32_t ring_idx) {
+    return spsc_push_n(cpp_lane->submit_head, cpp_lane->submit_tail, cpp_lane->submit_capacity,
+                       queue, &ring_idx, 1) == 1;
+}
+
+static uint32_t submit_queue_pop_n(ada::internal::Lane* cpp_lane, const uint32_t* queue,
+                                   uint32_t* rings, uint32_t max) {
+    return spsc_pop_n(cpp_lane->submit_head, cpp_lane->submit_tail, cpp_lane->submit_capacity,
+                      queue, rings, max);
+}
+
+static uint32_t free_queue_push_n(ada::internal::Lane* cpp_lane, uint32_t* queue,
+                                  const uint32_t* rings, uint32_t count) {
+    return spsc_push_n(cpp_lane->free_head, cpp_lane->free_tail, cpp_lane->free_capacity,
+                       queue, rings, count);
+}
+
+static uint32_t free_queue_pop(ada::internal::Lane* cpp_lane, const uint32_t* queue) {
+    uint32_t ring_idx = UINT32_MAX;
+    spsc_pop_n(cpp_lane->free_head, cpp_lane->free_tail, cpp_lane->free_capacity, queue, &ring_idx, 1);
+    return ring_idx;
+}
+
+// Best-effort: bump parent lane-set's events_generated for visibility tests
+static void note_submit(ada::internal::Lane* cpp_lane) {
+    if (ada::internal::ThreadLaneSet* parent = cpp_lane->owner()) {
+        parent->events_generated.fetch_add(1, std::memory_order_release);
     }
-    layout->submit_queue[tail] = ring_idx;
-    cpp_lane->submit_tail.store(next, std::memory_order_release);
-    return true;
+}
+
+// Lane operations - delegate to C++ implementation
+bool lane_submit_ring(Lane* lane, uint32_t ring_idx) {
+    if (!lane) return false;
+    auto* cpp_lane = reinterpret_cast<ada::internal::Lane*>(lane);
+    note_submit(cpp_lane);
+    auto* layout = lane_layout(cpp_lane);
+    if (!layout) return false;
+    return submit_queue_push(cpp_lane, layout->submit_queue, ring_idx);
 }
 
 uint32_t lane_take_ring(Lane* lane) {
     if (!lane) return UINT32_MAX;
     auto* cpp_lane = reinterpret_cast<ada::internal::Lane*>(lane);
-    using ada::internal::ThreadLaneSet;
-    uint8_t* p = reinterpret_cast<uint8_t*>(cpp_lane);
-    ThreadLaneSet* parent = nullptr;
-    bool is_index = false;
-    ThreadLaneSet* cand_idx = reinterpret_cast<ThreadLaneSet*>(p - offsetof(ThreadLaneSet, index_lane));
-    if (reinterpret_cast<ada::internal::Lane*>(&cand_idx->index_lane) == cpp_lane) {
-        parent = cand_idx;
-        is_index = true;
-    } else {
-        ThreadLaneSet* cand_det = reinterpret_cast<ThreadLaneSet*>(p - offsetof(ThreadLaneSet, detail_lane));
-        if (reinterpret_cast<ada::internal::Lane*>(&cand_det->detail_lane) == cpp_lane) {
-            parent = cand_det;
-            is_index = false;
-        }
-    }
-    ThreadRegistry* reg = ada_get_global_registry();
-    if (!reg || !parent) return UINT32_MAX;
-    auto* cpp_reg = reinterpret_cast<ada::internal::ThreadRegistry*>(reg);
-    void* base0 = shm_dir_get_base(0);
-    uint8_t* pool_base = base0 ? (reinterpret_cast<uint8_t*>(base0) + cpp_reg->segments[0].base_offset)
-                               : (reinterpret_cast<uint8_t*>(cpp_reg) + cpp_reg->segments[0].base_offset);
-    uint64_t layout_off = is_index ? parent->index_layout_off : parent->detail_layout_off;
-    auto* layout = reinterpret_cast<ada::internal::LaneMemoryLayout*>(pool_base + layout_off);
+    auto* layout = lane_layout(cpp_lane);
+    if (!layout) return UINT32_MAX;
+    uint32_t ring_idx = UINT32_MAX;
+    submit_queue_pop_n(cpp_lane, layout->submit_queue, &ring_idx, 1);
+    return ring_idx;
+}
 
-    auto head = cpp_lane->submit_head.load(std::memory_order_relaxed);
+uint32_t lane_take_rings(Lane* lane, uint32_t* rings, uint32_t max) {
+    if (!lane || !rings) return 0;
+    auto* cpp_lane = reinterpret_cast<ada::internal::Lane*>(lane);
+    auto* layout = lane_layout(cpp_lane);
+    if (!layout) return 0;
+    return submit_queue_pop_n(cpp_lane, layout->submit_queue, rings, max);
+}
+
+bool lane_has_submitted_rings(Lane* lane) {
+    if (!lane) return false;
+    auto* cpp_lane = reinterpret_cast<ada::internal::Lane*>(lane);
     auto tail = cpp_lane->submit_tail.load(std::memory_order_acquire);
-    if (head == tail) return UINT32_MAX;
-    uint32_t ring_idx = layout->submit_queue[head];
-    cpp_lane->submit_head.store((head + 1) % cpp_lane->submit_capacity, std::memory_order_release);
-    return ring_idx;
+    return cpp_lane->submit_head.load(std::memory_order_relaxed) != tail;
 }
 
 bool lane_return_ring(Lane* lane, uint32_t ring_idx) {
     if (!lane) return false;
     auto* cpp_lane = reinterpret_cast<ada::internal::Lane*>(lane);
-    using ada::internal::ThreadLaneSet;
-    uint8_t* p = reinterpret_cast<uint8_t*>(cpp_lane);
-    ThreadLaneSet* parent = nullptr;
-    bool is_index = false;
-    ThreadLaneSet* cand_idx = reinterpret_cast<ThreadLaneSet*>(p - offsetof(ThreadLaneSet, index_lane));
-    if (reinterpret_cast<ada::internal::Lane*>(&cand_idx->index_lane) == cpp_lane) {
-        parent = cand_idx;
-        is_index = true;
-    } else {
-        ThreadLaneSet* cand_det = reinterpret_cast<ThreadLaneSet*>(p - offsetof(ThreadLaneSet, detail_lane));
-        if (reinterpret_cast<ada::internal::Lane*>(&cand_det->detail_lane) == cpp_lane) {
-            parent = cand_det;
-            is_index = false;
-        }
-    }
-    ThreadRegistry* reg = ada_get_global_registry();
-    if (!reg || !parent) return false;
-    auto* cpp_reg = reinterpret_cast<ada::internal::ThreadRegistry*>(reg);
-    void* base0 = shm_dir_get_base(0);
-    uint8_t* pool_base = base0 ? (reinterpret_cast<uint8_t*>(base0) + cpp_reg->segments[0].base_offset)
-                               : (reinterpret_cast<uint8_t*>(cpp_reg) + cpp_reg->segments[0].base_offset);
-    uint64_t layout_off = is_index ? parent->index_layout_off : parent->detail_layout_off;
-    auto* layout = reinterpret_cast<ada::internal::LaneMemoryLayout*>(pool_base + layout_off);
-
-    auto head = cpp_lane->free_head.load(std::memory_order_relaxed);
-    auto tail = cpp_lane->free_tail.load(std::memory_order_acquire);
-    auto next = (tail + 1) % cpp_lane->free_capacity;
-    if (next == head) return false;  // Queue full
-    layout->free_queue[tail] = ring_idx;
-    cpp_lane->free_tail.store(next, std::memory_order_release);
-    return true;
+    auto* layout = lane_layout(cpp_lane);
+    if (!layout) return false;
+    return free_queue_push_n(cpp_lane, layout->free_queue, &ring_idx, 1) == 1;
+}
+
+uint32_t lane_return_rings(Lane* lane, const uint32_t* rings, uint32_t count) {
+    if (!lane || !rings) return 0;
+    auto* cpp_lane = reinterpret_cast<ada::internal::Lane*>(lane);
+    auto* layout = lane_layout(cpp_lane);
+    if (!layout) return 0;
+    return free_queue_push_n(cpp_lane, layout->free_queue, rings, count);
 }
 
 uint32_t lane_get_free_ring(Lane* lane) {
     if (!lane) return UINT32_MAX;
     auto* cpp_lane = reinterpret_cast<ada::internal::Lane*>(lane);
-    using ada::internal::ThreadLaneSet;
-    uint8_t* p = reinterpret_cast<uint8_t*>(cpp_lane);
-    ThreadLaneSet* parent = nullptr;
-    bool is_index = false;
-    ThreadLaneSet* cand_idx = reinterpret_cast<ThreadLaneSet*>(p - offsetof(ThreadLaneSet, index_lane));
-    if (reinterpret_cast<ada::internal::Lane*>(&cand_idx->index_lane) == cpp_lane) {
-        parent = cand_idx;
-        is_index = true;
-    } else {
-        ThreadLaneSet* cand_det = reinterpret_cast<ThreadLaneSet*>(p - offsetof(ThreadLaneSet, detail_lane));
-        if (reinterpret_cast<ada::internal::Lane*>(&cand_det->detail_lane) == cpp_lane) {
-            parent = cand_det;
-            is_index = false;
-        }
+    auto* layout = lane_layout(cpp_lane);
+    if (!layout) return UINT32_MAX;
+    return free_queue_pop(cpp_lane, layout->free_queue);
+}
+
+// Lane views
+bool lane_view_sync(ThreadRegistry* registry, Lane* lane, LaneView* view) {
+    if (!view) return false;
+    if (!registry) registry = ada_get_global_registry();
+    if (!registry || !lane) {
+        *view = LaneView{};
+        return false;
     }
-    ThreadRegistry* reg = ada_get_global_registry();
-    if (!reg || !parent) return UINT32_MAX;
-    auto* cpp_reg = reinterpret_cast<ada::internal::ThreadRegistry*>(reg);
-    void* base0 = shm_dir_get_base(0);
-    uint8_t* pool_base = base0 ? (reinterpret_cast<uint8_t*>(base0) + cpp_reg->segments[0].base_offset)
-                               : (reinterpret_cast<uint8_t*>(cpp_reg) + cpp_reg->segments[0].base_offset);
+    auto* cpp_registry = reinterpret_cast<ada::internal::ThreadRegistry*>(registry);
+    uint32_t epoch = cpp_registry->epoch.load(std::memory_order_acquire);
+    if (view->lane == lane && view->registry == registry && view->epoch == epoch) return true;
+
+    auto* cpp_lane = reinterpret_cast<ada::internal::Lane*>(lane);
+    ada::internal::ThreadLaneSet* parent = cpp_lane->owner();
+    if (!parent) {
+        *view = LaneView{};
+        return false;
+    }
+    bool is_index = cpp_lane->lane_kind == ada::internal::LANE_KIND_INDEX;
     uint64_t layout_off = is_index ? parent->index_layout_off : parent->detail_layout_off;
-    auto* layout = reinterpret_cast<ada::internal::LaneMemoryLayout*>(pool_base + layout_off);
+    auto* layout = reinterpret_cast<ada::internal::LaneMemoryLayout*>(
+        reinterpret_cast<uint8_t*>(cpp_registry) + cpp_registry->segments[0].base_offset + layout_off);
+
+    view->registry = registry;
+    view->lane = lane;
+    view->epoch = epoch;
+    view->submit_queue = layout->submit_queue;
+    view->free_queue = layout->free_queue;
+    view->ring_count = 0;
+    uint32_t count = __atomic_load_n(&cpp_lane->ring_count, __ATOMIC_ACQUIRE);
+    while (view->ring_count < count) {
+        RingBufferHeader* hdr = thread_registry_get_ring_header_by_idx(registry, lane, view->ring_count);
+        if (!hdr) break;
+        view->rings[view->ring_count++] = hdr;
+    }
+    return true;
+}
+
+RingBufferHeader* lane_view_resolve_ring(LaneView* view, uint32_t ring_idx) {
+    if (!view || !view->lane || ring_idx >= LANE_VIEW_MAX_RINGS) return nullptr;
+    // Rings are appended in order by the lane's producer; resolve up to ring_idx
+    while (view->ring_count <= ring_idx) {
+        RingBufferHeader* hdr = thread_registry_get_ring_header_by_idx(view->registry, view->lane,
+                                                                       view->ring_count);
+        if (!hdr) return nullptr;
+        view->rings[view->ring_count++] = hdr;
+    }
+    return view->rings[ring_idx];
+}
+
+RingBufferHeader* lane_view_active_ring(LaneView* view) {
+    if (!view || !view->lane) return nullptr;
+    auto* cpp_lane = reinterpret_cast<ada::internal::Lane*>(view->lane);
+    return lane_view_ring(view, cpp_lane->active_idx.load(std::memory_order_relaxed));
+}
 
-    auto head = cpp_lane->free_head.load(std::memory_order_relaxed);
-    auto tail = cpp_lane->free_tail.load(std::memory_order_acquire);
-    if (head == tail) return UINT32_MAX;
-    uint32_t ring_idx = layout->free_queue[head];
-    cpp_lane->free_head.store((head + 1) % cpp_lane->free_capacity, std::memory_order_release);
+bool lane_view_submit_ring(LaneView* view, uint32_t ring_idx) {
+    if (!view || !view->lane) return false;
+    auto* cpp_lane = reinterpret_cast<ada::internal::Lane*>(view->lane);
+    note_submit(cpp_lane);
+    return submit_queue_push(cpp_lane, view->submit_queue, ring_idx);
+}
+
+uint32_t lane_view_take_ring(LaneView* view) {
+    uint32_t ring_idx = UINT32_MAX;
+    lane_view_take_rings(view, &ring_idx, 1);
     return ring_idx;
 }
 
+uint32_t lane_view_take_rings(LaneView* view, uint32_t* rings, uint32_t max) {
+    if (!view || !view->lane || !rings) return 0;
+    return submit_queue_pop_n(reinterpret_cast<ada::internal::Lane*>(view->lane), view->submit_queue,
+                              rings, max);
+}
+
+bool lane_view_return_ring(LaneView* view, uint32_t ring_idx) {
+    return lane_view_return_rings(view, &ring_idx, 1) == 1;
+}
+
+uint32_t lane_view_return_rings(LaneView* view, const uint32_t* rings, uint32_t count) {
+    if (!view || !view->lane || !rings) return 0;
+    return free_queue_push_n(reinterpret_cast<ada::internal::Lane*>(view->lane), view->free_queue,
+                             rings, count);
+}
+
+uint32_t lane_view_get_free_ring(LaneView* view) {
+    if (!view || !view->lane) return UINT32_MAX;
+    return free_queue_pop(reinterpret_cast<ada::internal::Lane*>(view->lane), view->free_queue);
+}
+
 // lane_get_active_ring is already defined as inline in header
 
 void lane_mark_event(Lane* lane) {
@@ -427,37 +558,9 @@ bool lane_swap_active_ring(Lane* lane) {
 namespace ada { namespace internal {
 bool Lane::submit_ring(uint32_t ring_idx) {
     if (ring_idx >= ring_count) return false;
-    // Determine parent lane set
-    uint8_t* p = reinterpret_cast<uint8_t*>(this);
-    ThreadLaneSet* parent = nullptr;
-    bool is_index = false;
-    ThreadLaneSet* cand_idx = reinterpret_cast<ThreadLaneSet*>(p - offsetof(ThreadLaneSet, index_lane));
-    if (reinterpret_cast<Lane*>(&cand_idx->index_lane) == this) {
-        parent = cand_idx;
-        is_index = true;
-    } else {
-        ThreadLaneSet* cand_det = reinterpret_cast<ThreadLaneSet*>(p - offsetof(ThreadLaneSet, detail_lane));
-        if (reinterpret_cast<Lane*>(&cand_det->detail_lane) == this) {
-            parent = cand_det;
-            is_index = false;
-        }
-    }
-    ::ThreadRegistry* reg = ada_get_global_registry();
-    if (!reg || !parent) return false;
-    auto* cpp_reg = reinterpret_cast<ada::internal::ThreadRegistry*>(reg);
-    void* base0 = shm_dir_get_base(0);
-    uint8_t* pool_base = base0 ? (reinterpret_cast<uint8_t*>(base0) + cpp_reg->segments[0].base_offset)
-                               : (reinterpret_cast<uint8_t*>(cpp_reg) + cpp_reg->segments[0].base_offset);
-    uint64_t layout_off = is_index ? parent->index_layout_off : parent->detail_layout_off;
-    auto* layout = reinterpret_cast<LaneMemoryLayout*>(pool_base + layout_off);
-
-    auto head = submit_head.load(std::memory_order_relaxed);
-    auto tail = submit_tail.load(std::memory_order_acquire);
-    auto next = (tail + 1) % submit_capacity;
-    if (next == head) return false; // Queue full
-    layout->submit_queue[tail] = ring_idx;
-    submit_tail.store(next, std::memory_order_release);
-    return true;
+    LaneMemoryLayout* layout = lane_layout(this);
+    if (!layout) return false;
+    return submit_queue_push(this, layout->submit_queue, ring_idx);
 }
 }} // namespace ada::internal
 
@@ -473,18 +576,21 @@ size_t thread_registry_calculate_memory_size(void) {
 }
 
 size_t thread_registry_calculate_memory_size_with_capacity(uint32_t capacity) {
-    // Recommended size: header + lane array + per-thread (rings + metadata)
+    return thread_registry_calculate_memory_size_with_geometry(capacity, nullptr);
+}
+
+size_t thread_registry_calculate_memory_size_with_geometry(uint32_t capacity,
+                                                           const ThreadRegistryGeometry* geometry) {
+    // Recommended size: header + lane array + per-thread (rings + metadata) + overflow
+    ThreadRegistryGeometry g = ada::internal::ThreadRegistry::normalize_geometry(geometry);
     size_t header = sizeof(ada::internal::ThreadRegistry);
     size_t lanes = (size_t)capacity * sizeof(ada::internal::ThreadLaneSet);
-    size_t per_thread_rings = (size_t)RINGS_PER_INDEX_LANE * 64 * 1024 +
-                              (size_t)RINGS_PER_DETAIL_LANE * 256 * 1024;
-    size_t per_thread_meta = sizeof(ada::internal::LaneMemoryLayout) * 2;
     // Account for page alignment after lanes (~ worst case add one page)
     size_t align_slack = 4096;
-    // Add extra buffer for alignment overhead during allocation
-    // Each ring buffer is page-aligned (4KB), so worst case we waste up to 4KB per ring
-    size_t per_thread_alignment_overhead = (size_t)(RINGS_PER_INDEX_LANE + RINGS_PER_DETAIL_LANE) * 4096;
-    return header + lanes + align_slack + (size_t)capacity * (per_thread_rings + per_thread_meta + per_thread_alignment_overhead);
+    // Pages of slack for the overflow segment's carve-out and alignment
+    size_t overflow = g.overflow_bytes ? (size_t)g.overflow_bytes + 2 * 4096 : 0;
+    return header + lanes + align_slack +
+           (size_t)capacity * (size_t)ada::internal::ThreadRegistry::slot_pool_bytes(g) + overflow;
 }
 
 // Lane accessor functions for opaque ThreadLaneSet
@@ -500,6 +606,22 @@ Lane* thread_lanes_get_detail_lane(ThreadLaneSet* lanes) {
     return reinterpret_cast<Lane*>(&cpp_lanes->detail_lane);
 }
 
+AggregateTable* thread_registry_attach_aggregates(ThreadRegistry* registry, uint32_t slot) {
+    if (!registry) return nullptr;
+    return reinterpret_cast<ada::internal::ThreadRegistry*>(registry)->attach_aggregates(slot);
+}
+
+AggregateTable* thread_registry_get_aggregates(ThreadRegistry* registry, uint32_t slot) {
+    if (!registry) return nullptr;
+    auto* cpp_registry = reinterpret_cast<ada::internal::ThreadRegistry*>(registry);
+    if (slot >= cpp_registry->get_capacity()) return nullptr;
+    uint8_t* reg_base = reinterpret_cast<uint8_t*>(cpp_registry);
+    auto* lanes = reinterpret_cast<ada::internal::ThreadLaneSet*>(reg_base + cpp_registry->lanes_off);
+    uint64_t off = __atomic_load_n(&lanes[slot].aggregate_off, __ATOMIC_ACQUIRE);
+    if (off == 0) return nullptr;
+    return reinterpret_cast<AggregateTable*>(reg_base + cpp_registry->segments[0].base_offset + off);
+}
+
 ada_thread_metrics_t* thread_lanes_get_metrics(ThreadLaneSet* lanes) {
     if (!lanes) return nullptr;
     auto* cpp_lanes = reinterpret_cast<ada::internal::ThreadLaneSet*>(lanes);
@@ -512,6 +634,12 @@ uint32_t thread_lanes_get_slot_index(ThreadLaneSet* lanes) {
     return cpp_lanes->slot_index;
 }
 
+uint32_t thread_lanes_get_stream_id(ThreadLaneSet* lanes) {
+    if (!lanes) return 0;
+    auto* cpp_lanes = reinterpret_cast<ada::internal::ThreadLaneSet*>(lanes);
+    return cpp_lanes->stream_id;
+}
+
 uint64_t thread_lanes_get_thread_id(ThreadLaneSet* lanes) {
     if (!lanes) return 0;
     auto* cpp_lanes = reinterpret_cast<ada::internal::ThreadLaneSet*>(lanes);
@@ -542,6 +670,24 @@ uint32_t thread_registry_get_capacity(ThreadRegistry* registry) {
     return cpp_registry->get_capacity();
 }
 
+uint64_t thread_registry_get_active_mask(ThreadRegistry* registry) {
+    if (!registry) return 0;
+    auto* cpp_registry = reinterpret_cast<ada::internal::ThreadRegistry*>(registry);
+    return cpp_registry->slot_words[0].load(std::memory_order_acquire);
+}
+
+uint32_t thread_registry_next_active_slot(ThreadRegistry* registry, uint32_t from) {
+    if (!registry) return UINT32_MAX;
+    auto* cpp_registry = reinterpret_cast<ada::internal::ThreadRegistry*>(registry);
+    return cpp_registry->next_claimed_slot(from);
+}
+
+uint64_t thread_registry_get_slot_generation(ThreadRegistry* registry) {
+    if (!registry) return 0;
+    auto* cpp_registry = reinterpret_cast<ada::internal::ThreadRegistry*>(registry);
+    return cpp_registry->slot_generation.load(std::memory_order_acquire);
+}
+
 // Standalone lane initializer for tests/benchmarks
 bool lane_init(Lane* lane,
                void* ring_memory,
@@ -2,12 +2,15 @@
 #define THREAD_REGISTRY_PRIVATE_H
 
 #include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
 #include <new>
 #include <tracer_backend/utils/tracer_types.h>
 #include <tracer_backend/utils/ring_buffer.h>
+#include <tracer_backend/utils/aggregate_table.h>
+#include <tracer_backend/utils/thread_registry.h>
 // Need private definitions for concrete implementation
 #include "tracer_types_private.h"
 #include <tracer_backend/ada/thread.h>
@@ -53,10 +56,16 @@ struct LaneMemoryLayout {
         printf("  free_queue:   %p - %p\n", free_queue, free_queue + QUEUE_COUNT_INDEX_LANE);
     }
     
-    // Descriptors for rings (parallel to ring_ptrs). For now we fill for the active lane count.
-    RingDescriptor ring_descs[RINGS_PER_INDEX_LANE];
+    // Descriptors for rings (parallel to ring_ptrs); the first Lane::ring_count are valid.
+    // Grown rings live in the overflow segment, hence the per-ring segment id.
+    RingDescriptor ring_descs[RINGS_PER_LANE_MAX];
 };
 
+static_assert(RINGS_PER_LANE_MAX == LANE_VIEW_MAX_RINGS, "LaneView must cover every ring of a lane");
+// Lane queues wrap their positions by mask
+static_assert((QUEUE_COUNT_INDEX_LANE & (QUEUE_COUNT_INDEX_LANE - 1)) == 0, "queue capacity must be a power of two");
+static_assert((QUEUE_COUNT_DETAIL_LANE & (QUEUE_COUNT_DETAIL_LANE - 1)) == 0, "queue capacity must be a power of two");
+
 // Segment info for multi-segment design
 enum : uint8_t {
     SEGMENT_KIND_INDEX   = 1,
@@ -64,6 +73,12 @@ enum : uint8_t {
     SEGMENT_KIND_OVERFLOW = 3,
 };
 
+// Which of its lane set's two lanes a Lane is
+enum : uint32_t {
+    LANE_KIND_INDEX  = 0,
+    LANE_KIND_DETAIL = 1,
+};
+
 struct SegmentInfo {
     uint32_t id;           // Unique id (>=1)
     uint8_t  kind;         // Index/Detail/Overflow
@@ -84,9 +99,10 @@ public:
     // Ring pool management
     std::atomic<uint32_t> active_idx{0};
     uint32_t ring_count{0};
-    // Queue capacities (modulo bases)
+    // Queue capacities (powers of two; positions wrap by capacity - 1)
     uint32_t submit_capacity{QUEUE_COUNT_INDEX_LANE};
     uint32_t free_capacity{QUEUE_COUNT_INDEX_LANE};
+    uint32_t lane_kind{LANE_KIND_INDEX};
     
     // SPSC queues with proper atomics
     std::atomic<uint32_t> submit_head{0};
@@ -120,6 +136,9 @@ public:
     
     // Submit ring for draining (with bounds checking)
     bool submit_ring(uint32_t ring_idx);
+
+    // Lane set this lane belongs to
+    ThreadLaneSet* owner();
     
     // Get active ring buffer
     void* get_active_ring() { return nullptr; }
@@ -143,13 +162,21 @@ public:
     // Thread identification
     uintptr_t thread_id{0};
     uint32_t slot_index{0};
+    // ATF thread id of the current registration: slot_index on the slot's
+    // first use, capacity + n for the n-th reuse of any reclaimed slot
+    uint32_t stream_id{0};
     std::atomic<bool> active{false};
+    // 0 while the thread lives; after exit, the reclaim epoch it retired in.
+    // A retiring slot stays active so the drain can empty it.
+    std::atomic<uint64_t> retire_epoch{0};
 
     // Offsets to lane memory layouts within the unified SHM pool (prototype for offsets-only SHM)
     // These are relative to the segment base (segments[seg_id-1].base_offset) and can be
     // materialized as: reg_base + segment.base_offset + layout_off
     uint64_t index_layout_off{0};
     uint64_t detail_layout_off{0};
+    // Aggregation lane (AggregateTable) in the same pool; 0 = not allocated
+    uint64_t aggregate_off{0};
     
     // Lanes with structured memory
     Lane index_lane;
@@ -163,15 +190,20 @@ public:
     // Initialize with structured memory blocks
     void initialize(uintptr_t tid, uint32_t slot,
                    LaneMemoryLayout* index_memory,
-                   LaneMemoryLayout* detail_memory) {
+                   LaneMemoryLayout* detail_memory,
+                   const uint32_t ring_counts[2],
+                   const uint32_t ring_bytes[2]) {
         if (needs_log_thread_registry_registry) printf("DEBUG: ThreadLaneSet::initialize start - tid=%lx, slot=%u\n", tid, slot);
         thread_id = tid;
         slot_index = slot;
+        stream_id = slot;
+        index_lane.lane_kind = LANE_KIND_INDEX;
+        detail_lane.lane_kind = LANE_KIND_DETAIL;
         
         if (needs_log_thread_registry_registry) printf("DEBUG: Initializing index_lane\n");
-        index_lane.initialize(index_memory, RINGS_PER_INDEX_LANE, 64 * 1024, sizeof(IndexEvent), QUEUE_COUNT_INDEX_LANE);
+        index_lane.initialize(index_memory, ring_counts[0], ring_bytes[0], sizeof(IndexEvent), QUEUE_COUNT_INDEX_LANE);
         if (needs_log_thread_registry_registry) printf("DEBUG: Initializing detail_lane\n");
-        detail_lane.initialize(detail_memory, RINGS_PER_DETAIL_LANE, 256 * 1024, sizeof(DetailEvent), QUEUE_COUNT_DETAIL_LANE);
+        detail_lane.initialize(detail_memory, ring_counts[1], ring_bytes[1], DETAIL_RECORD_ALIGN, QUEUE_COUNT_DETAIL_LANE);
         index_lane.marked_event_seen.store(false, std::memory_order_relaxed);
         detail_lane.marked_event_seen.store(false, std::memory_order_relaxed);
 
@@ -194,6 +226,13 @@ public:
     }
 };
 
+// Both lanes sit at fixed offsets in their lane set, so the kind alone finds it
+inline ThreadLaneSet* Lane::owner() {
+    size_t off = lane_kind == LANE_KIND_DETAIL ? offsetof(ThreadLaneSet, detail_lane)
+                                               : offsetof(ThreadLaneSet, index_lane);
+    return reinterpret_cast<ThreadLaneSet*>(reinterpret_cast<uint8_t*>(this) - off);
+}
+
 // ============================================================================
 // ThreadRegistry with CRTP-style tail allocation
 // ============================================================================
@@ -207,20 +246,80 @@ public:
     std::atomic<uint32_t> thread_count{0};
     std::atomic<bool> accepting_registrations{true};
     std::atomic<bool> shutdown_requested{false};
-    // Active slot mask: bit i = slot i active (capacity <= 64)
-    std::atomic<uint64_t> active_mask{0};
     uint32_t capacity_{MAX_THREADS};
-    // Multi-segment table (epoched)
+    // Two-level slot bitmap: bit i of slot_words[w] = slot 64*w+i claimed;
+    // bit w of full_words = word w had no free slot when last checked (a hint,
+    // re-validated before it is trusted). slot_generation moves on every claim
+    // and release so readers can cache views derived from the bitmap.
+    std::atomic<uint64_t> full_words{0};
+    std::atomic<uint64_t> slot_generation{0};
+    std::atomic<uint64_t> slot_words[THREAD_REGISTRY_SLOT_WORDS]{};
+    // Multi-segment table (epoched; LaneViews are rebuilt when it moves)
     std::atomic<uint32_t> segment_count{0};
     std::atomic<uint32_t> epoch{0};
     // Keep small, enough for base + a few overflow pools
     SegmentInfo segments[8]{};
+    // Slot reclamation: the drain advances reclaim_epoch once per cycle; a
+    // retired slot is recycled only after a cycle that began after its exit
+    std::atomic<uint64_t> reclaim_epoch{0};
+    std::atomic<uint64_t> slots_reclaimed{0};
+    std::atomic<uint64_t> slots_reused{0};
+    // Ring geometry per lane kind (0 = index, 1 = detail), fixed at creation
+    uint32_t ring_counts[2]{};
+    uint32_t ring_bytes[2]{};
+    // Segment lanes grow into under pressure; 0 = growth disabled
+    uint32_t overflow_segment_id{0};
+    std::atomic<uint64_t> rings_grown{0};
+    std::atomic<uint64_t> ring_growth_denied{0};
     
     // Thread lane sets offset from registry base (SHM-portable)
     uint64_t lanes_off{0};
     
+    static constexpr uint32_t kMagic = 0x41544152; // 'ATAR' (ADA Thread ARchive marker)
+    static constexpr uint32_t kVersion = 3;         // 3: per-lane ring geometry, overflow segment
+
+    // Requested geometry clamped to what the layout supports; zero fields
+    // take the defaults
+    static ThreadRegistryGeometry normalize_geometry(const ThreadRegistryGeometry* requested) {
+        ThreadRegistryGeometry g{};
+        if (requested) g = *requested;
+        auto ring_size = [](uint32_t bytes, uint32_t fallback) -> uint32_t {
+            if (bytes == 0) return fallback;
+            uint32_t size = 4096;
+            while (size < bytes && size < (16u << 20)) size <<= 1;
+            return size;
+        };
+        auto ring_count = [](uint32_t count, uint32_t fallback) -> uint32_t {
+            if (count == 0) return fallback;
+            if (count < 2) return 2;
+            return count > RINGS_PER_LANE_MAX ? RINGS_PER_LANE_MAX : count;
+        };
+        g.index_ring_bytes = ring_size(g.index_ring_bytes, INDEX_RING_BYTES);
+        g.index_ring_count = ring_count(g.index_ring_count, RINGS_PER_INDEX_LANE);
+        g.detail_ring_bytes = ring_size(g.detail_ring_bytes, DETAIL_RING_BYTES);
+        g.detail_ring_count = ring_count(g.detail_ring_count, RINGS_PER_DETAIL_LANE);
+        g.overflow_bytes &= ~(uint64_t)4095;
+        return g;
+    }
+
+    // Pool bytes one slot takes at registration: lane layouts, initial rings,
+    // aggregation lane, plus up to a page of alignment waste per allocation
+    static uint64_t slot_pool_bytes(const ThreadRegistryGeometry& g) {
+        uint64_t layout = (sizeof(LaneMemoryLayout) + (CACHE_LINE_SIZE - 1)) & ~(uint64_t)(CACHE_LINE_SIZE - 1);
+        return 2 * layout +
+               (uint64_t)g.index_ring_count * g.index_ring_bytes +
+               (uint64_t)g.detail_ring_count * g.detail_ring_bytes +
+               aggregate_table_bytes(AGGREGATE_TABLE_CAPACITY) +
+               (uint64_t)(g.index_ring_count + g.detail_ring_count + 1) * 4096;
+    }
+
     // Factory method for creating with proper memory layout
-    static ThreadRegistry* create(void* memory, size_t size, uint32_t capacity) {
+    static ThreadRegistry* create(void* memory, size_t size, uint32_t capacity,
+                                  const ThreadRegistryGeometry* geometry = nullptr) {
+        if (capacity > THREAD_REGISTRY_MAX_CAPACITY) {
+            fprintf(stderr, "Registry capacity %u exceeds %u\n", capacity, THREAD_REGISTRY_MAX_CAPACITY);
+            return nullptr;
+        }
         // Place lane set array after the header, cache-line aligned
         uint8_t* base_ptr = static_cast<uint8_t*>(memory);
         size_t lanes_off = (sizeof(ThreadRegistry) + (CACHE_LINE_SIZE - 1)) & ~(size_t)(CACHE_LINE_SIZE - 1);
@@ -234,25 +333,52 @@ public:
         }
         size_t ring_memory_total = size - ring_off;
         
-        // Placement new with clear memory
-        std::memset(memory, 0, size);
+        // Placement new with clear header and lane sets. The ring pool is left
+        // untouched: everything carved from it is initialized on allocation, so
+        // a large capacity costs address space, not resident pages.
+        std::memset(memory, 0, ring_off);
         auto* registry = new (memory) ThreadRegistry();
         // Initialize header markers
-        registry->magic = 0x41544152; // 'ATAR' (ADA Thread ARchive marker)
-        registry->version = 1;
+        registry->magic = kMagic;
+        registry->version = kVersion;
         registry->capacity_ = capacity;
         registry->lanes_off = (uint64_t)lanes_off;
+        ThreadRegistryGeometry g = normalize_geometry(geometry);
+        registry->ring_counts[0] = g.index_ring_count;
+        registry->ring_counts[1] = g.detail_ring_count;
+        registry->ring_bytes[0] = g.index_ring_bytes;
+        registry->ring_bytes[1] = g.detail_ring_bytes;
         
         // Calculate where ring buffer memory starts (after all structures)
         uint8_t* ring_memory_start = base_ptr + ring_off;
         // Initialize segment table with one unified local pool
         registry->segment_count.store(1, std::memory_order_release);
         registry->epoch.store(1, std::memory_order_release);
+        registry->reclaim_epoch.store(1, std::memory_order_release);
         registry->segments[0].id = 1;
         registry->segments[0].kind = SEGMENT_KIND_OVERFLOW; // unified pool
         registry->segments[0].size = ring_memory_total;
         registry->segments[0].base_offset = (uint64_t)(ring_memory_start - static_cast<uint8_t*>(memory));
         std::snprintf(registry->segments[0].name, sizeof(registry->segments[0].name), "local:pool");
+
+        // Overflow segment at the pool's end, carved only from what every
+        // slot's initial rings leave spare (less a page for alignment)
+        uint64_t slots_need = (uint64_t)capacity * slot_pool_bytes(g);
+        uint64_t spare = ring_memory_total > slots_need + 4096 ? ring_memory_total - slots_need - 4096 : 0;
+        uint64_t overflow = (g.overflow_bytes < spare ? g.overflow_bytes : spare) & ~(uint64_t)4095;
+        uint32_t smallest_ring = g.index_ring_bytes < g.detail_ring_bytes ? g.index_ring_bytes : g.detail_ring_bytes;
+        if (overflow >= smallest_ring) {
+            uint64_t pool_end = registry->segments[0].base_offset + ring_memory_total;
+            uint64_t overflow_base = (pool_end - overflow) & ~(uint64_t)4095;
+            registry->segments[0].size = overflow_base - registry->segments[0].base_offset;
+            registry->segments[1].id = 2;
+            registry->segments[1].kind = SEGMENT_KIND_OVERFLOW;
+            registry->segments[1].size = pool_end - overflow_base;
+            registry->segments[1].base_offset = overflow_base;
+            std::snprintf(registry->segments[1].name, sizeof(registry->segments[1].name), "local:overflow");
+            registry->overflow_segment_id = 2;
+            registry->segment_count.store(2, std::memory_order_release);
+        }
         
         // Initialize each thread slot (lane layouts will be allocated lazily at registration)
         for (uint32_t i = 0; i < capacity; ++i) {
@@ -262,6 +388,7 @@ public:
             // Zero-initialize the lane set storage
             std::memset(lane_set, 0, sizeof(ThreadLaneSet));
             lane_set->slot_index = i;
+            lane_set->detail_lane.lane_kind = LANE_KIND_DETAIL;
             lane_set->thread_id = 0;
             lane_set->active.store(false);
             // Lane layouts will be assigned on registration (offsets only)
@@ -270,6 +397,33 @@ public:
         return registry;
     }
     
+    // Aggregation lane of slot, allocated from the pool on first use by the
+    // slot's owning thread so registration stays cheap. A table outlives its
+    // thread, so a reused slot keeps accumulating into the same totals.
+    AggregateTable* attach_aggregates(uint32_t slot) {
+        if (slot >= capacity_) return nullptr;
+        uint8_t* base = reinterpret_cast<uint8_t*>(this);
+        auto* thread_lanes = reinterpret_cast<ThreadLaneSet*>(base + lanes_off);
+        uint8_t* pool_base = base + segments[0].base_offset;
+        uint64_t off = __atomic_load_n(&thread_lanes[slot].aggregate_off, __ATOMIC_ACQUIRE);
+        if (off == 0) {
+            size_t bytes = aggregate_table_bytes(AGGREGATE_TABLE_CAPACITY);
+            uint64_t cur = segments[0].used.load(std::memory_order_relaxed);
+            for (;;) {
+                uint64_t aligned = (cur + 4095) & ~(uint64_t)4095;
+                if (aligned == 0) aligned = 4096; // Offset 0 means "no table"
+                if (aligned + bytes > segments[0].size) return nullptr;
+                if (segments[0].used.compare_exchange_weak(cur, aligned + bytes, std::memory_order_acq_rel)) {
+                    off = aligned;
+                    break;
+                }
+            }
+            aggregate_table_init(pool_base + off, AGGREGATE_TABLE_CAPACITY);
+            __atomic_store_n(&thread_lanes[slot].aggregate_off, off, __ATOMIC_RELEASE);
+        }
+        return reinterpret_cast<AggregateTable*>(pool_base + off);
+    }
+
     // Register thread with better error handling
     ThreadLaneSet* register_thread(uintptr_t thread_id) {
         if (!accepting_registrations.load(std::memory_order_acquire)) {
@@ -277,40 +431,22 @@ public:
             return nullptr;
         }
 
-        // Try to find existing registration (scan active slots)
+        // Try to find existing registration (scan claimed slots)
         auto* thread_lanes = reinterpret_cast<ThreadLaneSet*>(reinterpret_cast<uint8_t*>(this) + lanes_off);
-        for (uint32_t i = 0; i < capacity_; ++i) {
+        for (uint32_t i = next_claimed_slot(0); i != UINT32_MAX; i = next_claimed_slot(i + 1)) {
             if (thread_lanes[i].thread_id == thread_id &&
-                thread_lanes[i].active.load()) {
+                thread_lanes[i].active.load() &&
+                thread_lanes[i].retire_epoch.load(std::memory_order_acquire) == 0) {
                 if (needs_log_thread_registry_registry) printf("DEBUG: Thread %lx already registered at slot %u\n", thread_id, i);
                 return &thread_lanes[i];  // Already registered
             }
         }
         
-        // Allocate new slot via CAS on active_mask
-        uint32_t slot = UINT32_MAX;
-        while (true) {
-            uint64_t mask = active_mask.load(std::memory_order_acquire);
-            // Quick check: if all low capacity_ bits are set, full
-            if (capacity_ >= 64 && mask == UINT64_MAX) {
-                if (needs_log_thread_registry_registry) printf("DEBUG: Out of slots (mask full)\n");
-                return nullptr;
-            }
-            // Find first free slot
-            uint32_t candidate = UINT32_MAX;
-            for (uint32_t i = 0; i < capacity_; ++i) {
-                if (((mask >> i) & 1ull) == 0ull) { candidate = i; break; }
-            }
-            if (candidate == UINT32_MAX) {
-                if (needs_log_thread_registry_registry) printf("DEBUG: No free slot found up to capacity=%u (mask=0x%llx)\n", capacity_, (unsigned long long)mask);
-                return nullptr;
-            }
-            uint64_t new_mask = mask | (1ull << candidate);
-            if (active_mask.compare_exchange_weak(mask, new_mask, std::memory_order_acq_rel, std::memory_order_acquire)) {
-                slot = candidate;
-                break;
-            }
-            // CAS failed, retry with updated mask
+        // Claim a slot from the bitmap
+        uint32_t slot = claim_slot();
+        if (slot == UINT32_MAX) {
+            if (needs_log_thread_registry_registry) printf("DEBUG: No free slot up to capacity=%u\n", capacity_);
+            return nullptr;
         }
         thread_count.fetch_add(1, std::memory_order_acq_rel);
         if (needs_log_thread_registry_registry) printf("DEBUG: Allocated slot %u for thread %lx (capacity=%u)\n", slot, thread_id, capacity_);
@@ -320,26 +456,11 @@ public:
             // Resolve segment bases
             uint8_t* base = reinterpret_cast<uint8_t*>(this);
             uint8_t* pool_base = base + segments[0].base_offset; // unified pool id=1
-            // Helper lambda: allocate from segment with alignment
-            auto alloc_from = [](std::atomic<uint64_t>& used, uint64_t size, uint64_t seg_size, uint32_t align) -> uint64_t {
-                uint64_t cur = used.load(std::memory_order_relaxed);
-                for (;;) {
-                    uint64_t aligned = (cur + (align - 1)) & ~(uint64_t)(align - 1);
-                    uint64_t next = aligned + size;
-                    if (next > seg_size) return UINT64_MAX;
-                    if (used.compare_exchange_weak(cur, next, std::memory_order_acq_rel)) {
-                        return aligned;
-                    }
-                    // CAS failed; cur updated, retry
-                }
-            };
             // Allocate lane layouts from unified pool
             uint64_t idx_layout_off = alloc_from(segments[0].used, sizeof(LaneMemoryLayout), segments[0].size, CACHE_LINE_SIZE);
             if (idx_layout_off == UINT64_MAX) {
                 thread_count.fetch_sub(1, std::memory_order_acq_rel);
-                // Clear the bit from active_mask to free the slot
-                uint64_t bit = 1ull << slot;
-                active_mask.fetch_and(~bit, std::memory_order_acq_rel);
+                release_slot(slot);
                 if (needs_log_thread_registry_registry) printf("DEBUG: Out of metadata memory while registering thread %lx (index layout)\n", thread_id);
                 return nullptr;
             }
@@ -349,56 +470,50 @@ public:
             uint64_t det_layout_off = alloc_from(segments[0].used, sizeof(LaneMemoryLayout), segments[0].size, CACHE_LINE_SIZE);
             if (det_layout_off == UINT64_MAX) {
                 thread_count.fetch_sub(1, std::memory_order_acq_rel);
-                // Clear the bit from active_mask to free the slot
-                uint64_t bit = 1ull << slot;
-                active_mask.fetch_and(~bit, std::memory_order_acq_rel);
+                release_slot(slot);
                 if (needs_log_thread_registry_registry) printf("DEBUG: Out of metadata memory while registering thread %lx (detail layout)\n", thread_id);
                 return nullptr;
             }
             auto* det_layout = reinterpret_cast<LaneMemoryLayout*>(pool_base + det_layout_off);
             std::memset(det_layout, 0, sizeof(LaneMemoryLayout));
             // Allocate index rings (from unified pool segment[0])
-            for (uint32_t j = 0; j < RINGS_PER_INDEX_LANE; ++j) {
-                uint64_t off = alloc_from(segments[0].used, 64 * 1024, segments[0].size, 4096);
+            for (uint32_t j = 0; j < ring_counts[0]; ++j) {
+                uint64_t off = alloc_from(segments[0].used, ring_bytes[0], segments[0].size, 4096);
                 if (off == UINT64_MAX) {
                     // Out of ring memory
                     thread_count.fetch_sub(1, std::memory_order_acq_rel);
-                    // Clear the bit from active_mask to free the slot
-                    uint64_t bit = 1ull << slot;
-                    active_mask.fetch_and(~bit, std::memory_order_acq_rel);
+                    release_slot(slot);
                     if (needs_log_thread_registry_registry) printf("DEBUG: Out of index ring memory while registering thread %lx\n", thread_id);
                     return nullptr;
                 }
                 idx_layout->ring_descs[j].segment_id = 1;
-                idx_layout->ring_descs[j].bytes = 64 * 1024;
+                idx_layout->ring_descs[j].bytes = ring_bytes[0];
                 idx_layout->ring_descs[j].offset = off;
                 // Initialize ring header in-place using temporary handle
-                ::RingBuffer* tmp = ring_buffer_create(pool_base + off, 64 * 1024, sizeof(IndexEvent));
+                ::RingBuffer* tmp = ring_buffer_create(pool_base + off, ring_bytes[0], sizeof(IndexEvent));
                 if (tmp) ring_buffer_destroy(tmp);
             }
             // Initialize index free queue with all rings except active (0)
-            for (uint32_t j = 1; j < RINGS_PER_INDEX_LANE; ++j) {
+            for (uint32_t j = 1; j < ring_counts[0]; ++j) {
                 idx_layout->free_queue[j - 1] = j;
             }
             // Allocate detail rings (from unified pool segment[0])
-            for (uint32_t j = 0; j < RINGS_PER_DETAIL_LANE; ++j) {
-                uint64_t off = alloc_from(segments[0].used, 256 * 1024, segments[0].size, 4096);
+            for (uint32_t j = 0; j < ring_counts[1]; ++j) {
+                uint64_t off = alloc_from(segments[0].used, ring_bytes[1], segments[0].size, 4096);
                 if (off == UINT64_MAX) {
                     thread_count.fetch_sub(1, std::memory_order_acq_rel);
-                    // Clear the bit from active_mask to free the slot
-                    uint64_t bit = 1ull << slot;
-                    active_mask.fetch_and(~bit, std::memory_order_acq_rel);
+                    release_slot(slot);
                     if (needs_log_thread_registry_registry) printf("DEBUG: Out of detail ring memory while registering thread %lx\n", thread_id);
                     return nullptr;
                 }
                 det_layout->ring_descs[j].segment_id = 1;
-                det_layout->ring_descs[j].bytes = 256 * 1024;
+                det_layout->ring_descs[j].bytes = ring_bytes[1];
                 det_layout->ring_descs[j].offset = off;
-                ::RingBuffer* tmp = ring_buffer_create(pool_base + off, 256 * 1024, sizeof(DetailEvent));
+                ::RingBuffer* tmp = ring_buffer_create(pool_base + off, ring_bytes[1], DETAIL_RECORD_ALIGN);
                 if (tmp) ring_buffer_destroy(tmp);
             }
             // Initialize detail free queue with all rings except active (0)
-            for (uint32_t j = 1; j < RINGS_PER_DETAIL_LANE; ++j) {
+            for (uint32_t j = 1; j < ring_counts[1]; ++j) {
                 det_layout->free_queue[j - 1] = j;
             }
             
@@ -410,18 +525,97 @@ public:
                 thread_id, 
                 slot,
                 idx_layout,
-                det_layout
+                det_layout,
+                ring_counts,
+                ring_bytes
             );
         } else {
+            // Reclaimed slot: its layouts and rings are reused as-is
             thread_lanes[slot].thread_id = thread_id;
-            thread_lanes[slot].active.store(true, std::memory_order_release);
+            thread_lanes[slot].stream_id =
+                capacity_ + static_cast<uint32_t>(slots_reused.fetch_add(1, std::memory_order_relaxed));
             ada_thread_metrics_init(&thread_lanes[slot].metrics, thread_id, slot);
+            thread_lanes[slot].active.store(true, std::memory_order_release);
         }
         
         if (needs_log_thread_registry_registry) { printf("DEBUG: Returning thread_lanes[%u] at %p\n", slot, &thread_lanes[slot]); fflush(stdout); }
         return &thread_lanes[slot];
     }
     
+    // Thread exit: the slot stops counting as live but stays visible to the
+    // drain until reclaim_slot() finds its lanes empty. False if the lanes are
+    // not live.
+    bool retire_thread(ThreadLaneSet* lanes) {
+        if (!lanes->active.load(std::memory_order_acquire)) return false;
+        uint64_t expected = 0;
+        if (!lanes->retire_epoch.compare_exchange_strong(expected,
+                                                         reclaim_epoch.load(std::memory_order_acquire),
+                                                         std::memory_order_acq_rel)) {
+            return false; // Already retiring
+        }
+        thread_count.fetch_sub(1, std::memory_order_acq_rel);
+        return true;
+    }
+
+    uint64_t advance_reclaim_epoch() {
+        return reclaim_epoch.fetch_add(1, std::memory_order_acq_rel) + 1;
+    }
+
+    // Recycle a retired slot once a full drain cycle has started since the
+    // exit (publishes from the thread's teardown are visible by then) and no
+    // submitted rings remain. Called by the slot's current drainer only.
+    bool reclaim_slot(uint32_t slot) {
+        if (slot >= capacity_) return false;
+        auto* thread_lanes = reinterpret_cast<ThreadLaneSet*>(reinterpret_cast<uint8_t*>(this) + lanes_off);
+        ThreadLaneSet& lanes = thread_lanes[slot];
+        uint64_t retired = lanes.retire_epoch.load(std::memory_order_acquire);
+        if (retired == 0 || !lanes.active.load(std::memory_order_acquire)) return false;
+        if (reclaim_epoch.load(std::memory_order_acquire) < retired + 2) return false;
+        if (lanes.index_lane.submit_head.load(std::memory_order_acquire) !=
+                lanes.index_lane.submit_tail.load(std::memory_order_acquire) ||
+            lanes.detail_lane.submit_head.load(std::memory_order_acquire) !=
+                lanes.detail_lane.submit_tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        lanes.active.store(false, std::memory_order_release);
+        discard_unread(lanes.index_layout_off, __atomic_load_n(&lanes.index_lane.ring_count, __ATOMIC_ACQUIRE));
+        discard_unread(lanes.detail_layout_off, __atomic_load_n(&lanes.detail_lane.ring_count, __ATOMIC_ACQUIRE));
+        lanes.retire_epoch.store(0, std::memory_order_release);
+        if (!release_slot(slot)) return false;
+        slots_reclaimed.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Append one overflow ring to a lane; called by the lane's producer only,
+    // which is the sole writer of ring_count. The descriptor is published
+    // before the count, and the drain first meets the ring through a submit.
+    uint32_t grow_lane(ThreadLaneSet* lanes, int lane_type) {
+        if (overflow_segment_id == 0 || (lane_type != 0 && lane_type != 1)) return UINT32_MAX;
+        Lane& lane = lane_type == 0 ? lanes->index_lane : lanes->detail_lane;
+        uint64_t layout_off = lane_type == 0 ? lanes->index_layout_off : lanes->detail_layout_off;
+        uint32_t count = lane.ring_count;
+        SegmentInfo& seg = segments[overflow_segment_id - 1];
+        uint64_t off = count < RINGS_PER_LANE_MAX
+            ? alloc_from(seg.used, ring_bytes[lane_type], seg.size, 4096)
+            : UINT64_MAX;
+        if (off == UINT64_MAX) {
+            ring_growth_denied.fetch_add(1, std::memory_order_relaxed);
+            return UINT32_MAX;
+        }
+        uint8_t* base = reinterpret_cast<uint8_t*>(this);
+        ::RingBuffer* tmp = ring_buffer_create(base + seg.base_offset + off, ring_bytes[lane_type],
+                                               lane_type == 0 ? sizeof(IndexEvent) : DETAIL_RECORD_ALIGN);
+        if (tmp) ring_buffer_destroy(tmp);
+        auto* layout = reinterpret_cast<LaneMemoryLayout*>(base + segments[0].base_offset + layout_off);
+        layout->ring_descs[count].segment_id = seg.id;
+        layout->ring_descs[count].bytes = ring_bytes[lane_type];
+        layout->ring_descs[count].offset = off;
+        __atomic_store_n(&lane.ring_count, count + 1, __ATOMIC_RELEASE);
+        rings_grown.fetch_add(1, std::memory_order_relaxed);
+        return count;
+    }
+
     // Debug dump - actually useful!
     void debug_dump() const {
         printf("=== ThreadRegistry Debug Dump ===\n");
@@ -440,7 +634,7 @@ public:
         }
         
         auto* thread_lanes = reinterpret_cast<const ThreadLaneSet*>(reinterpret_cast<const uint8_t*>(this) + lanes_off);
-        for (uint32_t i = 0; i < thread_count.load(); ++i) {
+        for (uint32_t i = next_claimed_slot(0); i != UINT32_MAX; i = next_claimed_slot(i + 1)) {
             if (thread_lanes[i].active.load()) {
                 thread_lanes[i].debug_print();
             }
@@ -456,7 +650,7 @@ public:
             return false;
         }
         // Check markers
-        if (magic != 0x41544152 || version != 1) {
+        if (magic != kMagic || version != kVersion) {
             fprintf(stderr, "Registry magic/version invalid (magic=0x%x version=%u)\n", magic, version);
             return false;
         }
@@ -474,8 +668,127 @@ public:
         return true;
     }
     
+    // Claim the lowest free slot of the first word not hinted full. Lock-free;
+    // O(1) unless every word is hinted full, which costs one re-validation pass.
+    // Returns UINT32_MAX when every slot is claimed.
+    uint32_t claim_slot() {
+        const uint32_t words = slot_word_count();
+        const uint64_t all_words = words >= 64 ? ~0ull : ((1ull << words) - 1);
+        for (;;) {
+            uint64_t open = ~full_words.load(std::memory_order_acquire) & all_words;
+            if (open == 0) {
+                if (!clear_stale_full_hints()) return UINT32_MAX;
+                continue;
+            }
+            uint32_t w = (uint32_t)__builtin_ctzll(open);
+            uint64_t limit = slot_word_limit(w);
+            uint64_t cur = slot_words[w].load(std::memory_order_acquire);
+            for (;;) {
+                uint64_t free_bits = ~cur & limit;
+                if (free_bits == 0) {
+                    mark_word_full(w, limit);
+                    break;
+                }
+                uint64_t bit = free_bits & (~free_bits + 1);
+                if (slot_words[w].compare_exchange_weak(cur, cur | bit, std::memory_order_acq_rel,
+                                                        std::memory_order_acquire)) {
+                    if ((cur | bit) == limit) mark_word_full(w, limit);
+                    slot_generation.fetch_add(1, std::memory_order_release);
+                    return w * 64 + (uint32_t)__builtin_ctzll(bit);
+                }
+            }
+        }
+    }
+
+    // Returns false if the slot was not claimed
+    bool release_slot(uint32_t slot) {
+        if (slot >= capacity_) return false;
+        const uint32_t w = slot >> 6;
+        const uint64_t bit = 1ull << (slot & 63);
+        uint64_t prev = slot_words[w].fetch_and(~bit, std::memory_order_acq_rel);
+        if ((prev & bit) == 0) return false;
+        full_words.fetch_and(~(1ull << w), std::memory_order_seq_cst);
+        slot_generation.fetch_add(1, std::memory_order_release);
+        return true;
+    }
+
+    // First claimed slot >= from, or UINT32_MAX
+    uint32_t next_claimed_slot(uint32_t from) const {
+        if (from >= capacity_) return UINT32_MAX;
+        uint32_t w = from >> 6;
+        uint64_t bits = slot_words[w].load(std::memory_order_acquire) & (~0ull << (from & 63));
+        const uint32_t words = slot_word_count();
+        while (bits == 0) {
+            if (++w >= words) return UINT32_MAX;
+            bits = slot_words[w].load(std::memory_order_acquire);
+        }
+        return w * 64 + (uint32_t)__builtin_ctzll(bits);
+    }
+
+    uint32_t slot_word_count() const { return (capacity_ + 63) / 64; }
+
+    // Slot bits of word w that fall inside capacity
+    uint64_t slot_word_limit(uint32_t w) const {
+        uint32_t first = w * 64;
+        if (first >= capacity_) return 0;
+        uint32_t n = capacity_ - first;
+        return n >= 64 ? ~0ull : ((1ull << n) - 1);
+    }
+
     // Accessors
     uint32_t get_capacity() const;
+
+private:
+    // Bump-allocate size bytes at the given alignment from a segment
+    static uint64_t alloc_from(std::atomic<uint64_t>& used, uint64_t size, uint64_t seg_size, uint32_t align) {
+        uint64_t cur = used.load(std::memory_order_relaxed);
+        for (;;) {
+            uint64_t aligned = (cur + (align - 1)) & ~(uint64_t)(align - 1);
+            uint64_t next = aligned + size;
+            if (next > seg_size) return UINT64_MAX;
+            if (used.compare_exchange_weak(cur, next, std::memory_order_acq_rel)) {
+                return aligned;
+            }
+            // CAS failed; cur updated, retry
+        }
+    }
+
+    // Drop whatever a reclaimed slot's rings still hold (undrained leftovers
+    // when no session was writing), so the next thread starts empty
+    void discard_unread(uint64_t layout_off, uint32_t ring_count) {
+        uint8_t* base = reinterpret_cast<uint8_t*>(this);
+        auto* layout = reinterpret_cast<LaneMemoryLayout*>(base + segments[0].base_offset + layout_off);
+        for (uint32_t j = 0; j < ring_count; ++j) {
+            const auto& desc = layout->ring_descs[j];
+            if (desc.segment_id == 0 || desc.segment_id > segment_count.load(std::memory_order_acquire)) continue;
+            auto* header = reinterpret_cast<RingBufferHeader*>(base + segments[desc.segment_id - 1].base_offset + desc.offset);
+            uint32_t write_pos = __atomic_load_n(&header->write_pos, __ATOMIC_ACQUIRE);
+            header->cached_read_pos = write_pos;
+            header->cached_write_pos = write_pos;
+            __atomic_store_n(&header->read_pos, write_pos, __ATOMIC_RELEASE);
+        }
+    }
+
+    void mark_word_full(uint32_t w, uint64_t limit) {
+        full_words.fetch_or(1ull << w, std::memory_order_seq_cst);
+        // A release may have landed before the hint did
+        if ((slot_words[w].load(std::memory_order_seq_cst) & limit) != limit) {
+            full_words.fetch_and(~(1ull << w), std::memory_order_seq_cst);
+        }
+    }
+
+    // Drop full hints on words that have a free slot; false if none does
+    bool clear_stale_full_hints() {
+        bool any_free = false;
+        for (uint32_t w = 0; w < slot_word_count(); ++w) {
+            uint64_t limit = slot_word_limit(w);
+            if ((slot_words[w].load(std::memory_order_seq_cst) & limit) != limit) {
+                full_words.fetch_and(~(1ull << w), std::memory_order_seq_cst);
+                any_free = true;
+            }
+        }
+        return any_free;
+    }
 };
 
 // Public accessor for capacity from C layer
@@ -0,0 +1,146 @@
+#include <tracer_backend/utils/timestamp_source.h>
+
+#include <errno.h>
+#include <string.h>
+
+#if defined(__x86_64__)
+#include <cpuid.h>
+#endif
+
+// Counter/clock pairs are taken this many times; the tightest bracket wins
+#define TS_PAIR_ATTEMPTS 16
+// Fixed-point precision of mult when it fits
+#define TS_MULT_SHIFT 32u
+
+// Pair a counter value with CLOCK_MONOTONIC: the clock read is bracketed by two
+// counter reads and paired with their midpoint
+static void ts_sample_pair(uint64_t* ticks, uint64_t* ns) {
+    uint64_t best_window = UINT64_MAX;
+    for (int i = 0; i < TS_PAIR_ATTEMPTS; i++) {
+        uint64_t t0 = timestamp_source_counter();
+        uint64_t n = timestamp_source_monotonic_ns();
+        uint64_t t1 = timestamp_source_counter();
+        if (t1 - t0 < best_window) {
+            best_window = t1 - t0;
+            *ticks = t0 + (t1 - t0) / 2;
+            *ns = n;
+        }
+    }
+}
+
+// mult/shift for ns = (ticks * mult) >> shift, keeping mult within 63 bits
+static void ts_set_frequency(TimestampCalibration* cal, uint64_t ticks_per_sec) {
+    uint32_t shift = TS_MULT_SHIFT;
+    __uint128_t mult = ((__uint128_t)1000000000ull << shift) / ticks_per_sec;
+    while (shift > 0 && mult > (__uint128_t)INT64_MAX) {
+        shift--;
+        mult >>= 1;
+    }
+    cal->ticks_per_sec = ticks_per_sec;
+    cal->shift = shift;
+    cal->mult = (uint64_t)mult;
+}
+
+static void ts_set_monotonic(TimestampCalibration* out) {
+    memset(out, 0, sizeof(*out));
+    out->source = TIMESTAMP_SOURCE_MONOTONIC;
+    out->mult = 1;
+    out->ticks_per_sec = 1000000000ull;
+}
+
+// Frequency implied by two (ticks, ns) pairs; 0 when they are too close
+static uint64_t ts_frequency(uint64_t t0, uint64_t n0, uint64_t t1, uint64_t n1) {
+    if (t1 <= t0 || n1 <= n0) {
+        return 0; // LCOV_EXCL_LINE
+    }
+    return (uint64_t)(((__uint128_t)(t1 - t0) * 1000000000ull) / (n1 - n0));
+}
+
+bool timestamp_source_counter_usable(void) {
+#if defined(__x86_64__)
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(0x80000007u, &eax, &ebx, &ecx, &edx)) {
+        return false; // LCOV_EXCL_LINE
+    }
+    return (edx & (1u << 8)) != 0; // Invariant TSC
+#elif defined(__aarch64__)
+    return true; // Generic timer runs at a fixed frequency (cntfrq_el0)
+#else
+    return false;
+#endif
+}
+
+uint32_t timestamp_source_parse(const char* name) {
+    if (!name) {
+        return TIMESTAMP_SOURCE_MONOTONIC;
+    }
+    if (strcmp(name, "counter") == 0) {
+        return TIMESTAMP_SOURCE_COUNTER;
+    }
+    if (strcmp(name, "auto") == 0) {
+        return timestamp_source_counter_usable() ? TIMESTAMP_SOURCE_COUNTER
+                                                 : TIMESTAMP_SOURCE_MONOTONIC;
+    }
+    return TIMESTAMP_SOURCE_MONOTONIC;
+}
+
+int timestamp_source_calibrate(uint32_t source, uint32_t sample_ms, TimestampCalibration* out) {
+    if (!out || source > TIMESTAMP_SOURCE_COUNTER) {
+        return -EINVAL;
+    }
+    if (source == TIMESTAMP_SOURCE_MONOTONIC || !timestamp_source_counter_usable()) {
+        ts_set_monotonic(out);
+        return 0;
+    }
+
+    memset(out, 0, sizeof(*out));
+    out->source = TIMESTAMP_SOURCE_COUNTER;
+    ts_sample_pair(&out->tick_base, &out->ns_base);
+
+    uint64_t ticks_per_sec = 0;
+#if defined(__aarch64__)
+    uint64_t cntfrq;
+    __asm__ __volatile__("mrs %0, cntfrq_el0" : "=r"(cntfrq));
+    ticks_per_sec = cntfrq;
+#endif
+    if (ticks_per_sec == 0) {
+        if (sample_ms == 0) sample_ms = 1;
+        struct timespec delay = { (time_t)(sample_ms / 1000u), (long)(sample_ms % 1000u) * 1000000L };
+        while (nanosleep(&delay, &delay) != 0 && errno == EINTR) {
+        }
+        uint64_t t1 = 0, n1 = 0;
+        ts_sample_pair(&t1, &n1);
+        ticks_per_sec = ts_frequency(out->tick_base, out->ns_base, t1, n1);
+    }
+    if (ticks_per_sec == 0) {
+        ts_set_monotonic(out); // LCOV_EXCL_LINE
+        return 0;              // LCOV_EXCL_LINE
+    }
+    ts_set_frequency(out, ticks_per_sec);
+    return 0;
+}
+
+int timestamp_source_refine(const TimestampCalibration* cal, TimestampCalibration* out) {
+    if (!cal || !out) {
+        return -EINVAL;
+    }
+    *out = *cal;
+    if (cal->source != TIMESTAMP_SOURCE_COUNTER) {
+        return 0;
+    }
+    uint64_t t1 = 0, n1 = 0;
+    ts_sample_pair(&t1, &n1);
+    uint64_t ticks_per_sec = ts_frequency(cal->tick_base, cal->ns_base, t1, n1);
+    // Keep the start-up estimate when the span is too short to improve on it
+    if (ticks_per_sec != 0 && n1 - cal->ns_base >= 1000000000ull) {
+        ts_set_frequency(out, ticks_per_sec);
+    }
+    return 0;
+}
+
+uint64_t timestamp_source_duration_from_ns(const TimestampCalibration* cal, uint64_t ns) {
+    if (!cal || cal->source != TIMESTAMP_SOURCE_COUNTER) {
+        return ns;
+    }
+    return (uint64_t)(((__uint128_t)ns * cal->ticks_per_sec) / 1000000000ull);
+}
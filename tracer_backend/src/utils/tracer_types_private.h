@@ -13,6 +13,10 @@
 // Private constants for internal use
 #define RINGS_PER_INDEX_LANE 4
 #define RINGS_PER_DETAIL_LANE 2
+#define INDEX_RING_BYTES (64 * 1024)
+#define DETAIL_RING_BYTES (256 * 1024)
+// Rings a lane may hold, initial plus grown from the overflow segment
+#define RINGS_PER_LANE_MAX 32
 #define QUEUE_COUNT_INDEX_LANE 1024
 #define QUEUE_COUNT_DETAIL_LANE 256
 
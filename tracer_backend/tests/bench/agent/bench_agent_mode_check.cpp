@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <time.h>
+
+extern "C" {
+#include <tracer_backend/utils/agent_mode.h>
+#include <tracer_backend/utils/control_block_ipc.h>
+#include <tracer_backend/utils/timestamp_source.h>
+}
+
+// Per-hook cost of the registry mode check, as on_enter/on_leave pay it,
+// while a drain thread keeps rewriting the heartbeat in the same cache line
+// (the situation bench_baseline_hooks.c runs under with a live controller).
+
+namespace {
+
+constexpr int kHooks = 2000000;
+constexpr uint64_t kHeartbeatTimeoutNs = 500000000ull;
+
+struct HookSim {
+    ControlBlock cb{};
+    AgentModeState state{};
+    TimestampCalibration cal{};
+    std::atomic<bool> stop{false};
+
+    explicit HookSim(uint32_t source) {
+        (void)timestamp_source_calibrate(source, 10, &cal);
+        cb_set_registry_ready(&cb, 1);
+        cb_set_registry_epoch(&cb, 1);
+        cb_set_heartbeat_ns(&cb, timestamp_source_monotonic_ns());
+        state.mode = REGISTRY_MODE_GLOBAL_ONLY;
+    }
+
+    // Previous hot path: full tick plus a control block mode load on every hook
+    uint32_t legacy_hook() {
+        uint64_t now = timestamp_source_read(cal.source);
+        AgentModeState before = state;
+        agent_mode_tick(&state, &cb, timestamp_source_to_ns(&cal, now), kHeartbeatTimeoutNs);
+        if (before.mode != state.mode) {
+            cb_set_registry_mode(&cb, state.mode);
+        }
+        return cb_get_registry_mode(&cb);
+    }
+
+    // Amortized hot path: one thread-local deadline compare per hook
+    uint32_t amortized_hook(AgentModeCache* cache, uint64_t interval) {
+        uint64_t now = timestamp_source_read(cal.source);
+        if (agent_mode_cache_due(cache, now)) {
+            AgentModeState before = state;
+            agent_mode_tick(&state, &cb, timestamp_source_to_ns(&cal, now), kHeartbeatTimeoutNs);
+            if (before.mode != state.mode) {
+                cb_set_registry_mode(&cb, state.mode);
+            }
+            agent_mode_cache_refresh(cache, cb_get_registry_mode(&cb), now, interval);
+        }
+        return cache->mode;
+    }
+};
+
+uint64_t thread_cpu_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+template <typename Fn>
+double ns_per_hook(HookSim& sim, Fn hook) {
+    std::thread drain([&] {
+        while (!sim.stop.load(std::memory_order_relaxed)) {
+            cb_update_heartbeat_ns(&sim.cb, timestamp_source_monotonic_ns());
+        }
+    });
+    // Hook thread CPU time only, so a shared core does not bill the drain's share
+    uint64_t sink = 0;
+    uint64_t start = thread_cpu_ns();
+    for (int i = 0; i < kHooks; i++) {
+        sink += hook();
+    }
+    uint64_t end = thread_cpu_ns();
+    sim.stop.store(true, std::memory_order_relaxed);
+    drain.join();
+    sim.stop.store(false, std::memory_order_relaxed);
+    EXPECT_GT(sink, 0u); // Healthy control block: the mode leaves GLOBAL_ONLY
+    return static_cast<double>(end - start) / kHooks;
+}
+
+void run_case(uint32_t source, const char* label) {
+    HookSim sim(source);
+    double legacy_ns = ns_per_hook(sim, [&] { return sim.legacy_hook(); });
+
+    HookSim amortized_sim(source);
+    AgentModeCache cache{};
+    uint64_t interval =
+        timestamp_source_duration_from_ns(&amortized_sim.cal, AGENT_MODE_CHECK_INTERVAL_NS);
+    double amortized_ns = ns_per_hook(
+        amortized_sim, [&] { return amortized_sim.amortized_hook(&cache, interval); });
+
+    ::testing::Test::RecordProperty(std::string("per_call_tick_ns_") + label, legacy_ns);
+    ::testing::Test::RecordProperty(std::string("amortized_ns_") + label, amortized_ns);
+    printf("[BENCH] %s timestamps: per-call tick=%.1fns amortized=%.1fns per hook\n",
+           label, legacy_ns, amortized_ns);
+
+    EXPECT_LT(amortized_ns, legacy_ns);
+}
+
+} // namespace
+
+TEST(AgentModeCheckBench, mode_check__monotonic_timestamps__then_amortized_cheaper) {
+    run_case(TIMESTAMP_SOURCE_MONOTONIC, "monotonic");
+}
+
+TEST(AgentModeCheckBench, mode_check__counter_timestamps__then_amortized_cheaper) {
+    if (!timestamp_source_counter_usable()) {
+        GTEST_SKIP() << "No invariant CPU counter";
+    }
+    run_case(TIMESTAMP_SOURCE_COUNTER, "counter");
+}
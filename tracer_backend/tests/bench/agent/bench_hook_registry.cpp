@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+
+#include <tracer_backend/agent/comprehensive_hooks.h>
+#include <tracer_backend/agent/hook_registry.h>
+
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Startup cost of registering a large binary's symbols (DEFAULT_SYMBOL_LIMIT
+// names in frida_agent.cpp), looking them up and exporting the symbol table,
+// against the previous mutex + unordered_map registry with ostringstream export.
+
+using ada::agent::HookRegistry;
+using ada::agent::fnv1a32_ci;
+using ada::agent::make_function_id;
+
+namespace {
+
+constexpr size_t kSymbols = 100000;
+
+// Previous registry: locked map per module, one call per symbol
+class LegacyRegistry {
+public:
+    uint64_t register_symbol(const std::string& module_path, const std::string& symbol) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& me = modules_[module_path];
+        if (me.module_id == 0) me.module_id = fnv1a32_ci(module_path);
+        auto it = me.name_to_index.find(symbol);
+        if (it != me.name_to_index.end()) return make_function_id(me.module_id, it->second);
+        uint32_t idx = me.next_index++;
+        me.name_to_index.emplace(symbol, idx);
+        return make_function_id(me.module_id, idx);
+    }
+
+    bool get_id(const std::string& module_path, const std::string& symbol, uint64_t* out_id) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = modules_.find(module_path);
+        if (it == modules_.end()) return false;
+        auto it2 = it->second.name_to_index.find(symbol);
+        if (it2 == it->second.name_to_index.end()) return false;
+        *out_id = make_function_id(it->second.module_id, it2->second);
+        return true;
+    }
+
+    std::string export_to_json() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::ostringstream oss;
+        oss << "  \"symbols\": [\n";
+        bool first = true;
+        for (const auto& kv : modules_) {
+            for (const auto& sym : kv.second.name_to_index) {
+                if (!first) oss << ",\n";
+                first = false;
+                oss << "    {\n";
+                oss << "      \"function_id\": \"0x" << std::hex << std::setw(16) << std::setfill('0')
+                    << make_function_id(kv.second.module_id, sym.second) << std::dec << "\",\n";
+                oss << "      \"module_id\": " << kv.second.module_id << ",\n";
+                oss << "      \"symbol_index\": " << sym.second << ",\n";
+                oss << "      \"name\": \"" << sym.first << "\"\n";
+                oss << "    }";
+            }
+        }
+        oss << "\n  ]";
+        return oss.str();
+    }
+
+private:
+    struct ModuleEntry {
+        uint32_t module_id = 0;
+        uint32_t next_index = 1u;
+        std::unordered_map<std::string, uint32_t> name_to_index;
+    };
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, ModuleEntry> modules_;
+};
+
+// Mangled-looking names of realistic length
+std::vector<std::string> make_symbols(size_t n) {
+    std::vector<std::string> out;
+    out.reserve(n);
+    char buf[96];
+    for (size_t i = 0; i < n; ++i) {
+        snprintf(buf, sizeof(buf), "_ZN7project6module%zu9Component%zu6updateERKNS_5StateE", i % 97, i);
+        out.emplace_back(buf);
+    }
+    return out;
+}
+
+template <typename Fn>
+double elapsed_ms(Fn fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+} // namespace
+
+TEST(HookRegistryBench, hook_registry__large_module__then_bulk_startup_faster) {
+    const std::vector<std::string> symbols = make_symbols(kSymbols);
+    const std::string module = "<main>";
+
+    LegacyRegistry legacy;
+    double legacy_register_ms = elapsed_ms([&] {
+        for (const auto& sym : symbols) legacy.register_symbol(module, sym);
+    });
+
+    HookRegistry reg;
+    double bulk_register_ms = elapsed_ms([&] {
+        std::vector<uint64_t> ids;
+        reg.register_module_symbols(module, symbols, &ids);
+    });
+    ASSERT_EQ(reg.get_symbol_count(module), kSymbols);
+
+    // Full planning path as the agent runs it (fresh registry, no excludes)
+    HookRegistry planned;
+    double plan_ms = elapsed_ms([&] {
+        auto plan = ada::agent::plan_module_hooks(module, symbols, nullptr, planned);
+        ASSERT_EQ(plan.size(), kSymbols);
+    });
+
+    uint64_t sink = 0;
+    double legacy_lookup_ms = elapsed_ms([&] {
+        for (const auto& sym : symbols) {
+            uint64_t id = 0;
+            legacy.get_id(module, sym, &id);
+            sink += id;
+        }
+    });
+    double lookup_ms = elapsed_ms([&] {
+        for (const auto& sym : symbols) {
+            uint64_t id = 0;
+            reg.get_id(module, sym, &id);
+            sink += id;
+        }
+    });
+    EXPECT_NE(sink, 0u);
+
+    size_t legacy_bytes = 0;
+    double legacy_export_ms = elapsed_ms([&] { legacy_bytes = legacy.export_to_json().size(); });
+    size_t bytes = 0;
+    double export_ms = elapsed_ms([&] { bytes = reg.export_to_json().size(); });
+    EXPECT_GT(bytes, legacy_bytes); // New export also carries the modules array
+
+    ::testing::Test::RecordProperty("legacy_register_ms", std::to_string(legacy_register_ms));
+    ::testing::Test::RecordProperty("bulk_register_ms", std::to_string(bulk_register_ms));
+    ::testing::Test::RecordProperty("legacy_lookup_ms", std::to_string(legacy_lookup_ms));
+    ::testing::Test::RecordProperty("lookup_ms", std::to_string(lookup_ms));
+    ::testing::Test::RecordProperty("legacy_export_ms", std::to_string(legacy_export_ms));
+    ::testing::Test::RecordProperty("export_ms", std::to_string(export_ms));
+    printf("[BENCH] %zu symbols: register %.1fms -> %.1fms (plan_module_hooks %.1fms), "
+           "lookup %.1fms -> %.1fms, export %.1fms -> %.1fms\n",
+           kSymbols, legacy_register_ms, bulk_register_ms, plan_ms,
+           legacy_lookup_ms, lookup_ms, legacy_export_ms, export_ms);
+
+    EXPECT_LT(bulk_register_ms, legacy_register_ms);
+}
@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+extern "C" {
+#include <tracer_backend/atf/atf_thread_writer.h>
+#include <tracer_backend/utils/tracer_types.h>
+}
+
+namespace {
+
+using clock_mono = std::chrono::steady_clock;
+
+// One drained index ring (64 KiB of 32-byte records) per span
+constexpr size_t kSpanEvents = 64 * 1024 / sizeof(IndexEvent);
+constexpr size_t kSpans = 2048;  // 128 MiB per file
+constexpr uint32_t kThreads = 4; // Files written concurrently by the drain
+
+struct BackendResult {
+    AtfWriterBackend backend_in_use{ATF_WRITER_BACKEND_STDIO};
+    double ns_per_event{0.0};
+    double mib_per_second{0.0};
+};
+
+std::string bench_session_dir(const char* tag) {
+    return std::string("/tmp/ada_bench_writer_") + tag + "_" + std::to_string(getpid());
+}
+
+void remove_session_dir(const std::string& dir) {
+    std::string cmd = "rm -rf " + dir;
+    (void)system(cmd.c_str());
+}
+
+// Drain-shaped workload: round-robin ring-sized spans over several thread
+// files, then finalize (header rewrite) and close every file.
+BackendResult run_backend(AtfWriterBackend backend, const char* tag,
+                          const std::vector<IndexEvent>& span) {
+    BackendResult result;
+    std::string dir = bench_session_dir(tag);
+    remove_session_dir(dir);
+
+    AtfThreadWriter* writers[kThreads] = {};
+    for (uint32_t t = 0; t < kThreads; ++t) {
+        writers[t] = atf_thread_writer_create_with_backend(dir.c_str(), t, 1, backend);
+        EXPECT_NE(writers[t], nullptr);
+        if (!writers[t]) return result;
+    }
+    result.backend_in_use = atf_thread_writer_get_backend(writers[0]);
+
+    auto start = clock_mono::now();
+    for (size_t s = 0; s < kSpans; ++s) {
+        for (uint32_t t = 0; t < kThreads; ++t) {
+            EXPECT_EQ(atf_thread_writer_write_index_span(writers[t], span.data(), span.size()), 0);
+        }
+    }
+    for (uint32_t t = 0; t < kThreads; ++t) {
+        EXPECT_EQ(atf_thread_writer_finalize(writers[t]), 0);
+        atf_thread_writer_close(writers[t]);
+    }
+    auto end = clock_mono::now();
+
+    double ns = static_cast<double>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    double events = static_cast<double>(kSpans * kSpanEvents * kThreads);
+    double bytes = events * sizeof(IndexEvent);
+    result.ns_per_event = ns / events;
+    result.mib_per_second = (bytes / (1024.0 * 1024.0)) / (ns / 1e9);
+
+    remove_session_dir(dir);
+    return result;
+}
+
+// Per-event path: one 32-byte index record per call
+double run_per_event(AtfWriterBackend backend, const char* tag) {
+    std::string dir = bench_session_dir(tag);
+    remove_session_dir(dir);
+    AtfThreadWriter* writer = atf_thread_writer_create_with_backend(dir.c_str(), 1, 1, backend);
+    EXPECT_NE(writer, nullptr);
+    if (!writer) return 0.0;
+
+    constexpr size_t kEvents = 4u << 20;
+    auto start = clock_mono::now();
+    for (size_t i = 0; i < kEvents; ++i) {
+        atf_thread_writer_write_event(writer, i, 0x0000000100000001ull,
+                                      EVENT_KIND_CALL, static_cast<uint32_t>(i & 7),
+                                      NULL, 0);
+    }
+    EXPECT_EQ(atf_thread_writer_finalize(writer), 0);
+    atf_thread_writer_close(writer);
+    auto end = clock_mono::now();
+
+    remove_session_dir(dir);
+    double ns = static_cast<double>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    return ns / static_cast<double>(kEvents);
+}
+
+} // namespace
+
+TEST(AtfWriterBackendBench, index_spans__all_backends__then_within_budget) {
+    std::vector<IndexEvent> span(kSpanEvents);
+    for (size_t i = 0; i < span.size(); ++i) {
+        span[i].timestamp = i;
+        span[i].function_id = 0x0000000100000000ull | i;
+        span[i].thread_id = 0;
+        span[i].event_kind = (i & 1) ? EVENT_KIND_RETURN : EVENT_KIND_CALL;
+        span[i].call_depth = static_cast<uint32_t>(i & 7);
+        span[i].detail_seq = INDEX_EVENT_NO_DETAIL_SEQ;
+    }
+
+    BackendResult stdio = run_backend(ATF_WRITER_BACKEND_STDIO, "stdio", span);
+    BackendResult uring = run_backend(ATF_WRITER_BACKEND_IO_URING, "io_uring", span);
+    BackendResult mapped = run_backend(ATF_WRITER_BACKEND_MMAP, "mmap", span);
+
+    RecordProperty("stdio_mib_per_second", static_cast<int>(stdio.mib_per_second));
+    RecordProperty("stdio_per_event_ns", stdio.ns_per_event);
+    RecordProperty("io_uring_mib_per_second", static_cast<int>(uring.mib_per_second));
+    RecordProperty("io_uring_per_event_ns", uring.ns_per_event);
+    RecordProperty("mmap_mib_per_second", static_cast<int>(mapped.mib_per_second));
+    RecordProperty("mmap_per_event_ns", mapped.ns_per_event);
+
+    constexpr double kMaxAllowedNs = 2'000.0; // Generous cap for debug/sanitized builds
+    EXPECT_LT(stdio.ns_per_event, kMaxAllowedNs);
+
+    // Bulk spans pay one page fault per 4 KiB on fresh extents; mmap is for
+    // per-event appends and live tailing, so only the absolute cap applies
+    ASSERT_EQ(mapped.backend_in_use, ATF_WRITER_BACKEND_MMAP);
+    EXPECT_LT(mapped.ns_per_event, kMaxAllowedNs);
+
+    if (uring.backend_in_use != ATF_WRITER_BACKEND_IO_URING) {
+        GTEST_SKIP() << "io_uring not available on this host; stdio "
+                     << stdio.mib_per_second << " MiB/s";
+    }
+
+    EXPECT_LT(uring.ns_per_event, kMaxAllowedNs);
+    // Page-cache bound on tmpfs-like storage; only guard against regressions
+    EXPECT_LT(uring.ns_per_event, stdio.ns_per_event * 2.0)
+        << "io_uring=" << uring.mib_per_second << "MiB/s stdio="
+        << stdio.mib_per_second << "MiB/s";
+}
+
+TEST(AtfWriterBackendBench, index_per_event__mmap_vs_stdio__then_not_slower) {
+    double stdio_ns = run_per_event(ATF_WRITER_BACKEND_STDIO, "per_event_stdio");
+    double mmap_ns = run_per_event(ATF_WRITER_BACKEND_MMAP, "per_event_mmap");
+
+    RecordProperty("stdio_per_event_ns", stdio_ns);
+    RecordProperty("mmap_per_event_ns", mmap_ns);
+
+    constexpr double kMaxAllowedNs = 2'000.0; // Generous cap for debug/sanitized builds
+    EXPECT_LT(mmap_ns, kMaxAllowedNs);
+    // memcpy into the mapping replaces the stdio buffer copy and its flushes
+    EXPECT_LT(mmap_ns, stdio_ns * 1.25)
+        << "mmap=" << mmap_ns << "ns stdio=" << stdio_ns << "ns";
+}
@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include <unistd.h>
+
+extern "C" {
+#include <tracer_backend/atf/atf_thread_writer.h>
+#include <tracer_backend/utils/ring_buffer.h>
+#include <tracer_backend/utils/tracer_types.h>
+}
+
+namespace {
+
+using clock_mono = std::chrono::steady_clock;
+
+// Matches the per-thread index ring (64 KiB of 32-byte records)
+constexpr size_t kRingBytes = 64 * 1024;
+constexpr size_t kRounds = 200;
+
+double duration_per_iteration_ns(clock_mono::time_point start,
+                                 clock_mono::time_point end,
+                                 size_t iterations) {
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    if (iterations == 0) return 0.0;
+    return static_cast<double>(ns) / static_cast<double>(iterations);
+}
+
+class IndexRing {
+public:
+    IndexRing() : memory_(new uint8_t[kRingBytes + CACHE_LINE_SIZE]()) {
+        rb_ = ring_buffer_create(memory_.get(), kRingBytes + CACHE_LINE_SIZE, sizeof(IndexEvent));
+        header_ = rb_ ? ring_buffer_get_header(rb_) : nullptr;
+    }
+    ~IndexRing() {
+        if (rb_) ring_buffer_destroy(rb_);
+    }
+
+    RingBufferHeader* header() const { return header_; }
+
+    // Fill the ring the way the agent does: final ATF records, slot as thread id
+    size_t fill(uint32_t slot, uint64_t* timestamp) {
+        size_t written = 0;
+        IndexEvent event{};
+        event.function_id = 0x0000000100000001ull;
+        event.thread_id = slot;
+        event.detail_seq = INDEX_EVENT_NO_DETAIL_SEQ;
+        for (;;) {
+            event.timestamp = (*timestamp)++;
+            event.event_kind = (written & 1) ? EVENT_KIND_RETURN : EVENT_KIND_CALL;
+            event.call_depth = static_cast<uint32_t>(written & 7);
+            if (!ring_buffer_write_raw(header_, sizeof(IndexEvent), &event)) break;
+            ++written;
+        }
+        return written;
+    }
+
+private:
+    std::unique_ptr<uint8_t[]> memory_;
+    RingBuffer* rb_{nullptr};
+    RingBufferHeader* header_{nullptr};
+};
+
+std::string bench_session_dir(const char* tag) {
+    return std::string("/tmp/ada_bench_index_") + tag + "_" + std::to_string(getpid());
+}
+
+void remove_session_dir(const std::string& dir) {
+    std::string cmd = "rm -rf " + dir;
+    (void)system(cmd.c_str());
+}
+
+// Per-event path: copy each record out of the ring and re-marshal it
+double run_marshalled(IndexRing& ring, size_t* out_events) {
+    std::string dir = bench_session_dir("marshalled");
+    remove_session_dir(dir);
+    AtfThreadWriter* writer = atf_thread_writer_create(dir.c_str(), 1, 1);
+    EXPECT_NE(writer, nullptr);
+    if (!writer) return 0.0;
+
+    uint64_t ts = 1;
+    size_t events = 0;
+    auto start = clock_mono::now();
+    for (size_t round = 0; round < kRounds; ++round) {
+        ring.fill(1, &ts);
+        IndexEvent event;
+        while (ring_buffer_read_raw(ring.header(), sizeof(IndexEvent), &event)) {
+            atf_thread_writer_write_event(writer, event.timestamp, event.function_id,
+                                          event.event_kind, event.call_depth, NULL, 0);
+            ++events;
+        }
+    }
+    EXPECT_EQ(atf_thread_writer_finalize(writer), 0);
+    auto end = clock_mono::now();
+
+    atf_thread_writer_close(writer);
+    remove_session_dir(dir);
+    *out_events = events;
+    return duration_per_iteration_ns(start, end, events);
+}
+
+// Zero-copy path: hand contiguous ring spans straight to the index file
+double run_zero_copy(IndexRing& ring, size_t* out_events) {
+    std::string dir = bench_session_dir("zero_copy");
+    remove_session_dir(dir);
+    AtfThreadWriter* writer = atf_thread_writer_create(dir.c_str(), 1, 1);
+    EXPECT_NE(writer, nullptr);
+    if (!writer) return 0.0;
+
+    uint64_t ts = 1;
+    size_t events = 0;
+    auto start = clock_mono::now();
+    for (size_t round = 0; round < kRounds; ++round) {
+        ring.fill(1, &ts);
+        RingBufferSpan spans[2];
+        size_t available;
+        while ((available = ring_buffer_peek_spans_raw(ring.header(), sizeof(IndexEvent),
+                                                       spans, SIZE_MAX)) > 0) {
+            for (int i = 0; i < 2 && spans[i].count > 0; ++i) {
+                EXPECT_EQ(atf_thread_writer_write_index_span(writer, spans[i].data,
+                                                             spans[i].count), 0);
+            }
+            ring_buffer_consume_raw(ring.header(), available);
+            events += available;
+        }
+    }
+    EXPECT_EQ(atf_thread_writer_finalize(writer), 0);
+    auto end = clock_mono::now();
+
+    atf_thread_writer_close(writer);
+    remove_session_dir(dir);
+    *out_events = events;
+    return duration_per_iteration_ns(start, end, events);
+}
+
+} // namespace
+
+TEST(IndexZeroCopyBench, drain_to_atf__zero_copy_vs_marshalled__then_not_slower) {
+    IndexRing ring;
+    ASSERT_NE(ring.header(), nullptr);
+
+    size_t marshalled_events = 0;
+    size_t zero_copy_events = 0;
+    double marshalled_ns = run_marshalled(ring, &marshalled_events);
+    double zero_copy_ns = run_zero_copy(ring, &zero_copy_events);
+
+    ASSERT_GT(marshalled_events, 0u);
+    EXPECT_EQ(zero_copy_events, marshalled_events);
+
+    RecordProperty("events", static_cast<int>(zero_copy_events));
+    RecordProperty("marshalled_per_event_ns", marshalled_ns);
+    RecordProperty("zero_copy_per_event_ns", zero_copy_ns);
+    if (zero_copy_ns > 0.0) {
+        RecordProperty("speedup_x100", static_cast<int>(marshalled_ns * 100.0 / zero_copy_ns));
+    }
+
+    constexpr double kMaxAllowedNs = 2'000.0; // Generous cap for debug/sanitized builds
+    EXPECT_LT(zero_copy_ns, kMaxAllowedNs)
+        << "Zero-copy drain regression: " << zero_copy_ns << "ns/event";
+    // Allow noise, but the span path must not lose to per-event marshalling
+    EXPECT_LT(zero_copy_ns, marshalled_ns * 1.25)
+        << "zero-copy=" << zero_copy_ns << "ns marshalled=" << marshalled_ns << "ns";
+}
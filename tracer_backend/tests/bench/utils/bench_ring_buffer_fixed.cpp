@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+
+#include "ring_buffer_private.h"
+
+namespace {
+
+using clock_mono = std::chrono::steady_clock;
+using ada::internal::DynamicRing;
+using ada::internal::FixedRing;
+
+constexpr size_t kSlots = 1024;
+constexpr int kRounds = 2000;
+
+// Hidden from the optimiser so the dynamic path keeps a runtime size
+volatile size_t g_runtime_event_size = 0;
+
+struct Ring {
+    std::unique_ptr<void, decltype(&std::free)> memory{nullptr, &std::free};
+    RingBuffer* rb = nullptr;
+    RingBufferHeader* hdr = nullptr;
+
+    explicit Ring(size_t event_size) {
+        size_t bytes = sizeof(RingBufferHeader) + (kSlots * event_size);
+        void* raw = nullptr;
+        if (posix_memalign(&raw, CACHE_LINE_SIZE, bytes) != 0) return;
+        memory.reset(raw);
+        std::memset(raw, 0, bytes);
+        rb = ring_buffer_create(raw, bytes, event_size);
+        hdr = rb ? ring_buffer_get_header(rb) : nullptr;
+    }
+    ~Ring() { ring_buffer_destroy(rb); }
+};
+
+// Fill the ring to capacity then drain it, kRounds times; ns per write+read
+template <typename Ops>
+double measure(RingBufferHeader* hdr, size_t event_size) {
+    std::unique_ptr<uint8_t[]> event(new uint8_t[event_size]());
+    size_t runtime_size = g_runtime_event_size;
+    uint64_t moved = 0;
+
+    auto start = clock_mono::now();
+    for (int round = 0; round < kRounds; round++) {
+        event[0] = static_cast<uint8_t>(round);
+        while (Ops::write(hdr, runtime_size, event.get())) {
+            moved++;
+        }
+        while (Ops::read(hdr, runtime_size, event.get())) {
+        }
+    }
+    auto end = clock_mono::now();
+
+    double ns = static_cast<double>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    return moved ? ns / static_cast<double>(moved) : 0.0;
+}
+
+template <typename Event>
+void compare(const char* name, double max_allowed_ns) {
+    Ring ring(sizeof(Event));
+    ASSERT_NE(ring.hdr, nullptr);
+    g_runtime_event_size = sizeof(Event);
+
+    using Fixed = FixedRing<sizeof(Event)>;
+    (void)measure<DynamicRing>(ring.hdr, sizeof(Event)); // Warm-up
+    double dynamic_ns = measure<DynamicRing>(ring.hdr, sizeof(Event));
+    double fixed_ns = measure<Fixed>(ring.hdr, sizeof(Event));
+    dynamic_ns = std::min(dynamic_ns, measure<DynamicRing>(ring.hdr, sizeof(Event)));
+    fixed_ns = std::min(fixed_ns, measure<Fixed>(ring.hdr, sizeof(Event)));
+
+    ::testing::Test::RecordProperty(std::string(name) + "_dynamic_ns_per_event", dynamic_ns);
+    ::testing::Test::RecordProperty(std::string(name) + "_fixed_ns_per_event", fixed_ns);
+    printf("[BENCH] %s: dynamic=%.2fns fixed=%.2fns per event\n", name, dynamic_ns, fixed_ns);
+
+    EXPECT_LT(fixed_ns, max_allowed_ns);
+    // Same protocol, cheaper copy and offset math; allow noise on shared hosts
+    EXPECT_LT(fixed_ns, dynamic_ns * 1.15)
+        << name << " fixed=" << fixed_ns << "ns dynamic=" << dynamic_ns << "ns";
+}
+
+} // namespace
+
+TEST(RingBufferFixedBench, index_event__fixed_vs_runtime_size__then_not_slower) {
+    compare<IndexEvent>("index", 200.0); // Generous cap for debug/sanitized builds
+}
+
+TEST(RingBufferFixedBench, detail_event__fixed_vs_runtime_size__then_not_slower) {
+    compare<DetailEvent>("detail", 1000.0);
+}
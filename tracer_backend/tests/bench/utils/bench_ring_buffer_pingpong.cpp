@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <thread>
+
+extern "C" {
+#include <tracer_backend/utils/ring_buffer.h>
+#include <tracer_backend/utils/tracer_types.h>
+}
+
+namespace {
+
+using clock_mono = std::chrono::steady_clock;
+
+constexpr size_t kRingBytes = 64 * 1024;  // Index ring size used by the registry
+constexpr uint64_t kEvents = 8u << 20;
+
+// Version 1 protocol: both positions loaded on every operation
+bool legacy_write(RingBufferHeader* hdr, const IndexEvent* ev) {
+    uint32_t mask = hdr->capacity - 1u;
+    uint32_t write_pos = __atomic_load_n(&hdr->write_pos, __ATOMIC_ACQUIRE);
+    uint32_t next_pos = (write_pos + 1) & mask;
+    uint32_t read_pos = __atomic_load_n(&hdr->read_pos, __ATOMIC_ACQUIRE);
+    if (next_pos == read_pos) return false;
+    auto* buf = reinterpret_cast<uint8_t*>(hdr) + sizeof(RingBufferHeader);
+    std::memcpy(buf + write_pos * sizeof(IndexEvent), ev, sizeof(IndexEvent));
+    __atomic_store_n(&hdr->write_pos, next_pos, __ATOMIC_RELEASE);
+    return true;
+}
+
+bool legacy_read(RingBufferHeader* hdr, IndexEvent* ev) {
+    uint32_t mask = hdr->capacity - 1u;
+    uint32_t read_pos = __atomic_load_n(&hdr->read_pos, __ATOMIC_ACQUIRE);
+    uint32_t write_pos = __atomic_load_n(&hdr->write_pos, __ATOMIC_ACQUIRE);
+    if (read_pos == write_pos) return false;
+    auto* buf = reinterpret_cast<uint8_t*>(hdr) + sizeof(RingBufferHeader);
+    std::memcpy(ev, buf + read_pos * sizeof(IndexEvent), sizeof(IndexEvent));
+    __atomic_store_n(&hdr->read_pos, (read_pos + 1) & mask, __ATOMIC_RELEASE);
+    return true;
+}
+
+bool cached_write(RingBufferHeader* hdr, const IndexEvent* ev) {
+    return ring_buffer_write_raw(hdr, sizeof(IndexEvent), ev);
+}
+
+bool cached_read(RingBufferHeader* hdr, IndexEvent* ev) {
+    return ring_buffer_read_raw(hdr, sizeof(IndexEvent), ev);
+}
+
+// Producer and consumer on separate threads hand kEvents through one ring;
+// returns ns per event end to end
+template <typename WriteFn, typename ReadFn>
+double run_pingpong(WriteFn write_fn, ReadFn read_fn) {
+    void* raw = nullptr;
+    EXPECT_EQ(posix_memalign(&raw, CACHE_LINE_SIZE, kRingBytes), 0);
+    std::unique_ptr<void, decltype(&std::free)> memory(raw, &std::free);
+    std::memset(raw, 0, kRingBytes);
+
+    RingBuffer* rb = ring_buffer_create(raw, kRingBytes, sizeof(IndexEvent));
+    EXPECT_NE(rb, nullptr);
+    if (!rb) return 0.0;
+    RingBufferHeader* hdr = ring_buffer_get_header(rb);
+
+    uint64_t checksum = 0;
+    auto start = clock_mono::now();
+    std::thread consumer([&] {
+        IndexEvent ev;
+        for (uint64_t received = 0; received < kEvents;) {
+            if (read_fn(hdr, &ev)) {
+                checksum += ev.timestamp;
+                ++received;
+            }
+        }
+    });
+
+    IndexEvent ev = {};
+    ev.function_id = 0x0000000100000001ull;
+    ev.detail_seq = INDEX_EVENT_NO_DETAIL_SEQ;
+    for (uint64_t i = 0; i < kEvents;) {
+        ev.timestamp = i;
+        if (write_fn(hdr, &ev)) {
+            ++i;
+        }
+    }
+    consumer.join();
+    auto end = clock_mono::now();
+
+    EXPECT_EQ(checksum, kEvents * (kEvents - 1) / 2);
+    ring_buffer_destroy(rb);
+
+    double ns = static_cast<double>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    return ns / static_cast<double>(kEvents);
+}
+
+} // namespace
+
+TEST(RingBufferPingPongBench, spsc_pingpong__cached_positions__then_not_slower) {
+    if (std::thread::hardware_concurrency() < 2) {
+        GTEST_SKIP() << "needs two cores for a producer/consumer pair";
+    }
+
+    // Warm up both paths once, then take the better of two runs each
+    (void)run_pingpong(legacy_write, legacy_read);
+    double legacy_ns = run_pingpong(legacy_write, legacy_read);
+    double cached_ns = run_pingpong(cached_write, cached_read);
+    legacy_ns = std::min(legacy_ns, run_pingpong(legacy_write, legacy_read));
+    cached_ns = std::min(cached_ns, run_pingpong(cached_write, cached_read));
+
+    RecordProperty("legacy_ns_per_event", legacy_ns);
+    RecordProperty("cached_ns_per_event", cached_ns);
+    RecordProperty("speedup_x100", static_cast<int>(legacy_ns / cached_ns * 100.0));
+
+    constexpr double kMaxAllowedNs = 500.0; // Generous cap for debug/sanitized builds
+    EXPECT_LT(cached_ns, kMaxAllowedNs);
+    // Fewer cross-core line transfers per event; allow noise on shared hosts
+    EXPECT_LT(cached_ns, legacy_ns * 1.15)
+        << "cached=" << cached_ns << "ns legacy=" << legacy_ns << "ns";
+}
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <vector>
+
+extern "C" {
+#include <tracer_backend/utils/stack_capture.h>
+}
+
+namespace {
+
+using clock_mono = std::chrono::steady_clock;
+
+constexpr int kIterations = 200000;
+
+volatile sig_atomic_t g_legacy_fault = 0;
+
+void legacy_segv_handler(int) { g_legacy_fault = 1; }
+
+// Previous agent implementation: swap in a SIGSEGV handler around 16-byte probes
+size_t legacy_signal_capture(void* dest, void* stack_ptr, size_t max_size) {
+    struct sigaction old_sa, new_sa;
+    new_sa.sa_handler = legacy_segv_handler;
+    sigemptyset(&new_sa.sa_mask);
+    new_sa.sa_flags = 0;
+    sigaction(SIGSEGV, &new_sa, &old_sa);
+    g_legacy_fault = 0;
+
+    size_t copied = 0;
+    for (size_t offset = 0; offset < max_size && !g_legacy_fault; offset += 16) {
+        size_t to_copy = (offset + 16 <= max_size) ? 16 : (max_size - offset);
+        volatile char probe = *(static_cast<char*>(stack_ptr) + offset);
+        (void)probe;
+        if (!g_legacy_fault) {
+            memcpy(static_cast<char*>(dest) + offset, static_cast<char*>(stack_ptr) + offset, to_copy);
+            copied += to_copy;
+        }
+    }
+    sigaction(SIGSEGV, &old_sa, nullptr);
+    return copied;
+}
+
+template <typename Fn>
+double ns_per_call(Fn capture, void* src, size_t bytes) {
+    std::vector<uint8_t> dest(bytes);
+    size_t total = 0;
+    auto start = clock_mono::now();
+    for (int i = 0; i < kIterations; i++) {
+        total += capture(dest.data(), src, bytes);
+    }
+    auto end = clock_mono::now();
+    EXPECT_EQ(total, static_cast<size_t>(kIterations) * bytes);
+    return static_cast<double>(
+               std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) /
+           kIterations;
+}
+
+void run_case(size_t bytes) {
+    ASSERT_EQ(stack_capture_init_thread(), 0);
+    alignas(16) volatile uint8_t frame[1024];
+    for (size_t i = 0; i < sizeof(frame); i++) frame[i] = static_cast<uint8_t>(i);
+    void* src = const_cast<uint8_t*>(frame);
+
+    double legacy_ns = ns_per_call(legacy_signal_capture, src, bytes);
+    double bounded_ns = ns_per_call(stack_capture_copy, src, bytes);
+    double checked_ns = ns_per_call(
+        [](void* d, void* s, size_t n) { return stack_capture_copy_checked(d, s, n); }, src, bytes);
+
+    std::string tag = std::to_string(bytes) + "b";
+    ::testing::Test::RecordProperty("legacy_signal_ns_" + tag, legacy_ns);
+    ::testing::Test::RecordProperty("bounded_ns_" + tag, bounded_ns);
+    ::testing::Test::RecordProperty("checked_ns_" + tag, checked_ns);
+    printf("[BENCH] %zu bytes: signal=%.1fns bounded=%.1fns checked=%.1fns per call\n",
+           bytes, legacy_ns, bounded_ns, checked_ns);
+
+    // Two sigaction() syscalls versus none
+    EXPECT_LT(bounded_ns, legacy_ns);
+    EXPECT_LT(bounded_ns, 1000.0); // Generous cap for debug/sanitized builds
+}
+
+} // namespace
+
+TEST(StackCaptureBench, stack_capture__128_bytes__then_faster_than_signal_probe) {
+    run_case(128);
+}
+
+TEST(StackCaptureBench, stack_capture__512_bytes__then_faster_than_signal_probe) {
+    run_case(512);
+}
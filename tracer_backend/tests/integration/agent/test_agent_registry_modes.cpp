@@ -242,7 +242,8 @@ TEST(DISABLED_agent__registry_per_thread_only__then_per_thread_used, integration
     inject_and_run(controller, "test_cli", &pid);
 
     // Wait for agent to transition through states
-    // Each transition requires an event capture that calls update_registry_mode()
+    // Each transition happens at an amortized mode check (update_registry_mode(),
+    // at most once per AGENT_MODE_CHECK_INTERVAL_NS per thread)
     // The test_cli program generates many events quickly
     std::this_thread::sleep_for(500ms);
 
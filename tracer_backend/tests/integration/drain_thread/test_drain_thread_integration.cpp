@@ -453,6 +453,8 @@ TEST(DrainThreadAtfV2Integration,
     // Reset ring positions before writing
     ring_hdr1->write_pos = 0;
     ring_hdr1->read_pos = 0;
+    ring_hdr1->cached_read_pos = 0;
+    ring_hdr1->cached_write_pos = 0;
 
     // Write index events to thread 1's ring
     IndexEvent event1 = {
@@ -461,7 +463,7 @@ TEST(DrainThreadAtfV2Integration,
         .thread_id = 0x5001,
         .event_kind = (i % 2 == 0) ? EVENT_KIND_CALL : EVENT_KIND_RETURN,
         .call_depth = static_cast<uint32_t>(i % 10),
-        ._padding = 0
+        .detail_seq = INDEX_EVENT_NO_DETAIL_SEQ
     };
     ASSERT_TRUE(ring_buffer_write_raw(ring_hdr1, sizeof(IndexEvent), &event1));
 
@@ -485,6 +487,8 @@ TEST(DrainThreadAtfV2Integration,
     // Reset ring positions before writing
     ring_hdr2->write_pos = 0;
     ring_hdr2->read_pos = 0;
+    ring_hdr2->cached_read_pos = 0;
+    ring_hdr2->cached_write_pos = 0;
 
     // Write index events to thread 2's ring
     IndexEvent event2 = {
@@ -493,7 +497,7 @@ TEST(DrainThreadAtfV2Integration,
         .thread_id = 0x5002,
         .event_kind = (i % 2 == 0) ? EVENT_KIND_CALL : EVENT_KIND_RETURN,
         .call_depth = static_cast<uint32_t>(i % 10),
-        ._padding = 0
+        .detail_seq = INDEX_EVENT_NO_DETAIL_SEQ
     };
     ASSERT_TRUE(ring_buffer_write_raw(ring_hdr2, sizeof(IndexEvent), &event2));
 
@@ -582,24 +586,31 @@ TEST(DrainThreadAtfV2Integration,
     // Reset ring positions before writing
     ring_hdr->write_pos = 0;
     ring_hdr->read_pos = 0;
-
-    // Write detail event with full payload
-    DetailEvent detail_event = {};
-    detail_event.timestamp = 3000000 + i * 100;
-    detail_event.function_id = 0x0000000300000003ULL;
-    detail_event.thread_id = 0x5003;
-    detail_event.event_kind = EVENT_KIND_CALL;
-    detail_event.call_depth = i % 10;
-    detail_event.lr = 0x1234567890ABCDEFULL;
-    detail_event.fp = 0xFEDCBA0987654321ULL;
-    detail_event.sp = 0x7FFF00000000 + i * 16;
-    detail_event.stack_size = 64;
+    ring_hdr->cached_read_pos = 0;
+    ring_hdr->cached_write_pos = 0;
+
+    // Write a detail record carrying 64 bytes of stack
+    alignas(DETAIL_RECORD_ALIGN) uint8_t record[DETAIL_RECORD_MAX_SIZE] = {};
+    auto *rec = reinterpret_cast<DetailRecordHeader *>(record);
+    auto *payload = reinterpret_cast<DetailRecordPayload *>(rec + 1);
+    rec->timestamp = 3000000 + i * 100;
+    rec->event_type = DETAIL_RECORD_CALL;
+    rec->thread_id = 0x5003;
+    rec->call_depth = i % 10;
+    payload->function_id = 0x0000000300000003ULL;
+    payload->lr = 0x1234567890ABCDEFULL;
+    payload->fp = 0xFEDCBA0987654321ULL;
+    payload->sp = 0x7FFF00000000 + i * 16;
+    payload->stack_size = 64;
     // Fill stack snapshot with test pattern
+    uint8_t *stack = reinterpret_cast<uint8_t *>(payload + 1);
     for (size_t j = 0; j < 64; ++j) {
-      detail_event.stack_snapshot[j] = static_cast<uint8_t>((i + j) & 0xFF);
+      stack[j] = static_cast<uint8_t>((i + j) & 0xFF);
     }
+    size_t record_size = sizeof(DetailRecordHeader) + sizeof(DetailRecordPayload) + 64;
+    rec->total_length = static_cast<uint32_t>(record_size);
 
-    ASSERT_TRUE(ring_buffer_write_raw(ring_hdr, sizeof(DetailEvent), &detail_event));
+    ASSERT_TRUE(ring_buffer_write_record_raw(ring_hdr, record, record_size));
     ASSERT_TRUE(lane_submit_ring(detail_lane, ring_idx));
   }
 
@@ -682,6 +693,8 @@ TEST(DrainThreadAtfV2Integration,
     // Reset ring positions before writing
     ring_hdr->write_pos = 0;
     ring_hdr->read_pos = 0;
+    ring_hdr->cached_read_pos = 0;
+    ring_hdr->cached_write_pos = 0;
 
     IndexEvent event = {
         .timestamp = static_cast<uint64_t>(4000000 + i * 100),
@@ -689,7 +702,7 @@ TEST(DrainThreadAtfV2Integration,
         .thread_id = 0x5004,
         .event_kind = EVENT_KIND_CALL,
         .call_depth = 1,
-        ._padding = 0
+        .detail_seq = INDEX_EVENT_NO_DETAIL_SEQ
     };
     ASSERT_TRUE(ring_buffer_write_raw(ring_hdr, sizeof(IndexEvent), &event));
     ASSERT_TRUE(lane_submit_ring(index_lane, ring_idx));
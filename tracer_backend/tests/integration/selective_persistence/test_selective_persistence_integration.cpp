@@ -109,7 +109,7 @@ TEST(SelectivePersistenceIntegrationTest, full_cycle__metadata_persisted__then_a
 
     RingBufferHeader* header = ring_pool_get_active_header(fx.detail_pool);
     ASSERT_NE(header, nullptr);
-    fill_ring_to_capacity(header, sizeof(DetailEvent));
+    fill_ring_to_capacity(header, DETAIL_RECORD_ALIGN);
     ASSERT_TRUE(detail_lane_control_should_dump(control));
 
     SelectivePersistenceWindow window{};
@@ -178,7 +178,7 @@ TEST(SelectivePersistenceIntegrationTest, window_wrappers__multi_cycle__then_met
 
     RingBufferHeader* header = ring_pool_get_active_header(fx.detail_pool);
     ASSERT_NE(header, nullptr);
-    fill_ring_to_capacity(header, sizeof(DetailEvent));
+    fill_ring_to_capacity(header, DETAIL_RECORD_ALIGN);
     ASSERT_TRUE(detail_lane_control_should_dump(control));
 
     SelectivePersistenceWindow window{};
@@ -233,7 +233,7 @@ TEST(SelectivePersistenceIntegrationTest, symbol_regex_case_insensitive__then_du
 
     RingBufferHeader* header = ring_pool_get_active_header(fx.detail_pool);
     ASSERT_NE(header, nullptr);
-    fill_ring_to_capacity(header, sizeof(DetailEvent));
+    fill_ring_to_capacity(header, DETAIL_RECORD_ALIGN);
     ASSERT_TRUE(detail_lane_control_should_dump(control));
 
     SelectivePersistenceWindow window{};
@@ -82,6 +82,8 @@ void worker_entry(WorkerContext ctx) {
 
         header->read_pos = 0;
         header->write_pos = 0;
+        header->cached_read_pos = 0;
+        header->cached_write_pos = 0;
 
         const uint32_t burst_length = generator->config.burst_length;
         const uint32_t syscalls_per_burst = generator->config.syscalls_per_burst;
@@ -8,6 +8,7 @@
 #include <cstring>
 #include <chrono>
 #include <pthread.h>
+#include <sched.h>
 #include <unistd.h>
 #include <sys/mman.h>
 #include <set>
@@ -631,7 +632,9 @@ TEST_F(ThreadRegistryIntegrationTest, integration__high_frequency_events__then_h
                               if (lane_submit_ring(index_lane, value++)) {
                                   worker->events_sent++;
                               } else {
+                                  // Refused: the drain is behind, let it run
                                   worker->events_dropped++;
+                                  sched_yield();
                               }
                               
                               // No delay - maximum pressure
@@ -641,6 +644,28 @@ TEST_F(ThreadRegistryIntegrationTest, integration__high_frequency_events__then_h
                       }, &workers[i]);
     }
     
+    // Drain side: full submit queues refuse rather than overwrite, so take
+    // every ready ring of each lane in one batch as the drain thread does
+    std::atomic<bool> producers_done(false);
+    std::atomic<uint64_t> total_taken(0);
+    std::thread drainer([&]() {
+        std::vector<uint32_t> rings(QUEUE_COUNT_INDEX_LANE);
+        auto sweep = [&]() {
+            uint32_t capacity = thread_registry_get_capacity(registry);
+            for (uint32_t slot = 0; slot < capacity; ++slot) {
+                ThreadLaneSet* lanes = thread_registry_get_thread_at(registry, slot);
+                if (!lanes) continue;
+                Lane* index_lane = thread_lanes_get_index_lane(lanes);
+                total_taken += lane_take_rings(index_lane, rings.data(),
+                                               static_cast<uint32_t>(rings.size()));
+            }
+        };
+        while (!producers_done.load()) {
+            sweep();
+        }
+        sweep();
+    });
+
     // Run for specified duration
     usleep(DURATION_MS * 1000);
     should_run = false;
@@ -649,6 +674,8 @@ TEST_F(ThreadRegistryIntegrationTest, integration__high_frequency_events__then_h
     for (int i = 0; i < NUM_THREADS; i++) {
         pthread_join(threads[i], nullptr);
     }
+    producers_done = true;
+    drainer.join();
     
     // Report statistics
     uint64_t total_sent = 0;
@@ -672,6 +699,7 @@ TEST_F(ThreadRegistryIntegrationTest, integration__high_frequency_events__then_h
     
     // System should handle pressure gracefully
     EXPECT_GT(total_sent, 0U) << "No events were sent";
+    EXPECT_EQ(total_taken.load(), total_sent) << "Every accepted submit must reach the drain";
     
     // Reasonable drop rate under extreme pressure
     if (total_dropped > 0) {
@@ -177,14 +177,21 @@ TEST_F(AgentCoverageTest, agent__registry_modes__exercise_code_paths) {
     hdr = thread_registry_get_active_ring_header(registry, det_lane);
     ASSERT_NE(hdr, nullptr);
 
-    wrote_pt = ring_buffer_write_raw(hdr, sizeof(DetailEvent), &det_event);
+    // Per-thread detail lanes take variable-length records
+    alignas(DETAIL_RECORD_ALIGN) uint8_t record[sizeof(DetailRecordHeader) + sizeof(DetailRecordPayload)] = {};
+    auto* rec = reinterpret_cast<DetailRecordHeader*>(record);
+    rec->total_length = sizeof(record);
+    rec->event_type = DETAIL_RECORD_RETURN;
+    rec->timestamp = det_event.timestamp;
+    reinterpret_cast<DetailRecordPayload*>(rec + 1)->function_id = det_event.function_id;
+    wrote_pt = ring_buffer_write_record_raw(hdr, record, sizeof(record));
     EXPECT_TRUE(wrote_pt);
     wrote = ring_buffer_write(detail_rb, &det_event);
     EXPECT_TRUE(wrote);
 
     cb_set_registry_mode(cb, REGISTRY_MODE_PER_THREAD_ONLY);
-    det_event.timestamp = 4000;
-    wrote_pt = ring_buffer_write_raw(hdr, sizeof(DetailEvent), &det_event);
+    rec->timestamp = 4000;
+    wrote_pt = ring_buffer_write_record_raw(hdr, record, sizeof(record));
     EXPECT_TRUE(wrote_pt);
 
     // Cleanup
@@ -64,3 +64,17 @@ TEST(controller__heartbeat__then_updates_monotonic, unit) {
     EXPECT_EQ(cb_get_heartbeat_ns(&cb), t2);
 }
 
+
+TEST(agent_mode__cache__then_ticks_only_when_due, unit) {
+    AgentModeCache cache = {};
+    // Fresh cache is due immediately
+    EXPECT_TRUE(agent_mode_cache_due(&cache, 0));
+
+    agent_mode_cache_refresh(&cache, REGISTRY_MODE_DUAL_WRITE, 1000, AGENT_MODE_CHECK_INTERVAL_NS);
+    EXPECT_EQ(cache.mode, (uint32_t)REGISTRY_MODE_DUAL_WRITE);
+    EXPECT_FALSE(agent_mode_cache_due(&cache, 1000));
+    EXPECT_FALSE(agent_mode_cache_due(&cache, 1000 + AGENT_MODE_CHECK_INTERVAL_NS - 1));
+    EXPECT_TRUE(agent_mode_cache_due(&cache, 1000 + AGENT_MODE_CHECK_INTERVAL_NS));
+
+    agent_mode_cache_refresh(nullptr, REGISTRY_MODE_GLOBAL_ONLY, 0, 0); // No-op
+}
@@ -9,10 +9,21 @@ extern "C" {
 #include <tracer_backend/agent/hook_registry.h>
 #include <tracer_backend/agent/comprehensive_hooks.h>
 
+#include <atomic>
+#include <cstdlib>
+#include <vector>
+
 using ada::agent::HookRegistry;
 using ada::agent::HookPlanEntry;
+using ada::agent::HookAddressRange;
+using ada::agent::ModuleSymbols;
+using ada::agent::ResolvedHookEntry;
 using ada::agent::plan_module_hooks;
 using ada::agent::plan_comprehensive_hooks;
+using ada::agent::plan_module_symbols;
+using ada::agent::resolve_hook_addresses;
+using ada::agent::run_hook_plan_tasks;
+using ada::agent::hook_plan_worker_count;
 
 TEST(comprehensive_hooks__plan_module_hooks__then_excludes_filtered, unit) {
     AdaExcludeList* xs = ada_exclude_create(8);
@@ -65,3 +76,71 @@ TEST(comprehensive_hooks__plan_comprehensive__then_combines_modules, unit) {
     ada_exclude_destroy(xs);
 }
 
+
+TEST(comprehensive_hooks__plan_module_symbols__then_dedups_caps_and_flags_stubs, unit) {
+    AdaExcludeList* xs = ada_exclude_create(8);
+    ASSERT_NE(xs, nullptr);
+    ada_exclude_add(xs, "skip");
+
+    ModuleSymbols mod;
+    mod.path = "/app/main";
+    mod.names = {"a", "skip", "b", "a", "stub", "c", "over"};
+    mod.addresses = {0x1000, 0x1100, 0, 0x9999, 0x5010, 0x1200, 0x1300};
+    mod.stub_ranges = {HookAddressRange{0x5000, 0x6000}};
+
+    HookRegistry reg;
+    // Limit counts unique names before exclusion: a, skip, b, stub, c
+    auto plan = plan_module_symbols(mod, 5, xs, reg);
+    ASSERT_EQ(plan.size(), 4u);
+    EXPECT_EQ(plan[0].symbol, "a");
+    EXPECT_EQ(plan[0].address, 0x1000u);  // First occurrence wins
+    EXPECT_EQ(plan[1].symbol, "b");
+    EXPECT_EQ(plan[1].address, 0u);
+    EXPECT_EQ(plan[2].symbol, "stub");
+    EXPECT_TRUE(plan[2].stub);
+    EXPECT_EQ(plan[3].symbol, "c");
+    EXPECT_FALSE(plan[3].stub);
+
+    uint64_t id = 0;
+    ASSERT_TRUE(reg.get_id("/app/main", "c", &id));
+    EXPECT_EQ(plan[3].function_id, id);
+    EXPECT_FALSE(reg.get_id("/app/main", "over", &id));
+
+    ada_exclude_destroy(xs);
+}
+
+TEST(comprehensive_hooks__resolve_hook_addresses__then_fills_missing_in_parallel, unit) {
+    std::vector<ResolvedHookEntry> hooks;
+    for (uint64_t i = 0; i < 2000; ++i) {
+        // Every third entry already has its enumeration address
+        hooks.push_back(ResolvedHookEntry{"s" + std::to_string(i), i, i % 3 == 0 ? 0x100000 + i : 0, false});
+    }
+    std::atomic<size_t> calls{0};
+    auto resolve = [&](const std::string& sym) -> uint64_t {
+        calls.fetch_add(1);
+        uint64_t n = std::stoull(sym.substr(1));
+        if (n == 5) return 0;  // Unresolvable
+        return n == 7 ? 0x5000 : 0x200000 + n;
+    };
+    resolve_hook_addresses(hooks, {HookAddressRange{0x5000, 0x5001}}, resolve, 4);
+
+    EXPECT_EQ(calls.load(), 2000u - 667u);
+    EXPECT_EQ(hooks[3].address, 0x100003u);
+    EXPECT_EQ(hooks[4].address, 0x200004u);
+    EXPECT_EQ(hooks[5].address, 0u);
+    EXPECT_TRUE(hooks[7].stub);
+    EXPECT_FALSE(hooks[8].stub);
+}
+
+TEST(comprehensive_hooks__run_hook_plan_tasks__then_each_task_once, unit) {
+    std::vector<std::atomic<int>> runs(97);
+    for (auto& r : runs) r.store(0);
+    run_hook_plan_tasks(runs.size(), 4, [&](size_t i) { runs[i].fetch_add(1); });
+    for (auto& r : runs) EXPECT_EQ(r.load(), 1);
+
+    setenv("ADA_HOOK_PLAN_WORKERS", "3", 1);
+    EXPECT_EQ(hook_plan_worker_count(10), 3u);
+    EXPECT_EQ(hook_plan_worker_count(2), 2u);
+    unsetenv("ADA_HOOK_PLAN_WORKERS");
+    EXPECT_GE(hook_plan_worker_count(0), 1u);
+}
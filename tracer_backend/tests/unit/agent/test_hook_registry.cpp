@@ -3,6 +3,12 @@
 #include <gtest/gtest.h>
 #include <tracer_backend/agent/hook_registry.h>
 
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
 using ada::agent::HookRegistry;
 using ada::agent::make_function_id;
 using ada::agent::fnv1a32_ci;
@@ -30,3 +36,133 @@ TEST(hook_registry__different_modules__then_different_module_ids, unit) {
     ASSERT_NE((a1 >> 32), (b1 >> 32));
 }
 
+
+TEST(hook_registry__register_module_symbols__then_matches_per_symbol_ids, unit) {
+    HookRegistry bulk;
+    HookRegistry single;
+    std::vector<std::string> names;
+    for (int i = 0; i < 1000; ++i) names.push_back("sym_" + std::to_string(i));
+    names.push_back("sym_7"); // Duplicate keeps its first id
+
+    std::vector<uint64_t> ids;
+    ASSERT_EQ(bulk.register_module_symbols("/usr/lib/libbulk.so", names, &ids), 1000u);
+    ASSERT_EQ(ids.size(), names.size());
+    for (size_t i = 0; i < names.size(); ++i) {
+        ASSERT_EQ(ids[i], single.register_symbol("/usr/lib/libbulk.so", names[i]));
+        uint64_t found = 0;
+        ASSERT_TRUE(bulk.get_id("/usr/lib/libbulk.so", names[i], &found));
+        ASSERT_EQ(found, ids[i]);
+    }
+    EXPECT_EQ(ids.back(), ids[7]);
+    EXPECT_EQ(bulk.get_symbol_count("/usr/lib/libbulk.so"), 1000u);
+
+    // A second batch extends the module without renumbering
+    std::vector<std::string> more = {"sym_3", "late"};
+    EXPECT_EQ(bulk.register_module_symbols("/usr/lib/libbulk.so", more, &ids), 1u);
+    EXPECT_EQ(ids[0], make_function_id(fnv1a32_ci("/usr/lib/libbulk.so"), 4));
+    EXPECT_EQ(ids[1], make_function_id(fnv1a32_ci("/usr/lib/libbulk.so"), 1001));
+
+    uint64_t missing = 0;
+    EXPECT_FALSE(bulk.get_id("/usr/lib/libbulk.so", "absent", &missing));
+    EXPECT_FALSE(bulk.get_id("/usr/lib/libother.so", "sym_1", &missing));
+}
+
+TEST(hook_registry__concurrent_lookups__then_published_symbols_visible, unit) {
+    HookRegistry reg;
+    constexpr int kSymbols = 20000;
+    std::atomic<int> published{0};
+    std::atomic<bool> failed{false};
+
+    std::thread reader([&] {
+        while (published.load(std::memory_order_acquire) < kSymbols) {
+            int n = published.load(std::memory_order_acquire);
+            if (n == 0) continue;
+            uint64_t id = 0;
+            int probe = n - 1;
+            if (!reg.get_id("<main>", "fn_" + std::to_string(probe), &id) ||
+                (id & 0xffffffffULL) != static_cast<uint64_t>(probe + 1)) {
+                failed.store(true);
+            }
+        }
+    });
+    for (int i = 0; i < kSymbols; ++i) {
+        reg.register_symbol("<main>", "fn_" + std::to_string(i));
+        published.store(i + 1, std::memory_order_release);
+    }
+    reader.join();
+
+    EXPECT_FALSE(failed.load());
+    EXPECT_EQ(reg.get_symbol_count("<main>"), static_cast<uint32_t>(kSymbols));
+}
+
+TEST(hook_registry__clear_with_concurrent_lookups__then_readers_stay_safe, unit) {
+    HookRegistry reg;
+    std::atomic<bool> stop{false};
+    uint64_t first_id = reg.register_symbol("<main>", "fn_0");
+
+    std::thread reader([&]() {
+        while (!stop.load(std::memory_order_acquire)) {
+            uint64_t id = 0;
+            if (reg.get_id("<main>", "fn_0", &id)) {
+                EXPECT_EQ(id, first_id);
+            }
+            (void)reg.get_symbol_count("<main>");
+        }
+    });
+    for (int round = 0; round < 200; ++round) {
+        reg.clear();
+        for (int i = 0; i < 40; ++i) {
+            reg.register_symbol("<main>", "fn_" + std::to_string(i));
+            reg.register_symbol("/lib/m" + std::to_string(i) + ".so", "f");
+        }
+    }
+    stop.store(true, std::memory_order_release);
+    reader.join();
+
+    reg.clear();
+    EXPECT_EQ(reg.module_count(), 0u);
+    EXPECT_EQ(reg.get_module_id("<main>"), 0u);
+    EXPECT_EQ(reg.register_symbol("<main>", "fn_0"), first_id);
+}
+
+TEST(hook_registry__export_to_json__then_symbols_in_index_order, unit) {
+    HookRegistry reg;
+    reg.register_module_symbols("/lib/a\"b.so", {"first", "tab\there"}, nullptr);
+    uint8_t uuid[16];
+    for (int i = 0; i < 16; ++i) uuid[i] = static_cast<uint8_t>(0xA0 + i);
+    reg.set_module_metadata("/lib/a\"b.so", 0x100000, 4096, uuid);
+
+    uint32_t mod = reg.get_module_id("/lib/a\"b.so");
+    char fid[32];
+    snprintf(fid, sizeof(fid), "0x%016llx",
+             static_cast<unsigned long long>(make_function_id(mod, 2)));
+    std::string expected =
+        "\"modules\": [\n"
+        "    {\n"
+        "      \"module_id\": " + std::to_string(mod) + ",\n"
+        "      \"path\": \"/lib/a\\\"b.so\",\n"
+        "      \"base_address\": \"0x100000\",\n"
+        "      \"size\": 4096,\n"
+        "      \"uuid\": \"A0A1A2A3-A4A5-A6A7-A8A9-AAABACADAEAF\"\n"
+        "    }\n"
+        "  ],\n"
+        "  \"symbols\": [\n";
+    std::string json = reg.export_to_json();
+    ASSERT_EQ(json.compare(0, expected.size(), expected), 0) << json;
+    size_t first = json.find("\"name\": \"first\"");
+    size_t second = json.find("\"name\": \"tab\\there\"");
+    ASSERT_NE(first, std::string::npos);
+    ASSERT_NE(second, std::string::npos);
+    EXPECT_LT(first, second);
+    EXPECT_NE(json.find(fid), std::string::npos);
+
+    // Streaming writer emits the same bytes
+    FILE* tmp = tmpfile();
+    ASSERT_NE(tmp, nullptr);
+    EXPECT_EQ(reg.write_json(tmp), json.size());
+    rewind(tmp);
+    std::string streamed(json.size(), '\0');
+    EXPECT_EQ(fread(&streamed[0], 1, streamed.size(), tmp), json.size());
+    fclose(tmp);
+    EXPECT_EQ(streamed, json);
+}
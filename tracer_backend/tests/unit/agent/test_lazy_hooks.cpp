@@ -0,0 +1,98 @@
+// Unit tests for lazy hook promotion (first-hit tracking and budget)
+
+#include <gtest/gtest.h>
+#include <tracer_backend/agent/lazy_hooks.h>
+
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using ada::agent::LazyHookConfig;
+using ada::agent::LazyHookStats;
+using ada::agent::LazyHookTracker;
+using ada::agent::lazy_hook_config_from_env;
+
+TEST(lazy_hooks__record_hit__then_first_hit_claims_once, unit) {
+    LazyHookTracker tracker(4, 10);
+    EXPECT_TRUE(tracker.record_hit(2));
+    EXPECT_FALSE(tracker.record_hit(2));
+    EXPECT_FALSE(tracker.record_hit(4));  // Out of range
+    EXPECT_EQ(tracker.state(2), static_cast<uint32_t>(ada::agent::LAZY_HOOK_HIT));
+    EXPECT_EQ(tracker.state(0), static_cast<uint32_t>(ada::agent::LAZY_HOOK_COLD));
+
+    std::vector<uint32_t> promote;
+    std::vector<uint32_t> drop;
+    EXPECT_EQ(tracker.take_hits(&promote, &drop), 1u);
+    ASSERT_EQ(promote.size(), 1u);
+    EXPECT_EQ(promote[0], 2u);
+    EXPECT_EQ(tracker.state(2), static_cast<uint32_t>(ada::agent::LAZY_HOOK_PROMOTED));
+
+    // Promoted slots never queue again
+    EXPECT_FALSE(tracker.record_hit(2));
+    EXPECT_EQ(tracker.take_hits(&promote, &drop), 0u);
+}
+
+TEST(lazy_hooks__take_hits__then_budget_splits_in_hit_order, unit) {
+    LazyHookTracker tracker(8, 3);
+    for (uint32_t slot : {5u, 1u, 7u, 0u, 3u}) {
+        ASSERT_TRUE(tracker.record_hit(slot));
+    }
+    std::vector<uint32_t> promote;
+    std::vector<uint32_t> drop;
+    EXPECT_EQ(tracker.take_hits(&promote, &drop), 5u);
+    EXPECT_EQ(promote, (std::vector<uint32_t>{5, 1, 7}));
+    EXPECT_EQ(drop, (std::vector<uint32_t>{0, 3}));
+    EXPECT_EQ(tracker.state(0), static_cast<uint32_t>(ada::agent::LAZY_HOOK_OVER_BUDGET));
+
+    LazyHookStats stats = tracker.stats();
+    EXPECT_EQ(stats.probes, 8u);
+    EXPECT_EQ(stats.hits, 5u);
+    EXPECT_EQ(stats.promoted, 3u);
+    EXPECT_EQ(stats.over_budget, 2u);
+}
+
+TEST(lazy_hooks__concurrent_hits__then_each_slot_taken_once, unit) {
+    constexpr uint32_t kSlots = 5000;
+    LazyHookTracker tracker(kSlots, kSlots);
+    std::vector<uint32_t> promote;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&tracker] {
+            for (uint32_t slot = 0; slot < kSlots; ++slot) tracker.record_hit(slot);
+        });
+    }
+    // Promoter drains while producers are still publishing
+    while (promote.size() < kSlots) {
+        tracker.take_hits(&promote, nullptr);
+    }
+    for (auto& t : threads) t.join();
+
+    std::vector<bool> seen(kSlots, false);
+    for (uint32_t slot : promote) {
+        ASSERT_FALSE(seen[slot]);
+        seen[slot] = true;
+    }
+    EXPECT_EQ(tracker.stats().hits, kSlots);
+}
+
+TEST(lazy_hooks__config_from_env__then_parses_mode_and_budget, unit) {
+    unsetenv("ADA_HOOK_MODE");
+    unsetenv("ADA_LAZY_HOOK_BUDGET");
+    unsetenv("ADA_LAZY_PROMOTE_MS");
+    LazyHookConfig config = lazy_hook_config_from_env();
+    EXPECT_FALSE(config.enabled);
+    EXPECT_EQ(config.budget, ADA_LAZY_HOOK_DEFAULT_BUDGET);
+    EXPECT_EQ(config.promote_interval_ms, ADA_LAZY_PROMOTE_DEFAULT_MS);
+
+    setenv("ADA_HOOK_MODE", "lazy", 1);
+    setenv("ADA_LAZY_HOOK_BUDGET", "250", 1);
+    setenv("ADA_LAZY_PROMOTE_MS", "bogus", 1);
+    config = lazy_hook_config_from_env();
+    EXPECT_TRUE(config.enabled);
+    EXPECT_EQ(config.budget, 250u);
+    EXPECT_EQ(config.promote_interval_ms, ADA_LAZY_PROMOTE_DEFAULT_MS);
+
+    unsetenv("ADA_HOOK_MODE");
+    unsetenv("ADA_LAZY_HOOK_BUDGET");
+    unsetenv("ADA_LAZY_PROMOTE_MS");
+}
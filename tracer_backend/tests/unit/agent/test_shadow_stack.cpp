@@ -0,0 +1,77 @@
+// Unit tests for the per-thread shadow call stack used by span mode
+
+#include <gtest/gtest.h>
+#include <tracer_backend/agent/shadow_stack.h>
+
+#include <memory>
+
+extern "C" {
+#include <tracer_backend/utils/tracer_types.h>
+}
+
+using ada::agent::ShadowFrame;
+using ada::agent::ShadowStack;
+
+TEST(shadow_stack__nested_calls__then_pops_pair_with_entry_times, unit) {
+    ShadowStack stack;
+    ASSERT_TRUE(stack.push(1, 100));
+    ASSERT_TRUE(stack.push(2, 150));
+    ASSERT_TRUE(stack.push(1, 170));  // Recursion
+    EXPECT_EQ(stack.size(), 3u);
+
+    ShadowFrame frame{};
+    ASSERT_TRUE(stack.pop(1, 180, &frame));
+    EXPECT_EQ(frame.entry_timestamp, 170u);  // Innermost instance first
+    EXPECT_EQ(frame.inclusive(180), 10u);
+    ASSERT_TRUE(stack.pop(2, 200, &frame));
+    EXPECT_EQ(frame.entry_timestamp, 150u);
+    EXPECT_EQ(frame.inclusive(200), 50u);
+    EXPECT_EQ(frame.exclusive(200), 40u);
+    ASSERT_TRUE(stack.pop(1, 300, &frame));
+    EXPECT_EQ(frame.entry_timestamp, 100u);
+    EXPECT_EQ(frame.inclusive(300), 200u);
+    EXPECT_EQ(frame.exclusive(300), 150u);
+    EXPECT_EQ(stack.size(), 0u);
+    EXPECT_EQ(stack.discarded(), 0u);
+}
+
+TEST(shadow_stack__leave_skipped__then_outer_pop_discards_orphans, unit) {
+    ShadowStack stack;
+    stack.push(1, 10);
+    stack.push(2, 20);
+    stack.push(3, 30);  // 2 and 3 unwound without on_leave
+
+    ShadowFrame frame{};
+    ASSERT_TRUE(stack.pop(1, 40, &frame));
+    EXPECT_EQ(frame.entry_timestamp, 10u);
+    EXPECT_EQ(frame.exclusive(40), 30u);  // Orphans charge nothing
+    EXPECT_EQ(stack.discarded(), 2u);
+    EXPECT_FALSE(stack.pop(3, 50, &frame));  // Late leave falls back to RETURN
+}
+
+TEST(shadow_stack__full__then_push_refused_and_counted, unit) {
+    auto stack = std::make_unique<ShadowStack>();
+    for (uint32_t i = 0; i < ShadowStack::kCapacity; ++i) {
+        ASSERT_TRUE(stack->push(i, i));
+    }
+    EXPECT_FALSE(stack->push(999, 999));
+    EXPECT_EQ(stack->overflows(), 1u);
+
+    // Frames below the overflow still pair
+    ShadowFrame frame{};
+    ASSERT_TRUE(stack->pop(ShadowStack::kCapacity - 1, ShadowStack::kCapacity, &frame));
+    EXPECT_EQ(stack->size(), ShadowStack::kCapacity - 1);
+}
+
+TEST(shadow_stack__span_record__then_duration_and_depth_round_trip, unit) {
+    IndexEvent e{};
+    index_event_set_span(&e, 42, 0x0000123456789ABCull);
+    EXPECT_EQ(e.event_kind, (uint32_t)EVENT_KIND_SPAN);
+    EXPECT_EQ(index_event_span_depth(&e), 42u);
+    EXPECT_EQ(index_event_span_duration(&e), 0x0000123456789ABCull);
+
+    // Out-of-range values saturate instead of corrupting each other
+    index_event_set_span(&e, 0x12345, UINT64_MAX);
+    EXPECT_EQ(index_event_span_depth(&e), INDEX_SPAN_DEPTH_MASK);
+    EXPECT_EQ(index_event_span_duration(&e), INDEX_SPAN_MAX_DURATION);
+}
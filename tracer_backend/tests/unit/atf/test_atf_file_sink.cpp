@@ -0,0 +1,378 @@
+/**
+ * @file test_atf_file_sink.cpp
+ * @brief Unit tests for ATF v2 file sinks (stdio, io_uring and mmap backends)
+ *
+ * These tests verify:
+ * - Every backend produces byte-identical files for the same operations
+ * - Positioned header rewrites land after batched appends
+ * - Unavailable backends fall back to stdio
+ * - mmap-written index files stay readable while live and are truncated
+ *   to their logical size at finalize
+ */
+
+#include <gtest/gtest.h>
+#include <tracer_backend/atf/atf_v2_types.h>
+#include <tracer_backend/atf/atf_thread_writer.h>
+#include "atf_file_sink_private.h"
+#include "atf_index_writer_private.h"
+#include <sys/stat.h>
+#include <errno.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/* ===== Helper Functions ===== */
+
+static std::string get_temp_dir() {
+    return "/tmp/atf_file_sink_tests";
+}
+
+static void cleanup_temp_dir() {
+    std::string cmd = "rm -rf " + get_temp_dir();
+    system(cmd.c_str());
+}
+
+static void make_temp_dir() {
+    cleanup_temp_dir();
+    std::string cmd = "mkdir -p " + get_temp_dir();
+    system(cmd.c_str());
+}
+
+static std::vector<uint8_t> read_file(const std::string& path) {
+    std::vector<uint8_t> bytes;
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f) return bytes;
+    uint8_t chunk[4096];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0) {
+        bytes.insert(bytes.end(), chunk, chunk + n);
+    }
+    fclose(f);
+    return bytes;
+}
+
+// Append a pattern in odd-sized pieces (crossing staging buffer boundaries),
+// then patch a 64-byte header at offset 0.
+static void write_pattern(AtfFileSink* sink, size_t total) {
+    std::vector<uint8_t> data(total);
+    for (size_t i = 0; i < total; i++) {
+        data[i] = (uint8_t)(i * 131u + 7u);
+    }
+
+    size_t pos = 0;
+    size_t piece = 1;
+    while (pos < total) {
+        size_t n = std::min(piece, total - pos);
+        ASSERT_EQ(atf_file_sink_append(sink, data.data() + pos, n), 0);
+        pos += n;
+        piece = (piece * 7 + 13) % 100000 + 1;
+    }
+    ASSERT_EQ(sink->size, total);
+
+    uint8_t header[64];
+    memset(header, 0xAB, sizeof(header));
+    ASSERT_EQ(atf_file_sink_write_at(sink, header, sizeof(header), 0), 0);
+    ASSERT_EQ(atf_file_sink_flush(sink), 0);
+}
+
+static uint64_t file_size(const std::string& path) {
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) return 0;
+    return (uint64_t)st.st_size;
+}
+
+static std::vector<uint8_t> expected_pattern(size_t total) {
+    std::vector<uint8_t> data(total);
+    for (size_t i = 0; i < total; i++) {
+        data[i] = (i < 64) ? 0xAB : (uint8_t)(i * 131u + 7u);
+    }
+    return data;
+}
+
+/* ===== Sink Tests ===== */
+
+TEST(AtfFileSink, Stdio_AppendAndWriteAt_FileMatches) {
+    make_temp_dir();
+    std::string path = get_temp_dir() + "/stdio.bin";
+
+    AtfFileSink* sink = atf_file_sink_open(path.c_str(), ATF_WRITER_BACKEND_STDIO);
+    ASSERT_NE(sink, nullptr);
+    EXPECT_EQ(sink->backend, ATF_WRITER_BACKEND_STDIO);
+    write_pattern(sink, 3 * 1024 * 1024 + 17);
+    atf_file_sink_close(sink);
+
+    EXPECT_EQ(read_file(path), expected_pattern(3 * 1024 * 1024 + 17));
+    cleanup_temp_dir();
+}
+
+TEST(AtfFileSink, IoUring_AppendAndWriteAt_FileMatches) {
+    make_temp_dir();
+    std::string path = get_temp_dir() + "/uring.bin";
+
+    AtfFileSink* sink = atf_file_sink_open(path.c_str(), ATF_WRITER_BACKEND_IO_URING);
+    ASSERT_NE(sink, nullptr);
+    if (sink->backend != ATF_WRITER_BACKEND_IO_URING) {
+        atf_file_sink_close(sink);
+        cleanup_temp_dir();
+        GTEST_SKIP() << "io_uring not available on this host";
+    }
+    write_pattern(sink, 3 * 1024 * 1024 + 17);
+    atf_file_sink_close(sink);
+
+    EXPECT_EQ(read_file(path), expected_pattern(3 * 1024 * 1024 + 17));
+    cleanup_temp_dir();
+}
+
+TEST(AtfFileSink, IoUring_CloseWithoutFlush_WritesStagedData) {
+    make_temp_dir();
+    std::string path = get_temp_dir() + "/uring_close.bin";
+
+    AtfFileSink* sink = atf_file_sink_open(path.c_str(), ATF_WRITER_BACKEND_AUTO);
+    ASSERT_NE(sink, nullptr);
+    uint8_t data[100];
+    memset(data, 0x5A, sizeof(data));
+    ASSERT_EQ(atf_file_sink_append(sink, data, sizeof(data)), 0);
+    atf_file_sink_close(sink);
+
+    std::vector<uint8_t> bytes = read_file(path);
+    ASSERT_EQ(bytes.size(), sizeof(data));
+    EXPECT_EQ(memcmp(bytes.data(), data, sizeof(data)), 0);
+    cleanup_temp_dir();
+}
+
+TEST(AtfFileSink, Mmap_AppendAndWriteAt_FileMatches) {
+    make_temp_dir();
+    std::string path = get_temp_dir() + "/mmap.bin";
+
+    // Large enough to grow (and remap) past the first preallocated extent
+    const size_t total = 9 * 1024 * 1024 + 17;
+    AtfFileSink* sink = atf_file_sink_open(path.c_str(), ATF_WRITER_BACKEND_MMAP);
+    ASSERT_NE(sink, nullptr);
+    EXPECT_EQ(sink->backend, ATF_WRITER_BACKEND_MMAP);
+    write_pattern(sink, total);
+    atf_file_sink_close(sink);
+
+    EXPECT_EQ(read_file(path), expected_pattern(total));
+    cleanup_temp_dir();
+}
+
+TEST(AtfFileSink, Mmap_Preallocates_ThenFlushTruncatesToSize) {
+    make_temp_dir();
+    std::string path = get_temp_dir() + "/mmap_prealloc.bin";
+
+    AtfFileSink* sink = atf_file_sink_open(path.c_str(), ATF_WRITER_BACKEND_MMAP);
+    ASSERT_NE(sink, nullptr);
+    EXPECT_EQ(atf_file_sink_mapping(sink), nullptr);
+
+    uint8_t data[100];
+    memset(data, 0x11, sizeof(data));
+    ASSERT_EQ(atf_file_sink_append(sink, data, sizeof(data)), 0);
+    ASSERT_NE(atf_file_sink_mapping(sink), nullptr);
+    EXPECT_EQ(memcmp(atf_file_sink_mapping(sink), data, sizeof(data)), 0);
+    EXPECT_GT(file_size(path), sizeof(data));  // Whole extent reserved
+
+    ASSERT_EQ(atf_file_sink_flush(sink), 0);
+    EXPECT_EQ(file_size(path), sizeof(data));
+
+    // Appending after a flush re-extends the file
+    ASSERT_EQ(atf_file_sink_append(sink, data, sizeof(data)), 0);
+    atf_file_sink_close(sink);
+    EXPECT_EQ(file_size(path), 2 * sizeof(data));
+    cleanup_temp_dir();
+}
+
+TEST(AtfFileSink, Mapping_NonMmapBackend_ReturnsNull) {
+    make_temp_dir();
+    std::string path = get_temp_dir() + "/stdio_mapping.bin";
+    AtfFileSink* sink = atf_file_sink_open(path.c_str(), ATF_WRITER_BACKEND_STDIO);
+    ASSERT_NE(sink, nullptr);
+    EXPECT_EQ(atf_file_sink_mapping(sink), nullptr);
+    EXPECT_EQ(atf_file_sink_mapping(NULL), nullptr);
+    atf_file_sink_close(sink);
+    cleanup_temp_dir();
+}
+
+TEST(AtfFileSink, WriteAt_BeyondSize_ReturnsError) {
+    make_temp_dir();
+    const AtfWriterBackend backends[] = {ATF_WRITER_BACKEND_STDIO, ATF_WRITER_BACKEND_IO_URING,
+                                         ATF_WRITER_BACKEND_MMAP};
+    for (AtfWriterBackend backend : backends) {
+        std::string path = get_temp_dir() + "/beyond.bin";
+        AtfFileSink* sink = atf_file_sink_open(path.c_str(), backend);
+        ASSERT_NE(sink, nullptr);
+        uint8_t data[16] = {0};
+        ASSERT_EQ(atf_file_sink_append(sink, data, sizeof(data)), 0);
+        EXPECT_EQ(atf_file_sink_write_at(sink, data, sizeof(data), 8), -EINVAL);
+        atf_file_sink_close(sink);
+    }
+    cleanup_temp_dir();
+}
+
+TEST(AtfFileSink, Open_InvalidPath_ReturnsNull) {
+    const AtfWriterBackend backends[] = {ATF_WRITER_BACKEND_STDIO,
+                                         ATF_WRITER_BACKEND_IO_URING,
+                                         ATF_WRITER_BACKEND_AUTO,
+                                         ATF_WRITER_BACKEND_MMAP};
+    for (AtfWriterBackend backend : backends) {
+        EXPECT_EQ(atf_file_sink_open("/nonexistent_dir_for_atf/x.bin", backend), nullptr);
+        EXPECT_EQ(atf_file_sink_open(NULL, backend), nullptr);
+    }
+}
+
+TEST(AtfFileSink, CloseNull_NoCrash) {
+    atf_file_sink_close(NULL);
+}
+
+/* ===== Thread Writer Backend Tests ===== */
+
+static void write_session(const std::string& session_dir, AtfWriterBackend backend) {
+    AtfThreadWriter* writer = atf_thread_writer_create_with_backend(
+        session_dir.c_str(), 3, ATF_CLOCK_MACH_CONTINUOUS, backend);
+    ASSERT_NE(writer, nullptr);
+
+    IndexEvent span[64];
+    memset(span, 0, sizeof(span));
+    uint8_t payload[40];
+    memset(payload, 0x42, sizeof(payload));
+
+    for (uint32_t round = 0; round < 400; round++) {
+        for (uint32_t i = 0; i < 64; i++) {
+            span[i].timestamp_ns = round * 1000ull + i;
+            span[i].function_id = 0x100000000ull + i;
+            span[i].thread_id = 3;
+            span[i].event_kind = ATF_EVENT_KIND_CALL;
+            span[i].detail_seq = ATF_NO_DETAIL_SEQ;
+        }
+        ASSERT_EQ(atf_thread_writer_write_index_span(writer, span, 64), 0);
+        ASSERT_NE(atf_thread_writer_write_event(writer, round * 1000ull + 999, 0x200000000ull,
+                                                ATF_EVENT_KIND_RETURN, 1,
+                                                payload, sizeof(payload)),
+                  UINT32_MAX);
+    }
+
+    ASSERT_EQ(atf_thread_writer_finalize(writer), 0);
+    atf_thread_writer_close(writer);
+}
+
+TEST(AtfThreadWriter, Backends_ProduceIdenticalFiles) {
+    cleanup_temp_dir();
+    std::string stdio_dir = get_temp_dir() + "/stdio";
+    std::string uring_dir = get_temp_dir() + "/uring";
+
+    write_session(stdio_dir, ATF_WRITER_BACKEND_STDIO);
+    write_session(uring_dir, ATF_WRITER_BACKEND_IO_URING);
+
+    for (const char* name : {"/thread_3/index.atf", "/thread_3/detail.atf"}) {
+        std::vector<uint8_t> expected = read_file(stdio_dir + name);
+        std::vector<uint8_t> actual = read_file(uring_dir + name);
+        ASSERT_FALSE(expected.empty()) << name;
+        EXPECT_EQ(actual, expected) << name;
+    }
+
+    std::vector<uint8_t> index = read_file(uring_dir + "/thread_3/index.atf");
+    AtfIndexHeader header;
+    memcpy(&header, index.data(), sizeof(header));
+    EXPECT_EQ(memcmp(header.magic, "ATI2", 4), 0);
+    EXPECT_EQ(header.event_count, 400u * 65u);
+    EXPECT_EQ(header.footer_offset, 64u + 400u * 65u * sizeof(IndexEvent));
+    EXPECT_EQ(index.size(), header.footer_offset + sizeof(AtfIndexFooter));
+
+    cleanup_temp_dir();
+}
+
+/* ===== Live mmap Index Tests ===== */
+
+TEST(AtfIndexWriter, Mmap_LiveHeader_TracksCountBeforeFinalize) {
+    make_temp_dir();
+    std::string path = get_temp_dir() + "/index.atf";
+    AtfIndexWriter* writer = atf_index_writer_create_with_backend(
+        path.c_str(), 7, ATF_CLOCK_MACH_CONTINUOUS, ATF_WRITER_BACKEND_MMAP);
+    ASSERT_NE(writer, nullptr);
+
+    IndexEvent events[5];
+    memset(events, 0, sizeof(events));
+    for (int i = 0; i < 5; i++) {
+        events[i].timestamp_ns = 100 + i;
+        events[i].thread_id = 7;
+        events[i].detail_seq = ATF_NO_DETAIL_SEQ;
+    }
+    ASSERT_EQ(atf_index_writer_write_events(writer, events, 4), 0);
+    ASSERT_EQ(atf_index_writer_write_event(writer, &events[4]), 0);
+
+    // A second reader sees the live count although no footer exists yet
+    std::vector<uint8_t> live = read_file(path);
+    ASSERT_GT(live.size(), 64u + 5 * sizeof(IndexEvent));  // Preallocated tail
+    AtfIndexHeader header;
+    memcpy(&header, live.data(), sizeof(header));
+    EXPECT_TRUE(header.flags & ATF_INDEX_FLAG_LIVE_EVENT_COUNT);
+    EXPECT_EQ(header.event_count, 5u);
+    EXPECT_EQ(header.time_start_ns, 100u);
+    EXPECT_EQ(header.time_end_ns, 104u);
+    IndexEvent last;
+    memcpy(&last, live.data() + 64 + 4 * sizeof(IndexEvent), sizeof(last));
+    EXPECT_EQ(last.timestamp_ns, 104u);
+
+    // Finalize truncates to footer_offset + sizeof(AtfIndexFooter)
+    ASSERT_EQ(atf_index_writer_finalize(writer), 0);
+    std::vector<uint8_t> done = read_file(path);
+    memcpy(&header, done.data(), sizeof(header));
+    EXPECT_EQ(header.footer_offset, 64u + 5 * sizeof(IndexEvent));
+    EXPECT_EQ(done.size(), header.footer_offset + sizeof(AtfIndexFooter));
+    AtfIndexFooter footer;
+    memcpy(&footer, done.data() + header.footer_offset, sizeof(footer));
+    EXPECT_EQ(memcmp(footer.magic, "2ITA", 4), 0);
+    EXPECT_EQ(footer.event_count, 5u);
+
+    atf_index_writer_close(writer);
+    EXPECT_EQ(file_size(path), header.footer_offset + sizeof(AtfIndexFooter));
+    cleanup_temp_dir();
+}
+
+TEST(AtfThreadWriter, Mmap_MatchesStdioExceptLiveFlag) {
+    cleanup_temp_dir();
+    std::string stdio_dir = get_temp_dir() + "/stdio";
+    std::string mmap_dir = get_temp_dir() + "/mmap";
+
+    write_session(stdio_dir, ATF_WRITER_BACKEND_STDIO);
+    write_session(mmap_dir, ATF_WRITER_BACKEND_MMAP);
+
+    std::vector<uint8_t> expected = read_file(stdio_dir + "/thread_3/detail.atf");
+    ASSERT_FALSE(expected.empty());
+    EXPECT_EQ(read_file(mmap_dir + "/thread_3/detail.atf"), expected);
+
+    expected = read_file(stdio_dir + "/thread_3/index.atf");
+    std::vector<uint8_t> actual = read_file(mmap_dir + "/thread_3/index.atf");
+    ASSERT_EQ(actual.size(), expected.size());
+    AtfIndexHeader header;
+    memcpy(&header, actual.data(), sizeof(header));
+    EXPECT_TRUE(header.flags & ATF_INDEX_FLAG_LIVE_EVENT_COUNT);
+    header.flags &= ~ATF_INDEX_FLAG_LIVE_EVENT_COUNT;
+    memcpy(actual.data(), &header, sizeof(header));
+    EXPECT_EQ(actual, expected);
+
+    cleanup_temp_dir();
+}
+
+TEST(AtfThreadWriter, GetBackend_ReportsBackendInUse) {
+    cleanup_temp_dir();
+    EXPECT_EQ(atf_thread_writer_get_backend(NULL), ATF_WRITER_BACKEND_STDIO);
+
+    AtfThreadWriter* writer = atf_thread_writer_create(
+        get_temp_dir().c_str(), 1, ATF_CLOCK_MACH_CONTINUOUS);
+    ASSERT_NE(writer, nullptr);
+    EXPECT_EQ(atf_thread_writer_get_backend(writer), ATF_WRITER_BACKEND_STDIO);
+    atf_thread_writer_close(writer);
+
+    writer = atf_thread_writer_create_with_backend(
+        get_temp_dir().c_str(), 2, ATF_CLOCK_MACH_CONTINUOUS, ATF_WRITER_BACKEND_AUTO);
+    ASSERT_NE(writer, nullptr);
+    AtfWriterBackend backend = atf_thread_writer_get_backend(writer);
+    EXPECT_TRUE(backend == ATF_WRITER_BACKEND_STDIO || backend == ATF_WRITER_BACKEND_IO_URING);
+    EXPECT_NE(backend, ATF_WRITER_BACKEND_AUTO);
+    atf_thread_writer_close(writer);
+
+    cleanup_temp_dir();
+}
@@ -238,6 +238,62 @@ TEST(AtfIndexWriter, WriteEvent_NullEvent_ReturnsError) {
     cleanup_temp_dir();
 }
 
+// Span write: NULL arguments and empty spans
+TEST(AtfIndexWriter, WriteEvents_InvalidArgs_ReturnsError) {
+    IndexEvent event;
+    memset(&event, 0, sizeof(event));
+    EXPECT_EQ(atf_index_writer_write_events(NULL, &event, 1), -EINVAL);
+
+    cleanup_temp_dir();
+    std::string path = get_temp_dir() + "/thread_1/index.atf";
+    AtfIndexWriter* writer = atf_index_writer_create(path.c_str(), 1, ATF_CLOCK_MACH_CONTINUOUS);
+    ASSERT_NE(writer, nullptr);
+
+    EXPECT_EQ(atf_index_writer_write_events(writer, NULL, 1), -EINVAL);
+    EXPECT_EQ(atf_index_writer_write_events(writer, NULL, 0), 0);
+    EXPECT_EQ(writer->event_count, 0u);
+
+    atf_index_writer_close(writer);
+    cleanup_temp_dir();
+}
+
+// Span write: events land contiguously and update time range
+TEST(AtfIndexWriter, WriteEvents_Span_UpdatesCountsAndTimeRange) {
+    cleanup_temp_dir();
+    std::string path = get_temp_dir() + "/thread_1/index.atf";
+    AtfIndexWriter* writer = atf_index_writer_create(path.c_str(), 1, ATF_CLOCK_MACH_CONTINUOUS);
+    ASSERT_NE(writer, nullptr);
+
+    IndexEvent events[4];
+    memset(events, 0, sizeof(events));
+    for (int i = 0; i < 4; i++) {
+        events[i].timestamp_ns = 1000 + i;
+        events[i].function_id = 0x100000000ull + i;
+        events[i].detail_seq = ATF_NO_DETAIL_SEQ;
+    }
+
+    EXPECT_EQ(atf_index_writer_write_events(writer, events, 3), 0);
+    EXPECT_EQ(atf_index_writer_write_events(writer, events + 3, 1), 0);
+    EXPECT_EQ(writer->event_count, 4u);
+    EXPECT_EQ(writer->time_start_ns, 1000u);
+    EXPECT_EQ(writer->time_end_ns, 1003u);
+    ASSERT_EQ(atf_index_writer_finalize(writer), 0);
+    atf_index_writer_close(writer);
+
+    FILE* f = fopen(path.c_str(), "rb");
+    ASSERT_NE(f, nullptr);
+    AtfIndexHeader header;
+    ASSERT_EQ(fread(&header, sizeof(header), 1, f), 1u);
+    EXPECT_EQ(header.event_count, 4u);
+    IndexEvent read_back[4];
+    ASSERT_EQ(fread(read_back, sizeof(IndexEvent), 4, f), 4u);
+    for (int i = 0; i < 4; i++) {
+        EXPECT_EQ(read_back[i].timestamp_ns, 1000u + i);
+    }
+    fclose(f);
+    cleanup_temp_dir();
+}
+
 // US-005: Cover finalize with NULL writer
 TEST(AtfIndexWriter, Finalize_NullWriter_ReturnsError) {
     int ret = atf_index_writer_finalize(NULL);
@@ -408,6 +464,55 @@ TEST(AtfThreadWriter, Finalize_NoDetailWriter_Success) {
     cleanup_temp_dir();
 }
 
+// Span write through the thread writer passes ring records through verbatim
+TEST(AtfThreadWriter, WriteIndexSpan_WritesRecordsVerbatim) {
+    cleanup_temp_dir();
+    std::string session_dir = get_temp_dir();
+
+    AtfThreadWriter* writer = atf_thread_writer_create(session_dir.c_str(), 7, ATF_CLOCK_MACH_CONTINUOUS);
+    ASSERT_NE(writer, nullptr);
+
+    EXPECT_EQ(atf_thread_writer_write_index_span(NULL, NULL, 0), -EINVAL);
+    EXPECT_EQ(atf_thread_writer_write_index_span(writer, NULL, 1), -EINVAL);
+    EXPECT_EQ(atf_thread_writer_write_index_span(writer, NULL, 0), 0);
+
+    // Ring records are produced as final on-disk records
+    IndexEvent ring_records[3];
+    memset(ring_records, 0, sizeof(ring_records));
+    for (int i = 0; i < 3; i++) {
+        ring_records[i].timestamp_ns = 500 + i;
+        ring_records[i].function_id = 0x200000000ull + i;
+        ring_records[i].thread_id = 7;
+        ring_records[i].event_kind = ATF_EVENT_KIND_CALL;
+        ring_records[i].call_depth = i;
+        ring_records[i].detail_seq = (i == 1) ? 42u : ATF_NO_DETAIL_SEQ;
+    }
+    EXPECT_EQ(atf_thread_writer_write_index_span(writer, ring_records, 3), 0);
+
+    // Per-event writes continue the sequence after the span
+    uint32_t seq = atf_thread_writer_write_event(writer, 600, 0x200000010ull,
+                                                 ATF_EVENT_KIND_RETURN, 0, NULL, 0);
+    EXPECT_EQ(seq, 3u);
+
+    ASSERT_EQ(atf_thread_writer_finalize(writer), 0);
+    atf_thread_writer_close(writer);
+
+    std::string path = session_dir + "/thread_7/index.atf";
+    FILE* f = fopen(path.c_str(), "rb");
+    ASSERT_NE(f, nullptr);
+    AtfIndexHeader header;
+    ASSERT_EQ(fread(&header, sizeof(header), 1, f), 1u);
+    EXPECT_EQ(header.event_count, 4u);
+    IndexEvent read_back[4];
+    ASSERT_EQ(fread(read_back, sizeof(IndexEvent), 4, f), 4u);
+    EXPECT_EQ(memcmp(read_back, ring_records, sizeof(ring_records)), 0);
+    EXPECT_EQ(read_back[3].timestamp_ns, 600u);
+    EXPECT_EQ(read_back[3].thread_id, 7u);
+    EXPECT_EQ(read_back[3].detail_seq, ATF_NO_DETAIL_SEQ);
+    fclose(f);
+    cleanup_temp_dir();
+}
+
 // US-005: Cover close without finalize
 TEST(AtfThreadWriter, Close_WithoutFinalize_NoCrash) {
     cleanup_temp_dir();
@@ -114,7 +114,7 @@ TEST_F(ControllerCoverageTest, controller__create_with_output__then_initializes_
             .thread_id = 1234,
             .event_kind = EVENT_KIND_CALL,
             .call_depth = 0,
-            ._padding = 0
+            .detail_seq = INDEX_EVENT_NO_DETAIL_SEQ
         };
         ring_buffer_write(index_rb, &idx_event);
 
@@ -170,7 +170,7 @@ TEST_F(ControllerEnvPropagationTest, controller__spawn_and_drain_events__then_st
         .thread_id = 1234,
         .event_kind = EVENT_KIND_CALL,
         .call_depth = 0,
-        ._padding = 0
+        .detail_seq = INDEX_EVENT_NO_DETAIL_SEQ
     };
     ring_buffer_write(index_rb, &idx_event);
 
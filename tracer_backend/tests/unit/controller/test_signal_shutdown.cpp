@@ -277,12 +277,20 @@ TEST_F(ShutdownManagerTest, shutdown_state_init__zero_capacity__then_uses_max_th
     EXPECT_EQ(capacity, MAX_THREADS);
 }
 
-TEST_F(ShutdownManagerTest, shutdown_state_init__excessive_capacity__then_uses_max_threads) {
+TEST_F(ShutdownManagerTest, shutdown_state_init__excessive_capacity__then_uses_max_capacity) {
+    ShutdownState state;
+    shutdown_state_init(&state, THREAD_REGISTRY_MAX_CAPACITY + 100);
+
+    uint32_t capacity = atomic_load_explicit(&state.capacity, memory_order_acquire);
+    EXPECT_EQ(capacity, THREAD_REGISTRY_MAX_CAPACITY);
+}
+
+TEST_F(ShutdownManagerTest, shutdown_state_init__capacity_above_default__then_kept) {
     ShutdownState state;
     shutdown_state_init(&state, MAX_THREADS + 100);
 
     uint32_t capacity = atomic_load_explicit(&state.capacity, memory_order_acquire);
-    EXPECT_EQ(capacity, MAX_THREADS);
+    EXPECT_EQ(capacity, MAX_THREADS + 100);
 }
 
 TEST_F(ShutdownManagerTest, shutdown_state_init__valid_capacity__then_initializes_correctly) {
@@ -1206,18 +1214,18 @@ TEST_F(ShutdownManagerTest, duration_calculation__negative_time__then_returns_ze
 
 TEST_F(ShutdownManagerTest, events_in_flight_calculation__excessive_capacity__then_caps_correctly) {
     // Set up state with threads beyond normal capacity
-    for (uint32_t i = 0; i < MAX_THREADS; ++i) {
+    for (uint32_t i = 0; i < THREAD_REGISTRY_MAX_CAPACITY; ++i) {
         atomic_store_explicit(&state_.threads[i].pending_events, 10, memory_order_release);
     }
-    atomic_store_explicit(&state_.capacity, MAX_THREADS + 100, memory_order_release);
+    atomic_store_explicit(&state_.capacity, THREAD_REGISTRY_MAX_CAPACITY + 100, memory_order_release);
 
     testing::internal::CaptureStderr();
     shutdown_manager_print_summary(&manager_);
     std::string stderr_output = testing::internal::GetCapturedStderr();
 
     using ::testing::HasSubstr;
-    // Should process only MAX_THREADS worth of events
-    uint64_t expected_events = MAX_THREADS * 10;
+    // Should process only THREAD_REGISTRY_MAX_CAPACITY worth of events
+    uint64_t expected_events = THREAD_REGISTRY_MAX_CAPACITY * 10;
     EXPECT_THAT(stderr_output, HasSubstr("Events In Flight at Shutdown: " + std::to_string(expected_events)));
 }
 
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+extern "C" {
+#include <drain_thread/drain_slot_deque.h>
+}
+
+TEST(DrainSlotDeque, slot_deque__push_then_pop__then_lifo_order) {
+  DrainSlotDeque dq;
+  drain_slot_deque_init(&dq);
+
+  EXPECT_EQ(drain_slot_deque_pop(&dq), DRAIN_SLOT_DEQUE_EMPTY);
+  ASSERT_TRUE(drain_slot_deque_push(&dq, 3));
+  ASSERT_TRUE(drain_slot_deque_push(&dq, 7));
+  EXPECT_EQ(drain_slot_deque_size(&dq), 2u);
+
+  EXPECT_EQ(drain_slot_deque_pop(&dq), 7u);
+  EXPECT_EQ(drain_slot_deque_pop(&dq), 3u);
+  EXPECT_EQ(drain_slot_deque_pop(&dq), DRAIN_SLOT_DEQUE_EMPTY);
+  EXPECT_EQ(drain_slot_deque_size(&dq), 0u);
+}
+
+TEST(DrainSlotDeque, slot_deque__push_then_steal__then_fifo_order) {
+  DrainSlotDeque dq;
+  drain_slot_deque_init(&dq);
+
+  EXPECT_EQ(drain_slot_deque_steal(&dq), DRAIN_SLOT_DEQUE_EMPTY);
+  ASSERT_TRUE(drain_slot_deque_push(&dq, 1));
+  ASSERT_TRUE(drain_slot_deque_push(&dq, 2));
+  ASSERT_TRUE(drain_slot_deque_push(&dq, 3));
+
+  EXPECT_EQ(drain_slot_deque_steal(&dq), 1u);
+  EXPECT_EQ(drain_slot_deque_pop(&dq), 3u);
+  EXPECT_EQ(drain_slot_deque_steal(&dq), 2u);
+  EXPECT_EQ(drain_slot_deque_steal(&dq), DRAIN_SLOT_DEQUE_EMPTY);
+  EXPECT_EQ(drain_slot_deque_pop(&dq), DRAIN_SLOT_DEQUE_EMPTY);
+}
+
+TEST(DrainSlotDeque, slot_deque__full__then_push_rejected) {
+  DrainSlotDeque dq;
+  drain_slot_deque_init(&dq);
+
+  for (uint32_t i = 0; i < DRAIN_SLOT_DEQUE_CAPACITY; ++i) {
+    ASSERT_TRUE(drain_slot_deque_push(&dq, i));
+  }
+  EXPECT_FALSE(drain_slot_deque_push(&dq, 99));
+
+  EXPECT_EQ(drain_slot_deque_steal(&dq), 0u);
+  EXPECT_TRUE(drain_slot_deque_push(&dq, 99));
+  EXPECT_EQ(drain_slot_deque_pop(&dq), 99u);
+}
+
+TEST(DrainSlotDeque, slot_deque__owner_and_thieves_race__then_each_slot_taken_once) {
+  DrainSlotDeque dq;
+  drain_slot_deque_init(&dq);
+
+  constexpr uint32_t kRounds = 20000;
+  constexpr int kThieves = 3;
+  std::vector<std::atomic<uint32_t>> taken(kRounds);
+  for (auto &count : taken) {
+    count.store(0);
+  }
+  std::atomic<bool> done{false};
+
+  // Slot values are round numbers; the deque never holds more than two
+  auto record = [&](uint32_t slot) {
+    if (slot != DRAIN_SLOT_DEQUE_EMPTY) {
+      taken[slot].fetch_add(1);
+    }
+  };
+
+  std::vector<std::thread> thieves;
+  for (int t = 0; t < kThieves; ++t) {
+    thieves.emplace_back([&] {
+      while (!done.load()) {
+        record(drain_slot_deque_steal(&dq));
+      }
+    });
+  }
+
+  for (uint32_t round = 0; round < kRounds; round += 2) {
+    ASSERT_TRUE(drain_slot_deque_push(&dq, round));
+    ASSERT_TRUE(drain_slot_deque_push(&dq, round + 1));
+    record(drain_slot_deque_pop(&dq));
+    record(drain_slot_deque_pop(&dq));
+  }
+  done.store(true);
+  for (auto &thief : thieves) {
+    thief.join();
+  }
+
+  for (uint32_t i = 0; i < kRounds; ++i) {
+    EXPECT_EQ(taken[i].load(), 1u) << "slot " << i;
+  }
+}
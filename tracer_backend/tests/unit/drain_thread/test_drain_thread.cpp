@@ -6,6 +6,7 @@
 #include <errno.h>
 #include <cstdlib>
 #include <memory>
+#include <string>
 #include <thread>
 #include <unistd.h>
 #include <vector>
@@ -16,6 +17,8 @@ extern "C" {
 #include <tracer_backend/atf/atf_thread_writer.h>
 #include <tracer_backend/drain_thread/drain_thread.h>
 #include <tracer_backend/utils/control_block_ipc.h>
+#include <tracer_backend/utils/drain_wake.h>
+#include <tracer_backend/utils/ring_buffer.h>
 #include <tracer_backend/utils/thread_registry.h>
 
 void drain_thread_test_set_state(DrainThread *drain, DrainState state);
@@ -31,6 +34,10 @@ bool drain_thread_test_cycle(DrainThread *drain, bool final_pass);
 void drain_thread_test_return_ring(Lane *lane, uint32_t ring_idx);
 void drain_thread_test_update_control_block(DrainThread *drain);
 void *drain_thread_test_worker_entry(void *arg);
+bool drain_thread_test_worker_cycle(DrainThread *drain, uint32_t worker_index,
+                                    bool final_pass);
+bool drain_thread_test_enqueue_slot(DrainThread *drain, uint32_t worker_index,
+                                    uint32_t slot);
 }
 
 namespace {
@@ -40,6 +47,7 @@ struct HookConfig {
   int mutex_init_rc{0};
   bool override_pthread_create{false};
   int pthread_create_rc{0};
+  int pthread_create_real_calls{-1}; // Creates allowed before failing (-1 = off)
   bool override_pthread_join{false};
   int pthread_join_rc{0};
   int lane_return_failures{0};
@@ -77,6 +85,12 @@ void configure_pthread_create_failure(int rc) {
   state.pthread_create_rc = rc;
 }
 
+void configure_pthread_create_failure_after(int real_calls, int rc) {
+  auto &state = hook_state();
+  state.pthread_create_real_calls = real_calls;
+  state.pthread_create_rc = rc;
+}
+
 void configure_pthread_join_override(int rc) {
   auto &state = hook_state();
   state.override_pthread_join = true;
@@ -200,6 +214,11 @@ extern "C" int drain_thread_test_override_pthread_create(
   }
   auto &state = hook_state();
   ++state.pthread_create_calls;
+  if (state.pthread_create_real_calls >= 0 &&
+      state.pthread_create_calls > state.pthread_create_real_calls) {
+    *handled = true;
+    return state.pthread_create_rc;
+  }
   if (state.override_pthread_create) {
     *handled = true;
     return state.pthread_create_rc;
@@ -285,6 +304,13 @@ TEST(DrainThreadUnit,
   EXPECT_EQ(drain_thread_create(nullptr, nullptr), nullptr);
 }
 
+TEST(DrainThreadUnit,
+     drain_config_default__writer_backend__then_buffered_stdio) {
+  DrainConfig config;
+  drain_config_default(&config);
+  EXPECT_EQ(config.writer_backend, ATF_WRITER_BACKEND_STDIO);
+}
+
 TEST(DrainThreadUnit,
      drain_thread__start_and_stop_without_work__then_idle_metrics_increment) {
   RegistryHarness harness(4);
@@ -560,6 +586,46 @@ TEST(DrainThreadUnit,
   drain_thread_destroy(drain);
 }
 
+TEST(DrainThreadUnit,
+     drain_thread__retired_thread_with_pending_ring__then_drained_and_slot_reclaimed) {
+  RegistryHarness harness(4);
+
+  ThreadLaneSet *lanes = thread_registry_register(harness.registry, 0x5A5A);
+  ASSERT_NE(lanes, nullptr);
+  uint32_t slot = thread_lanes_get_slot_index(lanes);
+  Lane *index_lane = thread_lanes_get_index_lane(lanes);
+  ASSERT_TRUE(submit_ring_with_retry(index_lane));
+  ASSERT_TRUE(thread_registry_retire(harness.registry, lanes));
+
+  DrainConfig config;
+  drain_config_default(&config);
+  config.poll_interval_us = 0;
+
+  DrainThread *drain = create_drain(harness, &config);
+  ASSERT_NE(drain, nullptr);
+
+  // First cycle drains the exited thread's ring; later idle cycles reclaim
+  EXPECT_TRUE(drain_thread_test_cycle(drain, false));
+  EXPECT_NE(thread_registry_get_thread_at(harness.registry, slot), nullptr);
+  for (int i = 0; i < 3; ++i) {
+    drain_thread_test_cycle(drain, false);
+  }
+
+  DrainMetrics metrics{};
+  drain_thread_get_metrics(drain, &metrics);
+  EXPECT_GE(metrics.rings_index, 1u);
+  EXPECT_EQ(metrics.slots_reclaimed, 1u);
+  EXPECT_EQ(thread_registry_get_thread_at(harness.registry, slot), nullptr);
+
+  ThreadLaneSet *next = thread_registry_register(harness.registry, 0x5A5B);
+  ASSERT_NE(next, nullptr);
+  EXPECT_EQ(thread_lanes_get_slot_index(next), slot);
+  drain_thread_get_metrics(drain, &metrics);
+  EXPECT_EQ(metrics.slots_reused, 1u);
+
+  drain_thread_destroy(drain);
+}
+
 TEST(DrainThreadUnit,
      drain_thread__final_drain_flushes_pending_work__then_all_rings_processed) {
   RegistryHarness harness(4);
@@ -1120,6 +1186,238 @@ TEST(DrainThreadUnit,
   system(("rm -rf " + std::string(session_dir)).c_str());
 }
 
+TEST(DrainThreadUnit,
+     drain_thread__counter_timestamps__then_manifest_records_calibration) {
+  HookScope guard;
+  RegistryHarness harness(2);
+  DrainThread *drain = create_drain(harness, nullptr);
+  ASSERT_NE(drain, nullptr);
+
+  ControlBlock cb{};
+  cb.timestamp.source = TIMESTAMP_SOURCE_COUNTER;
+  cb.timestamp.tick_base = 1000;
+  cb.timestamp.ns_base = 5000;
+  cb.timestamp.mult = 1ull << 32;
+  cb.timestamp.shift = 32;
+  cb.timestamp.ticks_per_sec = 1000000000ull;
+  drain_thread_set_control_block(drain, &cb);
+
+  const char* session_dir = "/tmp/ada_test_session_counter_clock";
+  system(("rm -rf " + std::string(session_dir)).c_str());
+  system(("mkdir -p " + std::string(session_dir)).c_str());
+
+  ASSERT_EQ(drain_thread_start_session(drain, session_dir), 0);
+  ASSERT_NE(drain_thread_get_atf_writer(drain, 0), nullptr);
+  EXPECT_EQ(drain_thread_stop_session(drain), 0);
+
+  std::string manifest_path = std::string(session_dir) + "/manifest.json";
+  FILE* manifest_file = fopen(manifest_path.c_str(), "r");
+  ASSERT_NE(manifest_file, nullptr);
+  char buf[4096] = {};
+  size_t n = fread(buf, 1, sizeof(buf) - 1, manifest_file);
+  fclose(manifest_file);
+  std::string manifest(buf, n);
+  EXPECT_NE(manifest.find("\"clock_type\": 4"), std::string::npos);
+  EXPECT_NE(manifest.find("\"clock_calibration\": {\"tick_base\": 1000, \"ns_base\": 5000"),
+            std::string::npos);
+
+  // Index header carries the same clock type (AtfIndexHeader.clock_type, byte 16)
+  std::string index_path = std::string(session_dir) + "/thread_0/index.atf";
+  FILE* index_file = fopen(index_path.c_str(), "rb");
+  ASSERT_NE(index_file, nullptr);
+  uint8_t header[64] = {};
+  ASSERT_EQ(fread(header, sizeof(header), 1, index_file), 1u);
+  fclose(index_file);
+  EXPECT_EQ(header[16], 4u); // ATF_CLOCK_COUNTER
+
+  drain_thread_destroy(drain);
+  system(("rm -rf " + std::string(session_dir)).c_str());
+}
+
+TEST(DrainThreadUnit,
+     drain_thread__session_detail_records__then_all_written_without_errors) {
+  HookScope guard;
+  RegistryHarness harness(2);
+
+  const char* session_dir = "/tmp/ada_test_session_detail_records";
+  system(("rm -rf " + std::string(session_dir)).c_str());
+  system(("mkdir -p " + std::string(session_dir)).c_str());
+
+  DrainThread *drain = create_drain(harness, nullptr);
+  ASSERT_NE(drain, nullptr);
+  ASSERT_EQ(drain_thread_start_session(drain, session_dir), 0);
+
+  ThreadLaneSet *lanes = thread_registry_register(harness.registry, 0x7D01);
+  ASSERT_NE(lanes, nullptr);
+  Lane *detail_lane = thread_lanes_get_detail_lane(lanes);
+  RingBufferHeader *hdr = thread_registry_get_active_ring_header(harness.registry, detail_lane);
+  ASSERT_NE(hdr, nullptr);
+
+  // Several records: the writer's index sequence climbs past 0 after the first
+  constexpr int kRecords = 3;
+  alignas(DETAIL_RECORD_ALIGN) uint8_t record[sizeof(DetailRecordHeader) + sizeof(DetailRecordPayload)] = {};
+  auto *rec = reinterpret_cast<DetailRecordHeader *>(record);
+  rec->total_length = sizeof(record);
+  rec->event_type = DETAIL_RECORD_CALL;
+  for (int i = 0; i < kRecords; ++i) {
+    rec->timestamp = 1000 + i;
+    reinterpret_cast<DetailRecordPayload *>(rec + 1)->function_id = 0x100 + i;
+    ASSERT_TRUE(ring_buffer_write_record_raw(hdr, record, sizeof(record)));
+  }
+
+  EXPECT_TRUE(drain_thread_test_cycle(drain, true));
+
+  DrainMetrics metrics{};
+  drain_thread_get_metrics(drain, &metrics);
+  EXPECT_EQ(metrics.total_events_drained, static_cast<uint64_t>(kRecords));
+  EXPECT_EQ(metrics.total_bytes_drained, static_cast<uint64_t>(kRecords) * sizeof(record));
+  EXPECT_EQ(metrics.write_errors, 0u);
+  EXPECT_EQ(metrics.events_lost, 0u);
+
+  EXPECT_EQ(drain_thread_stop_session(drain), 0);
+  uint32_t slot = thread_lanes_get_slot_index(lanes);
+  std::string detail_path = std::string(session_dir) + "/thread_" + std::to_string(slot) + "/detail.atf";
+  EXPECT_EQ(access(detail_path.c_str(), F_OK), 0);
+
+  drain_thread_destroy(drain);
+  system(("rm -rf " + std::string(session_dir)).c_str());
+}
+
+TEST(DrainThreadUnit,
+     drain_thread__reclaimed_slot_reused__then_new_thread_writes_fresh_stream) {
+  HookScope guard;
+  RegistryHarness harness(4);
+
+  const char* session_dir = "/tmp/ada_test_session_slot_reuse";
+  system(("rm -rf " + std::string(session_dir)).c_str());
+  system(("mkdir -p " + std::string(session_dir)).c_str());
+
+  DrainConfig config;
+  drain_config_default(&config);
+  config.poll_interval_us = 0;
+  DrainThread *drain = create_drain(harness, &config);
+  ASSERT_NE(drain, nullptr);
+  ASSERT_EQ(drain_thread_start_session(drain, session_dir), 0);
+
+  ThreadLaneSet *first = thread_registry_register(harness.registry, 0x6A01);
+  ASSERT_NE(first, nullptr);
+  uint32_t slot = thread_lanes_get_slot_index(first);
+  EXPECT_EQ(thread_lanes_get_stream_id(first), slot);
+  ASSERT_TRUE(submit_ring_with_retry(thread_lanes_get_index_lane(first)));
+  ASSERT_TRUE(thread_registry_retire(harness.registry, first));
+
+  for (int i = 0; i < 4; ++i) {
+    drain_thread_test_cycle(drain, false);
+  }
+  ASSERT_EQ(thread_registry_get_thread_at(harness.registry, slot), nullptr);
+
+  ThreadLaneSet *second = thread_registry_register(harness.registry, 0x6A02);
+  ASSERT_NE(second, nullptr);
+  ASSERT_EQ(thread_lanes_get_slot_index(second), slot);
+  // The new registration gets its own stream id, which names its files and
+  // is what the agent stamps into its index records
+  uint32_t reused_id = thread_lanes_get_stream_id(second);
+  EXPECT_EQ(reused_id, thread_registry_get_capacity(harness.registry));
+  ASSERT_TRUE(submit_ring_with_retry(thread_lanes_get_index_lane(second)));
+  EXPECT_TRUE(drain_thread_test_cycle(drain, false));
+
+  EXPECT_EQ(drain_thread_stop_session(drain), 0);
+
+  // Both lifetimes of the slot have their own stream and manifest entry
+  std::string first_dir = std::string(session_dir) + "/thread_" + std::to_string(slot);
+  std::string second_dir = std::string(session_dir) + "/thread_" + std::to_string(reused_id);
+  EXPECT_EQ(access((first_dir + "/index.atf").c_str(), F_OK), 0);
+  EXPECT_EQ(access((second_dir + "/index.atf").c_str(), F_OK), 0);
+
+  FILE *manifest_file = fopen((std::string(session_dir) + "/manifest.json").c_str(), "r");
+  ASSERT_NE(manifest_file, nullptr);
+  char buf[4096] = {};
+  size_t n = fread(buf, 1, sizeof(buf) - 1, manifest_file);
+  fclose(manifest_file);
+  std::string manifest(buf, n);
+  EXPECT_NE(manifest.find("{\"id\": " + std::to_string(slot) + ","), std::string::npos);
+  EXPECT_NE(manifest.find("{\"id\": " + std::to_string(reused_id) + ","), std::string::npos);
+
+  drain_thread_destroy(drain);
+  system(("rm -rf " + std::string(session_dir)).c_str());
+}
+
+TEST(DrainThreadUnit,
+     drain_thread__aggregate_interval__then_snapshot_written_before_stop) {
+  HookScope guard;
+  RegistryHarness harness(2);
+  DrainConfig config;
+  drain_config_default(&config);
+  config.aggregate_interval_ms = 5;
+  DrainThread *drain = create_drain(harness, &config);
+  ASSERT_NE(drain, nullptr);
+
+  AggregateTable *table = thread_registry_attach_aggregates(harness.registry, 0);
+  ASSERT_NE(table, nullptr);
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_TRUE(aggregate_table_record(table, 0x42, 10, 4));
+  }
+
+  const char* session_dir = "/tmp/ada_test_session_aggregates";
+  system(("rm -rf " + std::string(session_dir)).c_str());
+  system(("mkdir -p " + std::string(session_dir)).c_str());
+  ASSERT_EQ(drain_thread_start_session(drain, session_dir), 0);
+  ASSERT_EQ(drain_thread_start(drain), 0);
+
+  auto read_file = [](const std::string &path) {
+    std::string text;
+    FILE *f = fopen(path.c_str(), "r");
+    if (f) {
+      char buf[4096];
+      size_t n;
+      while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+        text.append(buf, n);
+      }
+      fclose(f);
+    }
+    return text;
+  };
+
+  // The running drain publishes the merged totals without a session stop
+  std::string aggregates_path = std::string(session_dir) + "/aggregates.json";
+  std::string snapshot;
+  auto start = std::chrono::steady_clock::now();
+  while (std::chrono::steady_clock::now() - start < std::chrono::seconds(2)) {
+    snapshot = read_file(aggregates_path);
+    if (!snapshot.empty()) {
+      break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_NE(snapshot.find("\"function_id\": \"0x0000000000000042\", \"calls\": 3"),
+            std::string::npos);
+
+  // Later calls show up in a subsequent snapshot
+  ASSERT_TRUE(aggregate_table_record(table, 0x42, 10, 4));
+  start = std::chrono::steady_clock::now();
+  while (std::chrono::steady_clock::now() - start < std::chrono::seconds(2)) {
+    snapshot = read_file(aggregates_path);
+    if (snapshot.find("\"calls\": 4") != std::string::npos) {
+      break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_NE(snapshot.find("\"calls\": 4"), std::string::npos);
+
+  // Stopping the drain ends the session with a final merge
+  ASSERT_TRUE(aggregate_table_record(table, 0x42, 10, 4));
+  ASSERT_EQ(drain_thread_stop(drain), 0);
+
+  // The final merge at stop still lands in both the manifest and the file
+  std::string manifest = read_file(std::string(session_dir) + "/manifest.json");
+  EXPECT_NE(manifest.find("\"aggregates\": {\"dropped_calls\": 0"), std::string::npos);
+  EXPECT_NE(manifest.find("\"calls\": 5"), std::string::npos);
+  EXPECT_NE(read_file(aggregates_path).find("\"calls\": 5"), std::string::npos);
+
+  drain_thread_destroy(drain);
+  system(("rm -rf " + std::string(session_dir)).c_str());
+}
+
 TEST(DrainThreadUnit,
      drain_thread__get_atf_writer_before_session__then_returns_null) {
   HookScope guard;
@@ -1204,7 +1502,7 @@ TEST(DrainThreadUnit,
 
   ASSERT_EQ(drain_thread_start_session(drain, session_dir), 0);
 
-  // Invalid thread ID (>= MAX_THREADS)
+  // Invalid thread ID (beyond the slot capacity)
   AtfThreadWriter* writer = drain_thread_get_atf_writer(drain, 9999);
   EXPECT_EQ(writer, nullptr);
 
@@ -1288,3 +1586,366 @@ TEST(DrainThreadUnit,
 
   drain_thread_destroy(drain);
 }
+
+TEST(DrainThreadUnit,
+     drain_thread__multiple_workers__then_all_slots_drained_and_sharded) {
+  HookScope guard;
+  RegistryHarness harness(8);
+
+  std::vector<Lane *> index_lanes;
+  for (uintptr_t id = 0x5101; id < 0x5105; ++id) {
+    ThreadLaneSet *lanes = thread_registry_register(harness.registry, id);
+    ASSERT_NE(lanes, nullptr);
+    index_lanes.push_back(thread_lanes_get_index_lane(lanes));
+  }
+
+  DrainConfig config;
+  drain_config_default(&config);
+  config.poll_interval_us = 0;
+  config.yield_on_idle = true;
+  config.worker_count = 2;
+
+  DrainThread *drain = create_drain(harness, &config);
+  ASSERT_NE(drain, nullptr);
+  ASSERT_EQ(drain_thread_start(drain), 0);
+
+  for (Lane *lane : index_lanes) {
+    ASSERT_TRUE(submit_ring_with_retry(lane));
+  }
+
+  DrainMetrics metrics = wait_for_metrics(drain, [](const DrainMetrics &m) {
+    return m.rings_total >= 4u && m.workers[0].slots_owned == 2u &&
+           m.workers[1].slots_owned == 2u;
+  });
+  EXPECT_GE(metrics.rings_total, 4u);
+  ASSERT_EQ(metrics.worker_count, 2u);
+  EXPECT_EQ(metrics.workers[0].slots_owned, 2u);
+  EXPECT_EQ(metrics.workers[1].slots_owned, 2u);
+  EXPECT_GE(metrics.workers[0].rebalances, 1u);
+  EXPECT_GE(metrics.workers[1].rebalances, 1u);
+  EXPECT_GE(metrics.workers[0].rings_total, 2u);
+  EXPECT_GE(metrics.workers[1].rings_total, 2u);
+  EXPECT_EQ(metrics.workers[0].rings_total + metrics.workers[1].rings_total,
+            metrics.rings_total);
+
+  for (Lane *lane : index_lanes) {
+    EXPECT_EQ(lane_take_ring(lane), UINT32_MAX);
+  }
+
+  ASSERT_EQ(drain_thread_stop(drain), 0);
+  EXPECT_EQ(drain_thread_get_state(drain), DRAIN_STATE_STOPPED);
+  drain_thread_destroy(drain);
+}
+
+TEST(DrainThreadUnit,
+     drain_thread__active_mask_changes__then_slots_rebalanced_across_workers) {
+  HookScope guard;
+  RegistryHarness harness(8);
+
+  DrainConfig config;
+  drain_config_default(&config);
+  config.poll_interval_us = 0;
+  config.yield_on_idle = true;
+  config.worker_count = 2;
+
+  DrainThread *drain = create_drain(harness, &config);
+  ASSERT_NE(drain, nullptr);
+  ASSERT_EQ(drain_thread_start(drain), 0);
+
+  ASSERT_NE(thread_registry_register(harness.registry, 0x5201), nullptr);
+  DrainMetrics metrics = wait_for_metrics(drain, [](const DrainMetrics &m) {
+    return m.workers[0].slots_owned + m.workers[1].slots_owned == 1u;
+  });
+  EXPECT_EQ(metrics.workers[0].slots_owned + metrics.workers[1].slots_owned, 1u);
+
+  ASSERT_NE(thread_registry_register(harness.registry, 0x5202), nullptr);
+  metrics = wait_for_metrics(drain, [](const DrainMetrics &m) {
+    return m.workers[0].slots_owned == 1u && m.workers[1].slots_owned == 1u;
+  });
+  EXPECT_EQ(metrics.workers[0].slots_owned, 1u);
+  EXPECT_EQ(metrics.workers[1].slots_owned, 1u);
+
+  ASSERT_TRUE(thread_registry_unregister_by_id(harness.registry, 0x5201));
+  metrics = wait_for_metrics(drain, [](const DrainMetrics &m) {
+    return m.workers[0].slots_owned + m.workers[1].slots_owned == 1u;
+  });
+  EXPECT_EQ(metrics.workers[0].slots_owned + metrics.workers[1].slots_owned, 1u);
+
+  ASSERT_EQ(drain_thread_stop(drain), 0);
+  drain_thread_destroy(drain);
+}
+
+TEST(DrainThreadUnit,
+     drain_thread__multiple_workers_stop_with_pending_rings__then_final_drain_empties_lanes) {
+  HookScope guard;
+  RegistryHarness harness(8);
+
+  std::vector<Lane *> lanes_to_fill;
+  for (uintptr_t id = 0x5301; id < 0x5304; ++id) {
+    ThreadLaneSet *lanes = thread_registry_register(harness.registry, id);
+    ASSERT_NE(lanes, nullptr);
+    lanes_to_fill.push_back(thread_lanes_get_index_lane(lanes));
+    lanes_to_fill.push_back(thread_lanes_get_detail_lane(lanes));
+  }
+
+  DrainConfig config;
+  drain_config_default(&config);
+  config.poll_interval_us = 50000; // Idle workers sleep through the submits
+  config.worker_count = 3;
+
+  DrainThread *drain = create_drain(harness, &config);
+  ASSERT_NE(drain, nullptr);
+  ASSERT_EQ(drain_thread_start(drain), 0);
+
+  for (Lane *lane : lanes_to_fill) {
+    ASSERT_TRUE(submit_ring_with_retry(lane));
+  }
+
+  ASSERT_EQ(drain_thread_stop(drain), 0);
+  EXPECT_EQ(drain_thread_get_state(drain), DRAIN_STATE_STOPPED);
+
+  DrainMetrics metrics{};
+  drain_thread_get_metrics(drain, &metrics);
+  EXPECT_EQ(metrics.rings_total, lanes_to_fill.size());
+  EXPECT_EQ(metrics.final_drains, 1u);
+  for (Lane *lane : lanes_to_fill) {
+    EXPECT_EQ(lane_take_ring(lane), UINT32_MAX);
+  }
+
+  drain_thread_destroy(drain);
+}
+
+TEST(DrainThreadUnit,
+     drain_thread__worker_count_out_of_range__then_clamped) {
+  HookScope guard;
+  RegistryHarness harness(2);
+
+  DrainConfig config;
+  drain_config_default(&config);
+  EXPECT_EQ(config.worker_count, 1u);
+
+  config.worker_count = 0;
+  DrainThread *drain = create_drain(harness, &config);
+  ASSERT_NE(drain, nullptr);
+  DrainMetrics metrics{};
+  drain_thread_get_metrics(drain, &metrics);
+  EXPECT_EQ(metrics.worker_count, 1u);
+  drain_thread_destroy(drain);
+
+  config.worker_count = DRAIN_MAX_WORKERS + 10;
+  drain = create_drain(harness, &config);
+  ASSERT_NE(drain, nullptr);
+  drain_thread_get_metrics(drain, &metrics);
+  EXPECT_EQ(metrics.worker_count, static_cast<uint32_t>(DRAIN_MAX_WORKERS));
+  drain_thread_destroy(drain);
+
+  config.worker_count = DRAIN_WORKERS_PER_CORE;
+  drain = create_drain(harness, &config);
+  ASSERT_NE(drain, nullptr);
+  drain_thread_get_metrics(drain, &metrics);
+  EXPECT_GE(metrics.worker_count, 1u);
+  EXPECT_LE(metrics.worker_count, static_cast<uint32_t>(DRAIN_MAX_WORKERS));
+  drain_thread_destroy(drain);
+}
+
+TEST(DrainThreadUnit,
+     drain_thread__shard_worker_create_fails__then_start_unwinds) {
+  HookScope guard;
+  RegistryHarness harness(4);
+
+  DrainConfig config;
+  drain_config_default(&config);
+  config.poll_interval_us = 0;
+  config.yield_on_idle = true;
+  config.worker_count = 2;
+
+  DrainThread *drain = create_drain(harness, &config);
+  ASSERT_NE(drain, nullptr);
+
+  // Let worker 0 start for real, then fail the second create
+  configure_pthread_create_failure_after(1, EAGAIN);
+  EXPECT_EQ(drain_thread_start(drain), EAGAIN);
+  EXPECT_EQ(drain_thread_get_state(drain), DRAIN_STATE_INITIALIZED);
+
+  HookScope::reset();
+  ASSERT_EQ(drain_thread_start(drain), 0);
+  ASSERT_EQ(drain_thread_stop(drain), 0);
+  drain_thread_destroy(drain);
+}
+
+TEST(DrainThreadUnit,
+     drain_thread__idle_worker_with_queued_peer_slot__then_steals_and_drains) {
+  HookScope guard;
+  RegistryHarness harness(4);
+
+  // Three active slots: worker 0 owns ranks 0 and 2, worker 1 owns rank 1
+  std::vector<ThreadLaneSet *> lanes;
+  for (uintptr_t id = 0x5401; id < 0x5404; ++id) {
+    lanes.push_back(thread_registry_register(harness.registry, id));
+    ASSERT_NE(lanes.back(), nullptr);
+  }
+  Lane *hot_lane = thread_lanes_get_index_lane(lanes[0]);
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_TRUE(submit_ring_with_retry(hot_lane));
+  }
+
+  DrainConfig config;
+  drain_config_default(&config);
+  config.worker_count = 2;
+  config.enable_work_stealing = true;
+
+  DrainThread *drain = create_drain(harness, &config);
+  ASSERT_NE(drain, nullptr);
+
+  // Slot 0 waits on worker 0's deque while worker 0 is busy elsewhere
+  ASSERT_TRUE(drain_thread_test_enqueue_slot(drain, 0, 0));
+  EXPECT_FALSE(drain_thread_test_enqueue_slot(drain, 0, 0));
+
+  DrainMetrics metrics{};
+  drain_thread_get_metrics(drain, &metrics);
+  EXPECT_EQ(metrics.workers[0].slots_queued, 1u);
+
+  EXPECT_TRUE(drain_thread_test_worker_cycle(drain, 1, false));
+  EXPECT_FALSE(lane_has_submitted_rings(hot_lane));
+
+  drain_thread_get_metrics(drain, &metrics);
+  EXPECT_EQ(metrics.workers[1].steals, 1u);
+  EXPECT_EQ(metrics.workers[1].rings_total, 3u);
+  EXPECT_EQ(metrics.workers[0].steals, 0u);
+  EXPECT_EQ(metrics.workers[0].slots_queued, 0u);
+  EXPECT_EQ(metrics.rings_per_thread[0][0], 3u);
+
+  // Slot is idle again and can be queued by its owner
+  EXPECT_TRUE(drain_thread_test_enqueue_slot(drain, 0, 0));
+
+  drain_thread_destroy(drain);
+}
+
+TEST(DrainThreadUnit,
+     drain_thread__work_stealing_burst__then_all_rings_drained) {
+  HookScope guard;
+  RegistryHarness harness(8);
+
+  std::vector<Lane *> index_lanes;
+  for (uintptr_t id = 0x5501; id < 0x5505; ++id) {
+    ThreadLaneSet *lanes = thread_registry_register(harness.registry, id);
+    ASSERT_NE(lanes, nullptr);
+    index_lanes.push_back(thread_lanes_get_index_lane(lanes));
+  }
+
+  DrainConfig config;
+  drain_config_default(&config);
+  config.poll_interval_us = 0;
+  config.yield_on_idle = true;
+  config.max_batch_size = 1;
+  config.fairness_quantum = 1;
+  config.worker_count = 3;
+  config.enable_work_stealing = true;
+
+  DrainThread *drain = create_drain(harness, &config);
+  ASSERT_NE(drain, nullptr);
+  ASSERT_EQ(drain_thread_start(drain), 0);
+
+  // One bursty producer plus a trickle from the others
+  constexpr uint64_t kBurst = 64;
+  for (uint64_t i = 0; i < kBurst; ++i) {
+    ASSERT_TRUE(submit_ring_with_retry(index_lanes[0]));
+  }
+  for (size_t t = 1; t < index_lanes.size(); ++t) {
+    ASSERT_TRUE(submit_ring_with_retry(index_lanes[t]));
+  }
+
+  const uint64_t expected = kBurst + index_lanes.size() - 1;
+  DrainMetrics metrics = wait_for_metrics(
+      drain, [&](const DrainMetrics &m) { return m.rings_total >= expected; },
+      std::chrono::milliseconds(2000));
+  EXPECT_EQ(metrics.rings_total, expected);
+  EXPECT_EQ(metrics.rings_per_thread[0][0] + metrics.rings_per_thread[1][0] +
+                metrics.rings_per_thread[2][0] + metrics.rings_per_thread[3][0],
+            expected);
+
+  ASSERT_EQ(drain_thread_stop(drain), 0);
+  for (Lane *lane : index_lanes) {
+    EXPECT_FALSE(lane_has_submitted_rings(lane));
+  }
+  drain_thread_destroy(drain);
+}
+
+TEST(DrainThreadUnit,
+     drain_thread__wake_on_submit_signal__then_parked_worker_drains) {
+  HookScope guard;
+  RegistryHarness harness(4);
+  ThreadLaneSet *lanes = thread_registry_register(harness.registry, 0x6601);
+  ASSERT_NE(lanes, nullptr);
+  Lane *index_lane = thread_lanes_get_index_lane(lanes);
+
+  DrainConfig config;
+  drain_config_default(&config);
+  config.wake_on_submit = true;
+
+  DrainThread *drain = create_drain(harness, &config);
+  ASSERT_NE(drain, nullptr);
+  ControlBlock cb = {};
+  drain_thread_set_control_block(drain, &cb);
+  ASSERT_EQ(drain_thread_start(drain), 0);
+
+  // Idle worker parks instead of polling
+  DrainMetrics metrics = wait_for_metrics(
+      drain, [](const DrainMetrics &m) { return m.wake_parks > 0; });
+  ASSERT_GT(metrics.wake_parks, 0u);
+  while (__atomic_load_n(&cb.drain_wake.waiters, __ATOMIC_ACQUIRE) == 0) {
+    std::this_thread::yield();
+  }
+
+  // What ring_pool_swap_active does on an empty -> non-empty submit
+  ASSERT_TRUE(submit_ring_with_retry(index_lane));
+  drain_wake_signal(&cb.drain_wake);
+
+  metrics = wait_for_metrics(
+      drain, [](const DrainMetrics &m) { return m.rings_total >= 1; },
+      std::chrono::milliseconds(2000));
+  EXPECT_EQ(metrics.rings_total, 1u);
+  EXPECT_GE(metrics.wake_signals, 1u);
+  EXPECT_GT(metrics.idle_wait_ns, 0u);
+  EXPECT_EQ(metrics.sleeps, 0u);
+  EXPECT_EQ(metrics.yields, 0u);
+
+  metrics = wait_for_metrics(
+      drain, [](const DrainMetrics &m) { return m.wake_latency_max_ns > 0; });
+  EXPECT_GT(metrics.wake_latency_avg_ns, 0u);
+  EXPECT_GE(metrics.wake_latency_max_ns, metrics.wake_latency_avg_ns);
+
+  ASSERT_EQ(drain_thread_stop(drain), 0);
+  drain_thread_destroy(drain);
+}
+
+TEST(DrainThreadUnit,
+     drain_thread__wake_on_submit_stop_while_parked__then_stops_promptly) {
+  HookScope guard;
+  RegistryHarness harness(4);
+
+  DrainConfig config;
+  drain_config_default(&config);
+  config.wake_on_submit = true;
+  config.worker_count = 2;
+
+  DrainThread *drain = create_drain(harness, &config);
+  ASSERT_NE(drain, nullptr);
+  ControlBlock cb = {};
+  drain_thread_set_control_block(drain, &cb);
+  ASSERT_EQ(drain_thread_start(drain), 0);
+
+  while (__atomic_load_n(&cb.drain_wake.waiters, __ATOMIC_ACQUIRE) < 2) {
+    std::this_thread::yield();
+  }
+  uint32_t seq_before = __atomic_load_n(&cb.drain_wake.seq, __ATOMIC_ACQUIRE);
+
+  auto start = std::chrono::steady_clock::now();
+  ASSERT_EQ(drain_thread_stop(drain), 0);
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+  EXPECT_NE(__atomic_load_n(&cb.drain_wake.seq, __ATOMIC_ACQUIRE), seq_before);
+  EXPECT_EQ(__atomic_load_n(&cb.drain_wake.waiters, __ATOMIC_ACQUIRE), 0u);
+  EXPECT_EQ(drain_thread_get_state(drain), DRAIN_STATE_STOPPED);
+
+  drain_thread_destroy(drain);
+}
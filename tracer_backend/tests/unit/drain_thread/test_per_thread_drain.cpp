@@ -364,6 +364,26 @@ TEST_F(PerThreadDrainTest, DrainIterator__handles_thread_deregistration_final_pa
     EXPECT_GE(metrics.final_drains, 1u);
 }
 
+TEST_F(PerThreadDrainTest, DrainIterator__retired_thread_with_pending_ring__then_drained_before_reclaim) {
+    auto drain = makeDrain(make_fair_config());
+    ThreadLaneSet* lanes = register_thread(registry(), 0x7B01);
+    ASSERT_NE(lanes, nullptr);
+    uint32_t slot = thread_lanes_get_slot_index(lanes);
+    Lane* index_lane = thread_lanes_get_index_lane(lanes);
+    uint32_t ring = lane_get_free_ring(index_lane);
+    ASSERT_NE(ring, UINT32_MAX);
+    ASSERT_TRUE(lane_submit_ring(index_lane, ring));
+    ASSERT_TRUE(thread_registry_retire(registry(), lanes));
+
+    for (int i = 0; i < 4; ++i) {
+        run_single_iteration(drain.get());
+    }
+
+    // The submitted ring is consumed before the slot goes back to the pool
+    EXPECT_GE(atomic_load_explicit(&drain->metrics.rings_index, memory_order_relaxed), 1u);
+    EXPECT_EQ(thread_registry_get_thread_at(registry(), slot), nullptr);
+}
+
 TEST_F(PerThreadDrainTest, DrainIterator__supports_non_blocking_acquisition__then_completes_under_timeout) {
     auto cfg = make_fair_config(0, 0, 0, true);
     auto drain = makeDrain(cfg);
@@ -666,6 +686,8 @@ TEST_F(PerThreadDrainTest, DrainMetrics__initializes_zero__then_defaults) {
 
     EXPECT_EQ(metrics.cycles_total, 0u);
     EXPECT_EQ(metrics.total_iterations, 0u);
+    EXPECT_EQ(metrics.write_errors, 0u);
+    EXPECT_EQ(metrics.events_lost, 0u);
     EXPECT_DOUBLE_EQ(metrics.fairness_index, 1.0);
 }
 
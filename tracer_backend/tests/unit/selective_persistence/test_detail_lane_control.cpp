@@ -156,7 +156,7 @@ TEST(DetailLaneControlTest, ring_not_full__marked_event_seen__then_no_dump) {
 
     RingBufferHeader* header = ring_pool_get_active_header(fx.detail_pool);
     ASSERT_NE(header, nullptr);
-    fill_ring_fraction(header, sizeof(DetailEvent), 0.7);
+    fill_ring_fraction(header, DETAIL_RECORD_ALIGN, 0.7);
 
     AdaMarkingProbe probe = message_probe("ERROR: transient");
     EXPECT_TRUE(detail_lane_control_mark_event(control, &probe, 110));
@@ -180,7 +180,7 @@ TEST(DetailLaneControlTest, ring_full__no_marked_event__then_discard_and_continu
 
     RingBufferHeader* header = ring_pool_get_active_header(fx.detail_pool);
     ASSERT_NE(header, nullptr);
-    fill_ring_to_capacity(header, sizeof(DetailEvent));
+    fill_ring_to_capacity(header, DETAIL_RECORD_ALIGN);
 
     EXPECT_FALSE(detail_lane_control_should_dump(control));
     EXPECT_EQ(detail_lane_control_windows_discarded(control), 1u);
@@ -206,7 +206,7 @@ TEST(DetailLaneControlTest, ring_full__marked_event_seen__then_dump_triggered) {
 
     RingBufferHeader* header = ring_pool_get_active_header(fx.detail_pool);
     ASSERT_NE(header, nullptr);
-    fill_ring_to_capacity(header, sizeof(DetailEvent));
+    fill_ring_to_capacity(header, DETAIL_RECORD_ALIGN);
 
     EXPECT_TRUE(detail_lane_control_should_dump(control));
     SelectivePersistenceWindow window{};
@@ -245,7 +245,7 @@ TEST(DetailLaneControlTest, ring_full__lane_mark_cleared__then_discarded_and_res
 
     RingBufferHeader* header = ring_pool_get_active_header(fx.detail_pool);
     ASSERT_NE(header, nullptr);
-    fill_ring_to_capacity(header, sizeof(DetailEvent));
+    fill_ring_to_capacity(header, DETAIL_RECORD_ALIGN);
 
     EXPECT_FALSE(detail_lane_control_should_dump(control));
     EXPECT_EQ(detail_lane_control_windows_discarded(control), 1u);
@@ -301,7 +301,7 @@ TEST(DetailLaneControlTest, concurrent_marking__multiple_threads__then_thread_sa
 
     RingBufferHeader* header = ring_pool_get_active_header(fx.detail_pool);
     ASSERT_NE(header, nullptr);
-    fill_ring_to_capacity(header, sizeof(DetailEvent));
+    fill_ring_to_capacity(header, DETAIL_RECORD_ALIGN);
     EXPECT_TRUE(detail_lane_control_should_dump(control));
 
     SelectivePersistenceWindow window{};
@@ -356,7 +356,7 @@ TEST(DetailLaneControlTest, close_window__timestamps_updated__then_dump_ready) {
 
     RingBufferHeader* header = ring_pool_get_active_header(fx.detail_pool);
     ASSERT_NE(header, nullptr);
-    fill_ring_to_capacity(header, sizeof(DetailEvent));
+    fill_ring_to_capacity(header, DETAIL_RECORD_ALIGN);
 
     EXPECT_TRUE(detail_lane_control_should_dump(control));
 
@@ -399,7 +399,7 @@ TEST(DetailLaneControlTest, window_metadata__calculated_correctly__then_accurate
 
     RingBufferHeader* header = ring_pool_get_active_header(fx.detail_pool);
     ASSERT_NE(header, nullptr);
-    fill_ring_to_capacity(header, sizeof(DetailEvent));
+    fill_ring_to_capacity(header, DETAIL_RECORD_ALIGN);
 
     EXPECT_TRUE(detail_lane_control_should_dump(control));
 
@@ -431,7 +431,7 @@ TEST(DetailLaneControlTest, selective_swap__conditions_met__then_swap_performed)
 
     RingBufferHeader* header = ring_pool_get_active_header(fx.detail_pool);
     ASSERT_NE(header, nullptr);
-    fill_ring_to_capacity(header, sizeof(DetailEvent));
+    fill_ring_to_capacity(header, DETAIL_RECORD_ALIGN);
 
     EXPECT_TRUE(detail_lane_control_should_dump(control));
 
@@ -486,7 +486,7 @@ TEST(DetailLaneControlMetricsTest, AC_metrics__accurate_counting__then_observabl
 
     RingBufferHeader* header = ring_pool_get_active_header(fx.detail_pool);
     ASSERT_NE(header, nullptr);
-    fill_ring_to_capacity(header, sizeof(DetailEvent));
+    fill_ring_to_capacity(header, DETAIL_RECORD_ALIGN);
     ASSERT_TRUE(detail_lane_control_should_dump(control));
 
     SelectivePersistenceWindow window{};
@@ -550,7 +550,7 @@ TEST(DetailLaneControlErrorTest, AC_error_handling__metadata_failure__then_failu
 
     RingBufferHeader* header = ring_pool_get_active_header(fx.detail_pool);
     ASSERT_NE(header, nullptr);
-    fill_ring_to_capacity(header, sizeof(DetailEvent));
+    fill_ring_to_capacity(header, DETAIL_RECORD_ALIGN);
     ASSERT_TRUE(detail_lane_control_should_dump(control));
 
     SelectivePersistenceWindow window{};
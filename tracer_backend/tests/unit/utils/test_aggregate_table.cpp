@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <vector>
+
+extern "C" {
+#include <tracer_backend/utils/aggregate_table.h>
+#include <tracer_backend/utils/thread_registry.h>
+}
+
+namespace {
+
+struct TableBuffer {
+    explicit TableBuffer(uint32_t capacity) : bytes(aggregate_table_bytes(capacity)) {
+        table = aggregate_table_init(bytes.data(), capacity);
+    }
+    std::vector<uint8_t> bytes;
+    AggregateTable* table;
+};
+
+const AggregateEntry* find_entry(const AggregateTable* table, uint64_t function_id) {
+    for (uint32_t i = 0; i < table->capacity; ++i) {
+        if (table->entries[i].function_id == function_id) return &table->entries[i];
+    }
+    return nullptr;
+}
+
+}  // namespace
+
+TEST(AggregateTable, init__capacity_not_power_of_two__then_rejected) {
+    std::vector<uint8_t> bytes(aggregate_table_bytes(100));
+    EXPECT_EQ(aggregate_table_init(bytes.data(), 100), nullptr);
+    EXPECT_EQ(aggregate_table_init(nullptr, 64), nullptr);
+}
+
+TEST(AggregateTable, record__repeated_calls__then_totals_accumulate) {
+    TableBuffer buf(64);
+    ASSERT_NE(buf.table, nullptr);
+
+    EXPECT_TRUE(aggregate_table_record(buf.table, 0x100000001ull, 50, 20));
+    EXPECT_TRUE(aggregate_table_record(buf.table, 0x100000001ull, 30, 30));
+    EXPECT_TRUE(aggregate_table_record(buf.table, 0x200000007ull, 5, 5));
+    EXPECT_EQ(buf.table->used, 2u);
+
+    const AggregateEntry* e = find_entry(buf.table, 0x100000001ull);
+    ASSERT_NE(e, nullptr);
+    EXPECT_EQ(e->calls, 2u);
+    EXPECT_EQ(e->inclusive_time, 80u);
+    EXPECT_EQ(e->exclusive_time, 50u);
+}
+
+TEST(AggregateTable, record__load_cap_reached__then_new_keys_dropped_and_counted) {
+    TableBuffer buf(16);
+    ASSERT_NE(buf.table, nullptr);
+    EXPECT_EQ(buf.table->max_used, 12u);
+
+    for (uint64_t id = 1; id <= 12; ++id) {
+        ASSERT_TRUE(aggregate_table_record(buf.table, id, 1, 1));
+    }
+    EXPECT_FALSE(aggregate_table_record(buf.table, 13, 1, 1));
+    EXPECT_FALSE(aggregate_table_record(buf.table, 14, 1, 1));
+    EXPECT_EQ(buf.table->dropped_calls, 2u);
+
+    // Known keys still update at the cap
+    EXPECT_TRUE(aggregate_table_record(buf.table, 7, 1, 1));
+    EXPECT_EQ(find_entry(buf.table, 7)->calls, 2u);
+}
+
+TEST(AggregateTable, merge__two_threads__then_sums_per_function) {
+    TableBuffer a(64);
+    TableBuffer b(64);
+    TableBuffer merged(256);
+    aggregate_table_record(a.table, 1, 10, 4);
+    aggregate_table_record(a.table, 2, 7, 7);
+    aggregate_table_record(b.table, 1, 20, 6);
+    a.table->dropped_calls = 3;
+
+    EXPECT_TRUE(aggregate_table_merge(merged.table, a.table));
+    EXPECT_TRUE(aggregate_table_merge(merged.table, b.table));
+    EXPECT_TRUE(aggregate_table_merge(merged.table, nullptr));
+
+    EXPECT_EQ(merged.table->used, 2u);
+    EXPECT_EQ(merged.table->dropped_calls, 3u);
+    const AggregateEntry* e = find_entry(merged.table, 1);
+    ASSERT_NE(e, nullptr);
+    EXPECT_EQ(e->calls, 2u);
+    EXPECT_EQ(e->inclusive_time, 30u);
+    EXPECT_EQ(e->exclusive_time, 10u);
+    EXPECT_EQ(find_entry(merged.table, 2)->calls, 1u);
+}
+
+TEST(AggregateTable, merge__destination_full__then_reports_incomplete) {
+    TableBuffer src(64);
+    TableBuffer small(16);
+    for (uint64_t id = 1; id <= 40; id++) {
+        ASSERT_TRUE(aggregate_table_record(src.table, id, 1, 1));
+    }
+
+    EXPECT_FALSE(aggregate_table_merge(small.table, src.table));
+    EXPECT_EQ(small.table->used, small.table->max_used);
+
+    // A destination sized for the keys takes all of them
+    TableBuffer large(128);
+    EXPECT_TRUE(aggregate_table_merge(large.table, src.table));
+    EXPECT_EQ(large.table->used, 40u);
+    EXPECT_EQ(large.table->dropped_calls, 0u);
+}
+
+TEST(AggregateTable, registry__first_attach__then_allocates_once) {
+    const uint32_t capacity = 4;
+    size_t size = thread_registry_calculate_memory_size_with_capacity(capacity);
+    void* memory = aligned_alloc(4096, (size + 4095) & ~size_t(4095));
+    ASSERT_NE(memory, nullptr);
+    ThreadRegistry* registry = thread_registry_init_with_capacity(memory, size, capacity);
+    ASSERT_NE(registry, nullptr);
+
+    ThreadLaneSet* lanes = thread_registry_register(registry, 4242);
+    ASSERT_NE(lanes, nullptr);
+    uint32_t slot = thread_lanes_get_slot_index(lanes);
+
+    // Registration alone leaves the lane unallocated
+    EXPECT_EQ(thread_registry_get_aggregates(registry, slot), nullptr);
+
+    AggregateTable* table = thread_registry_attach_aggregates(registry, slot);
+    ASSERT_NE(table, nullptr);
+    EXPECT_EQ(table->capacity, AGGREGATE_TABLE_CAPACITY);
+    EXPECT_EQ(table->used, 0u);
+    EXPECT_TRUE(aggregate_table_record(table, 99, 3, 3));
+
+    // Later attaches and the drain's view resolve the same table
+    EXPECT_EQ(thread_registry_attach_aggregates(registry, slot), table);
+    EXPECT_EQ(thread_registry_get_aggregates(registry, slot), table);
+    EXPECT_EQ(table->used, 1u);
+
+    EXPECT_EQ(thread_registry_get_aggregates(registry, (slot + 1) % capacity), nullptr);
+    EXPECT_EQ(thread_registry_attach_aggregates(registry, capacity), nullptr);
+
+    thread_registry_deinit(registry);
+    free(memory);
+}
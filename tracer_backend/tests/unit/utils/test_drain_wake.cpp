@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <errno.h>
+#include <thread>
+
+extern "C" {
+#include <tracer_backend/utils/drain_wake.h>
+#include <tracer_backend/utils/tracer_types.h>
+}
+
+using clock_mono = std::chrono::steady_clock;
+
+TEST(DrainWake, drain_wake__wait_without_signal__then_times_out) {
+    DrainWakeWord word = {};
+
+    uint32_t seq = drain_wake_prepare(&word);
+    EXPECT_EQ(word.waiters, 1u);
+
+    auto start = clock_mono::now();
+    EXPECT_EQ(drain_wake_wait(&word, seq, 5 * 1000 * 1000ull), -ETIMEDOUT);
+    auto elapsed = clock_mono::now() - start;
+    EXPECT_GE(elapsed, std::chrono::milliseconds(1));
+
+    drain_wake_finish(&word);
+    EXPECT_EQ(word.waiters, 0u);
+}
+
+TEST(DrainWake, drain_wake__signal_before_wait__then_returns_immediately) {
+    DrainWakeWord word = {};
+
+    uint32_t seq = drain_wake_prepare(&word);
+    drain_wake_signal(&word);
+    EXPECT_NE(word.signal_ns, 0u); // Stamped because a waiter was registered
+
+    auto start = clock_mono::now();
+    EXPECT_EQ(drain_wake_wait(&word, seq, 10ull * 1000 * 1000 * 1000), 0);
+    EXPECT_LT(clock_mono::now() - start, std::chrono::seconds(1));
+    drain_wake_finish(&word);
+}
+
+TEST(DrainWake, drain_wake__signal_while_parked__then_waiter_wakes) {
+    DrainWakeWord word = {};
+    std::atomic<int> result{1};
+    std::atomic<bool> parked{false};
+
+    std::thread waiter([&] {
+        uint32_t seq = drain_wake_prepare(&word);
+        parked.store(true);
+        result.store(drain_wake_wait(&word, seq, 10ull * 1000 * 1000 * 1000));
+        drain_wake_finish(&word);
+    });
+
+    while (!parked.load()) {
+        std::this_thread::yield();
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+    auto start = clock_mono::now();
+    drain_wake_signal(&word);
+    waiter.join();
+    EXPECT_EQ(result.load(), 0);
+    EXPECT_LT(clock_mono::now() - start, std::chrono::seconds(1));
+}
+
+TEST(DrainWake, drain_wake__signal_without_waiters__then_only_sequence_moves) {
+    DrainWakeWord word = {};
+
+    drain_wake_signal(&word);
+    drain_wake_signal(&word);
+    EXPECT_EQ(word.seq, 2u);
+    EXPECT_EQ(word.signal_ns, 0u);
+
+    drain_wake_signal(nullptr); // Unbound producer is a no-op
+    EXPECT_EQ(drain_wake_wait(nullptr, 0, 0), -EINVAL);
+}
+
+TEST(DrainWake, drain_wake__bind_producer__then_word_returned) {
+    DrainWakeWord word = {};
+
+    EXPECT_EQ(drain_wake_producer_word(), nullptr);
+    drain_wake_bind_producer(&word);
+    EXPECT_EQ(drain_wake_producer_word(), &word);
+    drain_wake_bind_producer(nullptr);
+    EXPECT_EQ(drain_wake_producer_word(), nullptr);
+}
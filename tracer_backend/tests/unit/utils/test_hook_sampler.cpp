@@ -0,0 +1,221 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+extern "C" {
+#include <tracer_backend/utils/control_block_ipc.h>
+#include <tracer_backend/utils/hook_sampler.h>
+}
+
+namespace {
+
+// Monotonic timestamps: hook units are ns
+constexpr uint64_t kWindowNs = 100ull * 1000000ull;
+
+HookSamplerConfig make_config(uint32_t max_calls_per_sec, uint32_t max_shift) {
+    SamplingControl control;
+    hook_sampler_control_defaults(&control);
+    control.enabled = 1;
+    control.max_calls_per_sec = max_calls_per_sec;
+    control.max_sample_shift = max_shift;
+    control.window_ms = 100;
+    TimestampCalibration cal = {};
+    cal.source = TIMESTAMP_SOURCE_MONOTONIC;
+    HookSamplerConfig config;
+    hook_sampler_config_from_control(&control, &cal, &config);
+    return config;
+}
+
+// Feed `calls` calls spread across [start, start + kWindowNs); returns admitted
+uint32_t run_window(HookSampler* s, const HookSamplerConfig* config, HookSamplerTally* tally,
+                    uint64_t start, uint32_t calls, uint64_t* summaries) {
+    uint32_t admitted = 0;
+    for (uint32_t i = 0; i < calls; ++i) {
+        uint64_t summary = 0;
+        if (hook_sampler_admit(s, config, tally, start + (kWindowNs / calls) * i, &summary)) admitted++;
+        *summaries += summary;
+    }
+    return admitted;
+}
+
+} // namespace
+
+TEST(HookSampler, hook_sampler__disabled__then_records_every_call) {
+    SamplingControl control;
+    hook_sampler_control_defaults(&control);
+    EXPECT_EQ(control.enabled, 0u);
+    TimestampCalibration cal = {};
+    cal.source = TIMESTAMP_SOURCE_MONOTONIC;
+    HookSamplerConfig config;
+    hook_sampler_config_from_control(&control, &cal, &config);
+
+    HookSampler s = {};
+    HookSamplerTally tally = {};
+    for (uint64_t i = 1; i <= 100000; ++i) {
+        uint64_t summary = 1;
+        EXPECT_TRUE(hook_sampler_admit(&s, &config, &tally, i * 1000, &summary));
+        EXPECT_EQ(summary, 0u);
+    }
+    EXPECT_EQ(s.shift, 0u);
+}
+
+TEST(HookSampler, hook_sampler__config__then_scales_limit_and_window) {
+    SamplingControl control = {1, 50000, 40, 20};
+    TimestampCalibration cal = {};
+    cal.source = TIMESTAMP_SOURCE_COUNTER;
+    cal.ticks_per_sec = 3000000000ull;
+    HookSamplerConfig config;
+    hook_sampler_config_from_control(&control, &cal, &config);
+    EXPECT_EQ(config.enabled, 1u);
+    EXPECT_EQ(config.window_limit, 1000u);
+    EXPECT_EQ(config.window_ticks, 60000000u);
+    EXPECT_EQ(config.max_shift, SAMPLING_MAX_SHIFT_LIMIT);
+}
+
+TEST(HookSampler, hook_sampler__hot_function__then_rate_limited_and_summarised) {
+    // 1000 calls/s allowed -> 100 per window
+    HookSamplerConfig config = make_config(1000, 16);
+    HookSampler s = {};
+    HookSamplerTally tally = {};
+    uint64_t summaries = 0;
+    const uint64_t t0 = 1000;
+
+    // Under the limit: everything recorded
+    EXPECT_EQ(run_window(&s, &config, &tally, t0, 80, &summaries), 80u);
+    EXPECT_EQ(s.shift, 0u);
+
+    // Burst of 1000 calls; the next window starts sampling 1 in 16
+    EXPECT_EQ(run_window(&s, &config, &tally, t0 + kWindowNs, 1000, &summaries), 1000u);
+    EXPECT_EQ(s.shift, 0u);
+    uint32_t admitted = run_window(&s, &config, &tally, t0 + 2 * kWindowNs, 1000, &summaries);
+    EXPECT_EQ(s.shift, 4u);
+    EXPECT_LE(admitted, 1000u / 16u + 1u);
+    EXPECT_GE(admitted, 1000u / 16u);
+    EXPECT_EQ(summaries, 0u);
+
+    // Closing the window reports exactly the skipped calls
+    uint64_t summary = 0;
+    EXPECT_TRUE(hook_sampler_admit(&s, &config, &tally, t0 + 3 * kWindowNs, &summary));
+    EXPECT_EQ(summary, 1000u - admitted);
+    EXPECT_EQ(s.suppressed, 0u);
+}
+
+TEST(HookSampler, hook_sampler__load_drops__then_shift_decays_one_step_per_window) {
+    HookSamplerConfig config = make_config(1000, 16);
+    HookSampler s = {};
+    HookSamplerTally tally = {};
+    uint64_t summaries = 0;
+    run_window(&s, &config, &tally, 1000, 10, &summaries);
+    run_window(&s, &config, &tally, 1000 + kWindowNs, 5000, &summaries);
+    run_window(&s, &config, &tally, 1000 + 2 * kWindowNs, 10, &summaries);
+    const uint32_t peak = 6; // 5000 >> 6 = 78 <= 100
+    EXPECT_EQ(s.shift, peak);
+    for (uint32_t w = 3; w < 3 + peak; ++w) {
+        run_window(&s, &config, &tally, 1000 + w * kWindowNs, 10, &summaries);
+        EXPECT_EQ(s.shift, peak - (w - 2));
+    }
+    EXPECT_EQ(s.shift, 0u);
+}
+
+TEST(HookSampler, hook_sampler__extreme_rate__then_shift_capped) {
+    HookSamplerConfig config = make_config(10, 3);
+    HookSampler s = {};
+    HookSamplerTally tally = {};
+    uint64_t summaries = 0;
+    run_window(&s, &config, &tally, 1000, 1, &summaries);
+    run_window(&s, &config, &tally, 1000 + kWindowNs, 10000, &summaries);
+    run_window(&s, &config, &tally, 1000 + 2 * kWindowNs, 10, &summaries);
+    EXPECT_EQ(s.shift, 3u);
+}
+
+TEST(HookSampler, hook_sampler__concurrent_calls__then_recorded_plus_summaries_equal_calls) {
+    HookSamplerConfig config = make_config(1000, 16);
+    HookSampler s = {};
+    HookSamplerTally tally = {};
+    std::atomic<uint64_t> recorded{0};
+    std::atomic<uint64_t> summarised{0};
+    std::atomic<uint64_t> clock{1};
+    constexpr int kThreads = 4;
+    constexpr uint64_t kCallsPerThread = 200000;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&] {
+            HookSamplerTally own = {};
+            for (uint64_t i = 0; i < kCallsPerThread; ++i) {
+                // ~5 windows over the run
+                uint64_t now = clock.fetch_add(kWindowNs * 5 / (kThreads * kCallsPerThread)) + 1;
+                uint64_t summary = 0;
+                if (hook_sampler_admit(&s, &config, &own, now, &summary)) recorded.fetch_add(1);
+                summarised.fetch_add(summary);
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+
+    EXPECT_EQ(recorded.load() + summarised.load() + s.suppressed, kThreads * kCallsPerThread);
+    EXPECT_LT(recorded.load(), kThreads * kCallsPerThread);
+}
+
+TEST(HookSampler, hook_sampler__tally__then_window_calls_added_in_batches) {
+    HookSamplerConfig config = make_config(1000, 16);
+    HookSampler s = {};
+    HookSamplerTally tally = {};
+    uint64_t summary = 0;
+    const uint64_t t0 = 1000;
+    for (uint32_t i = 0; i < HOOK_SAMPLER_TALLY_FLUSH - 1; ++i) {
+        EXPECT_TRUE(hook_sampler_admit(&s, &config, &tally, t0 + i, &summary));
+    }
+    EXPECT_EQ(s.window_calls, 0u);
+    EXPECT_EQ(tally.calls, HOOK_SAMPLER_TALLY_FLUSH - 1);
+    EXPECT_TRUE(hook_sampler_admit(&s, &config, &tally, t0 + 100, &summary));
+    EXPECT_EQ(s.window_calls, HOOK_SAMPLER_TALLY_FLUSH);
+    EXPECT_EQ(tally.unflushed, 0u);
+
+    // Calls left in the tally at a roll are folded into the next window
+    for (uint32_t i = 0; i < 5; ++i) {
+        EXPECT_TRUE(hook_sampler_admit(&s, &config, &tally, t0 + 200 + i, &summary));
+    }
+    EXPECT_TRUE(hook_sampler_admit(&s, &config, &tally, t0 + kWindowNs, &summary));
+    EXPECT_EQ(s.window_calls, 5u);
+    EXPECT_EQ(tally.window_start, t0 + kWindowNs);
+    EXPECT_EQ(tally.calls, 1u);
+}
+
+TEST(HookSampler, hook_sampler__quiet_after_burst__then_flush_reports_pending_count) {
+    HookSamplerConfig config = make_config(1000, 16);
+    HookSampler s = {};
+    HookSamplerTally tally = {};
+    uint64_t summaries = 0;
+    run_window(&s, &config, &tally, 1000, 10, &summaries);
+    run_window(&s, &config, &tally, 1000 + kWindowNs, 1000, &summaries);
+    uint32_t admitted = run_window(&s, &config, &tally, 1000 + 2 * kWindowNs, 1000, &summaries);
+    ASSERT_GT(s.suppressed, 0u);
+
+    // The function goes quiet: nothing rolls its window until a tick does
+    EXPECT_EQ(hook_sampler_flush(&s, &config, 1000 + 2 * kWindowNs + kWindowNs / 2, false), 0u);
+    EXPECT_EQ(hook_sampler_flush(&s, &config, 1000 + 3 * kWindowNs, false), 1000u - admitted);
+    EXPECT_EQ(s.suppressed, 0u);
+    EXPECT_EQ(s.shift, 4u);  // The window it closed was still hot
+    EXPECT_EQ(hook_sampler_flush(&s, &config, 1000 + 4 * kWindowNs, false), 0u);
+    EXPECT_EQ(s.shift, 3u);  // A quiet window decays one step
+
+    // Session stop hands over whatever is pending
+    s.suppressed = 7;
+    EXPECT_EQ(hook_sampler_flush(&s, &config, 0, true), 7u);
+    EXPECT_EQ(hook_sampler_flush(&s, &config, 0, true), 0u);
+}
+
+TEST(HookSampler, control_block__set_sampling__then_get_returns_same) {
+    ControlBlock cb = {};
+    SamplingControl in = {1, 2500, 8, 50};
+    cb_set_sampling(&cb, &in);
+    SamplingControl out = {};
+    cb_get_sampling(&cb, &out);
+    EXPECT_EQ(out.enabled, 1u);
+    EXPECT_EQ(out.max_calls_per_sec, 2500u);
+    EXPECT_EQ(out.max_sample_shift, 8u);
+    EXPECT_EQ(out.window_ms, 50u);
+}
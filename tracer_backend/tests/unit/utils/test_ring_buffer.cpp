@@ -367,6 +367,298 @@ TEST_F(RingBufferTest, ring_buffer__header_alignment__then_no_false_sharing) {
     EXPECT_NE(wp / CACHE_LINE_SIZE, rp / CACHE_LINE_SIZE) << "write/read should not share cache line";
 }
 
+// v2 caches: each side's copy of the other's position lives on its own line
+// and is refreshed only when the cached value cannot satisfy the operation
+TEST_F(RingBufferTest, ring_buffer__cached_positions__then_refreshed_only_at_limits) {
+    rb = ring_buffer_create(memory.get(), buffer_size, sizeof(TestEvent));
+    ASSERT_NE(rb, nullptr);
+    RingBufferHeader* hdr = ring_buffer_get_header(rb);
+    EXPECT_EQ(hdr->version, 2u);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(&hdr->cached_read_pos) / CACHE_LINE_SIZE,
+              reinterpret_cast<uintptr_t>(&hdr->write_pos) / CACHE_LINE_SIZE);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(&hdr->cached_write_pos) / CACHE_LINE_SIZE,
+              reinterpret_cast<uintptr_t>(&hdr->read_pos) / CACHE_LINE_SIZE);
+
+    const size_t cap = ring_buffer_get_capacity(rb);
+    TestEvent ev{};
+    for (size_t i = 0; i < cap - 1; i++) {
+        ev.id = i;
+        ASSERT_TRUE(ring_buffer_write_raw(hdr, sizeof(TestEvent), &ev));
+    }
+    EXPECT_EQ(hdr->cached_read_pos, 0u); // Never needed the consumer's line
+
+    // Consumer caches the whole batch on its first read
+    ASSERT_TRUE(ring_buffer_read_raw(hdr, sizeof(TestEvent), &ev));
+    EXPECT_EQ(hdr->cached_write_pos, cap - 1);
+    ASSERT_TRUE(ring_buffer_read_raw(hdr, sizeof(TestEvent), &ev));
+    EXPECT_EQ(ev.id, 1u);
+
+    // Producer looks again only once the stale cache says full
+    ev.id = 1000;
+    ASSERT_TRUE(ring_buffer_write_raw(hdr, sizeof(TestEvent), &ev));
+    EXPECT_EQ(hdr->cached_read_pos, 2u);
+    ASSERT_TRUE(ring_buffer_write_raw(hdr, sizeof(TestEvent), &ev));
+    EXPECT_FALSE(ring_buffer_write_raw(hdr, sizeof(TestEvent), &ev));
+
+    // Dropping from the producer side keeps the consumer cache consistent
+    EXPECT_TRUE(ring_buffer_drop_oldest(rb));
+    EXPECT_EQ(hdr->cached_write_pos, hdr->write_pos);
+    size_t drained = 0;
+    while (ring_buffer_read_raw(hdr, sizeof(TestEvent), &ev)) drained++;
+    EXPECT_EQ(drained, cap - 2);
+}
+
+// Attach refuses headers written by an older protocol version
+TEST_F(RingBufferTest, ring_buffer__attach_version_mismatch__then_rejected) {
+    rb = ring_buffer_create(memory.get(), buffer_size, sizeof(TestEvent));
+    ASSERT_NE(rb, nullptr);
+    RingBufferHeader* hdr = ring_buffer_get_header(rb);
+
+    RingBuffer* attached = ring_buffer_attach(memory.get(), buffer_size, sizeof(TestEvent));
+    ASSERT_NE(attached, nullptr);
+    ring_buffer_destroy(attached);
+
+    hdr->version = 1;
+    EXPECT_EQ(ring_buffer_attach(memory.get(), buffer_size, sizeof(TestEvent)), nullptr);
+}
+
+// Span view: wrapped readable region is exposed as two contiguous spans
+TEST_F(RingBufferTest, ring_buffer__peek_spans_wrapped__then_two_spans_in_order) {
+    rb = ring_buffer_create(memory.get(), buffer_size, sizeof(TestEvent));
+    ASSERT_NE(rb, nullptr);
+    RingBufferHeader* hdr = ring_buffer_get_header(rb);
+    ASSERT_NE(hdr, nullptr);
+    const size_t cap = ring_buffer_get_capacity(rb);
+    ASSERT_GE(cap, 8u);
+
+    // Advance read/write positions close to the end of the payload
+    TestEvent ev{};
+    const size_t lead = cap - 3;
+    for (size_t i = 0; i < lead; i++) {
+        ev.id = i;
+        ASSERT_TRUE(ring_buffer_write_raw(hdr, sizeof(TestEvent), &ev));
+    }
+    for (size_t i = 0; i < lead; i++) {
+        ASSERT_TRUE(ring_buffer_read_raw(hdr, sizeof(TestEvent), &ev));
+    }
+
+    // Write enough events to wrap past the end
+    const size_t n = 6;
+    for (size_t i = 0; i < n; i++) {
+        ev.id = 1000 + i;
+        ASSERT_TRUE(ring_buffer_write_raw(hdr, sizeof(TestEvent), &ev));
+    }
+
+    RingBufferSpan spans[2];
+    size_t available = ring_buffer_peek_spans_raw(hdr, sizeof(TestEvent), spans, SIZE_MAX);
+    ASSERT_EQ(available, n);
+    ASSERT_EQ(spans[0].count, 3u);
+    ASSERT_EQ(spans[1].count, n - 3);
+
+    uint64_t expected = 1000;
+    for (int s = 0; s < 2; s++) {
+        const TestEvent* events = static_cast<const TestEvent*>(spans[s].data);
+        for (size_t i = 0; i < spans[s].count; i++) {
+            EXPECT_EQ(events[i].id, expected++);
+        }
+    }
+
+    // Peeking does not consume; consuming publishes the new read position
+    EXPECT_EQ(ring_buffer_available_read_raw(hdr), n);
+    ring_buffer_consume_raw(hdr, available);
+    EXPECT_EQ(ring_buffer_available_read_raw(hdr), 0u);
+    EXPECT_EQ(ring_buffer_peek_spans_raw(hdr, sizeof(TestEvent), spans, SIZE_MAX), 0u);
+    EXPECT_EQ(spans[0].count, 0u);
+}
+
+// Span view: max_count truncates the returned spans
+TEST_F(RingBufferTest, ring_buffer__peek_spans_limited__then_respects_max_count) {
+    rb = ring_buffer_create(memory.get(), buffer_size, sizeof(TestEvent));
+    ASSERT_NE(rb, nullptr);
+    RingBufferHeader* hdr = ring_buffer_get_header(rb);
+
+    TestEvent ev{};
+    for (size_t i = 0; i < 5; i++) {
+        ev.id = i;
+        ASSERT_TRUE(ring_buffer_write_raw(hdr, sizeof(TestEvent), &ev));
+    }
+
+    RingBufferSpan spans[2];
+    EXPECT_EQ(ring_buffer_peek_spans_raw(hdr, sizeof(TestEvent), spans, 2), 2u);
+    EXPECT_EQ(spans[0].count, 2u);
+    EXPECT_EQ(spans[1].count, 0u);
+    ring_buffer_consume_raw(hdr, 2);
+
+    ASSERT_TRUE(ring_buffer_read_raw(hdr, sizeof(TestEvent), &ev));
+    EXPECT_EQ(ev.id, 2u);
+
+    EXPECT_EQ(ring_buffer_peek_spans_raw(nullptr, sizeof(TestEvent), spans, 4), 0u);
+    EXPECT_EQ(ring_buffer_peek_spans_raw(hdr, sizeof(TestEvent), nullptr, 4), 0u);
+}
+
+// Bulk publish: wraps with two copies and stops at the free space
+TEST_F(RingBufferTest, ring_buffer__write_batch_wrapped__then_partial_in_order) {
+    rb = ring_buffer_create(memory.get(), buffer_size, sizeof(TestEvent));
+    ASSERT_NE(rb, nullptr);
+    RingBufferHeader* hdr = ring_buffer_get_header(rb);
+    const size_t cap = ring_buffer_get_capacity(rb);
+    ASSERT_GE(cap, 8u);
+
+    // Move both positions to just before the end of the payload
+    TestEvent ev{};
+    const size_t lead = cap - 2;
+    for (size_t i = 0; i < lead; i++) {
+        ASSERT_TRUE(ring_buffer_write_raw(hdr, sizeof(TestEvent), &ev));
+        ASSERT_TRUE(ring_buffer_read_raw(hdr, sizeof(TestEvent), &ev));
+    }
+
+    std::vector<TestEvent> batch(cap + 4);
+    for (size_t i = 0; i < batch.size(); i++) {
+        batch[i].id = 500 + i;
+    }
+    uint64_t overflow_before = hdr->overflow_count;
+    size_t written = ring_buffer_write_batch_raw(hdr, sizeof(TestEvent), batch.data(), batch.size());
+    EXPECT_EQ(written, cap - 1); // One slot always stays empty
+    EXPECT_EQ(hdr->overflow_count, overflow_before + 1);
+    EXPECT_EQ(ring_buffer_write_batch_raw(hdr, sizeof(TestEvent), batch.data(), 1), 0u);
+
+    for (size_t i = 0; i < written; i++) {
+        ASSERT_TRUE(ring_buffer_read_raw(hdr, sizeof(TestEvent), &ev));
+        EXPECT_EQ(ev.id, 500 + i);
+    }
+    EXPECT_EQ(ring_buffer_write_batch_raw(nullptr, sizeof(TestEvent), batch.data(), 1), 0u);
+    EXPECT_EQ(ring_buffer_write_batch_raw(hdr, sizeof(TestEvent), nullptr, 1), 0u);
+}
+
+// Index- and detail-sized rings take the fixed-size specialisations behind
+// the raw ABI; bulk reads wrap with two copies and keep order
+TEST(RingBufferFixedSize, ring_buffer__index_and_detail_sizes__then_round_trip_in_order) {
+    constexpr size_t kSlots = 16;
+    const size_t sizes[] = {sizeof(IndexEvent), sizeof(DetailEvent)};
+    for (size_t event_size : sizes) {
+        SCOPED_TRACE(event_size);
+        const size_t bytes = sizeof(RingBufferHeader) + CACHE_LINE_SIZE + (kSlots * event_size);
+        std::vector<uint8_t> memory(bytes, 0);
+        RingBuffer* rb = ring_buffer_create(memory.data(), bytes, event_size);
+        ASSERT_NE(rb, nullptr);
+        RingBufferHeader* hdr = ring_buffer_get_header(rb);
+        const size_t cap = ring_buffer_get_capacity(rb);
+        ASSERT_EQ(cap, kSlots);
+
+        std::vector<uint8_t> event(event_size, 0);
+        for (size_t i = 0; i < cap - 3; i++) {
+            ASSERT_TRUE(ring_buffer_write_raw(hdr, event_size, event.data()));
+            ASSERT_TRUE(ring_buffer_read_raw(hdr, event_size, event.data()));
+        }
+
+        // Tag the first and last byte of each event so short copies show up
+        std::vector<uint8_t> batch(8 * event_size);
+        for (size_t i = 0; i < 8; i++) {
+            batch[i * event_size] = static_cast<uint8_t>(i + 1);
+            batch[(i + 1) * event_size - 1] = static_cast<uint8_t>(0x80 + i);
+        }
+        ASSERT_EQ(ring_buffer_write_batch_raw(hdr, event_size, batch.data(), 8), 8u);
+
+        std::vector<uint8_t> out(8 * event_size, 0);
+        ASSERT_EQ(ring_buffer_read_batch_raw(hdr, event_size, out.data(), 8), 8u);
+        EXPECT_EQ(out, batch);
+        EXPECT_EQ(ring_buffer_available_read_raw(hdr), 0u);
+        EXPECT_FALSE(ring_buffer_read_raw(hdr, event_size, event.data()));
+
+        ring_buffer_destroy(rb);
+    }
+}
+
+namespace {
+
+// Build a detail record with stack_bytes of stack into buf; returns its length
+size_t make_detail_record(uint8_t* buf, uint64_t timestamp, uint16_t stack_bytes) {
+    auto* rec = reinterpret_cast<DetailRecordHeader*>(buf);
+    auto* payload = reinterpret_cast<DetailRecordPayload*>(rec + 1);
+    size_t length = sizeof(DetailRecordHeader) + sizeof(DetailRecordPayload) + stack_bytes;
+    memset(buf, 0, length);
+    rec->total_length = static_cast<uint32_t>(length);
+    rec->event_type = DETAIL_RECORD_CALL;
+    rec->timestamp = timestamp;
+    payload->function_id = timestamp * 2;
+    payload->stack_size = stack_bytes;
+    memset(payload + 1, static_cast<int>(timestamp & 0xFF), stack_bytes);
+    return length;
+}
+
+} // namespace
+
+// Records keep their exact length; one wraps behind a skip marker
+TEST(RingBufferRecords, ring_buffer__records_across_wrap__then_skip_marker_hidden) {
+    constexpr size_t kUnits = 64; // 512 bytes of payload
+    const size_t bytes = sizeof(RingBufferHeader) + CACHE_LINE_SIZE + (kUnits * DETAIL_RECORD_ALIGN);
+    std::vector<uint8_t> memory(bytes, 0);
+    RingBuffer* rb = ring_buffer_create(memory.data(), bytes, DETAIL_RECORD_ALIGN);
+    ASSERT_NE(rb, nullptr);
+    RingBufferHeader* hdr = ring_buffer_get_header(rb);
+    ASSERT_EQ(ring_buffer_get_capacity(rb), kUnits);
+
+    alignas(8) uint8_t buf[DETAIL_RECORD_MAX_SIZE];
+    const void* rec = nullptr;
+    uint64_t ts = 1;
+    // 124 bytes -> 16 units each; after three records 16 units remain before the end
+    for (int round = 0; round < 3; round++) {
+        size_t length = make_detail_record(buf, ts++, 0);
+        ASSERT_TRUE(ring_buffer_write_record_raw(hdr, buf, length));
+        ASSERT_EQ(ring_buffer_peek_record_raw(hdr, &rec), length);
+        ring_buffer_consume_record_raw(hdr, length);
+    }
+    EXPECT_EQ(hdr->write_pos, 48u);
+
+    // 188 bytes -> 24 units: does not fit in the 16-unit tail, so it wraps
+    size_t length = make_detail_record(buf, 77, 64);
+    ASSERT_TRUE(ring_buffer_write_record_raw(hdr, buf, length));
+    EXPECT_EQ(hdr->write_pos, 24u);
+
+    ASSERT_EQ(ring_buffer_peek_record_raw(hdr, &rec), length);
+    EXPECT_EQ(memcmp(rec, buf, length), 0);
+    EXPECT_EQ(hdr->read_pos, 0u); // Marker consumed by the peek
+    ring_buffer_consume_record_raw(hdr, length);
+    EXPECT_EQ(ring_buffer_peek_record_raw(hdr, &rec), 0u);
+    EXPECT_EQ(rec, nullptr);
+
+    ring_buffer_destroy(rb);
+}
+
+TEST(RingBufferRecords, ring_buffer__records_until_full__then_overflow_and_drop_oldest) {
+    constexpr size_t kUnits = 256;
+    const size_t bytes = sizeof(RingBufferHeader) + CACHE_LINE_SIZE + (kUnits * DETAIL_RECORD_ALIGN);
+    std::vector<uint8_t> memory(bytes, 0);
+    RingBuffer* rb = ring_buffer_create(memory.data(), bytes, DETAIL_RECORD_ALIGN);
+    ASSERT_NE(rb, nullptr);
+    RingBufferHeader* hdr = ring_buffer_get_header(rb);
+
+    alignas(8) uint8_t buf[DETAIL_RECORD_MAX_SIZE];
+    size_t written = 0;
+    EXPECT_FALSE(ring_buffer_record_ring_full_raw(hdr));
+    // Max-size records are 80 units; three fit into 255 usable units
+    while (ring_buffer_write_record_raw(hdr, buf, make_detail_record(buf, 100 + written, DETAIL_RECORD_STACK_MAX))) {
+        written++;
+    }
+    EXPECT_EQ(written, 3u);
+    EXPECT_EQ(hdr->overflow_count, 1u);
+    EXPECT_TRUE(ring_buffer_record_ring_full_raw(hdr));
+
+    ASSERT_TRUE(ring_buffer_drop_oldest_record_raw(hdr));
+    const void* rec = nullptr;
+    ASSERT_EQ(ring_buffer_peek_record_raw(hdr, &rec), DETAIL_RECORD_MAX_SIZE);
+    EXPECT_EQ(reinterpret_cast<const DetailRecordHeader*>(rec)->timestamp, 101u);
+
+    // Too short to be a record, or no ring at all
+    EXPECT_FALSE(ring_buffer_write_record_raw(hdr, buf, sizeof(DetailRecordHeader) - 1));
+    EXPECT_FALSE(ring_buffer_write_record_raw(nullptr, buf, DETAIL_RECORD_MAX_SIZE));
+    EXPECT_EQ(ring_buffer_peek_record_raw(nullptr, &rec), 0u);
+    EXPECT_FALSE(ring_buffer_drop_oldest_record_raw(nullptr));
+    EXPECT_FALSE(ring_buffer_record_ring_full_raw(nullptr));
+
+    ring_buffer_destroy(rb);
+}
+
 // Lightweight performance smoke tests (kept small for CI stability)
 TEST(RingBufferPerf, ring_buffer__throughput_smoke__then_reasonable) {
     struct Ev { uint64_t a, b; };
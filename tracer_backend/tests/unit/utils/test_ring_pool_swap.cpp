@@ -1,12 +1,14 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 #include <memory>
+#include <vector>
 #include <cstring>
 
 extern "C" {
 #include <tracer_backend/utils/thread_registry.h>
 #include <tracer_backend/utils/ring_pool.h>
 #include <tracer_backend/utils/ring_buffer.h>
+#include <tracer_backend/utils/drain_wake.h>
 #include <tracer_backend/utils/tracer_types.h>
 }
 
@@ -90,6 +92,37 @@ TEST(RingPoolSwap, ring_pool__exhaustion__then_drop_oldest_and_recover_capacity)
     ring_pool_destroy(pool);
 }
 
+TEST(RingPoolSwap, ring_pool__exhaustion_with_overflow__then_grows_instead_of_dropping) {
+    ThreadRegistryGeometry g;
+    thread_registry_geometry_default(&g);
+    g.overflow_bytes = 2 * 64 * 1024;
+    size_t size = thread_registry_calculate_memory_size_with_geometry(2, &g);
+    auto arena = std::unique_ptr<uint8_t[]>(new uint8_t[size]);
+    std::memset(arena.get(), 0, size);
+    auto* reg = thread_registry_init_with_geometry(arena.get(), size, 2, &g);
+    ASSERT_NE(reg, nullptr);
+    ASSERT_NE(thread_registry_attach(reg), nullptr);
+    ThreadLaneSet* lanes = thread_registry_register(reg, 0xCC77);
+    ASSERT_NE(lanes, nullptr);
+    Lane* idx_lane = thread_lanes_get_index_lane(lanes);
+    RingPool* pool = ring_pool_create(reg, lanes, 0);
+    ASSERT_NE(pool, nullptr);
+
+    // Three swaps use the free rings, two more grow the lane, then it drops
+    uint32_t old = UINT32_MAX;
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_TRUE(ring_pool_swap_active(pool, &old));
+    }
+    EXPECT_EQ(ada::internal::to_cpp(idx_lane)->ring_count, (uint32_t)RINGS_PER_INDEX_LANE + 2);
+    EXPECT_EQ(thread_registry_get_rings_grown(reg), 2u);
+    ada_thread_metrics_t* metrics = thread_lanes_get_metrics(lanes);
+    EXPECT_EQ(metrics->pressure.pool_exhaustion_count.load(), 0u) << "Growth absorbs the burst without dropping";
+
+    ASSERT_TRUE(ring_pool_swap_active(pool, &old));
+    EXPECT_EQ(metrics->pressure.pool_exhaustion_count.load(), 1u) << "Overflow spent, drop-oldest resumes";
+    ring_pool_destroy(pool);
+}
+
 TEST(RingPoolSwap, ring_pool__detail_mark__then_visible) {
     size_t size = 0; auto arena = alloc_registry(size);
     auto* reg = thread_registry_init_with_capacity(arena.get(), size, 2);
@@ -134,6 +167,43 @@ TEST(RingPoolSwap, ring_pool__fallback_no_alternative__then_swap_fails) {
     ring_pool_destroy(pool);
 }
 
+TEST(RingPoolSwap, ring_pool__submit_queue_full__then_keeps_active_and_returns_new_ring) {
+    size_t size = 0; auto arena = alloc_registry(size);
+    auto* reg = thread_registry_init_with_capacity(arena.get(), size, 2);
+    ASSERT_NE(reg, nullptr);
+    ASSERT_NE(thread_registry_attach(reg), nullptr);
+    ThreadLaneSet* lanes = thread_registry_register(reg, 0xDD99);
+    ASSERT_NE(lanes, nullptr);
+
+    RingPool* pool = ring_pool_create(reg, lanes, 0);
+    ASSERT_NE(pool, nullptr);
+    Lane* idx_lane = thread_lanes_get_index_lane(lanes);
+    ASSERT_NE(idx_lane, nullptr);
+    auto* cpp_lane = ada::internal::to_cpp(idx_lane);
+    ada_thread_metrics_t* metrics = thread_lanes_get_metrics(lanes);
+    ASSERT_NE(metrics, nullptr);
+
+    // Make the submit queue report full (head one past tail)
+    uint32_t free_before = (cpp_lane->free_tail.load() - cpp_lane->free_head.load()) &
+                           (cpp_lane->free_capacity - 1);
+    ASSERT_GT(free_before, 0u);
+    cpp_lane->submit_head.store(1);
+    cpp_lane->submit_tail.store(0);
+    uint64_t ring_full_before = metrics->pressure.ring_full_count.load();
+
+    RingBufferHeader* active = ring_pool_get_active_header(pool);
+    uint32_t old = UINT32_MAX;
+    EXPECT_FALSE(ring_pool_swap_active(pool, &old));
+    EXPECT_EQ(old, UINT32_MAX);
+    EXPECT_EQ(ring_pool_get_active_header(pool), active);
+    EXPECT_EQ((cpp_lane->free_tail.load() - cpp_lane->free_head.load()) &
+                  (cpp_lane->free_capacity - 1),
+              free_before);
+    EXPECT_EQ(metrics->pressure.ring_full_count.load(), ring_full_before + 1);
+
+    ring_pool_destroy(pool);
+}
+
 TEST(RingPoolSwap, ring_pool__exhaustion_no_oldest__then_handle_returns_false) {
     size_t size = 0; auto arena = alloc_registry(size);
     auto* reg = thread_registry_init_with_capacity(arena.get(), size, 2);
@@ -153,3 +223,69 @@ TEST(RingPoolSwap, ring_pool__exhaustion_no_oldest__then_handle_returns_false) {
 
     ring_pool_destroy(pool);
 }
+
+TEST(RingPoolSwap, ring_pool__swap_into_empty_queue__then_wakes_drain_once) {
+    size_t size = 0; auto arena = alloc_registry(size);
+    auto* reg = thread_registry_init_with_capacity(arena.get(), size, 2);
+    ASSERT_NE(reg, nullptr);
+    ASSERT_NE(thread_registry_attach(reg), nullptr);
+    ThreadLaneSet* lanes = thread_registry_register(reg, 0xFA11);
+    ASSERT_NE(lanes, nullptr);
+    Lane* idx_lane = thread_lanes_get_index_lane(lanes);
+    ASSERT_NE(idx_lane, nullptr);
+
+    RingPool* pool = ring_pool_create(reg, lanes, 0);
+    ASSERT_NE(pool, nullptr);
+
+    DrainWakeWord word = {};
+    drain_wake_bind_producer(&word);
+
+    // Empty -> non-empty signals; a second submit behind it does not
+    uint32_t old = UINT32_MAX;
+    ASSERT_TRUE(ring_pool_swap_active(pool, &old));
+    EXPECT_EQ(word.seq, 1u);
+    ASSERT_TRUE(ring_pool_swap_active(pool, &old));
+    EXPECT_EQ(word.seq, 1u);
+
+    // Drained empty again: the next submit signals
+    while (lane_take_ring(idx_lane) != UINT32_MAX) {
+    }
+    ASSERT_TRUE(ring_pool_swap_active(pool, &old));
+    EXPECT_EQ(word.seq, 2u);
+
+    drain_wake_bind_producer(nullptr);
+    ring_pool_destroy(pool);
+}
+
+TEST(RingPoolSwap, ring_pool__write_batch_past_ring_end__then_swaps_and_writes_all) {
+    size_t size = 0; auto arena = alloc_registry(size);
+    auto* reg = thread_registry_init_with_capacity(arena.get(), size, 2);
+    ASSERT_NE(reg, nullptr);
+    ASSERT_NE(thread_registry_attach(reg), nullptr);
+    ThreadLaneSet* lanes = thread_registry_register(reg, 0xBA7C);
+    ASSERT_NE(lanes, nullptr);
+    Lane* idx_lane = thread_lanes_get_index_lane(lanes);
+    ASSERT_NE(idx_lane, nullptr);
+
+    RingPool* pool = ring_pool_create(reg, lanes, 0);
+    ASSERT_NE(pool, nullptr);
+    RingBufferHeader* first = ring_pool_get_active_header(pool);
+    ASSERT_NE(first, nullptr);
+
+    // More events than one ring holds
+    std::vector<IndexEvent> events(first->capacity + 16);
+    for (size_t i = 0; i < events.size(); ++i) {
+        events[i].timestamp = i;
+    }
+    EXPECT_EQ(ring_pool_write_batch(pool, sizeof(IndexEvent), events.data(), events.size()),
+              events.size());
+
+    EXPECT_TRUE(lane_has_submitted_rings(idx_lane));
+    RingBufferHeader* active = ring_pool_get_active_header(pool);
+    EXPECT_NE(active, first);
+    EXPECT_EQ(ring_buffer_available_read_raw(first) + ring_buffer_available_read_raw(active),
+              events.size());
+
+    EXPECT_EQ(ring_pool_write_batch(nullptr, sizeof(IndexEvent), events.data(), 1), 0u);
+    ring_pool_destroy(pool);
+}
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <sys/mman.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+extern "C" {
+#include <tracer_backend/utils/stack_capture.h>
+}
+
+TEST(StackCapture, stack_capture__init_thread__then_bounds_contain_local) {
+    ASSERT_EQ(stack_capture_init_thread(), 0);
+
+    uintptr_t low = 0, high = 0;
+    ASSERT_TRUE(stack_capture_get_bounds(&low, &high));
+    int local = 0;
+    uintptr_t addr = reinterpret_cast<uintptr_t>(&local);
+    EXPECT_GE(addr, low);
+    EXPECT_LT(addr, high);
+}
+
+TEST(StackCapture, stack_capture__inside_stack__then_exact_copy) {
+    volatile uint8_t frame[256];
+    for (size_t i = 0; i < sizeof(frame); i++) {
+        frame[i] = static_cast<uint8_t>(i * 7);
+    }
+
+    uint8_t out[256] = {};
+    size_t n = stack_capture_copy(out, const_cast<uint8_t*>(frame), sizeof(out));
+    EXPECT_EQ(n, sizeof(out));
+    EXPECT_EQ(memcmp(out, const_cast<uint8_t*>(frame), sizeof(out)), 0);
+}
+
+TEST(StackCapture, stack_capture__near_stack_top__then_clipped_at_top) {
+    std::thread worker([] {
+        uintptr_t low = 0, high = 0;
+        ASSERT_EQ(stack_capture_init_thread(), 0);
+        ASSERT_TRUE(stack_capture_get_bounds(&low, &high));
+
+        uint8_t out[512] = {};
+        const void* near_top = reinterpret_cast<const void*>(high - 64);
+        EXPECT_EQ(stack_capture_copy(out, near_top, sizeof(out)), 64u);
+    });
+    worker.join();
+}
+
+TEST(StackCapture, stack_capture__outside_stack__then_checked_read) {
+    std::vector<uint8_t> heap(300);
+    for (size_t i = 0; i < heap.size(); i++) {
+        heap[i] = static_cast<uint8_t>(0xC0 ^ i);
+    }
+
+    uint8_t out[300] = {};
+    size_t n = stack_capture_copy(out, heap.data(), sizeof(out));
+#if defined(__linux__) || defined(__APPLE__)
+    EXPECT_EQ(n, sizeof(out));
+    EXPECT_EQ(memcmp(out, heap.data(), sizeof(out)), 0);
+#else
+    EXPECT_EQ(n, 0u);
+#endif
+}
+
+TEST(StackCapture, stack_capture__unmapped_address__then_no_fault) {
+    long page = sysconf(_SC_PAGESIZE);
+    void* region = mmap(nullptr, static_cast<size_t>(page) * 2, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    ASSERT_NE(region, MAP_FAILED);
+    auto* base = static_cast<uint8_t*>(region);
+    memset(base, 0x5A, static_cast<size_t>(page));
+    ASSERT_EQ(munmap(base + page, static_cast<size_t>(page)), 0);
+
+    uint8_t out[128] = {};
+    // Entirely unmapped: nothing copied, no signal
+    EXPECT_EQ(stack_capture_copy(out, base + page, sizeof(out)), 0u);
+#if defined(__linux__)
+    // Straddling into the unmapped page: the mapped prefix still arrives
+    EXPECT_EQ(stack_capture_copy(out, base + page - 32, sizeof(out)), 32u);
+    EXPECT_EQ(out[0], 0x5A);
+#endif
+    munmap(base, static_cast<size_t>(page));
+}
+
+TEST(StackCapture, stack_capture__null_args__then_zero) {
+    uint8_t out[16];
+    int local = 0;
+    EXPECT_EQ(stack_capture_copy(nullptr, &local, sizeof(out)), 0u);
+    EXPECT_EQ(stack_capture_copy(out, nullptr, sizeof(out)), 0u);
+    EXPECT_EQ(stack_capture_copy(out, &local, 0), 0u);
+    EXPECT_EQ(stack_capture_copy_checked(out, nullptr, sizeof(out)), 0u);
+}
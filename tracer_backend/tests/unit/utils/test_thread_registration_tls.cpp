@@ -7,6 +7,8 @@
 extern "C" {
 #include <tracer_backend/utils/thread_registry.h>
 #include <tracer_backend/ada/thread.h>
+#include <tracer_backend/utils/ring_buffer.h>
+#include <tracer_backend/utils/ring_pool.h>
 }
 
 class RegistryFixture : public ::testing::Test {
@@ -54,6 +56,15 @@ TEST_F(RegistryFixture, ada_get_thread_lane__triggers_registration_and_caches) {
     EXPECT_EQ(second, first);
 }
 
+TEST_F(RegistryFixture, ada_get_thread_lane__registration__then_caches_slot_id) {
+    std::thread([]() {
+        ada_reset_tls_state();
+        ThreadLaneSet* lanes = ada_get_thread_lane();
+        ASSERT_NE(lanes, nullptr);
+        EXPECT_EQ((uint32_t)ada_get_tls_state()->slot_id, thread_lanes_get_slot_index(lanes));
+    }).join();
+}
+
 TEST_F(RegistryFixture, thread_registry__concurrent_registration__unique_pointers) {
     const int N = 16;
     std::vector<std::thread> ths;
@@ -86,3 +97,149 @@ TEST(ADATLS, reentrancy_guard__enter_exit__tracks_depth) {
     ada_exit_trace(g1);
     EXPECT_EQ(ada_get_tls_state()->call_depth, 0u);
 }
+
+static IndexEvent make_index_event(uint64_t ts) {
+    IndexEvent ev = {};
+    ev.timestamp = ts;
+    ev.function_id = 0x0000000100000001ull;
+    ev.event_kind = EVENT_KIND_CALL;
+    ev.detail_seq = INDEX_EVENT_NO_DETAIL_SEQ;
+    return ev;
+}
+
+static size_t active_index_events() {
+    RingBufferHeader* hdr = ring_pool_get_active_header(ada_get_tls_state()->index_pool);
+    return hdr ? ring_buffer_available_read_raw(hdr) : 0;
+}
+
+TEST_F(RegistryFixture, tls_stage_index_event__batch_fills__then_published_together) {
+    std::thread([]() {
+        ada_reset_tls_state();
+        ASSERT_NE(ada_get_thread_lane(), nullptr);
+        ada_tls_set_index_batching(4, UINT64_MAX);
+
+        for (uint64_t i = 0; i < 3; ++i) {
+            IndexEvent ev = make_index_event(i);
+            ASSERT_TRUE(ada_tls_stage_index_event(&ev, FLIGHT_RECORDER_IDLE));
+        }
+        EXPECT_EQ(ada_get_tls_state()->stage_count, 3u);
+        EXPECT_EQ(active_index_events(), 0u);
+
+        IndexEvent ev = make_index_event(3);
+        ASSERT_TRUE(ada_tls_stage_index_event(&ev, FLIGHT_RECORDER_IDLE));
+        EXPECT_EQ(ada_get_tls_state()->stage_count, 0u);
+        EXPECT_EQ(active_index_events(), 4u);
+
+        ada_tls_set_index_batching(0, 0);
+        ada_tls_thread_cleanup();
+    }).join();
+}
+
+TEST_F(RegistryFixture, tls_stage_index_event__trigger_or_age__then_flushes_early) {
+    std::thread([]() {
+        ada_reset_tls_state();
+        ASSERT_NE(ada_get_thread_lane(), nullptr);
+        ada_tls_set_index_batching(ADA_TLS_STAGE_CAPACITY, 1000);
+
+        IndexEvent ev = make_index_event(100);
+        ASSERT_TRUE(ada_tls_stage_index_event(&ev, FLIGHT_RECORDER_ARMED));
+
+        // Trigger fired: the armed batch is published before the new event
+        ev = make_index_event(200);
+        ASSERT_TRUE(ada_tls_stage_index_event(&ev, FLIGHT_RECORDER_RECORDING));
+        EXPECT_EQ(active_index_events(), 1u);
+        EXPECT_EQ(ada_get_tls_state()->stage_count, 1u);
+
+        // Oldest staged event is past the age bound
+        ev = make_index_event(200 + 1001);
+        ASSERT_TRUE(ada_tls_stage_index_event(&ev, FLIGHT_RECORDER_RECORDING));
+        EXPECT_EQ(active_index_events(), 2u);
+
+        // Swapping the ring takes the staged event with it
+        uint32_t old_idx = UINT32_MAX;
+        ASSERT_TRUE(ring_pool_swap_active(ada_get_tls_state()->index_pool, &old_idx));
+        EXPECT_EQ(ada_get_tls_state()->stage_count, 0u);
+        EXPECT_EQ(active_index_events(), 0u);
+
+        ada_tls_set_index_batching(0, 0);
+        ada_tls_thread_cleanup();
+    }).join();
+}
+
+TEST_F(RegistryFixture, tls_stage_index_event__thread_cleanup__then_staged_published) {
+    std::thread([]() {
+        ada_reset_tls_state();
+        ThreadLaneSet* lanes = ada_get_thread_lane();
+        ASSERT_NE(lanes, nullptr);
+        ada_tls_set_index_batching(8, UINT64_MAX);
+
+        RingBufferHeader* hdr = ring_pool_get_active_header(ada_get_tls_state()->index_pool);
+        ASSERT_NE(hdr, nullptr);
+        IndexEvent ev = make_index_event(1);
+        ASSERT_TRUE(ada_tls_stage_index_event(&ev, FLIGHT_RECORDER_IDLE));
+        ASSERT_TRUE(ada_tls_stage_index_event(&ev, FLIGHT_RECORDER_IDLE));
+        EXPECT_EQ(ring_buffer_available_read_raw(hdr), 0u);
+
+        ada_tls_thread_cleanup();
+        EXPECT_EQ(ring_buffer_available_read_raw(hdr), 2u);
+        ada_tls_set_index_batching(0, 0);
+    }).join();
+}
+
+TEST_F(RegistryFixture, tls_sweep_staged_events__quiet_thread__then_published_by_age_or_force) {
+    ada_tls_set_index_batching(8, 1000);
+    std::atomic<int> phase{0};
+    RingBufferHeader* hdr = nullptr;
+    std::thread producer([&]() {
+        ada_reset_tls_state();
+        ASSERT_NE(ada_get_thread_lane(), nullptr);
+        hdr = ring_pool_get_active_header(ada_get_tls_state()->index_pool);
+        IndexEvent ev = make_index_event(100);
+        ASSERT_TRUE(ada_tls_stage_index_event(&ev, FLIGHT_RECORDER_IDLE));
+        ASSERT_TRUE(ada_tls_stage_index_event(&ev, FLIGHT_RECORDER_IDLE));
+        phase.store(1);
+        // Goes quiet: no further event reaches the age check
+        while (phase.load() == 1) std::this_thread::yield();
+        ev = make_index_event(5000);
+        ASSERT_TRUE(ada_tls_stage_index_event(&ev, FLIGHT_RECORDER_IDLE));
+        phase.store(3);
+        while (phase.load() == 3) std::this_thread::yield();
+        ada_tls_thread_cleanup();
+    });
+    while (phase.load() == 0) std::this_thread::yield();
+    ASSERT_NE(hdr, nullptr);
+
+    // Younger than the age bound: left staged
+    EXPECT_EQ(ada_tls_sweep_staged_events(100 + 500, false), 0u);
+    EXPECT_EQ(ring_buffer_available_read_raw(hdr), 0u);
+
+    // Aged past the bound: the sweeper publishes for the quiet thread
+    EXPECT_EQ(ada_tls_sweep_staged_events(100 + 1001, false), 1u);
+    EXPECT_EQ(ring_buffer_available_read_raw(hdr), 2u);
+    EXPECT_EQ(ada_tls_sweep_staged_events(100 + 1001, false), 0u);
+
+    // Session stop publishes regardless of age
+    phase.store(2);
+    while (phase.load() == 2) std::this_thread::yield();
+    EXPECT_EQ(ada_tls_sweep_staged_events(0, true), 1u);
+    EXPECT_EQ(ring_buffer_available_read_raw(hdr), 3u);
+
+    phase.store(4);
+    producer.join();
+    ada_tls_set_index_batching(0, 0);
+}
+
+TEST(ADATLS, tls_stage_index_event__disabled_or_unregistered__then_not_staged) {
+    ada_reset_tls_state();
+    IndexEvent ev = make_index_event(1);
+
+    ada_tls_set_index_batching(1, 0); // A batch of one is no batching
+    EXPECT_EQ(ada_tls_get_index_batch(), 0u);
+    EXPECT_FALSE(ada_tls_stage_index_event(&ev, FLIGHT_RECORDER_IDLE));
+
+    ada_tls_set_index_batching(1000, 0);
+    EXPECT_EQ(ada_tls_get_index_batch(), (uint32_t)ADA_TLS_STAGE_CAPACITY);
+    EXPECT_FALSE(ada_tls_stage_index_event(&ev, FLIGHT_RECORDER_IDLE)); // No index pool
+    EXPECT_EQ(ada_tls_flush_index_events(), 0u);
+    ada_tls_set_index_batching(0, 0);
+}
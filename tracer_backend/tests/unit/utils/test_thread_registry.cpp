@@ -4,7 +4,10 @@
 #include <vector>
 #include <atomic>
 #include <chrono>
+#include <cstring>
+#include <memory>
 #include <unistd.h>
+#include <sys/mman.h>
 
 // Include both C and C++ headers
 extern "C" {
@@ -347,6 +350,60 @@ TEST_F(ThreadRegistryTest, thread_registry__unregister__then_inactive) {
     EXPECT_FALSE(lanes->active.load()) << "Thread should be inactive after unregister";
 }
 
+// Retired slots stay visible to the drain and are recycled without new ring memory
+TEST_F(ThreadRegistryTest, thread_registry__retire_and_reclaim__then_slot_reused_without_allocation) {
+    auto* c_registry = reinterpret_cast<ThreadRegistry*>(registry);
+    auto* lanes = reinterpret_cast<ThreadLaneSet*>(registry->register_thread(0x1001));
+    ASSERT_NE(lanes, nullptr);
+    uint32_t slot = thread_lanes_get_slot_index(lanes);
+    uint64_t pool_used = registry->segments[0].used.load();
+
+    ASSERT_TRUE(thread_registry_retire(c_registry, lanes));
+    EXPECT_FALSE(thread_registry_retire(c_registry, lanes)) << "Retire is one-shot";
+    EXPECT_TRUE(thread_lanes_is_retiring(lanes));
+    EXPECT_EQ(thread_registry_get_active_count(c_registry), 0u);
+    EXPECT_EQ(thread_registry_get_thread_at(c_registry, slot), lanes) << "Drain must still see it";
+
+    // A full drain cycle must begin after the exit
+    EXPECT_FALSE(thread_registry_reclaim_slot(c_registry, slot));
+    thread_registry_advance_epoch(c_registry);
+    EXPECT_FALSE(thread_registry_reclaim_slot(c_registry, slot));
+    thread_registry_advance_epoch(c_registry);
+    ASSERT_TRUE(thread_registry_reclaim_slot(c_registry, slot));
+    EXPECT_EQ(thread_registry_get_thread_at(c_registry, slot), nullptr);
+    EXPECT_EQ(thread_registry_get_slots_reclaimed(c_registry), 1u);
+
+    auto* reused = registry->register_thread(0x1002);
+    ASSERT_NE(reused, nullptr);
+    EXPECT_EQ(reused->slot_index, slot);
+    EXPECT_EQ(reused->thread_id, 0x1002u);
+    EXPECT_EQ(reused->retire_epoch.load(), 0u);
+    EXPECT_EQ(registry->segments[0].used.load(), pool_used) << "Rings must be recycled, not re-allocated";
+    EXPECT_EQ(thread_registry_get_slots_reused(c_registry), 1u);
+}
+
+TEST_F(ThreadRegistryTest, thread_registry__retired_with_submitted_ring__then_reclaim_waits) {
+    auto* c_registry = reinterpret_cast<ThreadRegistry*>(registry);
+    auto* lanes = reinterpret_cast<ThreadLaneSet*>(registry->register_thread(0x2001));
+    ASSERT_NE(lanes, nullptr);
+    Lane* index_lane = thread_lanes_get_index_lane(lanes);
+    uint32_t ring = lane_get_free_ring(index_lane);
+    ASSERT_NE(ring, UINT32_MAX);
+    ASSERT_TRUE(lane_submit_ring(index_lane, ring));
+
+    ASSERT_TRUE(thread_registry_retire(c_registry, lanes));
+    thread_registry_advance_epoch(c_registry);
+    thread_registry_advance_epoch(c_registry);
+    EXPECT_FALSE(thread_registry_reclaim_slot(c_registry, thread_lanes_get_slot_index(lanes)))
+        << "Submitted rings must be drained first";
+
+    uint32_t taken = lane_take_ring(index_lane);
+    ASSERT_EQ(taken, ring);
+    ASSERT_TRUE(lane_return_ring(index_lane, taken));
+    EXPECT_TRUE(thread_registry_reclaim_slot(c_registry, thread_lanes_get_slot_index(lanes)));
+    EXPECT_EQ(thread_registry_get_slots_reclaimed(c_registry), 1u);
+}
+
 // Performance tests
 TEST_F(ThreadRegistryTest, performance__registration__then_fast) {
     // Test registration performance up to runtime capacity
@@ -562,6 +619,82 @@ TEST_F(ThreadRegistryTest, thread_registry__c_api_compatibility__then_works) {
     thread_registry_dump(c_registry);
 }
 
+TEST_F(ThreadRegistryTest, lane_has_submitted_rings__submit_and_take__then_tracks_queue) {
+    ThreadRegistry* c_registry = thread_registry_init(memory, memory_size);
+    ASSERT_NE(c_registry, nullptr);
+
+    ThreadLaneSet* lanes = thread_registry_register(c_registry, 67891);
+    ASSERT_NE(lanes, nullptr);
+    Lane* index_lane = thread_lanes_get_index_lane(lanes);
+    ASSERT_NE(index_lane, nullptr);
+
+    EXPECT_FALSE(lane_has_submitted_rings(index_lane));
+
+    uint32_t ring = lane_get_free_ring(index_lane);
+    ASSERT_NE(ring, UINT32_MAX);
+    ASSERT_TRUE(lane_submit_ring(index_lane, ring));
+    EXPECT_TRUE(lane_has_submitted_rings(index_lane));
+
+    EXPECT_EQ(lane_take_ring(index_lane), ring);
+    EXPECT_FALSE(lane_has_submitted_rings(index_lane));
+
+    EXPECT_FALSE(lane_has_submitted_rings(nullptr));
+}
+
+TEST_F(ThreadRegistryTest, lane_take_rings__several_submitted__then_taken_in_order_and_returned_at_once) {
+    ThreadRegistry* c_registry = thread_registry_init(memory, memory_size);
+    ASSERT_NE(c_registry, nullptr);
+    ThreadLaneSet* lanes = thread_registry_register(c_registry, 67892);
+    ASSERT_NE(lanes, nullptr);
+    Lane* index_lane = thread_lanes_get_index_lane(lanes);
+
+    // Free queue holds rings 1..3; submit them all
+    uint32_t submitted[RINGS_PER_INDEX_LANE - 1];
+    for (uint32_t& ring : submitted) {
+        ring = lane_get_free_ring(index_lane);
+        ASSERT_NE(ring, UINT32_MAX);
+        ASSERT_TRUE(lane_submit_ring(index_lane, ring));
+    }
+    EXPECT_EQ(lane_get_free_ring(index_lane), UINT32_MAX);
+
+    uint32_t taken[8] = {};
+    ASSERT_EQ(lane_take_rings(index_lane, taken, 2), 2u);
+    EXPECT_EQ(taken[0], submitted[0]);
+    EXPECT_EQ(taken[1], submitted[1]);
+    ASSERT_EQ(lane_take_rings(index_lane, taken + 2, 8), 1u);
+    EXPECT_EQ(taken[2], submitted[2]);
+    EXPECT_EQ(lane_take_rings(index_lane, taken, 8), 0u);
+
+    EXPECT_EQ(lane_return_rings(index_lane, taken, 3), 3u);
+    for (uint32_t i = 0; i < 3; ++i) {
+        EXPECT_EQ(lane_get_free_ring(index_lane), taken[i]);
+    }
+    EXPECT_EQ(lane_take_rings(nullptr, taken, 8), 0u);
+    EXPECT_EQ(lane_return_rings(nullptr, taken, 3), 0u);
+}
+
+TEST_F(ThreadRegistryTest, lane_queues__full__then_rejected_without_overwrite) {
+    ThreadRegistry* c_registry = thread_registry_init(memory, memory_size);
+    ASSERT_NE(c_registry, nullptr);
+    ThreadLaneSet* lanes = thread_registry_register(c_registry, 67893);
+    ASSERT_NE(lanes, nullptr);
+    Lane* detail_lane = thread_lanes_get_detail_lane(lanes);
+
+    // One slot stays empty: a capacity-N queue holds N - 1 entries
+    for (uint32_t i = 0; i < QUEUE_COUNT_DETAIL_LANE - 1; ++i) {
+        ASSERT_TRUE(lane_submit_ring(detail_lane, i % RINGS_PER_DETAIL_LANE)) << "entry " << i;
+    }
+    EXPECT_FALSE(lane_submit_ring(detail_lane, 1)) << "Full submit queue must refuse";
+    EXPECT_EQ(lane_take_ring(detail_lane), 0u) << "Oldest entry must survive";
+
+    // The free queue starts with ring 1; fill the rest and check a partial batch
+    std::vector<uint32_t> rings(QUEUE_COUNT_DETAIL_LANE, 0);
+    EXPECT_EQ(lane_return_rings(detail_lane, rings.data(), static_cast<uint32_t>(rings.size())),
+              QUEUE_COUNT_DETAIL_LANE - 2u);
+    EXPECT_FALSE(lane_return_ring(detail_lane, 0));
+    EXPECT_EQ(lane_get_free_ring(detail_lane), 1u);
+}
+
 // Test lane marking event functions
 TEST_F(ThreadRegistryTest, lane_mark_event__valid_lane__then_sets_marked) {
     ThreadRegistry* c_registry = thread_registry_init(memory, memory_size);
@@ -697,3 +830,246 @@ TEST_F(ThreadRegistryTest, lane_mark_event__multiple_lanes__then_independent) {
     EXPECT_FALSE(lane_has_marked_event(detail_lane1));
     EXPECT_TRUE(lane_has_marked_event(detail_lane2));
 }
+
+// Registries larger than one bitmap word (MAX_THREADS) live in an anonymous
+// mapping; only the pages registration touches get committed
+class LargeRegistryTest : public ::testing::Test {
+protected:
+    static constexpr uint32_t kCapacity = 200;
+    void* memory = MAP_FAILED;
+    size_t memory_size = 0;
+    ada::internal::ThreadRegistry* registry = nullptr;
+    ThreadRegistry* c_registry = nullptr;
+
+    void SetUp() override {
+        memory_size = thread_registry_calculate_memory_size_with_capacity(kCapacity);
+        memory = mmap(nullptr, memory_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        ASSERT_NE(memory, MAP_FAILED);
+        registry = ada::internal::ThreadRegistry::create(memory, memory_size, kCapacity);
+        ASSERT_NE(registry, nullptr);
+        c_registry = reinterpret_cast<ThreadRegistry*>(registry);
+        ada_set_global_registry(c_registry);
+    }
+
+    void TearDown() override {
+        ada_set_global_registry(nullptr);
+        if (memory != MAP_FAILED) {
+            munmap(memory, memory_size);
+        }
+    }
+};
+
+TEST_F(LargeRegistryTest, thread_registry__capacity_beyond_one_word__then_every_slot_claimable) {
+    std::vector<bool> seen(kCapacity, false);
+    for (uint32_t i = 0; i < kCapacity; ++i) {
+        auto* lanes = registry->register_thread(i + 1000);
+        ASSERT_NE(lanes, nullptr) << "Registration " << i << " should succeed";
+        uint32_t slot = thread_lanes_get_slot_index(reinterpret_cast<ThreadLaneSet*>(lanes));
+        ASSERT_LT(slot, kCapacity);
+        EXPECT_FALSE(seen[slot]) << "Slot " << slot << " handed out twice";
+        seen[slot] = true;
+    }
+
+    EXPECT_EQ(registry->register_thread(kCapacity + 1000), nullptr);
+    EXPECT_EQ(thread_registry_get_active_count(c_registry), kCapacity);
+
+    uint32_t walked = 0;
+    for (uint32_t slot = thread_registry_next_active_slot(c_registry, 0); slot != UINT32_MAX;
+         slot = thread_registry_next_active_slot(c_registry, slot + 1)) {
+        ++walked;
+    }
+    EXPECT_EQ(walked, kCapacity);
+    EXPECT_EQ(thread_registry_next_active_slot(c_registry, kCapacity), UINT32_MAX);
+}
+
+TEST_F(LargeRegistryTest, thread_registry__release_slot__then_lowest_reclaimed_and_generation_changes) {
+    for (uint32_t i = 0; i < 130; ++i) {
+        ASSERT_NE(registry->register_thread(i + 1000), nullptr);
+    }
+    ThreadLaneSet* lanes70 = thread_registry_get_thread_at(c_registry, 70);
+    ASSERT_NE(lanes70, nullptr);
+    ThreadLaneSet* lanes100 = thread_registry_get_thread_at(c_registry, 100);
+    ASSERT_NE(lanes100, nullptr);
+
+    uint64_t generation = thread_registry_get_slot_generation(c_registry);
+    ASSERT_TRUE(thread_registry_unregister_by_id(
+        c_registry, reinterpret_cast<ada::internal::ThreadLaneSet*>(lanes100)->thread_id));
+    ASSERT_TRUE(thread_registry_unregister_by_id(
+        c_registry, reinterpret_cast<ada::internal::ThreadLaneSet*>(lanes70)->thread_id));
+    EXPECT_NE(thread_registry_get_slot_generation(c_registry), generation);
+
+    // Walk skips the released slots across word boundaries
+    EXPECT_EQ(thread_registry_next_active_slot(c_registry, 70), 71u);
+    EXPECT_EQ(thread_registry_next_active_slot(c_registry, 100), 101u);
+    EXPECT_EQ(thread_registry_get_active_count(c_registry), 128u);
+
+    // The lowest free slot is reused first, keeping rings from the first claim
+    auto* again = registry->register_thread(5000);
+    ASSERT_NE(again, nullptr);
+    EXPECT_EQ(thread_lanes_get_slot_index(reinterpret_cast<ThreadLaneSet*>(again)), 70u);
+    auto* next = registry->register_thread(5001);
+    ASSERT_NE(next, nullptr);
+    EXPECT_EQ(thread_lanes_get_slot_index(reinterpret_cast<ThreadLaneSet*>(next)), 100u);
+}
+
+TEST_F(LargeRegistryTest, thread_registry__capacity_above_max__then_create_rejects) {
+    EXPECT_EQ(ada::internal::ThreadRegistry::create(memory, memory_size, THREAD_REGISTRY_MAX_CAPACITY + 1),
+              nullptr);
+}
+
+// Ring geometry and overflow growth
+static std::unique_ptr<uint8_t[]> alloc_geometry_arena(uint32_t capacity, const ThreadRegistryGeometry* g,
+                                                       size_t* out_size) {
+    *out_size = thread_registry_calculate_memory_size_with_geometry(capacity, g);
+    auto arena = std::unique_ptr<uint8_t[]>(new uint8_t[*out_size]);
+    std::memset(arena.get(), 0, *out_size);
+    return arena;
+}
+
+TEST(ThreadRegistryGeometry, geometry__custom_ring_sizes__then_lanes_use_them) {
+    ThreadRegistryGeometry g;
+    thread_registry_geometry_default(&g);
+    EXPECT_EQ(g.index_ring_bytes, 64u * 1024);
+    EXPECT_EQ(g.index_ring_count, 4u);
+    EXPECT_EQ(g.overflow_bytes, 0u);
+    g.index_ring_bytes = 100 * 1024;  // Rounded up to 128 KiB
+    g.index_ring_count = 6;
+    g.detail_ring_bytes = 32 * 1024;
+    g.detail_ring_count = 99;         // Clamped to the descriptor table
+
+    const uint32_t capacity = 3;
+    size_t size = 0;
+    auto arena = alloc_geometry_arena(capacity, &g, &size);
+    ThreadRegistry* reg = thread_registry_init_with_geometry(arena.get(), size, capacity, &g);
+    ASSERT_NE(reg, nullptr);
+    ASSERT_NE(thread_registry_attach(arena.get()), nullptr);
+
+    for (uint32_t i = 0; i < capacity; ++i) {
+        ThreadLaneSet* lanes = thread_registry_register(reg, 0x3000 + i);
+        ASSERT_NE(lanes, nullptr) << "Sizing must cover every slot, slot " << i;
+        Lane* index_lane = thread_lanes_get_index_lane(lanes);
+        Lane* detail_lane = thread_lanes_get_detail_lane(lanes);
+        EXPECT_EQ(ada::internal::to_cpp(index_lane)->ring_count, 6u);
+        EXPECT_EQ(ada::internal::to_cpp(detail_lane)->ring_count, 32u);
+        EXPECT_EQ(thread_registry_get_ring_bytes(reg, index_lane, 5), 128u * 1024);
+        EXPECT_EQ(thread_registry_get_ring_bytes(reg, detail_lane, 31), 32u * 1024);
+        EXPECT_EQ(thread_registry_get_ring_bytes(reg, index_lane, 6), 0u);
+        RingBufferHeader* hdr = thread_registry_get_ring_header_by_idx(reg, index_lane, 5);
+        ASSERT_NE(hdr, nullptr);
+        EXPECT_GT(ring_buffer_available_write_raw(hdr), 1023u);  // More than a default ring holds
+    }
+    EXPECT_EQ(thread_registry_grow_lane(reg, thread_registry_get_thread_at(reg, 0), 0), UINT32_MAX)
+        << "No overflow segment, no growth";
+}
+
+TEST(ThreadRegistryGeometry, grow_lane__overflow_segment__then_rings_appended_until_spent) {
+    ThreadRegistryGeometry g;
+    thread_registry_geometry_default(&g);
+    g.overflow_bytes = 3 * 64 * 1024;  // Three index rings
+
+    size_t size = 0;
+    auto arena = alloc_geometry_arena(2, &g, &size);
+    ThreadRegistry* reg = thread_registry_init_with_geometry(arena.get(), size, 2, &g);
+    ASSERT_NE(reg, nullptr);
+    ASSERT_NE(thread_registry_attach(arena.get()), nullptr);
+    auto* cpp_reg = ada::internal::to_cpp(reg);
+    ASSERT_EQ(cpp_reg->segment_count.load(), 2u);
+    EXPECT_EQ(cpp_reg->segments[1].kind, ada::internal::SEGMENT_KIND_OVERFLOW);
+
+    ThreadLaneSet* lanes = thread_registry_register(reg, 0x4001);
+    ASSERT_NE(lanes, nullptr);
+    Lane* index_lane = thread_lanes_get_index_lane(lanes);
+    uint64_t pool_used = cpp_reg->segments[0].used.load();
+
+    uint8_t* overflow_base = arena.get() + cpp_reg->segments[1].base_offset;
+    for (uint32_t expected = RINGS_PER_INDEX_LANE; expected < RINGS_PER_INDEX_LANE + 3; ++expected) {
+        uint32_t grown = thread_registry_grow_lane(reg, lanes, 0);
+        ASSERT_EQ(grown, expected);
+        auto* hdr = reinterpret_cast<uint8_t*>(thread_registry_get_ring_header_by_idx(reg, index_lane, grown));
+        EXPECT_GE(hdr, overflow_base);
+        EXPECT_LT(hdr, overflow_base + cpp_reg->segments[1].size);
+    }
+    EXPECT_EQ(thread_registry_grow_lane(reg, lanes, 0), UINT32_MAX) << "Overflow segment spent";
+    EXPECT_EQ(thread_registry_get_rings_grown(reg), 3u);
+    EXPECT_EQ(thread_registry_get_ring_growth_denied(reg), 1u);
+    EXPECT_EQ(cpp_reg->segments[0].used.load(), pool_used) << "Growth must not touch the slot pool";
+
+    // A grown ring circulates like the initial ones
+    uint32_t grown = RINGS_PER_INDEX_LANE + 2;
+    ASSERT_TRUE(lane_submit_ring(index_lane, grown));
+    EXPECT_EQ(lane_take_ring(index_lane), grown);
+    EXPECT_TRUE(lane_return_ring(index_lane, grown));
+}
+
+TEST(LaneView, lane_view_sync__registered_lane__then_matches_registry_and_reuses_until_epoch_moves) {
+    size_t size = 0;
+    auto arena = alloc_geometry_arena(2, nullptr, &size);
+    ThreadRegistry* reg = thread_registry_init_with_geometry(arena.get(), size, 2, nullptr);
+    ASSERT_NE(reg, nullptr);
+    ASSERT_NE(thread_registry_attach(arena.get()), nullptr);
+    ThreadLaneSet* lanes = thread_registry_register(reg, 0x5001);
+    ASSERT_NE(lanes, nullptr);
+    Lane* index_lane = thread_lanes_get_index_lane(lanes);
+
+    LaneView view{};
+    ASSERT_TRUE(lane_view_sync(reg, index_lane, &view));
+    ASSERT_EQ(view.ring_count, static_cast<uint32_t>(RINGS_PER_INDEX_LANE));
+    for (uint32_t i = 0; i < view.ring_count; ++i) {
+        EXPECT_EQ(view.rings[i], thread_registry_get_ring_header_by_idx(reg, index_lane, i));
+    }
+    EXPECT_EQ(lane_view_active_ring(&view), thread_registry_get_active_ring_header(reg, index_lane));
+    EXPECT_EQ(lane_view_ring(&view, RINGS_PER_INDEX_LANE), nullptr);
+
+    // View and lane_* operations drive the same queues
+    uint32_t ring = lane_view_get_free_ring(&view);
+    ASSERT_NE(ring, UINT32_MAX);
+    ASSERT_TRUE(lane_view_submit_ring(&view, ring));
+    EXPECT_EQ(lane_take_ring(index_lane), ring);
+    ASSERT_TRUE(lane_view_return_ring(&view, ring));
+    ASSERT_TRUE(lane_submit_ring(index_lane, ring));
+    EXPECT_EQ(lane_view_take_ring(&view), ring);
+
+    // Same lane and epoch: kept as is; an epoch change rebuilds it
+    view.rings[0] = nullptr;
+    ASSERT_TRUE(lane_view_sync(reg, index_lane, &view));
+    EXPECT_EQ(view.rings[0], nullptr);
+    ada::internal::to_cpp(reg)->epoch.fetch_add(1);
+    ASSERT_TRUE(lane_view_sync(reg, index_lane, &view));
+    EXPECT_EQ(view.rings[0], thread_registry_get_ring_header_by_idx(reg, index_lane, 0));
+
+    // Another lane rebuilds too; an unresolvable one clears the view
+    Lane* detail_lane = thread_lanes_get_detail_lane(lanes);
+    ASSERT_TRUE(lane_view_sync(reg, detail_lane, &view));
+    EXPECT_EQ(view.ring_count, static_cast<uint32_t>(RINGS_PER_DETAIL_LANE));
+    EXPECT_EQ(view.rings[1], thread_registry_get_ring_header_by_idx(reg, detail_lane, 1));
+    EXPECT_FALSE(lane_view_sync(reg, nullptr, &view));
+    EXPECT_EQ(view.lane, nullptr);
+}
+
+TEST(LaneView, lane_view_ring__lane_grew_after_build__then_resolved_without_rebuild) {
+    ThreadRegistryGeometry g;
+    thread_registry_geometry_default(&g);
+    g.overflow_bytes = 2 * 64 * 1024;
+
+    size_t size = 0;
+    auto arena = alloc_geometry_arena(2, &g, &size);
+    ThreadRegistry* reg = thread_registry_init_with_geometry(arena.get(), size, 2, &g);
+    ASSERT_NE(reg, nullptr);
+    ThreadLaneSet* lanes = thread_registry_register(reg, 0x5002);
+    ASSERT_NE(lanes, nullptr);
+    Lane* index_lane = thread_lanes_get_index_lane(lanes);
+
+    LaneView view{};
+    ASSERT_TRUE(lane_view_sync(reg, index_lane, &view));
+    uint32_t epoch = view.epoch;
+    uint32_t grown = thread_registry_grow_lane(reg, lanes, 0);
+    ASSERT_EQ(grown, static_cast<uint32_t>(RINGS_PER_INDEX_LANE));
+
+    ASSERT_TRUE(lane_view_sync(reg, index_lane, &view));
+    EXPECT_EQ(view.epoch, epoch) << "Growth leaves the segment table, and views, alone";
+    EXPECT_EQ(view.ring_count, static_cast<uint32_t>(RINGS_PER_INDEX_LANE));
+    RingBufferHeader* hdr = lane_view_ring(&view, grown);
+    ASSERT_NE(hdr, nullptr);
+    EXPECT_EQ(hdr, thread_registry_get_ring_header_by_idx(reg, index_lane, grown));
+    EXPECT_EQ(view.ring_count, grown + 1);
+}
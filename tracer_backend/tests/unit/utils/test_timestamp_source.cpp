@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+
+extern "C" {
+#include <tracer_backend/utils/timestamp_source.h>
+}
+
+TEST(TimestampSource, timestamp_source__monotonic__then_identity_conversion) {
+    TimestampCalibration cal;
+    ASSERT_EQ(timestamp_source_calibrate(TIMESTAMP_SOURCE_MONOTONIC, 0, &cal), 0);
+    EXPECT_EQ(cal.source, static_cast<uint32_t>(TIMESTAMP_SOURCE_MONOTONIC));
+
+    uint64_t now = timestamp_source_read(cal.source);
+    EXPECT_EQ(timestamp_source_to_ns(&cal, now), now);
+    EXPECT_EQ(timestamp_source_duration_from_ns(&cal, 12345), 12345u);
+}
+
+TEST(TimestampSource, timestamp_source__fixed_calibration__then_converts_both_sides_of_base) {
+    TimestampCalibration cal = {};
+    cal.source = TIMESTAMP_SOURCE_COUNTER;
+    cal.tick_base = 1000;
+    cal.ns_base = 1000000;
+    cal.mult = 3ull << 31; // 1.5 ns per tick
+    cal.shift = 32;
+    cal.ticks_per_sec = 666666666;
+
+    EXPECT_EQ(timestamp_source_to_ns(&cal, 1000), 1000000u);
+    EXPECT_EQ(timestamp_source_to_ns(&cal, 3000), 1003000u);
+    EXPECT_EQ(timestamp_source_to_ns(&cal, 0), 998500u);
+    EXPECT_EQ(timestamp_source_duration_from_ns(&cal, 1000000000ull), 666666666u);
+}
+
+TEST(TimestampSource, timestamp_source__counter__then_tracks_monotonic_clock) {
+    if (!timestamp_source_counter_usable()) {
+        GTEST_SKIP() << "No invariant CPU counter";
+    }
+    TimestampCalibration cal;
+    ASSERT_EQ(timestamp_source_calibrate(TIMESTAMP_SOURCE_COUNTER, 10, &cal), 0);
+    ASSERT_EQ(cal.source, static_cast<uint32_t>(TIMESTAMP_SOURCE_COUNTER));
+    EXPECT_GT(cal.ticks_per_sec, 0u);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    uint64_t ticks = timestamp_source_read(cal.source);
+    uint64_t ns = timestamp_source_monotonic_ns();
+    int64_t error = static_cast<int64_t>(timestamp_source_to_ns(&cal, ticks)) -
+                    static_cast<int64_t>(ns);
+    // Generous: scheduling noise between the two reads dominates
+    EXPECT_LT(std::llabs(error), 1000000);
+
+    TimestampCalibration refined;
+    ASSERT_EQ(timestamp_source_refine(&cal, &refined), 0);
+    EXPECT_EQ(refined.tick_base, cal.tick_base);
+    EXPECT_EQ(refined.ns_base, cal.ns_base);
+}
+
+TEST(TimestampSource, timestamp_source__parse__then_selects_source) {
+    EXPECT_EQ(timestamp_source_parse(nullptr), static_cast<uint32_t>(TIMESTAMP_SOURCE_MONOTONIC));
+    EXPECT_EQ(timestamp_source_parse("monotonic"), static_cast<uint32_t>(TIMESTAMP_SOURCE_MONOTONIC));
+    EXPECT_EQ(timestamp_source_parse("bogus"), static_cast<uint32_t>(TIMESTAMP_SOURCE_MONOTONIC));
+    EXPECT_EQ(timestamp_source_parse("counter"), static_cast<uint32_t>(TIMESTAMP_SOURCE_COUNTER));
+    EXPECT_EQ(timestamp_source_parse("auto"),
+              static_cast<uint32_t>(timestamp_source_counter_usable() ? TIMESTAMP_SOURCE_COUNTER
+                                                                      : TIMESTAMP_SOURCE_MONOTONIC));
+}
+
+TEST(TimestampSource, timestamp_source__null_args__then_einval) {
+    TimestampCalibration cal;
+    EXPECT_EQ(timestamp_source_calibrate(TIMESTAMP_SOURCE_COUNTER, 1, nullptr), -EINVAL);
+    EXPECT_EQ(timestamp_source_calibrate(7, 1, &cal), -EINVAL);
+    EXPECT_EQ(timestamp_source_refine(nullptr, &cal), -EINVAL);
+    EXPECT_EQ(timestamp_source_refine(&cal, nullptr), -EINVAL);
+}